@@ -0,0 +1,35 @@
+#pragma once
+
+namespace common
+{
+
+using crc_t = uint64_t;
+
+constexpr crc_t Crc(std::string_view pData)
+{
+	crc_t crc = 0xabcdef123456789a;
+	for (const char& c : pData)
+	{
+		crc = (crc ^ c) * 0x123456789abcdef1;
+	}
+	return crc;
+}
+
+// Crc to index pair, tables of these are sorted by crc at pack time so a lookup is a binary search over a constexpr array
+struct CrcIndex
+{
+	crc_t crc = 0;
+	int64_t iIndex = 0;
+};
+
+// Returns -1 when the crc isn't in the table, constant folds when both the table and the crc are known at compile time
+constexpr int64_t FindCrcIndex(std::span<const CrcIndex> table, crc_t crc)
+{
+	auto it = std::lower_bound(table.begin(), table.end(), crc, [](const CrcIndex& rEntry, crc_t crc)
+	{
+		return rEntry.crc < crc;
+	});
+	return it != table.end() && it->crc == crc ? it->iIndex : -1;
+}
+
+} // namespace common
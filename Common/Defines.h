@@ -131,10 +131,12 @@ while (0)
 	#define SCOPED_CPU_PROFILE_MULTITHREADED(a, b) CPU_PROFILE_START_MULTITHREADED(a, b); common::ScopedLambda CONCAT(scopedCpuProfile, __LINE__)([=](){ CPU_PROFILE_STOP(a); })
 	#define CPU_PROFILE_STOP(a) engine::gpProfileManager->CpuStop(a, false)
 	#define CPU_PROFILE_STOP_AND_SMOOTH(a) engine::gpProfileManager->CpuStop(a, true)
+	#define CPU_PROFILE_ADD(a, b) engine::gpProfileManager->CpuAdd(a, b)
 	#define GPU_PROFILE_START(a, b, c) engine::gpProfileManager->GpuStart(a, b, c)
 	#define GPU_PROFILE_STOP(a, b, c) engine::gpProfileManager->GpuStop(a, b, c)
 	#define GPU_PROFILE_READ(a, b, c) engine::gpProfileManager->GpuRead(a, b, c)
 	#define UPDATE_PROFILE_TEXT() engine::gpProfileManager->UpdateProfileText()
+	#define PROFILE_EXPORT_SUMMARY() engine::gpProfileManager->ExportSummary()
 #else
 	#define PROFILE_MANAGER_RESET_GLOBAL_QUERY_POOLS(a, b) ((void)0)
 	#define PROFILE_MANAGER_RESET_MAIN_QUERY_POOLS(a, b) ((void)0)
@@ -151,8 +153,10 @@ while (0)
 	#define SCOPED_CPU_PROFILE_MULTITHREADED(a, b) ((void)0)
 	#define CPU_PROFILE_STOP(a) ((void)0)
 	#define CPU_PROFILE_STOP_AND_SMOOTH(a) ((void)0)
+	#define CPU_PROFILE_ADD(a, b) ((void)0)
 	#define GPU_PROFILE_START(a, b, c) ((void)0)
 	#define GPU_PROFILE_STOP(a, b, c) ((void)0)
 	#define GPU_PROFILE_READ(a, b, c) ((void)0)
 	#define UPDATE_PROFILE_TEXT() ((void)0)
+	#define PROFILE_EXPORT_SUMMARY() ((void)0)
 #endif
@@ -59,12 +59,15 @@ using namespace std::chrono_literals;
 #include <algorithm>
 #include <any>
 #include <array>
+#include <atomic>
+#include <bit>
 // Do not use, very slow: #include <bitset>
 #include <charconv>
 #include <chrono>
 using namespace std::chrono_literals;
 #include <codecvt>
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
 #include <deque>
 #include <exception>
@@ -77,6 +80,7 @@ using namespace std::chrono_literals;
 #include <istream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numbers>
 #include <numeric>
 #include <optional>
@@ -86,6 +90,7 @@ using namespace std::chrono_literals;
 #include <ranges>
 #include <ratio>
 #include <span>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -104,6 +109,11 @@ using namespace std::chrono_literals;
 #include <windows.h>
 #include <wrl/client.h>
 #include <shellapi.h>
+#include <timeapi.h>
+#pragma comment(lib, "Winmm.lib")
+#if !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+	#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 
 static_assert(VER_PRODUCTBUILD >= 10011 && VER_PRODUCTBUILD_QFE >= 16384, "Update the Windows SDK");
 
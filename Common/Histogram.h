@@ -0,0 +1,110 @@
+#pragma once
+
+namespace common
+{
+
+// Log bucketed histogram of non negative integers, every power of two range is split into kiSubBucketCount linear buckets
+// Values below kiSubBucketCount are exact, above that a bucket is never wider than 1 / kiSubBucketCount of its values
+// Recording is lock free and can be done from any thread, reads taken while other threads record are approximate but never torn
+class Histogram
+{
+public:
+
+	static constexpr int64_t kiSubBucketBits = 4;
+	static constexpr int64_t kiSubBucketCount = 1ll << kiSubBucketBits;
+	static constexpr int64_t kiBucketCount = (64 - kiSubBucketBits + 1) * kiSubBucketCount;
+
+	static constexpr int64_t BucketIndex(uint64_t uiValue) noexcept
+	{
+		if (uiValue < kiSubBucketCount)
+		{
+			return static_cast<int64_t>(uiValue);
+		}
+
+		int64_t iShift = std::bit_width(uiValue) - 1 - kiSubBucketBits;
+		return (iShift + 1) * kiSubBucketCount + static_cast<int64_t>(uiValue >> iShift) - kiSubBucketCount;
+	}
+
+	// Largest value that lands in the bucket
+	static constexpr uint64_t BucketMax(int64_t iBucket) noexcept
+	{
+		int64_t iGroup = iBucket / kiSubBucketCount;
+		if (iGroup == 0)
+		{
+			return static_cast<uint64_t>(iBucket);
+		}
+
+		int64_t iShift = iGroup - 1;
+		uint64_t uiLowest = static_cast<uint64_t>(iBucket % kiSubBucketCount + kiSubBucketCount) << iShift;
+		return uiLowest + ((1ull << iShift) - 1);
+	}
+
+	void Record(int64_t iValue) noexcept
+	{
+		uint64_t uiValue = static_cast<uint64_t>(std::max<int64_t>(iValue, 0));
+		mpuiBuckets[BucketIndex(uiValue)].fetch_add(1, std::memory_order_relaxed);
+		miCount.fetch_add(1, std::memory_order_relaxed);
+
+		uint64_t uiMax = muiMax.load(std::memory_order_relaxed);
+		while (uiValue > uiMax && !muiMax.compare_exchange_weak(uiMax, uiValue, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	// Not safe against concurrent Record(), a value recorded during a reset may be partly kept
+	void Reset() noexcept
+	{
+		for (std::atomic<uint32_t>& rBucket : mpuiBuckets)
+		{
+			rBucket.store(0, std::memory_order_relaxed);
+		}
+		miCount.store(0, std::memory_order_relaxed);
+		muiMax.store(0, std::memory_order_relaxed);
+	}
+
+	int64_t Count() const noexcept
+	{
+		return miCount.load(std::memory_order_relaxed);
+	}
+
+	int64_t Max() const noexcept
+	{
+		return static_cast<int64_t>(muiMax.load(std::memory_order_relaxed));
+	}
+
+	// fPercentile is in [0, 1], returns the upper bound of the bucket holding that rank so the result never understates the tail
+	int64_t Percentile(float fPercentile) const noexcept
+	{
+		int64_t iCount = Count();
+		if (iCount == 0)
+		{
+			return 0;
+		}
+
+		int64_t iRank = std::clamp<int64_t>(static_cast<int64_t>(std::ceil(static_cast<double>(fPercentile) * static_cast<double>(iCount))), 1, iCount);
+		uint64_t uiMax = muiMax.load(std::memory_order_relaxed);
+
+		int64_t iSeen = 0;
+		for (int64_t i = 0; i < kiBucketCount; ++i)
+		{
+			iSeen += mpuiBuckets[i].load(std::memory_order_relaxed);
+			if (iSeen >= iRank)
+			{
+				return static_cast<int64_t>(std::min(BucketMax(i), uiMax));
+			}
+		}
+
+		return static_cast<int64_t>(uiMax);
+	}
+
+private:
+
+	std::atomic<uint32_t> mpuiBuckets[kiBucketCount] {};
+	std::atomic<int64_t> miCount = 0;
+	std::atomic<uint64_t> muiMax = 0;
+};
+
+static_assert(Histogram::BucketIndex(~0ull) == Histogram::kiBucketCount - 1);
+static_assert(Histogram::BucketMax(Histogram::BucketIndex(1000)) >= 1000 && Histogram::BucketIndex(Histogram::BucketMax(Histogram::BucketIndex(1000))) == Histogram::BucketIndex(1000));
+
+} // namespace common
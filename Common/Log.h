@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LogFormatters.h"
+#include "MpscQueue.h"
 #include "ThreadLocal.h"
 
 namespace common
@@ -14,8 +15,244 @@ inline void LogIndent(int64_t iIndent)
 	gpThreadLocal->miLogIndent += iIndent;
 }
 
+// Held by whoever writes to the log outputs, the LogWriter thread or a synchronous flush
 inline std::mutex gLogMutex;
 
+// gLogMutex isn't recursive, a crash handler running on the thread that holds it must not take it again
+inline thread_local bool gbLogMutexHeld = false;
+
+class LogLockGuard
+{
+public:
+
+	LogLockGuard()
+	{
+		gLogMutex.lock();
+		gbLogMutexHeld = true;
+	}
+
+	explicit LogLockGuard(std::adopt_lock_t)
+	{
+		gbLogMutexHeld = true;
+	}
+
+	~LogLockGuard()
+	{
+		gbLogMutexHeld = false;
+		gLogMutex.unlock();
+	}
+
+	LogLockGuard(const LogLockGuard&) = delete;
+	LogLockGuard& operator=(const LogLockGuard&) = delete;
+};
+
+// gLogMutex must be held
+inline void WriteLogRecord(const char* pcText)
+{
+	++giMyOutputDebugString;
+	OutputDebugString(pcText);
+	--giMyOutputDebugString;
+#if defined(BT_DATA_PACKER)
+	fputs(pcText, stdout);
+#endif
+	if (gpLogFileStream)
+	{
+		*gpLogFileStream << pcText;
+	}
+}
+
+enum class LogOverflow
+{
+	kDrop,
+	kBlock,
+};
+
+// Log() formats on the calling thread and copies the line into a lock free ring, a writer thread empties it and flushes the file once per batch
+// Lines too long for a slot, and everything logged while no LogWriter exists, are written synchronously after the queued lines
+class LogWriter
+{
+public:
+
+	static constexpr int64_t kiSlotSize = 512;
+	static constexpr int64_t kiCapacity = 2048;
+
+	explicit LogWriter(LogOverflow eLogOverflow);
+	~LogWriter();
+
+	// Any thread, returns false if the line has to be written synchronously
+	bool Push(std::string_view text) noexcept
+	{
+		if (static_cast<int64_t>(text.size()) >= kiSlotSize)
+		{
+			return false;
+		}
+
+		auto fill = [&](Record& rRecord)
+		{
+			std::copy_n(text.data(), text.size(), rRecord.pcText);
+			rRecord.pcText[text.size()] = 0;
+		};
+		while (!mQueue.TryPush(fill))
+		{
+			// A thread that holds gLogMutex is the consumer, waiting for itself to make room would never end
+			if (meLogOverflow == LogOverflow::kDrop || gbLogMutexHeld)
+			{
+				miDropped.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			Wake();
+			std::this_thread::yield();
+		}
+
+		Wake();
+		return true;
+	}
+
+	// Writes everything queued so far on the calling thread, for exit and crash paths that can't wait for the writer thread
+	void Flush()
+	{
+		LogLockGuard logLockGuard;
+		Drain();
+	}
+
+	// Crash paths, the crashing thread may hold gLogMutex or the writer thread may have stopped in the middle of a batch
+	// Gives up after timeoutNs and leaves the lines queued, a crash report missing its last lines is better than a hang
+	bool TryFlush(std::chrono::nanoseconds timeoutNs)
+	{
+		if (gbLogMutexHeld)
+		{
+			return false;
+		}
+
+		auto end = std::chrono::steady_clock::now() + timeoutNs;
+		while (!gLogMutex.try_lock())
+		{
+			if (std::chrono::steady_clock::now() >= end)
+			{
+				return false;
+			}
+			std::this_thread::yield();
+		}
+
+		LogLockGuard logLockGuard(std::adopt_lock);
+		Drain();
+		return true;
+	}
+
+	// gLogMutex must be held
+	void Drain()
+	{
+		int64_t iDropped = miDropped.exchange(0, std::memory_order_relaxed);
+		if (iDropped > 0)
+		{
+			WriteLogRecord(std::format("({} log lines dropped)\n", iDropped).c_str());
+		}
+
+		while (mQueue.TryPop([](const Record& rRecord){ WriteLogRecord(rRecord.pcText); }))
+		{
+		}
+
+		if (gpLogFileStream)
+		{
+			gpLogFileStream->flush();
+		}
+	}
+
+private:
+
+	struct Record
+	{
+		char pcText[kiSlotSize];
+	};
+
+	void Wake() noexcept
+	{
+		muiWakeups.fetch_add(1, std::memory_order_release);
+		muiWakeups.notify_one();
+	}
+
+	void Run();
+
+	LogOverflow meLogOverflow;
+	MpscQueue<Record, kiCapacity> mQueue;
+	std::atomic<int64_t> miDropped = 0;
+	std::atomic<uint32_t> muiWakeups = 0;
+	std::atomic<bool> mbStop = false;
+
+	std::future<void> mFuture;
+};
+
+// giLogPushesInFlight counts Log() calls between loading gpLogWriter and being done with it, the destructor swaps the pointer out and waits for them
+inline std::atomic<LogWriter*> gpLogWriter = nullptr;
+inline std::atomic<int64_t> giLogPushesInFlight = 0;
+
+inline LogWriter::LogWriter(LogOverflow eLogOverflow)
+: meLogOverflow(eLogOverflow)
+{
+	mFuture = std::async(std::launch::async, [this]()
+	{
+		Run();
+	});
+
+	gpLogWriter = this;
+}
+
+inline LogWriter::~LogWriter()
+{
+	// Anyone who loads the pointer after the exchange sees nullptr and writes synchronously
+	gpLogWriter.exchange(nullptr);
+	while (giLogPushesInFlight.load() != 0)
+	{
+		std::this_thread::yield();
+	}
+
+	mbStop.store(true, std::memory_order_relaxed);
+	Wake();
+	mFuture.wait();
+
+	Flush();
+}
+
+inline void LogWriter::Run()
+{
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+
+	while (true)
+	{
+		// Read before draining, a line pushed after the drain changes muiWakeups and the wait returns right away
+		bool bStop = mbStop.load(std::memory_order_relaxed);
+		uint32_t uiWakeups = muiWakeups.load(std::memory_order_acquire);
+
+		Flush();
+
+		if (bStop)
+		{
+			return;
+		}
+		muiWakeups.wait(uiWakeups, std::memory_order_acquire);
+	}
+}
+
+inline void FlushLog()
+{
+	LogWriter* pLogWriter = gpLogWriter.load();
+	if (pLogWriter != nullptr)
+	{
+		pLogWriter->Flush();
+	}
+}
+
+// For exception and terminate handlers, never blocks for longer than timeoutNs
+inline void TryFlushLog(std::chrono::nanoseconds timeoutNs = 100ms)
+{
+	LogWriter* pLogWriter = gpLogWriter.load();
+	if (pLogWriter != nullptr)
+	{
+		pLogWriter->TryFlush(timeoutNs);
+	}
+}
+
 template<typename... TUV>
 void Log(std::string_view pcFormat, const TUV&... parameters)
 {
@@ -66,21 +303,33 @@ void Log(std::string_view pcFormat, const TUV&... parameters)
 	*(it++) = '\n';
 	*(it++) = 0;
 
-#if defined(BT_DATA_PACKER)
-	std::lock_guard lockGuard(gLogMutex);
-#endif
-	++giMyOutputDebugString;
-	OutputDebugString(rLogBuffer.data());
-	--giMyOutputDebugString;
-#if defined(BT_DATA_PACKER)
-	printf(rLogBuffer.data());
-#endif
+	giLogPushesInFlight.fetch_add(1);
+	LogWriter* pLogWriter = gpLogWriter.load();
+	bool bPushed = pLogWriter != nullptr && pLogWriter->Push(std::string_view(rLogBuffer.data(), static_cast<size_t>(it - rLogBuffer.begin() - 1)));
+	if (bPushed) [[likely]]
+	{
+		giLogPushesInFlight.fetch_sub(1);
+		return;
+	}
+
+	// An exception handler on a thread that is already writing the log, taking gLogMutex again would deadlock
+	if (gbLogMutexHeld) [[unlikely]]
+	{
+		giLogPushesInFlight.fetch_sub(1);
+		return;
+	}
+
+	// Still counted as in flight, so the writer can't be destroyed before its queued lines are drained ahead of this one
+	LogLockGuard logLockGuard;
+	if (pLogWriter != nullptr)
+	{
+		pLogWriter->Drain();
+	}
+	giLogPushesInFlight.fetch_sub(1);
+	WriteLogRecord(rLogBuffer.data());
 	if (gpLogFileStream)
 	{
-	#if !defined(BT_DATA_PACKER)
-		std::lock_guard lockGuard(gLogMutex);
-	#endif
-		*gpLogFileStream << rLogBuffer.data() << std::flush;
+		*gpLogFileStream << std::flush;
 	}
 }
 
@@ -23,6 +23,14 @@ float RotationFromPosition(DirectX::FXMVECTOR vecPosition)
 	return std::acos(f4Position.x / std::sqrt(f4Position.x * f4Position.x + f4Position.y * f4Position.y));
 }
 
+XMVECTOR XM_CALLCONV RotationsFromPositions(FXMVECTOR vecX, FXMVECTOR vecY, FXMVECTOR vecZ)
+{
+	auto vecInverseLength = XMVectorReciprocalSqrt(XMVectorMultiplyAdd(vecZ, vecZ, XMVectorMultiplyAdd(vecY, vecY, XMVectorMultiply(vecX, vecX))));
+	auto vecNormalX = XMVectorMultiply(vecX, vecInverseLength);
+	auto vecNormalY = XMVectorMultiply(vecY, vecInverseLength);
+	return XMVectorACos(XMVectorDivide(vecNormalX, XMVectorSqrt(XMVectorMultiplyAdd(vecNormalY, vecNormalY, XMVectorMultiply(vecNormalX, vecNormalX)))));
+}
+
 XMVECTOR XM_CALLCONV QuaternionFromDirection(FXMVECTOR vecDirection, FXMVECTOR vecOriginNormal, DirectX::FXMVECTOR vecUp)
 {
 	if (XMVector4EqualInt(XMVectorEqual(vecOriginNormal, vecDirection), XMVectorTrueInt()))
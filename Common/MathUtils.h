@@ -29,6 +29,8 @@ DirectX::XMVECTOR XM_CALLCONV ColorToVector(uint32_t uiColor);
 DirectX::XMVECTOR XM_CALLCONV Project(DirectX::FXMVECTOR vecA, DirectX::FXMVECTOR vecB);
 DirectX::XMVECTOR XM_CALLCONV ToBaseHeight(DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecEyePosition, float fBaseHeight);
 float RotationFromPosition(DirectX::FXMVECTOR vecPosition);
+// RotationFromPosition(XMVector3Normalize()) of four positions split into components, XMVectorACos() is an approximation so it is close to the scalar version but not exact
+DirectX::XMVECTOR XM_CALLCONV RotationsFromPositions(DirectX::FXMVECTOR vecX, DirectX::FXMVECTOR vecY, DirectX::FXMVECTOR vecZ);
 DirectX::XMVECTOR XM_CALLCONV QuaternionFromDirection(DirectX::FXMVECTOR vecDirection, DirectX::FXMVECTOR vecOriginNormal, DirectX::FXMVECTOR vecUp = DirectX::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f));
 DirectX::XMVECTOR XM_CALLCONV Closest(DirectX::FXMVECTOR vecOrigin, DirectX::FXMVECTOR vecA, DirectX::FXMVECTOR vecB);
 AreaVertices XM_CALLCONV CalculateArea(DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecDirection, float fForward, float fBack, float fWidth);
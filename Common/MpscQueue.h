@@ -0,0 +1,86 @@
+#pragma once
+
+namespace common
+{
+
+// Bounded ring buffer for any number of producer threads and one consumer at a time, the slots are preallocated and reused so neither side allocates
+// Every slot carries a sequence number, a producer claims a slot with one compare exchange on the tail and publishes it by bumping the sequence
+// Nothing blocks, TryPush() returns false when the ring is full and TryPop() returns false when the next slot hasn't been published yet
+template<typename T, int64_t CAPACITY>
+class MpscQueue
+{
+public:
+
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0);
+
+	MpscQueue() noexcept
+	{
+		for (int64_t i = 0; i < CAPACITY; ++i)
+		{
+			mSlots[i].iSequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// Producers, rFill is called with the claimed slot
+	template<typename FILL>
+	bool TryPush(const FILL& rFill) noexcept
+	{
+		int64_t iTail = miTail.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot& rSlot = mSlots[iTail & kiIndexMask];
+			int64_t iDifference = rSlot.iSequence.load(std::memory_order_acquire) - iTail;
+			if (iDifference == 0)
+			{
+				if (miTail.compare_exchange_weak(iTail, iTail + 1, std::memory_order_relaxed))
+				{
+					rFill(rSlot.value);
+					rSlot.iSequence.store(iTail + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (iDifference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				iTail = miTail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Consumer, rRead is called with the oldest published slot
+	template<typename READ>
+	bool TryPop(const READ& rRead) noexcept
+	{
+		Slot& rSlot = mSlots[miHead & kiIndexMask];
+		if (rSlot.iSequence.load(std::memory_order_acquire) != miHead + 1)
+		{
+			return false;
+		}
+
+		rRead(rSlot.value);
+		rSlot.iSequence.store(miHead + CAPACITY, std::memory_order_release);
+		++miHead;
+		return true;
+	}
+
+private:
+
+	static constexpr int64_t kiIndexMask = CAPACITY - 1;
+
+	struct Slot
+	{
+		std::atomic<int64_t> iSequence = 0;
+		T value {};
+	};
+
+	std::array<Slot, CAPACITY> mSlots;
+
+	// The tail is shared by all producers, the head is only touched by whoever holds the consumer side
+	alignas(64) std::atomic<int64_t> miTail = 0;
+	alignas(64) int64_t miHead = 0;
+};
+
+} // namespace common
@@ -44,6 +44,102 @@ inline float Random(RandomEngine& rRandomEngine)
 	return static_cast<float>((rRandomEngine.uiZ << 16) + rRandomEngine.uiW) * kfDivisor;
 }
 
+// Counter based generator, a draw is a pure function of the stream key and the draw index so streams can be drawn from on any thread in any order
+// The key mixes (tick, subsystem, entity) with SplitMix64, a draw runs the counter through two rounds of lowbias32 keyed with it
+// Both rounds are bijections of the counter, a stream doesn't repeat within 2^32 draws and neighbouring entities get unrelated keys
+inline constexpr uint64_t kuiRandomStreamSeed = 0x2545f4914f6cdd1d;
+
+constexpr uint64_t SplitMix64(uint64_t uiValue)
+{
+	uiValue += 0x9e3779b97f4a7c15;
+	uiValue = (uiValue ^ (uiValue >> 30)) * 0xbf58476d1ce4e5b9;
+	uiValue = (uiValue ^ (uiValue >> 27)) * 0x94d049bb133111eb;
+	return uiValue ^ (uiValue >> 31);
+}
+
+// https://nullprogram.com/blog/2018/07/31/
+constexpr uint32_t LowBias32(uint32_t uiValue)
+{
+	uiValue ^= uiValue >> 16;
+	uiValue *= 0x7feb352d;
+	uiValue ^= uiValue >> 15;
+	uiValue *= 0x846ca68b;
+	uiValue ^= uiValue >> 16;
+	return uiValue;
+}
+
+struct RandomStream
+{
+	uint32_t uiKeyLow = 0;
+	uint32_t uiKeyHigh = 0;
+	uint32_t uiCounter = 0;
+
+	RandomStream() = default;
+
+	constexpr RandomStream(uint64_t uiTick, uint64_t uiSubsystem, uint64_t uiEntity, uint64_t uiSeed = kuiRandomStreamSeed)
+	{
+		uint64_t uiKey = SplitMix64(SplitMix64(SplitMix64(uiSeed ^ uiTick) ^ uiSubsystem) ^ uiEntity);
+		uiKeyLow = static_cast<uint32_t>(uiKey);
+		uiKeyHigh = static_cast<uint32_t>(uiKey >> 32);
+	}
+
+	constexpr uint32_t Bits(uint32_t uiDraw) const
+	{
+		return LowBias32(LowBias32(uiDraw ^ uiKeyLow) + uiKeyHigh);
+	}
+
+	bool operator==(const RandomStream& rOther) const = default;
+};
+
+inline uint32_t Random(uint32_t uiMax, RandomStream& rRandomStream)
+{
+	return rRandomStream.Bits(rRandomStream.uiCounter++) % (uiMax + 1);
+}
+
+// In [0, MAX), the top 24 bits so every value is exact in a float
+template<float MAX = 1.0f>
+inline float Random(RandomStream& rRandomStream)
+{
+	static constexpr float kfScale = MAX / 16777216.0f;
+	return static_cast<float>(rRandomStream.Bits(rRandomStream.uiCounter++) >> 8) * kfScale;
+}
+
+// Four draws per iteration with SSE4.1, gives the same values as calling Random<MAX>() once per element and advances the counter as far
+inline void RandomFloats(RandomStream& rRandomStream, std::span<float> values, float fMax = 1.0f)
+{
+	const float fScale = fMax / 16777216.0f;
+	int64_t iCount = static_cast<int64_t>(values.size());
+	int64_t i = 0;
+
+	const __m128i keyLow = _mm_set1_epi32(static_cast<int32_t>(rRandomStream.uiKeyLow));
+	const __m128i keyHigh = _mm_set1_epi32(static_cast<int32_t>(rRandomStream.uiKeyHigh));
+	const __m128i multiplyOne = _mm_set1_epi32(0x7feb352d);
+	const __m128i multiplyTwo = _mm_set1_epi32(static_cast<int32_t>(0x846ca68b));
+	const __m128 scale = _mm_set1_ps(fScale);
+	auto lowBias32 = [&](__m128i value)
+	{
+		value = _mm_xor_si128(value, _mm_srli_epi32(value, 16));
+		value = _mm_mullo_epi32(value, multiplyOne);
+		value = _mm_xor_si128(value, _mm_srli_epi32(value, 15));
+		value = _mm_mullo_epi32(value, multiplyTwo);
+		return _mm_xor_si128(value, _mm_srli_epi32(value, 16));
+	};
+
+	__m128i counter = _mm_add_epi32(_mm_set1_epi32(static_cast<int32_t>(rRandomStream.uiCounter)), _mm_setr_epi32(0, 1, 2, 3));
+	for (; i + 4 <= iCount; i += 4)
+	{
+		__m128i bits = lowBias32(_mm_add_epi32(lowBias32(_mm_xor_si128(counter, keyLow)), keyHigh));
+		_mm_storeu_ps(&values[i], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 8)), scale));
+		counter = _mm_add_epi32(counter, _mm_set1_epi32(4));
+	}
+	rRandomStream.uiCounter += static_cast<uint32_t>(i);
+
+	for (; i < iCount; ++i)
+	{
+		values[i] = static_cast<float>(rRandomStream.Bits(rRandomStream.uiCounter++) >> 8) * fScale;
+	}
+}
+
 template<std::floating_point T>
 T UniformRandom(std::mt19937& rRandomEngine, T min, T max)
 {
@@ -0,0 +1,66 @@
+#pragma once
+
+namespace common
+{
+
+// Bounded ring buffer for one producer thread and one consumer thread, the slots are preallocated and reused so neither side allocates
+// The producer fills the slot returned by Back() and then calls Push(), the consumer reads Front() and then calls Pop()
+template<typename T, int64_t CAPACITY>
+class SpscQueue
+{
+public:
+
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0);
+
+	// Producer, blocks while the queue is full
+	T& Back() noexcept
+	{
+		int64_t iTail = miTail.load(std::memory_order_relaxed);
+		int64_t iHead = miHead.load(std::memory_order_acquire);
+		while (iTail - iHead == CAPACITY)
+		{
+			miHead.wait(iHead, std::memory_order_acquire);
+			iHead = miHead.load(std::memory_order_acquire);
+		}
+
+		return mSlots[iTail & kiIndexMask];
+	}
+
+	void Push() noexcept
+	{
+		miTail.fetch_add(1, std::memory_order_release);
+		miTail.notify_one();
+	}
+
+	// Consumer, blocks while the queue is empty
+	T& Front() noexcept
+	{
+		int64_t iHead = miHead.load(std::memory_order_relaxed);
+		int64_t iTail = miTail.load(std::memory_order_acquire);
+		while (iHead == iTail)
+		{
+			miTail.wait(iTail, std::memory_order_acquire);
+			iTail = miTail.load(std::memory_order_acquire);
+		}
+
+		return mSlots[iHead & kiIndexMask];
+	}
+
+	void Pop() noexcept
+	{
+		miHead.fetch_add(1, std::memory_order_release);
+		miHead.notify_one();
+	}
+
+private:
+
+	static constexpr int64_t kiIndexMask = CAPACITY - 1;
+
+	std::array<T, CAPACITY> mSlots {};
+
+	// Kept on separate cache lines, each index is only ever written by one side
+	alignas(64) std::atomic<int64_t> miHead = 0;
+	alignas(64) std::atomic<int64_t> miTail = 0;
+};
+
+} // namespace common
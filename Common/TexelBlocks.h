@@ -0,0 +1,49 @@
+#pragma once
+
+namespace common
+{
+
+// Bytes of one texel block, a 4 x 4 block for the block compressed formats and a single texel for the rest
+inline int64_t TexelBlockSize(VkFormat vkFormat)
+{
+	switch (vkFormat)
+	{
+		case VK_FORMAT_R8_UNORM:
+			return 1;
+
+		case VK_FORMAT_R16_UNORM:
+			return 2;
+
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R16G16_UNORM:
+		case VK_FORMAT_R32_SFLOAT:
+			return 4;
+
+		case VK_FORMAT_BC4_UNORM_BLOCK:
+		case VK_FORMAT_R16G16B16A16_SFLOAT:
+		case VK_FORMAT_R32G32_SFLOAT:
+			return 8;
+
+		case VK_FORMAT_BC7_UNORM_BLOCK:
+			return 16;
+
+		default:
+			DEBUG_BREAK();
+			return 0;
+	}
+}
+
+inline int64_t TexelBlockExtent(VkFormat vkFormat)
+{
+	return vkFormat == VK_FORMAT_BC4_UNORM_BLOCK || vkFormat == VK_FORMAT_BC7_UNORM_BLOCK ? 4 : 1;
+}
+
+// Mips smaller than a block still take a whole block
+inline int64_t SizeInBytes(VkFormat vkFormat, int64_t iWidth, int64_t iHeight)
+{
+	int64_t iBlockExtent = TexelBlockExtent(vkFormat);
+	return ((iWidth + iBlockExtent - 1) / iBlockExtent) * ((iHeight + iBlockExtent - 1) / iBlockExtent) * TexelBlockSize(vkFormat);
+}
+
+} // namespace common
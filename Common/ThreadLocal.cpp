@@ -124,6 +124,7 @@ void SetupExceptionHandling()
 						LogStackWalker logStackWalker(StackWalker::NonExcept);
 						logStackWalker.ShowCallstack();
 						Log("</ {}>", pcType);
+						TryFlushLog();
 
 						DEBUG_BREAK();
 					}
@@ -144,6 +145,7 @@ void SetupExceptionHandling()
 	std::set_terminate([]()
 	{
 		Log("std::set_terminate");
+		TryFlushLog();
 		DEBUG_BREAK();
 		std::abort();
 	});
@@ -10,6 +10,9 @@ enum Threads
 	kThreadDataFile,
 	kThreadTexturesFile,
 	kThreadDxDiag,
+	kThreadSimulation,
+	kThreadSubmission,
+	kThreadBootPreparation,
 };
 
 class ThreadLocal;
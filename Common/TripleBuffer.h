@@ -0,0 +1,79 @@
+#pragma once
+
+namespace common
+{
+
+// Lock free handoff of the latest value from one producer thread to one consumer thread, neither side ever blocks
+// The three slots rotate between the producer (back), the shared middle and the consumer (front)
+// Latest() is the slot the producer published last, it is always either the middle or the front and is never written again until it has been replaced
+// With KEEP_PREVIOUS a fourth slot holds the front the last Acquire() replaced, so the consumer can look at the last two values it took
+template<typename T, bool KEEP_PREVIOUS = false>
+class TripleBuffer
+{
+public:
+
+	// Producer
+	T& Back() noexcept
+	{
+		return mSlots[muiBack];
+	}
+
+	const T& Latest() const noexcept
+	{
+		return mSlots[muiLatest];
+	}
+
+	void Publish() noexcept
+	{
+		muiLatest = muiBack;
+		muiBack = mMiddle.exchange(muiBack | kuiFresh, std::memory_order_acq_rel) & kuiIndexMask;
+	}
+
+	// Consumer, returns true if a newer value was taken
+	T& Front() noexcept
+	{
+		return mSlots[muiFront];
+	}
+
+	T& Previous() noexcept requires KEEP_PREVIOUS
+	{
+		return mSlots[muiPrevious];
+	}
+
+	bool Acquire() noexcept
+	{
+		if (!(mMiddle.load(std::memory_order_acquire) & kuiFresh))
+		{
+			return false;
+		}
+
+		if constexpr (KEEP_PREVIOUS)
+		{
+			// The old previous goes back to the producer instead of the old front
+			uint8_t uiFront = muiFront;
+			muiFront = mMiddle.exchange(muiPrevious, std::memory_order_acq_rel) & kuiIndexMask;
+			muiPrevious = uiFront;
+		}
+		else
+		{
+			muiFront = mMiddle.exchange(muiFront, std::memory_order_acq_rel) & kuiIndexMask;
+		}
+		return true;
+	}
+
+	std::array<T, KEEP_PREVIOUS ? 4 : 3> mSlots {};
+
+private:
+
+	static constexpr uint8_t kuiIndexMask = 0x03;
+	static constexpr uint8_t kuiFresh = 0x04;
+
+	// Front starts out as the latest so both sides agree on the initial value
+	uint8_t muiBack = 0;
+	uint8_t muiLatest = KEEP_PREVIOUS ? 3 : 2;
+	std::atomic<uint8_t> mMiddle = 1;
+	uint8_t muiFront = KEEP_PREVIOUS ? 3 : 2;
+	uint8_t muiPrevious = 2;
+};
+
+} // namespace common
@@ -1,5 +1,8 @@
 #pragma once
 
+// Needed by ConstexprCrcArray below, the rest of Common is included at the end
+#include "Crc.h"
+
 namespace common
 {
 
@@ -71,18 +74,6 @@ inline uint32_t ColorLerp(uint32_t uiA, uint32_t uiB, float fPercent)
 	return ColorToUint(DirectX::XMVectorLerp(ColorToVector(uiA), ColorToVector(uiB), fPercent));
 }
 
-using crc_t = uint64_t;
-
-constexpr crc_t Crc(std::string_view pData)
-{
-	crc_t crc = 0xabcdef123456789a;
-	for (const char& c : pData)
-	{
-		crc = (crc ^ c) * 0x123456789abcdef1;
-	}
-	return crc;
-}
-
 template <typename T>
 void MemOr(T& rOut, const T& rInOne, const T& rInTwo)
 {
@@ -179,37 +170,6 @@ inline void WaitAll(std::vector<std::future<void>>& futures)
 	}
 }
 
-inline int64_t SizeInBytes(VkFormat vkFormat, int64_t iWidth, int64_t iHeight)
-{
-	int64_t iPixels = iWidth * iHeight;
-	switch (vkFormat)
-	{
-		case VK_FORMAT_BC4_UNORM_BLOCK:
-			return iPixels / 2;
-
-		case VK_FORMAT_BC7_UNORM_BLOCK:
-		case VK_FORMAT_R8_UNORM:
-			return iPixels;
-
-		case VK_FORMAT_R16_UNORM:
-			return 2 * iPixels;
-
-		case VK_FORMAT_R8G8B8A8_SRGB:
-		case VK_FORMAT_R8G8B8A8_UNORM:
-		case VK_FORMAT_R16G16_UNORM:
-		case VK_FORMAT_R32_SFLOAT:
-			return 4 * iPixels;
-
-		case VK_FORMAT_R16G16B16A16_SFLOAT:
-		case VK_FORMAT_R32G32_SFLOAT:
-			return 8 * iPixels;
-
-		default:
-			DEBUG_BREAK();
-			return 0;
-	}
-}
-
 template<int64_t SIZE>
 struct ConstexprCrcArray
 {
@@ -288,12 +248,18 @@ inline std::wstring GetStringValueFromHKLM(const std::wstring& rRegSubKey, const
 
 #include "DataFile.h"
 #include "Flags.h"
+#include "Histogram.h"
 #include "Log.h"
 #include "MathUtils.h"
+#include "MpscQueue.h"
 #include "StackWalker.h"
 #include "Random.h"
 #include "ScopedLambda.h"
 #include "Smoothed.h"
+#include "SpscQueue.h"
+#include "TexelBlocks.h"
 #include "ThreadLocal.h"
 #include "Timer.h"
+#include "TripleBuffer.h"
 #include "WindowsUtils.h"
+#include "WorkerPool.h"
@@ -157,4 +157,35 @@ inline int64_t HardwareCoreCount()
 	}
 }
 
+// sleep_for() wakes on the scheduler tick, 15.6 ms unless something raised the timer resolution, so it can overshoot a frame deadline by most of a refresh
+// A high resolution waitable timer (Windows 10 1803 and later) wakes within about half a millisecond, older versions raise the timer resolution to 1 ms for the rest of the process instead
+// Spins for the last part, the timer is created once and shared, only the main loop paces itself
+inline void SleepUntil(std::chrono::high_resolution_clock::time_point target, std::chrono::nanoseconds spin = 1ms)
+{
+	static HANDLE sTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	[[maybe_unused]] static bool sbTimerResolutionRaised = sTimer == nullptr && timeBeginPeriod(1) == TIMERR_NOERROR;
+
+	std::chrono::nanoseconds sleepNs = target - std::chrono::high_resolution_clock::now() - spin;
+	if (sleepNs > 0ns)
+	{
+		if (sTimer != nullptr)
+		{
+			// Negative is relative, in 100 ns units
+			LARGE_INTEGER dueTime {};
+			dueTime.QuadPart = -std::max<int64_t>(sleepNs.count() / 100, 1);
+			VERIFY_SUCCESS(SetWaitableTimerEx(sTimer, &dueTime, 0, nullptr, nullptr, nullptr, 0));
+			WaitForSingleObject(sTimer, INFINITE);
+		}
+		else
+		{
+			std::this_thread::sleep_for(sleepNs);
+		}
+	}
+
+	while (std::chrono::high_resolution_clock::now() < target)
+	{
+		std::this_thread::yield();
+	}
+}
+
 } // namespace common
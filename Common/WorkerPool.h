@@ -0,0 +1,183 @@
+#pragma once
+
+namespace common
+{
+
+// Persistent threads for the fork join loops inside a frame, so splitting work over the cores doesn't start threads or allocate on every call
+// Run() publishes a batch that lives on the caller's stack, the caller runs jobs of its own batch too and returns once all of them are done
+// A job may call Run() again, its thread then works on the nested batch instead of waiting for workers that may all be busy, so nesting can't deadlock
+class WorkerPool
+{
+public:
+
+	// Batches running at the same time, every nesting level and every thread calling Run() has one
+	static constexpr int64_t kiMaxBatches = 64;
+
+	explicit WorkerPool(int64_t iThreads)
+	{
+		mThreads.reserve(iThreads);
+		for (int64_t i = 0; i < iThreads; ++i)
+		{
+			mThreads.emplace_back([this]()
+			{
+				WorkerThread();
+			});
+		}
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::scoped_lock lock(mMutex);
+			mbStop = true;
+		}
+		mWorkConditionVariable.notify_all();
+
+		for (std::thread& rThread : mThreads)
+		{
+			rThread.join();
+		}
+	}
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	int64_t ThreadCount() const noexcept
+	{
+		return static_cast<int64_t>(mThreads.size());
+	}
+
+	// Calls rFunction(i) for every i in [0, iCount) on the workers and the calling thread, in no particular order
+	// An exception thrown by a job is rethrown here once the other jobs of the batch are done
+	template<typename T>
+	void Run(int64_t iCount, const T& rFunction)
+	{
+		if (iCount <= 0)
+		{
+			return;
+		}
+
+		Batch batch;
+		batch.pFunction = [](const void* pContext, int64_t i)
+		{
+			(*static_cast<const T*>(pContext))(i);
+		};
+		batch.pContext = &rFunction;
+		batch.iCount = iCount;
+
+		std::unique_lock lock(mMutex);
+		ASSERT(miBatches < kiMaxBatches);
+		mpBatches[miBatches] = &batch;
+		++miBatches;
+		lock.unlock();
+		mWorkConditionVariable.notify_all();
+
+		lock.lock();
+		while (batch.iNext < batch.iCount)
+		{
+			int64_t i = Claim(batch);
+			lock.unlock();
+			Execute(batch, i);
+			lock.lock();
+		}
+		mDoneConditionVariable.wait(lock, [&batch]()
+		{
+			return batch.iDone == batch.iCount;
+		});
+
+		if (batch.exception) [[unlikely]]
+		{
+			std::rethrow_exception(batch.exception);
+		}
+	}
+
+private:
+
+	// Everything but the function is guarded by mMutex
+	struct Batch
+	{
+		void (*pFunction)(const void*, int64_t) = nullptr;
+		const void* pContext = nullptr;
+		int64_t iCount = 0;
+		int64_t iNext = 0;
+		int64_t iDone = 0;
+		std::exception_ptr exception;
+	};
+
+	// With mMutex held, a batch leaves the list when its last job is claimed so workers only ever see batches with jobs left
+	int64_t Claim(Batch& rBatch)
+	{
+		int64_t i = rBatch.iNext;
+		++rBatch.iNext;
+		if (rBatch.iNext == rBatch.iCount)
+		{
+			Batch** ppBatch = std::find(&mpBatches[0], &mpBatches[miBatches], &rBatch);
+			std::copy(ppBatch + 1, &mpBatches[miBatches], ppBatch);
+			--miBatches;
+		}
+		return i;
+	}
+
+	// Without mMutex held, the batch isn't touched after the last job is counted since its owner may return right away
+	void Execute(Batch& rBatch, int64_t i)
+	{
+		std::exception_ptr exception;
+		try
+		{
+			rBatch.pFunction(rBatch.pContext, i);
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+
+		bool bLast = false;
+		{
+			std::scoped_lock lock(mMutex);
+			if (exception && !rBatch.exception)
+			{
+				rBatch.exception = exception;
+			}
+			++rBatch.iDone;
+			bLast = rBatch.iDone == rBatch.iCount;
+		}
+		if (bLast)
+		{
+			mDoneConditionVariable.notify_all();
+		}
+	}
+
+	// Oldest batch first
+	void WorkerThread()
+	{
+		std::unique_lock lock(mMutex);
+		while (true)
+		{
+			mWorkConditionVariable.wait(lock, [this]()
+			{
+				return mbStop || miBatches > 0;
+			});
+			if (mbStop)
+			{
+				return;
+			}
+
+			Batch& rBatch = *mpBatches[0];
+			int64_t i = Claim(rBatch);
+			lock.unlock();
+			Execute(rBatch, i);
+			lock.lock();
+		}
+	}
+
+	std::mutex mMutex;
+	std::condition_variable mWorkConditionVariable;
+	std::condition_variable mDoneConditionVariable;
+	Batch* mpBatches[kiMaxBatches] {};
+	int64_t miBatches = 0;
+	bool mbStop = false;
+
+	std::vector<std::thread> mThreads;
+};
+
+} // namespace common
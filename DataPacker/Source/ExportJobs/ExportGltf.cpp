@@ -341,6 +341,12 @@ bool IsOcclusion(int64_t iIndex, const tinygltf::Material& rMaterial)
 	return bOcculsion;
 }
 
+bool IsColor(int64_t iIndex, const tinygltf::Material& rMaterial)
+{
+	return rMaterial.values.find("baseColorTexture") != rMaterial.values.end() && rMaterial.values.at("baseColorTexture").TextureIndex() == iIndex ||
+		rMaterial.additionalValues.find("emissiveTexture") != rMaterial.additionalValues.end() && rMaterial.additionalValues.at("emissiveTexture").TextureIndex() == iIndex;
+}
+
 void ExportGltf::PreExport()
 {
 	std::filesystem::path preExportPath(mInputPath);
@@ -372,7 +378,9 @@ void ExportGltf::PreExport()
 
 		const tinygltf::Image& rImage = gltfModel.images[rTexture.source];
 		Texture texture(reinterpret_cast<const std::byte*>(rImage.image.data()), rImage.width, rImage.height, rImage.component);
-		texture.MakeMipmaps(bOcclusion ? VK_FORMAT_BC4_UNORM_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK);
+		// Normal and metallic roughness maps are data, filtering them as colors would bend them
+		bool bColor = IsColor(rTexture.source, gltfModel.materials[0]);
+		texture.MakeMipmaps(bOcclusion ? VK_FORMAT_BC4_UNORM_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK, 32, bColor ? MipFilter::kKaiser : MipFilter::kBox, bColor);
 
 		texture.Save(path, bOcclusion ? VK_FORMAT_BC4_UNORM_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK, false);
 
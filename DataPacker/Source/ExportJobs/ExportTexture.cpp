@@ -92,7 +92,8 @@ void ExportTexture::Export()
 	else
 	{
 		Texture texture(mInputPath, FileType::kImage, false);
-		texture.MakeMipmaps(vkFormat);
+		bool bColor = vkFormat == VK_FORMAT_BC7_UNORM_BLOCK || vkFormat == VK_FORMAT_R8G8B8A8_UNORM;
+		texture.MakeMipmaps(vkFormat, 32, bColor ? MipFilter::kKaiser : MipFilter::kBox, bColor);
 		std::vector<std::byte> data = texture.Export(vkFormat, false);
 
 		auto [pHeader, dataSpan] = AllocateHeaderAndData(data.size());
@@ -0,0 +1,106 @@
+#include "Exr.h"
+
+#pragma warning(push, 0)
+#pragma warning(disable : 4201)
+#define OPENEXR_EXPORT
+#include "openexr/src/lib/OpenEXRCore/openexr.h"
+#pragma warning(pop)
+
+using namespace DirectX;
+
+// Without SVML XMVectorPow is powf per lane, so the result matches 255 * common::FromGamma() to the bit
+static XMVECTOR XM_CALLCONV ToStored(FXMVECTOR vecPixels, bool bFromGamma)
+{
+	XMVECTOR vecResult = vecPixels;
+	if (bFromGamma)
+	{
+		vecResult = XMVectorPow(XMVectorMax(vecResult, XMVectorZero()), XMVectorReplicate(1.0f / 2.2f));
+	}
+	return XMVectorMultiply(XMVectorReplicate(255.0f), vecResult);
+}
+
+void ReadExr(std::vector<float>& rPixels, int64_t& riWidth, int64_t& riHeight, const std::filesystem::path& rPath, bool bFromGamma, int64_t iThreads)
+{
+	exr_context_initializer_t ctxtinit = EXR_DEFAULT_CONTEXT_INITIALIZER;
+	exr_context_t f {};
+	exr_result_t rv = exr_start_read(&f, rPath.string().c_str(), &ctxtinit);
+	ASSERT(rv == EXR_ERR_SUCCESS);
+	common::ScopedLambda releaseExrContext([=]()
+	{
+		exr_context_t exrContextCopy = f;
+		exr_finish(&exrContextCopy);
+	});
+
+	exr_attr_box2i_t dw {};
+	exr_get_data_window(f, 0, &dw);
+	int32_t scansperchunk = 0;
+	exr_get_scanlines_per_chunk(f, 0, &scansperchunk);
+	int32_t iChunkCount = 0;
+	exr_get_chunk_count(f, 0, &iChunkCount);
+
+	riWidth = dw.max.x + 1;
+	riHeight = dw.max.y + 1;
+	int64_t iWidth = riWidth;
+	rPixels.assign(3 * riWidth * riHeight, 0.0f);
+
+	// The context can be read from several threads at once, every chunk gets its own decode pipeline
+	// Channels are stored sorted by name, so B, G, R, and are decoded straight into their interleaved slots
+	auto decodeChunks = [&](int64_t iChunkStart, int64_t iChunkEnd)
+	{
+		for (int64_t iChunk = iChunkStart; iChunk < iChunkEnd; ++iChunk)
+		{
+			exr_chunk_info_t cinfo {};
+			exr_result_t result = exr_read_scanline_chunk_info(f, 0, static_cast<int>(dw.min.y + iChunk * scansperchunk), &cinfo);
+			ASSERT(result == EXR_ERR_SUCCESS);
+
+			exr_decode_pipeline_t decoder {};
+			exr_decoding_initialize(f, 0, &cinfo, &decoder);
+			common::ScopedLambda destroyDecoder([&]()
+			{
+				exr_decoding_destroy(f, &decoder);
+			});
+
+			float* pfChunk = rPixels.data() + 3 * cinfo.start_y * iWidth;
+			for (int64_t c = 0; c < 3; ++c)
+			{
+				decoder.channels[c].user_data_type = EXR_PIXEL_FLOAT;
+				decoder.channels[c].decode_to_ptr = reinterpret_cast<uint8_t*>(pfChunk + 2 - c);
+				decoder.channels[c].user_pixel_stride = static_cast<int32_t>(3 * sizeof(float));
+				decoder.channels[c].user_line_stride = static_cast<int32_t>(3 * sizeof(float) * iWidth);
+				decoder.channels[c].user_bytes_per_element = sizeof(float);
+			}
+
+			exr_decoding_choose_default_routines(f, 0, &decoder);
+			result = exr_decoding_run(f, 0, &decoder);
+			ASSERT(result == EXR_ERR_SUCCESS);
+
+			int64_t iFloats = 3 * cinfo.height * iWidth;
+			int64_t i = 0;
+			for (; i + 4 <= iFloats; i += 4)
+			{
+				XMVECTOR vecPixels = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pfChunk + i));
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pfChunk + i), ToStored(vecPixels, bFromGamma));
+			}
+
+			// The last one to three floats go through a padded copy so every value takes the same path
+			if (i < iFloats)
+			{
+				XMFLOAT4 f4Tail {};
+				std::memcpy(&f4Tail, pfChunk + i, (iFloats - i) * sizeof(float));
+				XMStoreFloat4(&f4Tail, ToStored(XMLoadFloat4(&f4Tail), bFromGamma));
+				std::memcpy(pfChunk + i, &f4Tail, (iFloats - i) * sizeof(float));
+			}
+		}
+	};
+
+	int64_t iBands = std::clamp<int64_t>(iChunkCount, 1, std::max<int64_t>(iThreads, 1));
+	std::vector<std::future<void>> futures;
+	for (int64_t b = 0; b < iBands; ++b)
+	{
+		futures.push_back(std::async(std::launch::async, decodeChunks, b * iChunkCount / iBands, (b + 1) * iChunkCount / iBands));
+	}
+	for (std::future<void>& rFuture : futures)
+	{
+		rFuture.get();
+	}
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Decodes the B, G, R channels of a scanline EXR into interleaved R, G, B floats in [0, 255], bands of chunks are decoded on iThreads std::async tasks
+// Only needs OpenEXRCore and DirectXMath, so it can be compared against the old decoder without the rest of the packer
+void ReadExr(std::vector<float>& rPixels, int64_t& riWidth, int64_t& riHeight, const std::filesystem::path& rPath, bool bFromGamma, int64_t iThreads = std::thread::hardware_concurrency());
@@ -17,6 +17,7 @@ void MainThread(int argc, char* argv[])
 	SetProcessDPIAware();
 
 	common::ThreadLocal threadLocal(1024);
+	auto pLogWriter = std::make_unique<common::LogWriter>(common::LogOverflow::kBlock);
 
 	LOG("\nData Packer");
 	LOG_INDENT(1);
@@ -354,14 +355,10 @@ void MainThread(int argc, char* argv[])
 
 			if (rpExportJob->mChunkFlags & kTexture && !(rpExportJob->mChunkFlags & kCubemap) && !(rpExportJob->mChunkFlags & kElevation) && rpExportJob->mInputPath.native().find(L"Gltf") == std::wstring::npos)
 			{
-				if (rpExportJob->mInputPath.native().find(L"Textures\\Ui") != std::wstring::npos)
-				{
-					textureCrcsUi.emplace_back(crc);
-				}
-				else
-				{
-					textureCrcs.emplace_back(crc);
-				}
+				// The index is the slot in the descriptor array the TextureManager fills in kpTextureCrcs/kpUiTextureCrcs order
+				std::vector<common::crc_t>& rTextureCrcs = rpExportJob->mInputPath.native().find(L"Textures\\Ui") != std::wstring::npos ? textureCrcsUi : textureCrcs;
+				dataHeaderTempFileStream << "inline constexpr int64_t k" << crcConstant << "Index = " << rTextureCrcs.size() << ";" << std::endl;
+				rTextureCrcs.emplace_back(crc);
 			}
 		}
 		catch (std::exception& rException)
@@ -394,6 +391,32 @@ void MainThread(int argc, char* argv[])
 	}
 	dataHeaderTempFileStream << std::endl << "};" << std::endl;
 
+	// Same crcs sorted with their slot, looked up with common::FindCrcIndex() instead of building hash maps at runtime
+	auto writeIndexTable = [&](const char* pcName, const std::vector<common::crc_t>& rCrcs)
+	{
+		std::vector<common::CrcIndex> table;
+		for (int64_t i = 0; i < static_cast<int64_t>(rCrcs.size()); ++i)
+		{
+			table.push_back({.crc = rCrcs[i], .iIndex = i});
+		}
+		std::sort(table.begin(), table.end(), [](const common::CrcIndex& rA, const common::CrcIndex& rB)
+		{
+			return rA.crc < rB.crc;
+		});
+
+		dataHeaderTempFileStream << std::endl;
+		dataHeaderTempFileStream << "inline constexpr common::CrcIndex " << pcName << "[] = " << std::endl;
+		dataHeaderTempFileStream << "{" << std::endl;
+		for (const common::CrcIndex& rEntry : table)
+		{
+			dataHeaderTempFileStream << "{" << rEntry.crc << ", " << rEntry.iIndex << "}";
+			dataHeaderTempFileStream << ", ";
+		}
+		dataHeaderTempFileStream << std::endl << "};" << std::endl;
+	};
+	writeIndexTable("kpTextureIndices", textureCrcs);
+	writeIndexTable("kpUiTextureIndices", textureCrcsUi);
+
 	if (bFailed)
 	{
 		LOG("\n\n\nFAILED\n\n\n");
@@ -455,6 +478,7 @@ void MainThread(int argc, char* argv[])
 
 void Quit(const char* pcMessage, const char* pcTitle)
 {
+	common::FlushLog();
 	fflush(stdout);
 	MessageBox(nullptr, pcMessage, pcTitle, MB_OK | MB_SYSTEMMODAL);
 }
@@ -0,0 +1,181 @@
+#include "Mipmaps.h"
+
+using namespace DirectX;
+
+static constexpr int64_t kiMipKernelPad = 8;
+
+static double Sinc(double x)
+{
+	return std::abs(x) < 1e-9 ? 1.0 : std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+}
+
+static double BesselI0(double x)
+{
+	double fSum = 1.0;
+	double fTerm = 1.0;
+	for (int64_t k = 1; k < 32; ++k)
+	{
+		fTerm *= (x / (2.0 * k)) * (x / (2.0 * k));
+		fSum += fTerm;
+	}
+	return fSum;
+}
+
+static MipKernel CreateMipKernel(MipFilter eMipFilter)
+{
+	if (eMipFilter == MipFilter::kBox)
+	{
+		return MipKernel {.iFirstTap = 0, .iTapCount = 2, .pfWeights = {0.5f, 0.5f}};
+	}
+
+	// Three destination pixels of support on each side, evaluated at the source pixel centers
+	constexpr double kfRadius = 3.0;
+	constexpr double kfKaiserBeta = 4.0;
+	MipKernel mipKernel {.iFirstTap = -5, .iTapCount = MipKernel::kiMaxTaps};
+
+	double fTotal = 0.0;
+	double pfWeights[MipKernel::kiMaxTaps] {};
+	for (int64_t t = 0; t < mipKernel.iTapCount; ++t)
+	{
+		double fDistance = (static_cast<double>(mipKernel.iFirstTap + t) - 0.5) / 2.0;
+		double fWindow = eMipFilter == MipFilter::kLanczos
+			? Sinc(fDistance / kfRadius)
+			: BesselI0(kfKaiserBeta * std::sqrt(std::max(0.0, 1.0 - (fDistance / kfRadius) * (fDistance / kfRadius)))) / BesselI0(kfKaiserBeta);
+		pfWeights[t] = Sinc(fDistance) * fWindow;
+		fTotal += pfWeights[t];
+	}
+	for (int64_t t = 0; t < mipKernel.iTapCount; ++t)
+	{
+		mipKernel.pfWeights[t] = static_cast<float>(pfWeights[t] / fTotal);
+	}
+
+	return mipKernel;
+}
+
+const MipKernel& GetMipKernel(MipFilter eMipFilter)
+{
+	static const MipKernel spMipKernels[] = {CreateMipKernel(MipFilter::kBox), CreateMipKernel(MipFilter::kKaiser), CreateMipKernel(MipFilter::kLanczos)};
+	return spMipKernels[static_cast<int64_t>(eMipFilter)];
+}
+
+// Filters rows [iRowStart, iRowEnd) of the destination, the vertical taps are summed into a padded row first so the horizontal taps never need clamping
+static void DownsampleRows(float* pfDest, const float* pfSrc, int64_t iSrcWidth, int64_t iSrcHeight, int64_t iChannels, const MipKernel& rMipKernel, int64_t iRowStart, int64_t iRowEnd)
+{
+	int64_t iWidth = iSrcWidth / 2;
+	int64_t iRowFloats = iChannels * iSrcWidth;
+
+	// Four floats of slack after the right pad for the single channel loads below
+	std::vector<float> paddedRow(iChannels * (iSrcWidth + 2 * kiMipKernelPad) + 4);
+	float* pfRow = paddedRow.data() + iChannels * kiMipKernelPad;
+
+	const float* ppfSrcRows[MipKernel::kiMaxTaps] {};
+	XMVECTOR pVecWeights[MipKernel::kiMaxTaps] {};
+	for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+	{
+		pVecWeights[t] = XMVectorReplicate(rMipKernel.pfWeights[t]);
+	}
+
+	const XMVECTOR vecMax = XMVectorReplicate(255.0f);
+	for (int64_t j = iRowStart; j < iRowEnd; ++j)
+	{
+		// Vertical, rows past the edges repeat the edge row
+		for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+		{
+			ppfSrcRows[t] = pfSrc + std::clamp<int64_t>(2 * j + rMipKernel.iFirstTap + t, 0, iSrcHeight - 1) * iRowFloats;
+		}
+
+		int64_t x = 0;
+		for (; x + 4 <= iRowFloats; x += 4)
+		{
+			XMVECTOR vecSum = XMVectorZero();
+			for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+			{
+				vecSum = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(ppfSrcRows[t] + x)), pVecWeights[t], vecSum);
+			}
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pfRow + x), vecSum);
+		}
+		for (; x < iRowFloats; ++x)
+		{
+			float fSum = 0.0f;
+			for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+			{
+				fSum += rMipKernel.pfWeights[t] * ppfSrcRows[t][x];
+			}
+			pfRow[x] = fSum;
+		}
+
+		for (int64_t p = 0; p < kiMipKernelPad; ++p)
+		{
+			std::copy_n(pfRow, iChannels, pfRow - (p + 1) * iChannels);
+			std::copy_n(pfRow + iRowFloats - iChannels, iChannels, pfRow + iRowFloats + p * iChannels);
+		}
+
+		// Horizontal, windowed sincs can overshoot so the result is clamped back into range
+		float* pfDestRow = pfDest + j * iChannels * iWidth;
+		const float* pfFirstTap = pfRow + iChannels * rMipKernel.iFirstTap;
+		int64_t i = 0;
+		if (iChannels == 4)
+		{
+			for (; i < iWidth; ++i)
+			{
+				XMVECTOR vecSum = XMVectorZero();
+				for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+				{
+					vecSum = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pfFirstTap + 4 * (2 * i + t))), pVecWeights[t], vecSum);
+				}
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pfDestRow + 4 * i), XMVectorClamp(vecSum, XMVectorZero(), vecMax));
+			}
+		}
+		else if (iChannels == 1)
+		{
+			// Four destination pixels at a time, the even source pixels of two loads line up with the tap of each
+			for (; i + 4 <= iWidth; i += 4)
+			{
+				XMVECTOR vecSum = XMVectorZero();
+				for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+				{
+					const float* pfTap = pfFirstTap + 2 * i + t;
+					XMVECTOR vecEven = XMVectorPermute<0, 2, 4, 6>(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pfTap)), XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pfTap + 4)));
+					vecSum = XMVectorMultiplyAdd(vecEven, pVecWeights[t], vecSum);
+				}
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pfDestRow + i), XMVectorClamp(vecSum, XMVectorZero(), vecMax));
+			}
+		}
+
+		for (; i < iWidth; ++i)
+		{
+			for (int64_t c = 0; c < iChannels; ++c)
+			{
+				float fSum = 0.0f;
+				for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+				{
+					fSum += rMipKernel.pfWeights[t] * pfFirstTap[iChannels * (2 * i + t) + c];
+				}
+				pfDestRow[iChannels * i + c] = std::clamp(fSum, 0.0f, 255.0f);
+			}
+		}
+	}
+}
+
+void Downsample(float* pfDest, const float* pfSrc, int64_t iSrcWidth, int64_t iSrcHeight, int64_t iChannels, const MipKernel& rMipKernel)
+{
+	// Small levels aren't worth the thread start
+	constexpr int64_t kiMinRowsPerBand = 16;
+	int64_t iHeight = iSrcHeight / 2;
+	int64_t iBands = std::clamp<int64_t>(iHeight / kiMinRowsPerBand, 1, std::thread::hardware_concurrency());
+	if (iBands == 1)
+	{
+		DownsampleRows(pfDest, pfSrc, iSrcWidth, iSrcHeight, iChannels, rMipKernel, 0, iHeight);
+		return;
+	}
+
+	std::vector<std::future<void>> futures;
+	for (int64_t b = 0; b < iBands; ++b)
+	{
+		futures.push_back(std::async(std::launch::async, DownsampleRows, pfDest, pfSrc, iSrcWidth, iSrcHeight, iChannels, std::cref(rMipKernel), b * iHeight / iBands, (b + 1) * iHeight / iBands));
+	}
+	for (std::future<void>& rFuture : futures)
+	{
+		rFuture.get();
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Kaiser and Lanczos are 3 lobe windowed sincs, sharper than box but they can ring next to hard edges
+enum class MipFilter
+{
+	kBox,
+	kKaiser,
+	kLanczos,
+};
+
+// Separable weights for halving a dimension, destination pixel i covers source pixels 2 * i and 2 * i + 1 and tap t reads 2 * i + iFirstTap + t
+struct MipKernel
+{
+	static constexpr int64_t kiMaxTaps = 12;
+
+	int64_t iFirstTap = 0;
+	int64_t iTapCount = 0;
+	float pfWeights[kiMaxTaps] {};
+};
+
+const MipKernel& GetMipKernel(MipFilter eMipFilter);
+
+// Halves a level of iChannels interleaved floats in [0, 255], rows are split into bands on std::async
+// Only needs DirectXMath, so it can be benchmarked without the rest of the packer
+void Downsample(float* pfDest, const float* pfSrc, int64_t iSrcWidth, int64_t iSrcHeight, int64_t iChannels, const MipKernel& rMipKernel);
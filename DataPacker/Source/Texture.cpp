@@ -1,21 +1,15 @@
 #include "Texture.h"
 
+#include "Exr.h"
+
 #pragma warning(push, 0)
 #pragma warning(disable : 6297 26495)
 #include "bc7enc_rdo/bc7enc.h"
 #include "bc7enc_rdo/rgbcx.h"
 #pragma warning(pop)
 
-#pragma warning(push, 0)
-#pragma warning(disable : 4201)
-#define OPENEXR_EXPORT
-#include "openexr/src/lib/OpenEXRCore/openexr.h"
-#pragma warning(pop)
-
 #include "stb/stb_image.h"
 
-using namespace DirectX;
-
 void Texture::StaticInit()
 {
 	rgbcx::init();
@@ -67,8 +61,10 @@ Texture::Texture(const std::filesystem::path& rPath, FileType eFileType, bool bF
 		fileStream.read(reinterpret_cast<char*>(data.data()), data.size());
 		fileStream.close();
 
+		miChannels = 1;
+
 		float* pfSrcR = reinterpret_cast<float*>(data.data());
-		std::vector<float>& rPixels = mData.emplace_back(4 * miWidth * miHeight);
+		std::vector<float>& rPixels = mData.emplace_back(miWidth * miHeight);
 		float* pfDest = rPixels.data();
 		for (int64_t j = 0; j < miHeight; ++j)
 		{
@@ -82,176 +78,131 @@ Texture::Texture(const std::filesystem::path& rPath, FileType eFileType, bool bF
 				{
 					pfDest[0] = 255.0f * pfSrcR[0];
 				}
-				pfDest[1] = 0.0f;
-				pfDest[2] = 0.0f;
-				pfDest[3] = 0.0f;
 
 				++pfSrcR;
-				pfDest += 4;
+				++pfDest;
 			}
 		}
 	}
 	else
 	{
-		exr_context_initializer_t ctxtinit = EXR_DEFAULT_CONTEXT_INITIALIZER;
-		exr_context_t f {};
-		exr_result_t rv = exr_start_read(&f, rPath.string().c_str(), &ctxtinit);
-		ASSERT(rv == EXR_ERR_SUCCESS);
-		common::ScopedLambda releaseExrContext([=]()
-		{
-			exr_context_t exrContextCopy = f;
-			exr_finish(&exrContextCopy);
-		});
-
-		exr_attr_box2i_t dw {};
-		exr_get_data_window(f, 0, &dw);
-		int32_t scansperchunk = 0;
-		exr_get_scanlines_per_chunk(f, 0, &scansperchunk);
-		ASSERT(scansperchunk == 1);
-
-		miWidth = dw.max.x + 1;
-		miHeight = dw.max.y + 1;
-		std::vector<float> pixelsR(miWidth * miHeight);
-		std::vector<float> pixelsG(miWidth * miHeight);
-		std::vector<float> pixelsB(miWidth * miHeight);
-
-		for (int y = dw.min.y; y <= dw.max.y; y += scansperchunk)
-		{
-			exr_chunk_info_t cinfo;
-			exr_read_scanline_chunk_info(f, 0, y, &cinfo);
-
-			exr_decode_pipeline_t decoder {};
-			exr_decoding_initialize(f, 0, &cinfo, &decoder);
-
-			decoder.channels[0].user_data_type = EXR_PIXEL_FLOAT;
-			decoder.channels[0].decode_to_ptr = reinterpret_cast<uint8_t*>(pixelsB.data() + y * miWidth);
-			decoder.channels[0].user_pixel_stride = 4;
-			decoder.channels[0].user_line_stride = static_cast<int32_t>(4 * miWidth);
-			decoder.channels[0].user_bytes_per_element = 4;
-
-			decoder.channels[1].user_data_type = EXR_PIXEL_FLOAT;
-			decoder.channels[1].decode_to_ptr = reinterpret_cast<uint8_t*>(pixelsG.data() + y * miWidth);
-			decoder.channels[1].user_pixel_stride = 4;
-			decoder.channels[1].user_line_stride = static_cast<int32_t>(4 * miWidth);
-			decoder.channels[1].user_bytes_per_element = 4;
-
-			decoder.channels[2].user_data_type = EXR_PIXEL_FLOAT;
-			decoder.channels[2].decode_to_ptr = reinterpret_cast<uint8_t*>(pixelsR.data() + y * miWidth);
-			decoder.channels[2].user_pixel_stride = 4;
-			decoder.channels[2].user_line_stride = static_cast<int32_t>(4 * miWidth);
-			decoder.channels[2].user_bytes_per_element = 4;
-
-			exr_decoding_choose_default_routines(f, 0, &decoder);
-			exr_decoding_run(f, 0, &decoder);
-			exr_decoding_destroy(f, &decoder);
-		}
-
-		float* pfSrcR = pixelsR.data();
-		float* pfSrcG = pixelsG.data();
-		float* pfSrcB = pixelsB.data();
-		std::vector<float>& rPixels = mData.emplace_back(4 * miWidth * miHeight);
-		float* pfDest = rPixels.data();
-		for (int64_t j = 0; j < miHeight; ++j)
-		{
-			for (int64_t i = 0; i < miWidth; ++i)
-			{
-				if (bFromGamma)
-				{
-					pfDest[0] = 255.0f * common::FromGamma(pfSrcR[0]);
-					pfDest[1] = 255.0f * common::FromGamma(pfSrcG[1]);
-					pfDest[2] = 255.0f * common::FromGamma(pfSrcB[2]);
-				}
-				else
-				{
-					pfDest[0] = 255.0f * pfSrcR[0];
-					pfDest[1] = 255.0f * pfSrcG[1];
-					pfDest[2] = 255.0f * pfSrcB[2];
-				}
-				pfDest[3] = 255.0f;
-
-				++pfSrcR;
-				++pfSrcG;
-				++pfSrcB;
-				pfDest += 4;
-			}
-		}
+		miChannels = 3;
+		ReadExr(mData.emplace_back(), miWidth, miHeight, rPath, bFromGamma);
 	}
 }
 
 Texture::Texture(const std::byte* puiPixels, int64_t iWidth, int64_t iHeight, int64_t iStride)
 : miWidth(iWidth)
 , miHeight(iHeight)
+, miChannels(iStride)
 {
-	std::vector<float>& rPixels = mData.emplace_back(4 * miWidth * miHeight);
+	ASSERT(iStride >= 1 && iStride <= 4);
+
+	std::vector<float>& rPixels = mData.emplace_back(miChannels * miWidth * miHeight);
 	float* pfDest = rPixels.data();
-	for (int64_t j = 0; j < miHeight; ++j)
+	for (int64_t i = 0; i < miChannels * miWidth * miHeight; ++i)
 	{
-		for (int64_t i = 0; i < miWidth; ++i)
-		{
-			pfDest[0] = static_cast<float>(puiPixels[0]);
-			pfDest[1] = static_cast<float>(puiPixels[1]);
-			pfDest[2] = static_cast<float>(puiPixels[2]);
-			pfDest[3] = static_cast<float>(iStride == 4 ? puiPixels[3] : std::byte(255));
+		pfDest[i] = static_cast<float>(puiPixels[i]);
+	}
+}
 
-			puiPixels += iStride;
-			pfDest += 4;
+// Values are 0 to 255 with an exponent of 2.2, only the color channels are converted and alpha stays as it is
+static void ToLinear(std::vector<float>& rPixels, int64_t iChannels)
+{
+	for (size_t i = 0; i < rPixels.size(); i += iChannels)
+	{
+		for (int64_t c = 0; c < 3; ++c)
+		{
+			rPixels[i + c] = 255.0f * std::pow(std::max(0.0f, rPixels[i + c] / 255.0f), 2.2f);
 		}
 	}
 }
 
-void Texture::MakeMipmaps(VkFormat vkFormat, int64_t iMaxLevel, int64_t iPreviousLevel, int64_t iPreviousWidth, int64_t iPreviousHeight)
+static void ToGamma(std::vector<float>& rPixels, int64_t iChannels)
 {
-	if (iPreviousWidth == 1 || iPreviousHeight == 1 || iPreviousLevel + 1 == iMaxLevel)
+	for (size_t i = 0; i < rPixels.size(); i += iChannels)
 	{
-		return;
+		for (int64_t c = 0; c < 3; ++c)
+		{
+			rPixels[i + c] = 255.0f * std::pow(std::max(0.0f, rPixels[i + c] / 255.0f), 1.0f / 2.2f);
+		}
 	}
+}
+
+void Texture::MakeMipmaps(VkFormat vkFormat, int64_t iMaxLevel, MipFilter eMipFilter, bool bColor)
+{
+	ASSERT(mData.size() == 1);
+	common::Timer timer;
 
-	int64_t iWidth = std::max(iPreviousWidth / 2, 1ll);
-	int64_t iHeight = std::max(iPreviousHeight / 2, 1ll);
+	const MipKernel& rMipKernel = GetMipKernel(eMipFilter);
 
-	if (vkFormat == VK_FORMAT_BC4_UNORM_BLOCK || vkFormat == VK_FORMAT_BC7_UNORM_BLOCK)
+	// Averaging gamma encoded values darkens, so color levels are made from a linear copy and encoded again when stored
+	bool bLinear = bColor && miChannels >= 3;
+	std::vector<float> previousLinear;
+	std::vector<float> linear;
+	if (bLinear)
 	{
-		if (iWidth < 4 || iHeight < 4)
+		previousLinear = mData.front();
+		ToLinear(previousLinear, miChannels);
+	}
+
+	int64_t iPeakBytes = 0;
+	int64_t iPreviousWidth = miWidth;
+	int64_t iPreviousHeight = miHeight;
+	for (int64_t iLevel = 1; iLevel < iMaxLevel && iPreviousWidth > 1 && iPreviousHeight > 1; ++iLevel)
+	{
+		int64_t iWidth = iPreviousWidth / 2;
+		int64_t iHeight = iPreviousHeight / 2;
+
+		if (vkFormat == VK_FORMAT_BC4_UNORM_BLOCK || vkFormat == VK_FORMAT_BC7_UNORM_BLOCK)
 		{
-			return;
+			if (iWidth < 4 || iHeight < 4)
+			{
+				break;
+			}
+
+			if ((iWidth % 4) != 0 || (iHeight % 4) != 0)
+			{
+				LOG("BC4/BC7 early out {} x {}", iWidth, iHeight);
+				break;
+			}
 		}
 
-		if ((iWidth % 4) != 0 || (iHeight % 4) != 0)
+		if (bLinear)
 		{
-			LOG("BC4/BC7 early out {} x {}", iWidth, iHeight);
-			return;
+			linear.resize(miChannels * iWidth * iHeight);
+			Downsample(linear.data(), previousLinear.data(), iPreviousWidth, iPreviousHeight, miChannels, rMipKernel);
+			ToGamma(mData.emplace_back(linear), miChannels);
+			iPeakBytes = std::max(iPeakBytes, static_cast<int64_t>(sizeof(float) * (previousLinear.size() + linear.size())));
+			std::swap(previousLinear, linear);
 		}
-	}
-
-	std::vector<float>& rPixels = mData.emplace_back(4 * iWidth * iHeight);
-
-	float* pfPreviousPixels = mData.at(iPreviousLevel).data();
-	float* pfPixels = rPixels.data();
-	for (int64_t j = 0; j < iHeight; ++j)
-	{
-		for (int64_t i = 0; i < iWidth; ++i)
+		else
 		{
-			int64_t iTopLeft     = (2 * j + 0) * 4 * iPreviousWidth + (2 * i + 0) * 4;
-			int64_t iTopRight    = (2 * j + 0) * 4 * iPreviousWidth + (2 * i + 1) * 4;
-			int64_t iBottomLeft  = (2 * j + 1) * 4 * iPreviousWidth + (2 * i + 0) * 4;
-			int64_t iBottomRight = (2 * j + 1) * 4 * iPreviousWidth + (2 * i + 1) * 4;
-
-			pfPixels[j * 4 * iWidth + 4 * i + 0] = 0.25f * (pfPreviousPixels[iTopLeft + 0] + pfPreviousPixels[iTopRight + 0] + pfPreviousPixels[iBottomLeft + 0] + pfPreviousPixels[iBottomRight + 0]);
-			pfPixels[j * 4 * iWidth + 4 * i + 1] = 0.25f * (pfPreviousPixels[iTopLeft + 1] + pfPreviousPixels[iTopRight + 1] + pfPreviousPixels[iBottomLeft + 1] + pfPreviousPixels[iBottomRight + 1]);
-			pfPixels[j * 4 * iWidth + 4 * i + 2] = 0.25f * (pfPreviousPixels[iTopLeft + 2] + pfPreviousPixels[iTopRight + 2] + pfPreviousPixels[iBottomLeft + 2] + pfPreviousPixels[iBottomRight + 2]);
-			pfPixels[j * 4 * iWidth + 4 * i + 3] = 0.25f * (pfPreviousPixels[iTopLeft + 3] + pfPreviousPixels[iTopRight + 3] + pfPreviousPixels[iBottomLeft + 3] + pfPreviousPixels[iBottomRight + 3]);
+			mData.emplace_back(miChannels * iWidth * iHeight);
+			Downsample(mData.back().data(), mData.at(iLevel - 1).data(), iPreviousWidth, iPreviousHeight, miChannels, rMipKernel);
 		}
+
+		iPreviousWidth = iWidth;
+		iPreviousHeight = iHeight;
 	}
 
-	return MakeMipmaps(vkFormat, iMaxLevel, iPreviousLevel + 1, iWidth, iHeight);
+	for (const std::vector<float>& rLevel : mData)
+	{
+		iPeakBytes += static_cast<int64_t>(sizeof(float) * rLevel.size());
+	}
+	LOG("Mipmaps {} x {} x {}: {} levels in {} ms, peak {} MB", miWidth, miHeight, miChannels, mData.size(), std::chrono::duration_cast<std::chrono::milliseconds>(timer.GetDeltaNs()).count(), iPeakBytes / (1024 * 1024));
 }
 
 uint32_t Texture::PixelToUint32(const std::vector<float>& rIn, int64_t iWidth, [[maybe_unused]] int64_t iHeight, int64_t iX, int64_t iY)
 {
-	return static_cast<uint32_t>(rIn.at(4 * (iY * iWidth + iX) + 3)) << 24 |
-	       static_cast<uint32_t>(rIn.at(4 * (iY * iWidth + iX) + 2)) << 16 |
-	       static_cast<uint32_t>(rIn.at(4 * (iY * iWidth + iX) + 1)) <<  8 |
-	       static_cast<uint32_t>(rIn.at(4 * (iY * iWidth + iX) + 0));
+	// One and two channel textures are grey, alpha is opaque unless it was stored
+	int64_t iPixel = miChannels * (iY * iWidth + iX);
+	uint32_t uiR = static_cast<uint32_t>(rIn.at(iPixel));
+	uint32_t uiG = miChannels >= 3 ? static_cast<uint32_t>(rIn.at(iPixel + 1)) : uiR;
+	uint32_t uiB = miChannels >= 3 ? static_cast<uint32_t>(rIn.at(iPixel + 2)) : uiR;
+	uint32_t uiA = miChannels == 4 || miChannels == 2 ? static_cast<uint32_t>(rIn.at(iPixel + miChannels - 1)) : 255;
+
+	return uiA << 24 | uiB << 16 | uiG << 8 | uiR;
 }
 
 std::mutex gBc4Mutex;
@@ -268,10 +219,10 @@ void Texture::ToBc4(std::byte* puiOut, const std::vector<float>& rIn, int64_t iW
 			uint8_t puiBlock[16] {};
 			for (int64_t k = 0; k < 4; ++k)
 			{
-				puiBlock[4 * k + 0] = static_cast<uint8_t>(rIn.at(4 * (j * 4 * iWidth + i * 4 + k * iWidth + 0) + iIndex));
-				puiBlock[4 * k + 1] = static_cast<uint8_t>(rIn.at(4 * (j * 4 * iWidth + i * 4 + k * iWidth + 1) + iIndex));
-				puiBlock[4 * k + 2] = static_cast<uint8_t>(rIn.at(4 * (j * 4 * iWidth + i * 4 + k * iWidth + 2) + iIndex));
-				puiBlock[4 * k + 3] = static_cast<uint8_t>(rIn.at(4 * (j * 4 * iWidth + i * 4 + k * iWidth + 3) + iIndex));
+				puiBlock[4 * k + 0] = static_cast<uint8_t>(rIn.at(miChannels * (j * 4 * iWidth + i * 4 + k * iWidth + 0) + iIndex));
+				puiBlock[4 * k + 1] = static_cast<uint8_t>(rIn.at(miChannels * (j * 4 * iWidth + i * 4 + k * iWidth + 1) + iIndex));
+				puiBlock[4 * k + 2] = static_cast<uint8_t>(rIn.at(miChannels * (j * 4 * iWidth + i * 4 + k * iWidth + 2) + iIndex));
+				puiBlock[4 * k + 3] = static_cast<uint8_t>(rIn.at(miChannels * (j * 4 * iWidth + i * 4 + k * iWidth + 3) + iIndex));
 			}
 
 			std::lock_guard lockGuard(gBc4Mutex);
@@ -333,7 +284,7 @@ void Texture::ToR16(std::byte* puiOut, const std::vector<float>& rIn, int64_t iW
 	{
 		for (int64_t i = 0; i < iWidth; ++i)
 		{
-			float fPixel = rIn.at(4 * (j * iWidth + i)) / 255.0f;
+			float fPixel = rIn.at(miChannels * (j * iWidth + i)) / 255.0f;
 
 			if (fPixel > 1.0f) [[unlikely]]
 			{
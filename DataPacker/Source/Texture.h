@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Mipmaps.h"
+
 enum class FileType
 {
 	kExr,
@@ -19,13 +21,8 @@ public:
 
 	~Texture() = default;
 
-	void MakeMipmaps(VkFormat vkFormat, int64_t iMaxLevel, int64_t iPreviousLevel, int64_t iPreviousWidth, int64_t iPreviousHeight);
-
-	void MakeMipmaps(VkFormat vkFormat, int64_t iMaxLevel = 32)
-	{
-		ASSERT(mData.size() == 1);
-		MakeMipmaps(vkFormat, iMaxLevel, 0, miWidth, miHeight);
-	}
+	// Color textures are filtered in linear space, the stored levels stay gamma encoded
+	void MakeMipmaps(VkFormat vkFormat, int64_t iMaxLevel = 32, MipFilter eMipFilter = MipFilter::kBox, bool bColor = false);
 
 	uint32_t PixelToUint32(const std::vector<float>& rIn, int64_t iWidth, int64_t iHeight, int64_t iX, int64_t iY);
 	void ToBc4(std::byte* puiOut, const std::vector<float>& rIn, int64_t iWidth, int64_t iHeight, int64_t iIndex = 0);
@@ -48,5 +45,6 @@ public:
 	int64_t miHeight = 0;
 	int64_t miChannels = 0;
 
+	// Every level holds miChannels interleaved floats per pixel in [0, 255]
 	std::vector<std::vector<float>> mData;
 };
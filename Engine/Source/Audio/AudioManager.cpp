@@ -246,6 +246,8 @@ void XM_CALLCONV AudioManager::Apply3d(IXAudio2SourceVoice* pIXAudio2SourceVoice
 
 void AudioManager::Update(const game::Frame& rFrame)
 {
+	std::lock_guard lockGuard(mMutex);
+
 	if (mpAudioEngine != nullptr && !mpAudioEngine->IsAudioDevicePresent())
 	{
 		LOG("mpAudioEngine->Reset()");
@@ -479,6 +481,12 @@ IXAudio2SourceVoice* AudioManager::PlayOneShot(common::crc_t audioCrc, bool b3d,
 	ASSERT(gCurrentFrameTypeProcessing == FrameType::kFull);
 #endif
 
+	std::lock_guard lockGuard(mMutex);
+	return StartOneShot(audioCrc, b3d, fVolume, fPitch);
+}
+
+IXAudio2SourceVoice* AudioManager::StartOneShot(common::crc_t audioCrc, bool b3d, float fVolume, float fPitch)
+{
 	if (mpAudioEngine == nullptr || !mpAudioEngine->IsAudioDevicePresent()) [[unlikely]]
 	{
 		return nullptr;
@@ -499,12 +507,14 @@ void XM_CALLCONV AudioManager::PlayOneShot(common::crc_t audioCrc, DirectX::FXMV
 	ASSERT(gCurrentFrameTypeProcessing == FrameType::kFull);
 #endif
 
+	std::lock_guard lockGuard(mMutex);
+
 	if (mpAudioEngine == nullptr || !mpAudioEngine->IsAudioDevicePresent()) [[unlikely]]
 	{
 		return;
 	}
 
-	IXAudio2SourceVoice* pIXAudio2SourceVoice = PlayOneShot(audioCrc, true, fVolume, fPitch);
+	IXAudio2SourceVoice* pIXAudio2SourceVoice = StartOneShot(audioCrc, true, fVolume, fPitch);
 	Apply3d(pIXAudio2SourceVoice, vecPosition, XMVectorZero(), fVolume, fPitch);
 }
 
@@ -56,9 +56,13 @@ public:
 
 private:
 
+	IXAudio2SourceVoice* StartOneShot(common::crc_t audioCrc, bool b3d, float fVolume, float fPitch);
 	void LoadVoice(IXAudio2SourceVoice*& rpVoice, common::crc_t audioCrc, bool bOneShot, bool bMusic, bool b3d);
 	void XM_CALLCONV Apply3d(IXAudio2SourceVoice* pIXAudio2SourceVoice, DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecVelocity, float fVolume, float fPitch);
 
+	// One shots are started by kFull ticks on the simulation thread while Update() runs on the main thread
+	std::mutex mMutex;
+
 	int64_t miMenuMusicIndex = 0;
 	int64_t miGameMusicIndex = 0;
 	IXAudio2SourceVoice* mpMenuMusicVoice = nullptr;
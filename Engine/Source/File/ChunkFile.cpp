@@ -0,0 +1,70 @@
+#include "ChunkFile.h"
+
+namespace engine
+{
+
+ChunkKind ClassifyChunk(const common::ChunkFlags_t& rFlags)
+{
+	using enum common::ChunkFlags;
+
+	if (rFlags & kShaderCompute || rFlags & kShaderFragment || rFlags & kShaderVertex)
+	{
+		return kChunkShaders;
+	}
+	if (rFlags & kModel)
+	{
+		return kChunkModels;
+	}
+	if (rFlags & kIsland)
+	{
+		return kChunkIslands;
+	}
+	if (rFlags & kFont)
+	{
+		return kChunkFonts;
+	}
+	if (rFlags & kTexture)
+	{
+		return kChunkTextures;
+	}
+
+	return kChunkOther;
+}
+
+void ReadChunkFile(const std::filesystem::path& rDataFile, std::vector<byte>& rData, std::unordered_map<common::crc_t, Chunk>& rDataChunkMap, ChunkLists& rChunkLists)
+{
+	rData.resize(std::filesystem::file_size(rDataFile));
+	std::fstream fileStream(rDataFile, std::ios::in | std::ios::binary);
+	fileStream.read(reinterpret_cast<char*>(rData.data()), rData.size());
+
+	int64_t iCurrentPosition = 0;
+	auto pDataHeader = reinterpret_cast<common::DataHeader*>(&rData[iCurrentPosition]);
+	iCurrentPosition += common::RoundUp(static_cast<int64_t>(sizeof(common::DataHeader)), common::kiAlignmentBytes);
+	ASSERT(pDataHeader->iMagic == common::DataHeader::kiMagic);
+	ASSERT(pDataHeader->iVersion == common::DataHeader::kiVersion);
+
+	LOG("Found {} chunks in the data file", pDataHeader->iChunkCount);
+	for (int64_t i = 0; i < pDataHeader->iChunkCount; ++i)
+	{
+		auto pChunkHeader = reinterpret_cast<common::ChunkHeader*>(&rData[iCurrentPosition]);
+		// LOG("  {}, {}: ({:#018x}) {:#018x} {}", i, iCurrentPosition, pChunkHeader->crc, pChunkHeader->flags.muiUnderlying, pChunkHeader->iSize);
+		iCurrentPosition += common::RoundUp(static_cast<int64_t>(sizeof(common::ChunkHeader)), common::kiAlignmentBytes);
+		ASSERT(pChunkHeader->iMagic == common::ChunkHeader::kiMagic);
+
+		Chunk chunk
+		{
+			.pHeader = pChunkHeader,
+			.pData = &rData[iCurrentPosition],
+		};
+		iCurrentPosition += common::RoundUp(pChunkHeader->iSize, common::kiAlignmentBytes);
+
+		rChunkLists[ClassifyChunk(pChunkHeader->flags)].push_back(chunk);
+
+		auto [it, bInserted] = rDataChunkMap.try_emplace(pChunkHeader->crc, std::move(chunk));
+		ASSERT(bInserted);
+	}
+
+	LOG("{} models, {} islands, {} fonts, {} shaders, {} textures, {} other", rChunkLists[kChunkModels].size(), rChunkLists[kChunkIslands].size(), rChunkLists[kChunkFonts].size(), rChunkLists[kChunkShaders].size(), rChunkLists[kChunkTextures].size(), rChunkLists[kChunkOther].size());
+}
+
+} // namespace engine
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "DataFile.h"
+#include "MathUtils.h"
+
+namespace engine
+{
+
+struct Chunk
+{
+	common::ChunkHeader* pHeader = nullptr;
+	byte* pData = nullptr;
+};
+
+// What consumes a chunk, every chunk is put in one list while the file is read so the managers don't each walk the whole map filtering by flags
+enum ChunkKind
+{
+	kChunkModels,
+	kChunkIslands,
+	kChunkFonts,
+	kChunkShaders,
+	kChunkTextures,
+	kChunkOther,
+
+	kChunkKindCount
+};
+ChunkKind ClassifyChunk(const common::ChunkFlags_t& rFlags);
+// In file order, which unlike the chunk maps is the same on every run
+using ChunkLists = std::array<std::vector<Chunk>, kChunkKindCount>;
+
+// Reads Data.bin or Textures.bin into rData, the chunks point into it so it has to outlive them
+void ReadChunkFile(const std::filesystem::path& rDataFile, std::vector<byte>& rData, std::unordered_map<common::crc_t, Chunk>& rDataChunkMap, ChunkLists& rChunkLists);
+
+} // namespace engine
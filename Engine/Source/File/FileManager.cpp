@@ -21,6 +21,7 @@ FileManager::FileManager()
 	std::filesystem::create_directory(mAppDataDirectory);
 	mLogFileStream.open(LogFile(), std::ofstream::out);
 	common::gpLogFileStream = &mLogFileStream;
+	mpLogWriter = std::make_unique<common::LogWriter>(common::LogOverflow::kBlock);
 	LOG("AppData directory: \"{}\"", mAppDataDirectory.string());
 
 	char pcDirectory[MAX_PATH] {};
@@ -61,6 +62,7 @@ FileManager::FileManager()
 
 FileManager::~FileManager()
 {
+	mpLogWriter.reset();
 	common::gpLogFileStream = nullptr;
 
 	gpFileManager = nullptr;
@@ -126,36 +128,20 @@ void FileManager::RemoveFile(const FileFlags_t& rFlags, const std::filesystem::p
 	std::filesystem::remove(file);
 }
 
-void ReadChunkFile(const std::filesystem::path& rDataFile, std::vector<byte>& rData, std::unordered_map<common::crc_t, Chunk>& rDataChunkMap)
+void FileManager::RenameFile(const FileFlags_t& rFlags, const std::filesystem::path& rFromFilename, const std::filesystem::path& rToFilename)
 {
-	rData.resize(std::filesystem::file_size(rDataFile));
-	std::fstream fileStream(rDataFile, std::ios::in | std::ios::binary);
-	fileStream.read(reinterpret_cast<char*>(rData.data()), rData.size());
-
-	int64_t iCurrentPosition = 0;
-	auto pDataHeader = reinterpret_cast<common::DataHeader*>(&rData[iCurrentPosition]);
-	iCurrentPosition += common::RoundUp(static_cast<int64_t>(sizeof(common::DataHeader)), common::kiAlignmentBytes);
-	ASSERT(pDataHeader->iMagic == common::DataHeader::kiMagic);
-	ASSERT(pDataHeader->iVersion == common::DataHeader::kiVersion);
-
-	LOG("Found {} chunks in the data file", pDataHeader->iChunkCount);
-	for (int64_t i = 0; i < pDataHeader->iChunkCount; ++i)
-	{
-		auto pChunkHeader = reinterpret_cast<common::ChunkHeader*>(&rData[iCurrentPosition]);
-		// LOG("  {}, {}: ({:#018x}) {:#018x} {}", i, iCurrentPosition, pChunkHeader->crc, pChunkHeader->flags.muiUnderlying, pChunkHeader->iSize);
-		iCurrentPosition += common::RoundUp(static_cast<int64_t>(sizeof(common::ChunkHeader)), common::kiAlignmentBytes);
-		ASSERT(pChunkHeader->iMagic == common::ChunkHeader::kiMagic);
-
-		Chunk chunk
-		{
-			.pHeader = pChunkHeader,
-			.pData = &rData[iCurrentPosition],
-		};
-		iCurrentPosition += common::RoundUp(pChunkHeader->iSize, common::kiAlignmentBytes);
+	std::filesystem::path fromFile = GetFilePath(rFlags, rFromFilename);
+	std::filesystem::path toFile = GetFilePath(rFlags, rToFilename);
+	LOG("Rename \"{}\" to \"{}\" at \"{}\"", rFromFilename.string(), rToFilename.string(), toFile.string());
+	std::filesystem::rename(fromFile, toFile);
+}
 
-		auto [it, bInserted] = rDataChunkMap.try_emplace(pChunkHeader->crc, std::move(chunk));
-		ASSERT(bInserted);
-	}
+// The files are read before the profile manager exists, so the boot timer is written directly
+void TimedReadChunkFile(BootTimers eBootTimer, const std::filesystem::path& rDataFile, std::vector<byte>& rData, std::unordered_map<common::crc_t, Chunk>& rDataChunkMap, ChunkLists& rChunkLists)
+{
+	auto startTimePoint = std::chrono::high_resolution_clock::now();
+	ReadChunkFile(rDataFile, rData, rDataChunkMap, rChunkLists);
+	gpBootTimers[eBootTimer].timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startTimePoint);
 }
 
 void FileManager::ReadDataFile()
@@ -163,38 +149,55 @@ void FileManager::ReadDataFile()
 	mDataFuture = std::async(std::launch::async, [this]()
 	{
 		common::ThreadLocal threadLocal(0, common::kThreadDataFile);
-		ReadChunkFile(mDataFile, mDataBytes, mDataChunkMap);
 
+		// Both files are read at the same time, the textures future is only looked at once the data future is ready
 		mTexturesFuture = std::async(std::launch::async, [this]()
 		{
 			common::ThreadLocal threadLocal(0, common::kThreadTexturesFile);
-			ReadChunkFile(mTexturesFile, mTexturesBytes, mTexturesChunkMap);
+			TimedReadChunkFile(kBootTimerReadTexturesFile, mTexturesFile, mTexturesBytes, mTexturesChunkMap, mTexturesChunkLists);
 		});
+
+		TimedReadChunkFile(kBootTimerReadDataFile, mDataFile, mDataBytes, mDataChunkMap, mDataChunkLists);
 	});
 }
 
 std::unordered_map<common::crc_t, Chunk>& FileManager::GetDataChunkMap()
 {
-	BOOT_TIMER_START(kBootTimerWaitForDataFile);
-	if (gpFileManager->mDataFuture.valid())
+	if (mDataFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
 	{
-		gpFileManager->mDataFuture.get();
+		SCOPED_BOOT_TIMER(kBootTimerWaitForDataFile);
+		mDataFuture.wait();
 	}
-	BOOT_TIMER_STOP(kBootTimerWaitForDataFile);
+	mDataFuture.get();
 
 	return mDataChunkMap;
 }
 
 std::unordered_map<common::crc_t, Chunk>& FileManager::GetTexturesChunkMap()
 {
-	BOOT_TIMER_START(kBootTimerWaitForTexturesFile);
-	if (gpFileManager->mTexturesFuture.valid())
+	// The textures file is started from the data file thread
+	GetDataChunkMap();
+
+	if (mTexturesFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
 	{
-		gpFileManager->mTexturesFuture.get();
+		SCOPED_BOOT_TIMER(kBootTimerWaitForTexturesFile);
+		mTexturesFuture.wait();
 	}
-	BOOT_TIMER_STOP(kBootTimerWaitForTexturesFile);
+	mTexturesFuture.get();
 
 	return mTexturesChunkMap;
 }
 
+std::span<const Chunk> FileManager::GetDataChunks(ChunkKind eChunkKind)
+{
+	GetDataChunkMap();
+	return mDataChunkLists[eChunkKind];
+}
+
+std::span<const Chunk> FileManager::GetTexturesChunks(ChunkKind eChunkKind)
+{
+	GetTexturesChunkMap();
+	return mTexturesChunkLists[eChunkKind];
+}
+
 } // namespace engine
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ChunkFile.h"
+
 namespace engine
 {
 
@@ -22,12 +24,6 @@ enum class FileFlags : uint64_t
 };
 using FileFlags_t = common::Flags<FileFlags>;
 
-struct Chunk
-{
-	common::ChunkHeader* pHeader = nullptr;
-	byte* pData = nullptr;
-};
-
 class FileManager
 {
 public:
@@ -39,6 +35,7 @@ public:
 	int64_t GetFileSize(const FileFlags_t& rFlags, const std::filesystem::path& rFilename);
 	std::fstream OpenFile(const FileFlags_t& rFlags, const std::filesystem::path& rFilename);
 	void RemoveFile(const FileFlags_t& rFlags, const std::filesystem::path& rFilename);
+	void RenameFile(const FileFlags_t& rFlags, const std::filesystem::path& rFromFilename, const std::filesystem::path& rToFilename);
 
 	std::filesystem::path LogFile()
 	{
@@ -55,9 +52,17 @@ public:
 
 	std::unordered_map<common::crc_t, Chunk>& GetDataChunkMap();
 	std::unordered_map<common::crc_t, Chunk>& GetTexturesChunkMap();
+	std::span<const Chunk> GetDataChunks(ChunkKind eChunkKind);
+	std::span<const Chunk> GetTexturesChunks(ChunkKind eChunkKind);
+
+	// For worker threads started before the file is read, waits without touching the boot timers
+	void WaitForDataFile() const
+	{
+		mDataFuture.get();
+	}
 
-	std::future<void> mDataFuture;
-	std::future<void> mTexturesFuture;
+	std::shared_future<void> mDataFuture;
+	std::shared_future<void> mTexturesFuture;
 
 private:
 
@@ -70,12 +75,15 @@ private:
 	std::filesystem::path mDataFile;
 	std::vector<byte> mDataBytes;
 	std::unordered_map<common::crc_t, Chunk> mDataChunkMap;
+	ChunkLists mDataChunkLists;
 
 	std::filesystem::path mTexturesFile;
 	std::vector<byte> mTexturesBytes;
 	std::unordered_map<common::crc_t, Chunk> mTexturesChunkMap;
+	ChunkLists mTexturesChunkLists;
 
 	std::ofstream mLogFileStream;
+	std::unique_ptr<common::LogWriter> mpLogWriter;
 };
 
 inline FileManager* gpFileManager = nullptr;
@@ -20,7 +20,7 @@ FrameBase::FrameBase(IslandsFlip eInitialIslandsFlip)
 	Navmesh::SetupGrid(f4GlobalArea, navmesh);
 }
 
-void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFrame, const game::FrameInput& __restrict rFrameInput, float fDeltaTime, FrameType eFrameType)
+static void UpdateFrame(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFrame, const game::FrameInput& __restrict rFrameInput, float fDeltaTime, FrameType eFrameType)
 {
 	SCOPED_CPU_PROFILE(kCpuTimerFrameUpdate);
 
@@ -49,8 +49,8 @@ void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restri
 
 		rFrame.iFrame = eFrameType == FrameType::kFull ? rPreviousFrame.iFrame + 1 : rPreviousFrame.iFrame;
 		rFrame.eFrameType = eFrameType;
+		// Only carried here, ticks run on the simulation thread and GameBase::ApplyIslandsFlip() applies it on the main thread
 		rFrame.eIslandsFlip = rPreviousFrame.eIslandsFlip;
-		engine::gpIslands->SetIslandsFlip(rFrame.eIslandsFlip);
 
 		if (bEpsilon)
 		{
@@ -76,8 +76,16 @@ void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restri
 		gCurrentFrameTypeProcessing = FrameType::kMain;
 #endif
 
-		Areas::Copy(rFrame.enemyAreas, rPreviousFrame.enemyAreas);
-		Areas::Copy(rFrame.playerAreas, rPreviousFrame.playerAreas);
+		// A kMain frame only copies the pools that interpolation writes to, the rest are read in place from the kFull frame it was built from
+		if (eFrameType == FrameType::kFull)
+		{
+			Areas::Copy(rFrame.enemyAreas, rPreviousFrame.enemyAreas);
+			Areas::Copy(rFrame.playerAreas, rPreviousFrame.playerAreas);
+			Pullers::Copy(rFrame.pullers, rPreviousFrame.pullers);
+			Sounds::Copy(rFrame.sounds, rPreviousFrame.sounds);
+			Splashes::Copy(rFrame.splashes, rPreviousFrame.splashes);
+		}
+
 		AreaLights::Copy(rFrame.areaLights, rPreviousFrame.areaLights);
 		Billboards::Copy(rFrame.billboards, rPreviousFrame.billboards);
 		Explosions::Copy(rFrame.explosions, rPreviousFrame.explosions);
@@ -88,17 +96,13 @@ void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restri
 		Puffs::Copy(rFrame.puffs, rPreviousFrame.puffs);
 			rFrame.puffControllers2.UpdateMain(rFrame.puffControllers2, rPreviousFrame.puffControllers2, rFrame.puffs, rFrame.fCurrentTime);
 			rFrame.puffControllers3.UpdateMain(rFrame.puffControllers3, rPreviousFrame.puffControllers3, rFrame.puffs, rFrame.fCurrentTime);
-		Pullers::Copy(rFrame.pullers, rPreviousFrame.pullers);
 		Pushers::Copy(rFrame.pushers, rPreviousFrame.pushers);
-		Sounds::Copy(rFrame.sounds, rPreviousFrame.sounds);
-		Splashes::Copy(rFrame.splashes, rPreviousFrame.splashes);
 		Targets::Copy(rFrame.targets, rPreviousFrame.targets);
 		Trails::Copy(rFrame.trails, rPreviousFrame.trails);
 
 		FrameInterpolate(rFrame, rPreviousFrame, rFrameInput.held, fDeltaTime);
 		InterpolateList(rFrame, rPreviousFrame, rFrameInput.held, fDeltaTime, UPDATE_LIST);
 		Explosions::Interpolate(rFrame);
-		Targets::Interpolate(rFrame);
 	}
 
 	{
@@ -132,6 +136,57 @@ void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restri
 	}
 }
 
+void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFrame, const game::FrameInput& __restrict rFrameInput, float fDeltaTime, FrameType eFrameType)
+{
+	if constexpr (common::kbVerifyFrame)
+	{
+		// The same tick with every update list run serially, scheduling them over the workers must not change the frame
+		if (eFrameType == FrameType::kFull)
+		{
+			auto pSerialFrame = std::make_unique<game::Frame>(rFrame);
+			gbSerialUpdateLists = true;
+			UpdateFrame(*pSerialFrame, rPreviousFrame, rFrameInput, fDeltaTime, eFrameType);
+			gbSerialUpdateLists = false;
+
+			UpdateFrame(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, eFrameType);
+			common::BreakOnNotEqual(*pSerialFrame == rFrame);
+			return;
+		}
+	}
+
+	UpdateFrame(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, eFrameType);
+}
+
+void HashAccess(const FrameBase& rFrame, uint64_t uiAccess, access_hashes_t& rHashes)
+{
+	HashMember(rHashes, uiAccess, kAccessGlobal, rFrame.iFrame);
+	HashMember(rHashes, uiAccess, kAccessGlobal, rFrame.eFrameType);
+	HashMember(rHashes, uiAccess, kAccessGlobal, rFrame.eIslandsFlip);
+	HashMember(rHashes, uiAccess, kAccessGlobal, rFrame.fCurrentTime);
+	HashMember(rHashes, uiAccess, kAccessGlobal, rFrame.fSunAngle);
+	HashMember(rHashes, uiAccess, kAccessGlobal, rFrame.f4GlobalArea);
+	HashMember(rHashes, uiAccess, kAccessRandom, rFrame.randomEngine);
+	HashMember(rHashes, uiAccess, kAccessNavmesh, rFrame.navmesh);
+	HashMember(rHashes, uiAccess, kAccessAreas, rFrame.enemyAreas);
+	HashMember(rHashes, uiAccess, kAccessAreas, rFrame.playerAreas);
+	HashMember(rHashes, uiAccess, kAccessAreaLights, rFrame.areaLights);
+	HashMember(rHashes, uiAccess, kAccessBillboards, rFrame.billboards);
+	HashMember(rHashes, uiAccess, kAccessExplosions, rFrame.explosions);
+	HashMember(rHashes, uiAccess, kAccessHexShields, rFrame.hexShields);
+	HashMember(rHashes, uiAccess, kAccessPointLights, rFrame.pointLights);
+	HashMember(rHashes, uiAccess, kAccessPointLights, rFrame.pointLightControllers2);
+	HashMember(rHashes, uiAccess, kAccessPointLights, rFrame.pointLightControllers3);
+	HashMember(rHashes, uiAccess, kAccessPuffs, rFrame.puffs);
+	HashMember(rHashes, uiAccess, kAccessPuffs, rFrame.puffControllers2);
+	HashMember(rHashes, uiAccess, kAccessPuffs, rFrame.puffControllers3);
+	HashMember(rHashes, uiAccess, kAccessPullers, rFrame.pullers);
+	HashMember(rHashes, uiAccess, kAccessPushers, rFrame.pushers);
+	HashMember(rHashes, uiAccess, kAccessSounds, rFrame.sounds);
+	HashMember(rHashes, uiAccess, kAccessSplashes, rFrame.splashes);
+	HashMember(rHashes, uiAccess, kAccessTargets, rFrame.targets);
+	HashMember(rHashes, uiAccess, kAccessTrails, rFrame.trails);
+}
+
 bool XM_CALLCONV InsideVisibleArea(const game::FrameInput& rFrameInput, FXMVECTOR vecPosition, float fAdjustLeft, float fAdjustRight, float fAdjustTop, float fAdjustBottom)
 {
 	return InVisibleArea(rFrameInput.f4LargeVisibleArea, vecPosition, fAdjustLeft, fAdjustRight, fAdjustTop, fAdjustBottom);
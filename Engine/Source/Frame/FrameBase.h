@@ -28,7 +28,7 @@ enum class FrameType
 
 
 #if defined(BT_DEBUG)
-inline FrameType gCurrentFrameTypeProcessing = FrameType::kFull;
+inline thread_local FrameType gCurrentFrameTypeProcessing = FrameType::kFull;
 #endif
 
 }
@@ -51,6 +51,10 @@ inline constexpr std::chrono::nanoseconds kUpdateStepNs = 1'000'000'000ns / 250;
 inline constexpr float kfDeltaTime = common::NanosecondsToFloatSeconds<float>(kUpdateStepNs);
 
 inline int64_t giBackgroundThreadCount = 0;
+// Runs Multithread<> and RenderBuckets() work, giBackgroundThreadCount threads plus the caller
+inline common::WorkerPool* gpWorkerPool = nullptr;
+// Set while common::kbVerifyFrame runs a tick a second time with the update lists on the calling thread, see UpdateFrameBase()
+inline thread_local bool gbSerialUpdateLists = false;
 
 // Can be used by frame update to decide what is visible to the player
 constexpr float kfVisibleXAdjust = 0.0f;
@@ -84,9 +88,18 @@ inline float VisibleDistance(DirectX::XMFLOAT4 f4Distances)
 bool XM_CALLCONV InsideVisibleArea(const game::FrameInput& rFrameInput, DirectX::FXMVECTOR vecPosition, float fAdjustLeft = kfVisibleXAdjust, float fAdjustRight = kfVisibleXAdjust, float fAdjustTop = kfVisibleYAdjustTop, float fAdjustBottom = kfVisibleYAdjustBottom);
 bool XM_CALLCONV OutsideVisibleArea(const game::FrameInput& rFrameInput, DirectX::FXMVECTOR vecPosition, float fAdjustLeft = kfVisibleXAdjust, float fAdjustRight = kfVisibleXAdjust, float fAdjustTop = kfVisibleYAdjustTop, float fAdjustBottom = kfVisibleYAdjustBottom);
 
+// Subsystem part of a common::RandomStream key, the game adds its own starting at kRandomGameFirst
+enum RandomSubsystem : uint32_t
+{
+	kRandomExplosions = 0,
+	kRandomSplashes   = 1,
+
+	kRandomGameFirst  = 1024,
+};
+
 struct alignas(64) FrameBase
 {
-	static constexpr int64_t kiVersion = 5 + kiBillboardsVersion + kiExplosionsVersion + kiHexShieldsVersion + kiLightingVersion + kiNavmeshVersion + kiSoundsVersion + kiSmokeVersion + kiPullersVersion + kiPushersVersion + kiTargetsVersion + kiSplashesVersion;
+	static constexpr int64_t kiVersion = 6 + kiBillboardsVersion + kiExplosionsVersion + kiHexShieldsVersion + kiLightingVersion + kiNavmeshVersion + kiSoundsVersion + kiSmokeVersion + kiPullersVersion + kiPushersVersion + kiTargetsVersion + kiSplashesVersion;
 
 	// Global
 	int64_t iFrame = 0;
@@ -100,6 +113,7 @@ struct alignas(64) FrameBase
 	alignas(64) Navmesh navmesh {};
 
 	// Objects in a pool don't destroy themselves and the responsibility is on the owner to Remove() them (Controllers can optionally destroy themselves)
+	// Areas, pullers, sounds and splashes have no interpolated state and are not copied into kMain frames, read them from the kFull frame instead
 	alignas(64) Areas enemyAreas {};
 	alignas(64) Areas playerAreas {};
 	alignas(64) AreaLights areaLights {};
@@ -130,6 +144,15 @@ protected:
 	FrameBase() = default;
 };
 static_assert(std::is_trivially_copyable_v<FrameBase>);
+
+// Keyed by the tick so a replay draws the same values, streams never touch randomEngine so they can be used inside Multithread<> buckets without kAccessRandom
+inline common::RandomStream FrameRandomStream(const FrameBase& rFrame, uint32_t uiSubsystem, uint64_t uiEntity)
+{
+	return common::RandomStream(static_cast<uint64_t>(rFrame.iFrame), uiSubsystem, uiEntity);
+}
+// Hashes the engine members under the FrameAccess bits in uiAccess, game::Frame::HashAccess() adds the game's
+void HashAccess(const FrameBase& rFrame, uint64_t uiAccess, access_hashes_t& rHashes);
+
 #define UPDATE_LIST_BASE &rFrame.billboards, &rFrame.hexShields
 
 void UpdateFrameBase(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFrame, const game::FrameInput& __restrict rFrameInput, float fDeltaTime, FrameType eFrameType);
@@ -140,36 +163,23 @@ void Multithread(game::Frame& __restrict rFrame, const game::Frame& __restrict r
 	int64_t iBuckets = static_cast<int64_t>(std::round(static_cast<float>(iCount) / static_cast<float>(BUCKET_SIZE)));
 	iBuckets = std::min(iBuckets, giBackgroundThreadCount + 1);
 	int64_t iBucketSize = static_cast<int64_t>(static_cast<float>(iCount) / static_cast<float>(iBuckets));
-	int64_t iLeft = iCount;
-
 	SCOPED_CPU_PROFILE_MULTITHREADED(eCpuTimer, iBuckets);
 
 	if (iBuckets > 1)
 	{
-		++giMultithreading;
-
-		std::vector<std::future<void>> futures(iBuckets - 1);
-		int64_t iPos = 0;
-		for (int64_t i = 0; i < iBuckets - 1; ++i)
+		// The last bucket takes what's left
+		gpWorkerPool->Run(iBuckets, [&](int64_t iBucket)
 		{
-			int64_t iBucketCount = std::min(iLeft, iBucketSize);
-			futures[i] = std::async(std::launch::async, [fDeltaTime, &rFrame, &rPreviousFrame, &rFrameInput, iPos, iBucketCount, pFunction]()
-			{
-				pFunction(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, iPos, iPos + iBucketCount);
-			});
-
-			iPos += iBucketCount;
-			iLeft -= iBucketCount;
-		}
-
-		pFunction(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, iPos, iPos + iLeft);
-		common::WaitAll(futures);
-
-		--giMultithreading;
+			int64_t iPos = iBucket * iBucketSize;
+			int64_t iEnd = iBucket == iBuckets - 1 ? iCount : iPos + iBucketSize;
+			++giMultithreading;
+			pFunction(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, iPos, iEnd);
+			--giMultithreading;
+		});
 	}
 	else
 	{
-		pFunction(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, 0, iLeft);
+		pFunction(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, 0, iCount);
 	}
 }
 
@@ -184,22 +194,23 @@ void a(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFr
 	} \
 }
 
-#define UPDATE_LIST_FUNCTION(a, b) \
-template <class T, class... Ts> \
-void a(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFrame, const game::FrameInput& __restrict rFrameInput, float fDeltaTime, [[maybe_unused]] T* pCurrentT, const Ts&... nextTs) \
+using update_function_t = phase_function_t<game::Frame, game::FrameInput>;
+
+#define SCHEDULED_UPDATE_LIST_FUNCTION(a, b) \
+template <class... Ts> \
+void a(game::Frame& __restrict rFrame, const game::Frame& __restrict rPreviousFrame, const game::FrameInput& __restrict rFrameInput, float fDeltaTime, [[maybe_unused]] Ts*... pTs) \
 { \
-	T::b(rFrame, rPreviousFrame, rFrameInput, fDeltaTime); \
-	if constexpr (sizeof...(nextTs) > 0) \
-	{ \
-		a(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, nextTs...); \
-	} \
+	static constexpr std::array<update_function_t, sizeof...(Ts)> kpFunctions {&Ts::b...}; \
+	static constexpr std::array<PhaseAccess, sizeof...(Ts)> kAccesses {Ts::k##b##Access...}; \
+	static constexpr std::array<int64_t, sizeof...(Ts)> kLevels = UpdateListLevels(kAccesses); \
+	RunUpdateListLevels(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, kpFunctions, kAccesses, kLevels, giBackgroundThreadCount > 0 && !gbSerialUpdateLists ? gpWorkerPool : nullptr); \
 }
 
 INTERPOLATE_LIST_FUNCTION(GlobalList, Global)
 INTERPOLATE_LIST_FUNCTION(InterpolateList, Interpolate)
-UPDATE_LIST_FUNCTION(PostRenderList, PostRender)
-UPDATE_LIST_FUNCTION(SpawnList, Spawn)
-UPDATE_LIST_FUNCTION(CollideList, Collide)
-UPDATE_LIST_FUNCTION(DestroyList, Destroy)
+SCHEDULED_UPDATE_LIST_FUNCTION(PostRenderList, PostRender)
+SCHEDULED_UPDATE_LIST_FUNCTION(SpawnList, Spawn)
+SCHEDULED_UPDATE_LIST_FUNCTION(CollideList, Collide)
+SCHEDULED_UPDATE_LIST_FUNCTION(DestroyList, Destroy)
 
 }
@@ -0,0 +1,145 @@
+#include "BillboardProjection.h"
+
+#include "MathUtils.h"
+
+using namespace DirectX;
+
+namespace engine
+{
+
+int64_t XM_CALLCONV ProjectBillboard(ProjectedBillboard* __restrict pLayouts, const BillboardsSoA& rBillboards, int64_t i, FXMMATRIX matViewProjection, float fAspectRatio)
+{
+	bool bOffscreenOnly = rBillboards.puiOffscreenOnly[i] != 0;
+	float fExtra = rBillboards.pfExtras[i];
+
+	XMFLOAT4A f4Position {0.0f, 0.0f, 0.0f, 1.0f};
+	XMStoreFloat4A(&f4Position, XMVector4Transform(rBillboards.pVecPositions[i], matViewProjection));
+	f4Position.x /= f4Position.w;
+	f4Position.y /= f4Position.w;
+	f4Position.z /= f4Position.w;
+	f4Position.w /= f4Position.w;
+
+	if (bOffscreenOnly && !(f4Position.x < -1.0f - fExtra || f4Position.x > 1.0f + fExtra || f4Position.y > 1.0f + fExtra || f4Position.y < -1.0f - fExtra))
+	{
+		return 0;
+	}
+
+	float fSize = rBillboards.pfSizes[i];
+	if (bOffscreenOnly)
+	{
+		f4Position.x = std::clamp(f4Position.x, -1.0f + fSize / fAspectRatio, 1.0f - fSize / fAspectRatio);
+		f4Position.y = std::clamp(f4Position.y, -1.0f + fSize, 1.0f - fSize);
+	}
+
+	float fRotation = rBillboards.pfRotations[i];
+	if (rBillboards.puiOffscreenRotate[i] != 0)
+	{
+		fRotation = XM_PI + XM_PIDIV2 + common::RotationFromPosition(XMVector3Normalize(XMLoadFloat4A(&f4Position)));
+		if (f4Position.y > 0.0f)
+		{
+			fRotation = XM_PI - fRotation;
+		}
+	}
+
+	pLayouts[0].f4Position = f4Position;
+	pLayouts[0].f4Misc = {fSize, rBillboards.pfTextureIndices[i], fRotation, rBillboards.pfAlphas[i]};
+
+	return 1;
+}
+
+int64_t XM_CALLCONV ProjectBillboards(ProjectedBillboard* __restrict pLayouts, const BillboardsSoA& rBillboards, int64_t iCount, FXMMATRIX matViewProjection, float fAspectRatio)
+{
+	// Each column of the view projection splatted, so a row of the transposed positions can be multiplied by one element at a time
+	auto matColumns = XMMatrixTranspose(matViewProjection);
+	XMVECTOR pVecElements[4][4] {};
+	for (int64_t i = 0; i < 4; ++i)
+	{
+		pVecElements[i][0] = XMVectorSplatX(matColumns.r[i]);
+		pVecElements[i][1] = XMVectorSplatY(matColumns.r[i]);
+		pVecElements[i][2] = XMVectorSplatZ(matColumns.r[i]);
+		pVecElements[i][3] = XMVectorSplatW(matColumns.r[i]);
+	}
+
+	auto vecOne = XMVectorSplatOne();
+	auto vecMinusOne = XMVectorNegate(vecOne);
+	auto vecZero = XMVectorZero();
+	auto vecAspectRatio = XMVectorReplicate(fAspectRatio);
+	auto vecRotationBase = XMVectorReplicate(XM_PI + XM_PIDIV2);
+	auto vecPi = XMVectorReplicate(XM_PI);
+
+	// Same steps as ProjectBillboard() for four billboards at once, the offscreen clamp and rotation are computed for all of them and selected by the flag masks
+	int64_t iRendered = 0;
+	int64_t i = 0;
+	for (; i + 4 <= iCount; i += 4)
+	{
+		auto matPositions = XMMatrixTranspose(XMMATRIX(rBillboards.pVecPositions[i], rBillboards.pVecPositions[i + 1], rBillboards.pVecPositions[i + 2], rBillboards.pVecPositions[i + 3]));
+
+		// Accumulated in the same order as XMVector4Transform()
+		XMVECTOR pVecProjected[4] {};
+		for (int64_t j = 0; j < 4; ++j)
+		{
+			pVecProjected[j] = XMVectorMultiply(matPositions.r[3], pVecElements[j][3]);
+			pVecProjected[j] = XMVectorMultiplyAdd(matPositions.r[2], pVecElements[j][2], pVecProjected[j]);
+			pVecProjected[j] = XMVectorMultiplyAdd(matPositions.r[1], pVecElements[j][1], pVecProjected[j]);
+			pVecProjected[j] = XMVectorMultiplyAdd(matPositions.r[0], pVecElements[j][0], pVecProjected[j]);
+		}
+
+		auto vecX = XMVectorDivide(pVecProjected[0], pVecProjected[3]);
+		auto vecY = XMVectorDivide(pVecProjected[1], pVecProjected[3]);
+		auto vecZ = XMVectorDivide(pVecProjected[2], pVecProjected[3]);
+		auto vecW = XMVectorDivide(pVecProjected[3], pVecProjected[3]);
+
+		auto vecOffscreenOnly = XMLoadInt4(&rBillboards.puiOffscreenOnly[i]);
+		auto vecOffscreenRotate = XMLoadInt4(&rBillboards.puiOffscreenRotate[i]);
+		auto vecExtra = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&rBillboards.pfExtras[i]));
+		auto vecSize = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&rBillboards.pfSizes[i]));
+
+		// Offscreen only billboards that are on screen are culled
+		auto vecMin = XMVectorSubtract(vecMinusOne, vecExtra);
+		auto vecMax = XMVectorAdd(vecOne, vecExtra);
+		auto vecOutsideX = XMVectorOrInt(XMVectorLess(vecX, vecMin), XMVectorGreater(vecX, vecMax));
+		auto vecOutsideY = XMVectorOrInt(XMVectorGreater(vecY, vecMax), XMVectorLess(vecY, vecMin));
+		auto vecCulled = XMVectorAndCInt(vecOffscreenOnly, XMVectorOrInt(vecOutsideX, vecOutsideY));
+
+		// std::clamp() picks the low bound first, so the low select goes last
+		auto vecSizeX = XMVectorDivide(vecSize, vecAspectRatio);
+		auto vecMinX = XMVectorAdd(vecMinusOne, vecSizeX);
+		auto vecMaxX = XMVectorSubtract(vecOne, vecSizeX);
+		auto vecMinY = XMVectorAdd(vecMinusOne, vecSize);
+		auto vecMaxY = XMVectorSubtract(vecOne, vecSize);
+		auto vecClampedX = XMVectorSelect(vecX, vecMaxX, XMVectorLess(vecMaxX, vecX));
+		vecClampedX = XMVectorSelect(vecClampedX, vecMinX, XMVectorLess(vecX, vecMinX));
+		auto vecClampedY = XMVectorSelect(vecY, vecMaxY, XMVectorLess(vecMaxY, vecY));
+		vecClampedY = XMVectorSelect(vecClampedY, vecMinY, XMVectorLess(vecY, vecMinY));
+		vecX = XMVectorSelect(vecX, vecClampedX, vecOffscreenOnly);
+		vecY = XMVectorSelect(vecY, vecClampedY, vecOffscreenOnly);
+
+		auto vecRotation = XMVectorAdd(vecRotationBase, common::RotationsFromPositions(vecX, vecY, vecZ));
+		vecRotation = XMVectorSelect(vecRotation, XMVectorSubtract(vecPi, vecRotation), XMVectorGreater(vecY, vecZero));
+		vecRotation = XMVectorSelect(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&rBillboards.pfRotations[i])), vecRotation, vecOffscreenRotate);
+
+		auto matLayoutPositions = XMMatrixTranspose(XMMATRIX(vecX, vecY, vecZ, vecW));
+		auto matLayoutMiscs = XMMatrixTranspose(XMMATRIX(vecSize, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&rBillboards.pfTextureIndices[i])), vecRotation, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&rBillboards.pfAlphas[i]))));
+
+		XMUINT4 ui4Culled {};
+		XMStoreUInt4(&ui4Culled, vecCulled);
+		const uint32_t puiCulled[4] = {ui4Culled.x, ui4Culled.y, ui4Culled.z, ui4Culled.w};
+
+		// Every billboard is written to the next free slot and the slot is only kept if it wasn't culled, the slot is never past the billboard's own index
+		for (int64_t j = 0; j < 4; ++j)
+		{
+			XMStoreFloat4(&pLayouts[iRendered].f4Position, matLayoutPositions.r[j]);
+			XMStoreFloat4(&pLayouts[iRendered].f4Misc, matLayoutMiscs.r[j]);
+			iRendered += puiCulled[j] == 0 ? 1 : 0;
+		}
+	}
+
+	for (; i < iCount; ++i)
+	{
+		iRendered += ProjectBillboard(pLayouts + iRendered, rBillboards, i, matViewProjection, fAspectRatio);
+	}
+
+	return iRendered;
+}
+
+} // namespace engine
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace engine
+{
+
+// The used billboards of a frame gathered into arrays, so they can be projected four at a time
+// The flag masks have all bits set when the flag is set, so they can be used as selects directly
+struct BillboardsSoA
+{
+	DirectX::XMVECTOR* __restrict pVecPositions = nullptr;
+	float* __restrict pfSizes = nullptr;
+	float* __restrict pfExtras = nullptr;
+	float* __restrict pfRotations = nullptr;
+	float* __restrict pfAlphas = nullptr;
+	float* __restrict pfTextureIndices = nullptr;
+	uint32_t* __restrict puiOffscreenOnly = nullptr;
+	uint32_t* __restrict puiOffscreenRotate = nullptr;
+};
+
+// Same layout as shaders::BillboardLayout, which can't be included without the engine's Vulkan setup, Billboards.cpp checks that they match
+struct ProjectedBillboard
+{
+	DirectX::XMFLOAT4 f4Position {};
+	DirectX::XMFLOAT4 f4Misc {};
+};
+
+// Pure CPU stages of Billboards::RenderMain(), both write the layout of a billboard that is drawn to the next free slot and return how many were written
+// ProjectBillboard() is the scalar version that ProjectBillboards() uses for what is left over after the batches of four
+int64_t XM_CALLCONV ProjectBillboard(ProjectedBillboard* __restrict pLayouts, const BillboardsSoA& rBillboards, int64_t i, DirectX::FXMMATRIX matViewProjection, float fAspectRatio);
+int64_t XM_CALLCONV ProjectBillboards(ProjectedBillboard* __restrict pLayouts, const BillboardsSoA& rBillboards, int64_t iCount, DirectX::FXMMATRIX matViewProjection, float fAspectRatio);
+
+} // namespace engine
@@ -1,6 +1,7 @@
 #include "Billboards.h"
 
 #include "Frame/Render.h"
+#include "Frame/Pools/BillboardProjection.h"
 #include "Graphics/Managers/BufferManager.h"
 #include "Graphics/Managers/SwapchainManager.h"
 #include "Graphics/Managers/TextureManager.h"
@@ -14,14 +15,31 @@ namespace engine
 
 using enum BillboardFlags;
 
+static_assert(sizeof(ProjectedBillboard) == sizeof(shaders::BillboardLayout));
+static_assert(offsetof(ProjectedBillboard, f4Position) == offsetof(shaders::BillboardLayout, f4Position));
+static_assert(offsetof(ProjectedBillboard, f4Misc) == offsetof(shaders::BillboardLayout, f4Misc));
+
 void Billboards::RenderMain([[maybe_unused]] int64_t iCommandBuffer, [[maybe_unused]] const game::Frame& __restrict rFrame)
 {
 	const Billboards& rCurrent = rFrame.billboards;
 
-	auto pLayouts = reinterpret_cast<shaders::BillboardLayout*>(gpBufferManager->mBillboardsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
+	auto pLayouts = reinterpret_cast<ProjectedBillboard*>(gpBufferManager->mBillboardsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
+
+	// Gather the used billboards into arrays, the positions go first in the workbuffer so they stay aligned
+	int64_t iMaxCount = static_cast<int64_t>(rCurrent.uiMaxIndex) + 1;
+	auto pWorkbuffer = common::gpThreadLocal->GetWorkbuffer<uint8_t*>(iMaxCount * (sizeof(XMVECTOR) + 5 * sizeof(float) + 2 * sizeof(uint32_t)));
+
+	BillboardsSoA billboards;
+	billboards.pVecPositions = reinterpret_cast<XMVECTOR*>(pWorkbuffer);
+	billboards.pfSizes = reinterpret_cast<float*>(billboards.pVecPositions + iMaxCount);
+	billboards.pfExtras = billboards.pfSizes + iMaxCount;
+	billboards.pfRotations = billboards.pfExtras + iMaxCount;
+	billboards.pfAlphas = billboards.pfRotations + iMaxCount;
+	billboards.pfTextureIndices = billboards.pfAlphas + iMaxCount;
+	billboards.puiOffscreenOnly = reinterpret_cast<uint32_t*>(billboards.pfTextureIndices + iMaxCount);
+	billboards.puiOffscreenRotate = billboards.puiOffscreenOnly + iMaxCount;
 
 	int64_t iCount = 0;
-	int64_t iRendered = 0;
 	for (decltype(rCurrent.uiMaxIndex) i = 0; i <= rCurrent.uiMaxIndex; ++i)
 	{
 		if (!rCurrent.pbUsed[i])
@@ -30,49 +48,20 @@ void Billboards::RenderMain([[maybe_unused]] int64_t iCommandBuffer, [[maybe_unu
 		}
 
 		const BillboardInfo& rBillboardInfo = rCurrent.pObjectInfos[i];
-		
-		++iCount;
-
-		auto vecPosition = rBillboardInfo.vecPosition;
-
-		auto vecProjection = XMVector4Transform(vecPosition, XMMatrixMultiply(gMatView, gMatPerspective));
-
-		XMFLOAT4A f4Position {0.0f, 0.0f, 0.0f, 1.0f};
-		XMStoreFloat4A(&f4Position, vecProjection);
-		f4Position.x /= f4Position.w;
-		f4Position.y /= f4Position.w;
-		f4Position.z /= f4Position.w;
-		f4Position.w /= f4Position.w;
-
-		if (rBillboardInfo.flags & kOffscreenOnly && !(f4Position.x < -1.0f - rBillboardInfo.fExtra || f4Position.x > 1.0f + rBillboardInfo.fExtra || f4Position.y > 1.0f + rBillboardInfo.fExtra || f4Position.y < -1.0f - rBillboardInfo.fExtra))
-		{
-			continue;
-		}
 
-		float fSize = rBillboardInfo.fSize;
-		
-		if (rBillboardInfo.flags & kOffscreenOnly)
-		{
-			f4Position.x = std::clamp(f4Position.x, -1.0f + fSize / gpSwapchainManager->mfAspectRatio, 1.0f - fSize / gpSwapchainManager->mfAspectRatio);
-			f4Position.y = std::clamp(f4Position.y, -1.0f + fSize, 1.0f - fSize);
-		}
+		billboards.pVecPositions[iCount] = rBillboardInfo.vecPosition;
+		billboards.pfSizes[iCount] = rBillboardInfo.fSize;
+		billboards.pfExtras[iCount] = rBillboardInfo.fExtra;
+		billboards.pfRotations[iCount] = rBillboardInfo.fRotation;
+		billboards.pfAlphas[iCount] = rBillboardInfo.fAlpha;
+		billboards.pfTextureIndices[iCount] = CrcToIndex(rBillboardInfo.crc);
+		billboards.puiOffscreenOnly[iCount] = rBillboardInfo.flags & kOffscreenOnly ? 0xFFFFFFFF : 0;
+		billboards.puiOffscreenRotate[iCount] = rBillboardInfo.flags & kOffscreenRotate ? 0xFFFFFFFF : 0;
 
-		float fRotation = rBillboardInfo.fRotation;
-		if (rBillboardInfo.flags & kOffscreenRotate)
-		{
-			fRotation = XM_PI + XM_PIDIV2 + common::RotationFromPosition(XMVector3Normalize(XMLoadFloat4A(&f4Position)));
-			if (f4Position.y > 0.0f)
-			{
-				fRotation = XM_PI - fRotation;
-			}
-		}
-			
-		shaders::BillboardLayout& rBillboardLayout = pLayouts[iRendered];
-		rBillboardLayout.f4Position = f4Position;
-		rBillboardLayout.f4Misc = {fSize, CrcToIndex(rBillboardInfo.crc), fRotation, rBillboardInfo.fAlpha};
-
-		++iRendered;
+		++iCount;
 	}
+
+	int64_t iRendered = ProjectBillboards(pLayouts, billboards, iCount, XMMatrixMultiply(gMatView, gMatPerspective), gpSwapchainManager->mfAspectRatio);
 	PROFILE_SET_COUNT(kCpuCounterBillboards, iCount);
 	PROFILE_SET_COUNT(kCpuCounterBillboardsRendered, iRendered);
 
@@ -68,8 +68,10 @@ constexpr float kfParticleIntensityPower = 2.5f;
 constexpr float kfParticleLightingSize = 10.0f;
 constexpr float kfParticleLightingIntesnity = 400.0f;
 
-void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplosionInfo, Explosion& rExplosion)
+void Explosions::SetupExplosion(game::Frame& rFrame, explosion_t uiIndex, const ExplosionInfo& rExplosionInfo, Explosion& rExplosion)
 {
+	common::RandomStream randomStream = FrameRandomStream(rFrame, kRandomExplosions, uiIndex);
+
 	rExplosion.fStartTime = rFrame.fCurrentTime;
 
 	float fLightPercent = rExplosionInfo.fLightPercent;
@@ -80,7 +82,7 @@ void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplo
 	// Primary explosion
 	uint32_t uiExplosionColor = 0xFFFFFFFF;
 
-	float fPrimaryRotation = common::Random<XM_2PI>(rFrame.randomEngine);
+	float fPrimaryRotation = common::Random<XM_2PI>(randomStream);
 
 	rFrame.pointLightControllers3.Add(rFrame.pointLights, rFrame.fCurrentTime,
 	{
@@ -114,20 +116,20 @@ void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplo
 	});
 
 	// Secondary explosions
-	int64_t kiSecondaryExplosions = 4; // + static_cast<int64_t>(common::Random<4.0f>(rFrame.randomEngine));
+	int64_t kiSecondaryExplosions = 4; // + static_cast<int64_t>(common::Random<4.0f>(randomStream));
 	float kfSecondaryExplosions = static_cast<float>(kiSecondaryExplosions);
 
 	float fDelayDelta = (0.75f * fTimePercent * kfPrimaryTime) / kfSecondaryExplosions;
 	float fDelay = fDelayDelta;
 	for (int64_t i = 0; i < kiSecondaryExplosions; ++i, fDelay += fDelayDelta)
 	{
-		auto vecSecondaryExplosionPosition = XMVector3Rotate(XMVectorSet(kfSecondaryPositionMin + std::pow(fSizePercent, 1.5f) * common::Random<kfSecondaryPositionJitter>(rFrame.randomEngine), 0.0f, 0.0f, 0.0f), XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, common::Random<XM_2PI>(rFrame.randomEngine)));
+		auto vecSecondaryExplosionPosition = XMVector3Rotate(XMVectorSet(kfSecondaryPositionMin + std::pow(fSizePercent, 1.5f) * common::Random<kfSecondaryPositionJitter>(randomStream), 0.0f, 0.0f, 0.0f), XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, common::Random<XM_2PI>(randomStream)));
 		vecSecondaryExplosionPosition = XMVectorAdd(vecSecondaryExplosionPosition, rExplosionInfo.vecPosition);
 
 		uiExplosionColor = 0x000000FF;
-		uiExplosionColor |= ((100 + common::Random(155, rFrame.randomEngine)) << 24) | ((55 + common::Random(200, rFrame.randomEngine)) << 16) | ((55 + common::Random(200, rFrame.randomEngine)) << 8) | (55 + common::Random(200, rFrame.randomEngine));
+		uiExplosionColor |= ((100 + common::Random(155, randomStream)) << 24) | ((55 + common::Random(200, randomStream)) << 16) | ((55 + common::Random(200, randomStream)) << 8) | (55 + common::Random(200, randomStream));
 
-		float fSecondaryLightSize = (0.25f + common::Random<0.5f>(rFrame.randomEngine)) * fSizePercent * kfSecondaryVisibleSize;
+		float fSecondaryLightSize = (0.25f + common::Random<0.5f>(randomStream)) * fSizePercent * kfSecondaryVisibleSize;
 		rFrame.pointLightControllers3.Add(rFrame.pointLights, rFrame.fCurrentTime,
 		{
 			.bDestroysSelf = true,
@@ -135,7 +137,7 @@ void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplo
 			{
 				fDelay + 0.0f,
 				fDelay + 1.0f * kfPrimaryTime,
-				fDelay + 1.0f * kfPrimaryTime + 1.0f * kfPrimaryTime + common::Random<2.0f>(rFrame.randomEngine) * kfPrimaryTime,
+				fDelay + 1.0f * kfPrimaryTime + 1.0f * kfPrimaryTime + common::Random<2.0f>(randomStream) * kfPrimaryTime,
 			},
 			.pObjectInfos =
 			{
@@ -145,7 +147,7 @@ void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplo
 			},
 		});
 
-		float fSecondaryPuffSize = (0.25f + common::Random<0.5f>(rFrame.randomEngine)) * fSizePercent * kfPrimaryPuffSize;
+		float fSecondaryPuffSize = (0.25f + common::Random<0.5f>(randomStream)) * fSizePercent * kfPrimaryPuffSize;
 		rFrame.puffControllers2.Add(rFrame.puffs, rFrame.fCurrentTime,
 		{
 			.bDestroysSelf = true,
@@ -169,18 +171,18 @@ void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplo
 	{
 		rExplosion.pTrails[i] = 0;
 				
-		rExplosion.pfTrailTimes[i] = fTimePercent * (kfTrailTimeMin + common::Random<kfTrailTimeRandom>(rFrame.randomEngine));
+		rExplosion.pfTrailTimes[i] = fTimePercent * (kfTrailTimeMin + common::Random<kfTrailTimeRandom>(randomStream));
 
-		rExplosion.pfTrailIntensities[i] = fSmokePercent * (kfTrailIntensityMin + common::Random<kfTrailIntensityRandom>(rFrame.randomEngine));
+		rExplosion.pfTrailIntensities[i] = fSmokePercent * (kfTrailIntensityMin + common::Random<kfTrailIntensityRandom>(randomStream));
 
 		auto vecDirection = vecDirection2dNormal;
 		if (i != 0)
 		{
 			float fTrailAngle = rExplosionInfo.fTrailAngle;
-			vecDirection = XMVector3Rotate(vecDirection, XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, fTrailAngle * common::Random(rFrame.randomEngine)));
+			vecDirection = XMVector3Rotate(vecDirection, XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, fTrailAngle * common::Random(randomStream)));
 		}
 		rExplosion.pVecTrailStartPositions[i] = XMVectorMultiplyAdd(vecDirection, XMVectorReplicate(kfTrailStart), rExplosionInfo.vecPosition);
-		rExplosion.pVecTrailEndPositions[i] = XMVectorMultiplyAdd(vecDirection, XMVectorReplicate(kfTrailLengthMin + kfTrailLengthRandom * common::Random(rFrame.randomEngine)), rExplosionInfo.vecPosition);
+		rExplosion.pVecTrailEndPositions[i] = XMVectorMultiplyAdd(vecDirection, XMVectorReplicate(kfTrailLengthMin + kfTrailLengthRandom * common::Random(randomStream)), rExplosionInfo.vecPosition);
 
 		rFrame.trails.Add(rExplosion.pTrails[i], rFrame.fCurrentTime,
 		{
@@ -196,31 +198,31 @@ void Explosions::SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplo
 		float fParticleAngle = rExplosionInfo.fParticleAngle;
 
 		auto vecPosition = rExplosionInfo.vecPosition;
-		vecPosition = XMVectorAdd(vecPosition, XMVectorSet(-kfParticlePositionJitter + common::Random<2.0f * kfParticlePositionJitter>(rFrame.randomEngine), -kfParticlePositionJitter + common::Random<2.0f * kfParticlePositionJitter>(rFrame.randomEngine), 0.0f, 0.0f));
+		vecPosition = XMVectorAdd(vecPosition, XMVectorSet(-kfParticlePositionJitter + common::Random<2.0f * kfParticlePositionJitter>(randomStream), -kfParticlePositionJitter + common::Random<2.0f * kfParticlePositionJitter>(randomStream), 0.0f, 0.0f));
 		XMFLOAT4A f4Position {};
 		XMStoreFloat4A(&f4Position, vecPosition);
 
-		auto vecVelocity = XMVectorMultiply(XMVectorReplicate(kfParticleVelocityMin + common::Random<kfParticleVelocityRandom>(rFrame.randomEngine)), vecDirection2dNormal);
-		vecVelocity = XMVector3Rotate(vecVelocity, XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, -0.5f * fParticleAngle + fParticleAngle * common::Random(rFrame.randomEngine)));
-		vecVelocity = XMVectorSetZ(vecVelocity, common::Random<kfParticleVerticalVelocity>(rFrame.randomEngine));
+		auto vecVelocity = XMVectorMultiply(XMVectorReplicate(kfParticleVelocityMin + common::Random<kfParticleVelocityRandom>(randomStream)), vecDirection2dNormal);
+		vecVelocity = XMVector3Rotate(vecVelocity, XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, -0.5f * fParticleAngle + fParticleAngle * common::Random(randomStream)));
+		vecVelocity = XMVectorSetZ(vecVelocity, common::Random<kfParticleVerticalVelocity>(randomStream));
 		XMFLOAT4A f4Velocity {};
 		XMStoreFloat4A(&f4Velocity, vecVelocity);
 
 		uint32_t uiParticleColor = 0xFF0000FF;
 		if (rExplosionInfo.flags & kYellow)
 		{
-			uiParticleColor |= ((100 + common::Random(25, rFrame.randomEngine)) << 16) | ((common::Random(25, rFrame.randomEngine)) << 8);
+			uiParticleColor |= ((100 + common::Random(25, randomStream)) << 16) | ((common::Random(25, randomStream)) << 8);
 		}
 		else if (rExplosionInfo.flags & kRed)
 		{
-			uiParticleColor |= ((50 + common::Random(25, rFrame.randomEngine)) << 16) | ((common::Random(25, rFrame.randomEngine)) << 8);
+			uiParticleColor |= ((50 + common::Random(25, randomStream)) << 16) | ((common::Random(25, randomStream)) << 8);
 		}
 
 		ParticleManager::Spawn(gpParticleManager->mLongParticlesSpawnLayout,
 		{
 			.i4Misc = {static_cast<int32_t>(uiParticleColor), kiParticleCookie, static_cast<int32_t>(kfParticleLightingIntesnity), 0},
 			.f4MiscOne = {kfParticleVelocityDecay, kfParticleGravity, kfParticleIntensityDecay, kfParticleLightingSize},
-			.f4MiscTwo = {kfParticleWidth, kfParticleLength, kfParticleIntensityMin + common::Random<kfParticleIntensityRandom>(rFrame.randomEngine), kfParticleIntensityPower},
+			.f4MiscTwo = {kfParticleWidth, kfParticleLength, kfParticleIntensityMin + common::Random<kfParticleIntensityRandom>(randomStream), kfParticleIntensityPower},
 			.f4MiscThree = {},
 			.f4Position = f4Position,
 			.f4Velocity = f4Velocity,
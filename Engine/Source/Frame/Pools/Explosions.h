@@ -62,7 +62,7 @@ struct Explosion
 };
 struct Explosions : public ObjectPool<ExplosionInfo, Explosion, explosion_t, kuiMaxExplosions>
 {
-	void SetupExplosion(game::Frame& rFrame, const ExplosionInfo& rExplosionInfo, Explosion& rExplosion);
+	void SetupExplosion(game::Frame& rFrame, explosion_t uiIndex, const ExplosionInfo& rExplosionInfo, Explosion& rExplosion);
 
 	void Add(explosion_t& ruiIndex, game::Frame& rFrame, const ExplosionInfo& rExplosionInfo)
 	{
@@ -70,7 +70,7 @@ struct Explosions : public ObjectPool<ExplosionInfo, Explosion, explosion_t, kui
 
 		if (ruiIndex != 0)
 		{
-			SetupExplosion(rFrame, rExplosionInfo, Get(ruiIndex));
+			SetupExplosion(rFrame, ruiIndex, rExplosionInfo, Get(ruiIndex));
 		}
 	}
 
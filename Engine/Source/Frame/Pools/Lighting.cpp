@@ -1,6 +1,7 @@
 #include "Lighting.h"
 
 #include "Frame/Render.h"
+#include "Frame/Pools/RenderExtraction.h"
 #include "Graphics/Islands.h"
 #include "Graphics/Managers/BufferManager.h"
 #include "Graphics/Managers/PipelineManager.h"
@@ -24,6 +25,9 @@ XMVECTOR XM_CALLCONV DirectionToDirectionMultipliers(FXMVECTOR vecDirection)
 	return XMVectorSet(std::max(f4Direction.x, 0.0f), std::max(-f4Direction.x, 0.0f), std::max(f4Direction.y, 0.0f), std::max(-f4Direction.y, 0.0f));
 }
 
+static constexpr int64_t kiLightsBucketSize = 256;
+static constexpr int64_t kiLightsMaxBuckets = 64;
+
 void RenderLightingGlobal(int64_t iCommandBuffer)
 {
 	shaders::GlobalLayout& rGlobalLayout = *reinterpret_cast<shaders::GlobalLayout*>(&gpBufferManager->mGlobalLayoutUniformBuffers.at(iCommandBuffer).mpMappedMemory[0]);
@@ -108,137 +112,73 @@ void RenderLightingMain(int64_t iCommandBuffer, const game::Frame& __restrict rF
 	rMainLayout.fGltfLighting = gGltfLighting.Get();
 	rMainLayout.fGltfLightingPower = gGltfLightingPower.Get();
 
-	int64_t iLightCount = 0;
+	XMVECTOR vecEyePosition = rFrame.camera.vecEyePosition;
+	float fBaseHeight = gBaseHeight.Get();
 	auto pVisibleLightsLayouts = reinterpret_cast<shaders::VisibleLightQuadLayout*>(gpBufferManager->mVisibleLightsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
-	int64_t iVisibleLightsRendered = 0;
+	auto baseHeight = [vecEyePosition, fBaseHeight](XMVECTOR* pVecPositions, int64_t iCount)
+	{
+		BaseHeightPositions(pVecPositions, pVecPositions, iCount, vecEyePosition, fBaseHeight);
+	};
+	auto textureIndex = [](common::crc_t crc)
+	{
+		return CrcToIndex(crc);
+	};
+
+	// Area lights, see ExtractAreaLights()
+	int64_t iAreaLightCount = rFrame.areaLights.uiMaxIndex + 1;
+	auto pVecAreaPositions = common::gpThreadLocal->GetWorkbuffer<XMVECTOR*>(iAreaLightCount * (4 * sizeof(XMVECTOR) + sizeof(shaders::VisibleLightQuadLayout) + sizeof(shaders::QuadLayout) + sizeof(int64_t)));
+	auto pVisibleAreaLayouts = reinterpret_cast<shaders::VisibleLightQuadLayout*>(pVecAreaPositions + 4 * iAreaLightCount);
+	auto pAreaLayouts = reinterpret_cast<shaders::QuadLayout*>(pVisibleAreaLayouts + iAreaLightCount);
+	auto piAreaVisible = reinterpret_cast<int64_t*>(pAreaLayouts + iAreaLightCount);
+
+	int64_t piStarts[kiLightsMaxBuckets + 1] {};
+	int64_t piUsedCounts[kiLightsMaxBuckets] {};
+	int64_t piRenderedCounts[kiLightsMaxBuckets] {};
+	int64_t iBuckets = RenderBuckets<kiLightsBucketSize, kiLightsMaxBuckets>(piStarts, iAreaLightCount, [&](int64_t iBucket, int64_t iStart, int64_t iEnd)
+	{
+		std::tie(piUsedCounts[iBucket], piRenderedCounts[iBucket]) = ExtractAreaLights(pVisibleAreaLayouts + iStart, pAreaLayouts + iStart, piAreaVisible + iStart, pVecAreaPositions + 4 * iStart, iStart, iEnd, rFrame.areaLights, gf4RenderVisibleArea, baseHeight, textureIndex);
+	});
 
 	auto pAreaLightsLayouts = reinterpret_cast<shaders::QuadLayout*>(gpBufferManager->mAreaLightsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
+	int64_t iLightCount = 0;
 	int64_t iAreaLightsRendered = 0;
-	for (decltype(rFrame.areaLights.uiMaxIndex) i = 0; i <= rFrame.areaLights.uiMaxIndex; ++i)
+	for (int64_t i = 0; i < iBuckets; ++i)
 	{
-		if (!rFrame.areaLights.pbUsed[i])
-		{
-			continue;
-		}
-
-		const AreaLightInfo& rAreaLightInfo = rFrame.areaLights.pObjectInfos[i];
-
-		++iLightCount;
-
-		shaders::VisibleLightQuadLayout& rVisibleLightQuadLayout = pVisibleLightsLayouts[iVisibleLightsRendered];
-		shaders::QuadLayout& rAreaLightQuadLayout = pAreaLightsLayouts[iAreaLightsRendered];
-
-		bool bInVisibleArea = rAreaLightInfo.bAlwaysVisible;
-		for (int64_t j = 0; j < 4; ++j)
-		{
-			if (InVisibleArea(gf4RenderVisibleArea, rAreaLightInfo.pVecVisiblePositions[j]))
-			{
-				bInVisibleArea = true;
-			}
-
-			XMFLOAT4A f4Position {};
-			XMStoreFloat4A(&f4Position, rAreaLightInfo.pVecVisiblePositions[j]);
-			rVisibleLightQuadLayout.pf4Vertices[j] = f4Position;
-			rVisibleLightQuadLayout.pf4Texcoords[j] = {rAreaLightInfo.pf2Texcoords[j].x, rAreaLightInfo.pf2Texcoords[j].y, 0.0f, 0.0f};
-
-			float fElevation = gpIslands->GlobalElevation(rAreaLightInfo.pVecLightingPositions[j]);
-			auto vecBaseAreaPosition = common::ToBaseHeight(rAreaLightInfo.pVecLightingPositions[j], rFrame.camera.vecEyePosition, std::max(fElevation, gBaseHeight.Get()));
-			XMStoreFloat4A(&f4Position, vecBaseAreaPosition);
-			rAreaLightQuadLayout.pf4VerticesTexcoords[j] = {f4Position.x, f4Position.y, rAreaLightInfo.pf2Texcoords[j].x, rAreaLightInfo.pf2Texcoords[j].y};
-
-			rVisibleLightQuadLayout.puiColors[j] = rAreaLightInfo.puiColors[j];
-		}
-
-		if (!bInVisibleArea)
-		{
-			continue;
-		}
-
-		rVisibleLightQuadLayout.fIntensity = rAreaLightInfo.fVisibleIntensity;
-		rVisibleLightQuadLayout.fRotation = 0.0f;
-		rVisibleLightQuadLayout.uiTextureIndex = static_cast<uint32_t>(CrcToIndex(rAreaLightInfo.crc));
-
-		XMFLOAT4A f4Misc {};
-		f4Misc.x = CrcToIndex(rAreaLightInfo.crc);
-		f4Misc.y = rAreaLightInfo.fLightingIntensity;
-		rAreaLightQuadLayout.pf4Misc[0] = rAreaLightQuadLayout.pf4Misc[1] = rAreaLightQuadLayout.pf4Misc[2] = rAreaLightQuadLayout.pf4Misc[3] = f4Misc;
-		XMStoreFloat4(&rAreaLightQuadLayout.f4Misc, rAreaLightInfo.vecDirectionMultipliers);
-		rAreaLightQuadLayout.uiColor = rAreaLightInfo.puiColors[0];
-
-		++iVisibleLightsRendered;
-		++iAreaLightsRendered;
+		memcpy(&pVisibleLightsLayouts[iAreaLightsRendered], &pVisibleAreaLayouts[piStarts[i]], piRenderedCounts[i] * sizeof(shaders::VisibleLightQuadLayout));
+		memcpy(&pAreaLightsLayouts[iAreaLightsRendered], &pAreaLayouts[piStarts[i]], piRenderedCounts[i] * sizeof(shaders::QuadLayout));
+		iLightCount += piUsedCounts[i];
+		iAreaLightsRendered += piRenderedCounts[i];
 	}
 	PROFILE_SET_COUNT(kCpuCounterAreaLightsRendered, iAreaLightsRendered);
 	gpPipelineManager->mpPipelines[kPipelineAreaLights].WriteIndirectBuffer(iCommandBuffer, iAreaLightsRendered);
 
+	// Point lights, see ExtractPointLights(), the scratch memory is reused
+	int64_t iPointLightCount = rFrame.pointLights.uiMaxIndex + 1;
+	auto pVecPointPositions = common::gpThreadLocal->GetWorkbuffer<XMVECTOR*>(iPointLightCount * (sizeof(XMVECTOR) + sizeof(shaders::VisibleLightQuadLayout) + sizeof(shaders::AxisAlignedQuadLayout) + sizeof(int64_t)));
+	auto pVisiblePointLayouts = reinterpret_cast<shaders::VisibleLightQuadLayout*>(pVecPointPositions + iPointLightCount);
+	auto pPointLayouts = reinterpret_cast<shaders::AxisAlignedQuadLayout*>(pVisiblePointLayouts + iPointLightCount);
+	auto piPointVisible = reinterpret_cast<int64_t*>(pPointLayouts + iPointLightCount);
+
+	iBuckets = RenderBuckets<kiLightsBucketSize, kiLightsMaxBuckets>(piStarts, iPointLightCount, [&](int64_t iBucket, int64_t iStart, int64_t iEnd)
+	{
+		std::tie(piUsedCounts[iBucket], piRenderedCounts[iBucket]) = ExtractPointLights(pVisiblePointLayouts + iStart, pPointLayouts + iStart, piPointVisible + iStart, pVecPointPositions + iStart, iStart, iEnd, rFrame.pointLights, gf4RenderVisibleArea, baseHeight, textureIndex);
+	});
+
 	auto pPointLightsLayouts = reinterpret_cast<shaders::AxisAlignedQuadLayout*>(gpBufferManager->mPointLightsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
 	int64_t iPointLightsRendered = 0;
-	for (decltype(rFrame.pointLights.uiMaxIndex) i = 0; i <= rFrame.pointLights.uiMaxIndex; ++i)
+	for (int64_t i = 0; i < iBuckets; ++i)
 	{
-		if (!rFrame.pointLights.pbUsed[i])
-		{
-			continue;
-		}
-
-		const PointLightInfo& rPointLightInfo = rFrame.pointLights.pObjectInfos[i];
-		
-		++iLightCount;
-
-		XMFLOAT4A f4Position {};
-		XMStoreFloat4A(&f4Position, rPointLightInfo.vecPosition);
-		if (f4Position.x < gf4RenderVisibleArea.x || f4Position.x > gf4RenderVisibleArea.z || f4Position.y > gf4RenderVisibleArea.y || f4Position.y < gf4RenderVisibleArea.w)
-		{
-			continue;
-		}
-		
-		XMFLOAT4 f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
-
-		// Visible
-		XMStoreFloat4A(&f4Position, rPointLightInfo.vecPosition);
-
-		XMFLOAT4 f4VertexRect = {f4Position.x - rPointLightInfo.fVisibleArea, f4Position.y + rPointLightInfo.fVisibleArea, 2.0f * rPointLightInfo.fVisibleArea, -2.0f * rPointLightInfo.fVisibleArea};
-
-		shaders::VisibleLightQuadLayout& rVisibleLightQuadLayout = pVisibleLightsLayouts[iVisibleLightsRendered];
-		rVisibleLightQuadLayout.pf4Vertices[0] = {f4VertexRect.x, f4VertexRect.y, f4Position.z, 1.0f};
-		rVisibleLightQuadLayout.pf4Vertices[1] = {f4VertexRect.x + f4VertexRect.z, f4VertexRect.y, f4Position.z, 1.0f};
-		rVisibleLightQuadLayout.pf4Vertices[2] = {f4VertexRect.x, f4VertexRect.y + f4VertexRect.w, f4Position.z, 1.0f};
-		rVisibleLightQuadLayout.pf4Vertices[3] = {f4VertexRect.x + f4VertexRect.z, f4VertexRect.y + f4VertexRect.w, f4Position.z, 1.0f};
-		rVisibleLightQuadLayout.pf4Texcoords[0] = {0.0f, 0.0f, 0.0f, 0.0f};
-		rVisibleLightQuadLayout.pf4Texcoords[1] = {1.0f, 0.0f, 0.0f, 0.0f};
-		rVisibleLightQuadLayout.pf4Texcoords[2] = {0.0f, 1.0f, 0.0f, 0.0f};
-		rVisibleLightQuadLayout.pf4Texcoords[3] = {1.0f, 1.0f, 0.0f, 0.0f};
-		rVisibleLightQuadLayout.fIntensity = rPointLightInfo.fVisibleIntensity;
-		rVisibleLightQuadLayout.fRotation = rPointLightInfo.fRotation;
-		rVisibleLightQuadLayout.puiColors[0] = rVisibleLightQuadLayout.puiColors[1] = rVisibleLightQuadLayout.puiColors[2] = rPointLightInfo.uiColor;
-		rVisibleLightQuadLayout.uiTextureIndex = static_cast<uint32_t>(CrcToIndex(rPointLightInfo.crc));
-
-		// Lighting
-		float fElevation = gpIslands->GlobalElevation(rPointLightInfo.vecPosition);
-		auto vecBaseAreaPosition = common::ToBaseHeight(rPointLightInfo.vecPosition, rFrame.camera.vecEyePosition, std::max(fElevation, gBaseHeight.Get()));
-		XMStoreFloat4A(&f4Position, vecBaseAreaPosition);
-
-		XMFLOAT4A f4Misc {};
-		f4Misc.x = CrcToIndex(rPointLightInfo.crc);
-		f4Misc.y = rPointLightInfo.fLightingIntensity;
-		f4Misc.z = rPointLightInfo.fRotation;
-
-		f4VertexRect = {f4Position.x - rPointLightInfo.fLightingArea, f4Position.y + rPointLightInfo.fLightingArea, 2.0f * rPointLightInfo.fLightingArea, -2.0f * rPointLightInfo.fLightingArea};
-
-		shaders::AxisAlignedQuadLayout& rLightingQuadLayout = pPointLightsLayouts[iPointLightsRendered];
-		rLightingQuadLayout.f4VertexRect = f4VertexRect;
-		rLightingQuadLayout.f4TextureRect = f4TextureRect;
-		rLightingQuadLayout.f4Misc = f4Misc;
-		rLightingQuadLayout.uiColor = rPointLightInfo.uiColor;
-
-		++iVisibleLightsRendered;
-		++iPointLightsRendered;
+		memcpy(&pVisibleLightsLayouts[iAreaLightsRendered + iPointLightsRendered], &pVisiblePointLayouts[piStarts[i]], piRenderedCounts[i] * sizeof(shaders::VisibleLightQuadLayout));
+		memcpy(&pPointLightsLayouts[iPointLightsRendered], &pPointLayouts[piStarts[i]], piRenderedCounts[i] * sizeof(shaders::AxisAlignedQuadLayout));
+		iLightCount += piUsedCounts[i];
+		iPointLightsRendered += piRenderedCounts[i];
 	}
 	PROFILE_SET_COUNT(kCpuCounterPointLightsRendered, iPointLightsRendered);
 	gpPipelineManager->mpPipelines[kPipelinePointLights].WriteIndirectBuffer(iCommandBuffer, iPointLightsRendered);
 
 	PROFILE_SET_COUNT(kCpuCounterLights, iLightCount);
 
-	gpPipelineManager->mpPipelines[kPipelineVisibleLights].WriteIndirectBuffer(iCommandBuffer, iVisibleLightsRendered);
+	gpPipelineManager->mpPipelines[kPipelineVisibleLights].WriteIndirectBuffer(iCommandBuffer, iAreaLightsRendered + iPointLightsRendered);
 }
 
 } // namespace engine
@@ -21,6 +21,8 @@ struct ObjectController
 {
 	float fStartTime = 0.0f;
 	V objectIndex {};
+	// Keyframe the last UpdateMain() lerped towards, time only moves forward so the search starts there
+	uint8_t uiKeyframe = 1;
 
 	bool operator==(const ObjectController<V>& rOther) const = default;
 };
@@ -40,6 +42,31 @@ struct ObjectControllerPool : public ObjectPool<ObjectControllerInfo<POOL_T, CON
 
 	using OBJECT_POOL = ObjectPool<POOL_T, POOL_U, POOL_V, POOL_SIZE>;
 
+	static_assert(CONTROLLER_LERP_SIZE <= std::numeric_limits<decltype(CONTROLLER_U::uiKeyframe)>::max());
+
+	// Self destroying controllers are kept in a min-heap ordered by end time, so expiring them only touches the ones that expired
+	// Entries are not removed when a controller is, instead they are checked against the controller when they reach the top
+	// The old sweep freed expired slots in index order and the heap frees them by end time, replays still match because Remove() only clears pbUsed
+	// and rescans uiMaxIndex, so once a tick is done both pools hold the same slots whatever the order, and Add() always takes the lowest free one
+	struct Expiry
+	{
+		float fEndTime = 0.0f;
+		CONTROLLER_V uiController = 0;
+
+		bool operator==(const Expiry& rOther) const = default;
+
+		// std::push_heap() builds a max-heap, ties are broken by index so the order never depends on how the heap was built
+		bool operator<(const Expiry& rOther) const
+		{
+			return fEndTime != rOther.fEndTime ? fEndTime > rOther.fEndTime : uiController > rOther.uiController;
+		}
+	};
+
+	static constexpr int64_t kiMaxExpiries = 2 * static_cast<int64_t>(CONTROLLER_SIZE);
+
+	Expiry pExpiries[kiMaxExpiries] {};
+	int64_t iExpiryCount = 0;
+
 	void Add(OBJECT_POOL& __restrict rPool, CONTROLLER_V& __restrict ruiControllerIndex, float fCurrentTime, const CONTROLLER_T& __restrict rControllerInfo)
 	{
 		bool bNew = ruiControllerIndex == 0;
@@ -52,6 +79,19 @@ struct ObjectControllerPool : public ObjectPool<ObjectControllerInfo<POOL_T, CON
 			rController.fStartTime = fCurrentTime;
 			rPool.Add(rController.objectIndex, rControllerInfo.pObjectInfos[0]);
 		}
+
+		if (ruiControllerIndex == 0) [[unlikely]]
+		{
+			return;
+		}
+
+		// The keyframes may have changed, so the search starts over
+		CONTROLLER_POOL::Get(ruiControllerIndex).uiKeyframe = 1;
+
+		if (rControllerInfo.bDestroysSelf)
+		{
+			PushExpiry({.fEndTime = EndTime(*this, ruiControllerIndex), .uiController = ruiControllerIndex});
+		}
 	}
 
 	void Add(OBJECT_POOL& __restrict rPool, float fCurrentTime, const CONTROLLER_T& __restrict rControllerInfo)
@@ -73,18 +113,41 @@ struct ObjectControllerPool : public ObjectPool<ObjectControllerInfo<POOL_T, CON
 		CONTROLLER_POOL::Remove(ruiController);
 	}
 
-	static float EndTime(CONTROLLER_POOL& __restrict rCurrent, CONTROLLER_V uiController)
+	static float EndTime(const CONTROLLER_POOL& __restrict rCurrent, CONTROLLER_V uiController)
 	{
 		const CONTROLLER_T& rControllerInfo = rCurrent.GetInfo(uiController);
 		const CONTROLLER_U& rController = rCurrent.Get(uiController);
 		return rController.fStartTime + rControllerInfo.pfTimes[CONTROLLER_LERP_SIZE - 1];
 	}
 
-	static void UpdateMain(CONTROLLER_POOL& __restrict rCurrent, const CONTROLLER_POOL& __restrict rPrevious, OBJECT_POOL& __restrict rPool, float fCurrentTime)
+	static void Copy(ObjectControllerPool& __restrict rCurrent, const ObjectControllerPool& __restrict rPrevious)
+	{
+		CONTROLLER_POOL::Copy(rCurrent, rPrevious);
+
+		rCurrent.iExpiryCount = rPrevious.iExpiryCount;
+		memcpy(&rCurrent.pExpiries[0], &rPrevious.pExpiries[0], rCurrent.iExpiryCount * sizeof(Expiry));
+	}
+
+	static void UpdateMain(ObjectControllerPool& __restrict rCurrent, const ObjectControllerPool& __restrict rPrevious, OBJECT_POOL& __restrict rPool, float fCurrentTime)
 	{
 		SCOPED_CPU_PROFILE(kCpuTimerControllers);
 
-		CONTROLLER_POOL::Copy(rCurrent, rPrevious);
+		Copy(rCurrent, rPrevious);
+
+		while (rCurrent.iExpiryCount > 0 && fCurrentTime > rCurrent.pExpiries[0].fEndTime)
+		{
+			std::pop_heap(rCurrent.pExpiries, rCurrent.pExpiries + rCurrent.iExpiryCount);
+			--rCurrent.iExpiryCount;
+
+			const Expiry& rExpiry = rCurrent.pExpiries[rCurrent.iExpiryCount];
+			if (!rCurrent.IsExpiryValid(rExpiry))
+			{
+				continue;
+			}
+
+			CONTROLLER_V uiController = rExpiry.uiController;
+			rCurrent.Remove(rPool, uiController);
+		}
 
 		int64_t iCount = 0;
 		for (CONTROLLER_V i = 0; i <= rCurrent.uiMaxIndex; ++i)
@@ -94,23 +157,10 @@ struct ObjectControllerPool : public ObjectPool<ObjectControllerInfo<POOL_T, CON
 				continue;
 			}
 
-			CONTROLLER_T& rControllerInfo = rCurrent.pObjectInfos[i];
+			const CONTROLLER_T& rControllerInfo = rCurrent.pObjectInfos[i];
 			CONTROLLER_U& rController = rCurrent.pObjects[i];
-			
-			++iCount;
 
-			float fEndTime = EndTime(rCurrent, i);
-			if (rControllerInfo.bDestroysSelf && fCurrentTime > fEndTime)
-			{
-				--iCount;
-
-				rPool.Remove(rController.objectIndex);
-
-				CONTROLLER_V uiController = i;
-				rCurrent.Remove(uiController);
-
-				continue;
-			}
+			++iCount;
 
 			if (rController.objectIndex == 0)
 			{
@@ -118,7 +168,7 @@ struct ObjectControllerPool : public ObjectPool<ObjectControllerInfo<POOL_T, CON
 			}
 
 			POOL_T& rObjectInfo = rPool.GetInfo(rController.objectIndex);
-			for (int64_t j = 1; j < CONTROLLER_LERP_SIZE; ++j)
+			for (int64_t j = rController.uiKeyframe; j < static_cast<int64_t>(CONTROLLER_LERP_SIZE); ++j)
 			{
 				float fTime = rController.fStartTime + rControllerInfo.pfTimes[j];
 				if (fCurrentTime < fTime)
@@ -126,12 +176,45 @@ struct ObjectControllerPool : public ObjectPool<ObjectControllerInfo<POOL_T, CON
 					float fPreviousTime = rController.fStartTime + rControllerInfo.pfTimes[j - 1];
 					float fPercent = std::clamp((fCurrentTime - fPreviousTime) / (fTime - fPreviousTime), 0.0f, 1.0f);
 					rObjectInfo = POOL_T::Lerp(rControllerInfo.pObjectInfos[j - 1], rControllerInfo.pObjectInfos[j], fPercent);
+					rController.uiKeyframe = static_cast<uint8_t>(j);
 					break;
 				}
 			}
 		}
 		PROFILE_SET_COUNT(kCpuCounterControllers, iCount);
 	}
+
+private:
+
+	bool IsExpiryValid(const Expiry& rExpiry) const
+	{
+		// The controller may have been removed by its owner, or the slot reused by a controller that ends at a different time
+		return CONTROLLER_POOL::pbUsed[rExpiry.uiController]
+			&& CONTROLLER_POOL::pObjectInfos[rExpiry.uiController].bDestroysSelf
+			&& EndTime(*this, rExpiry.uiController) == rExpiry.fEndTime;
+	}
+
+	void PushExpiry(const Expiry& rExpiry)
+	{
+		ASSERT(giMultithreading == 0);
+
+		if (iExpiryCount == kiMaxExpiries) [[unlikely]]
+		{
+			// Only stale entries can fill the heap past CONTROLLER_SIZE, drop them and rebuild
+			Expiry* pEnd = std::remove_if(pExpiries, pExpiries + iExpiryCount, [this](const Expiry& rOther)
+			{
+				return !IsExpiryValid(rOther);
+			});
+			iExpiryCount = pEnd - pExpiries;
+			std::make_heap(pExpiries, pExpiries + iExpiryCount);
+
+			ASSERT(iExpiryCount < kiMaxExpiries);
+		}
+
+		pExpiries[iExpiryCount] = rExpiry;
+		++iExpiryCount;
+		std::push_heap(pExpiries, pExpiries + iExpiryCount);
+	}
 };
 
 } // namespace engine
@@ -13,7 +13,9 @@ struct TrailInfo;
 template<typename T, int64_t CONTROLLER_COUNT>
 struct ObjectControllerInfo;
 
-inline std::atomic<int64_t> giMultithreading = 0;
+// Raised on each thread while it runs a Multithread<> bucket, pools can't grow or shrink from inside one
+// Per thread because the simulation thread runs its buckets while the main thread adds to and removes from the kMain frame
+inline thread_local int64_t giMultithreading = 0;
 
 // Objects in a pool generally don't destroy themselves and the responsibility is on the owner to Remove() them
 template<typename T, typename U, typename V, V POOL_SIZE>
@@ -32,8 +34,9 @@ struct alignas(64) ObjectPool
 
 	static void Copy(POOL& __restrict rCurrent, const POOL& __restrict rPrevious)
 	{
+		// Nothing above uiMaxIndex is ever used, so only the part of pbUsed that either side could have set needs copying
+		memcpy(&rCurrent.pbUsed[0], &rPrevious.pbUsed[0], (std::max(rCurrent.uiMaxIndex, rPrevious.uiMaxIndex) + 1) * sizeof(bool));
 		rCurrent.uiMaxIndex = rPrevious.uiMaxIndex;
-		memcpy(&rCurrent.pbUsed[0], &rPrevious.pbUsed[0], sizeof(rCurrent.pbUsed));
 		memcpy(&rCurrent.pObjectInfos[0], &rPrevious.pObjectInfos[0], (rCurrent.uiMaxIndex + 1) * sizeof(T));
 		memcpy(&rCurrent.pObjects[0], &rPrevious.pObjects[0], (rCurrent.uiMaxIndex + 1) * sizeof(U));
 	}
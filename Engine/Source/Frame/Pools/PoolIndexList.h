@@ -0,0 +1,60 @@
+#pragma once
+
+namespace engine
+{
+
+// Indices of some of the objects in an ObjectPool in the order they were added, so their owner walks only those instead of sweeping the whole pool
+// The owner removes the objects from the pool itself, the list only keeps track of which are left
+template<typename V, int64_t SIZE>
+struct PoolIndexList
+{
+	V puiIndices[SIZE] {};
+	int64_t iCount = 0;
+
+	bool Full() const
+	{
+		return iCount == SIZE;
+	}
+
+	void Add(V uiIndex)
+	{
+		ASSERT(iCount < SIZE);
+		puiIndices[iCount] = uiIndex;
+		++iCount;
+	}
+
+	// Makes room for a new index when full
+	V TakeOldest()
+	{
+		ASSERT(iCount > 0);
+		V uiOldest = puiIndices[0];
+		std::copy(&puiIndices[1], &puiIndices[iCount], &puiIndices[0]);
+		--iCount;
+		return uiOldest;
+	}
+
+	// rKeep(uiIndex) returns false for the indices the owner removed from the pool, the rest stay in order
+	template<typename T>
+	void Compact(const T& rKeep)
+	{
+		int64_t iLeft = 0;
+		for (int64_t i = 0; i < iCount; ++i)
+		{
+			V uiIndex = puiIndices[i];
+			if (rKeep(uiIndex))
+			{
+				puiIndices[iLeft] = uiIndex;
+				++iLeft;
+			}
+		}
+		iCount = iLeft;
+	}
+
+	// Entries past iCount are left over from earlier compactions
+	bool operator==(const PoolIndexList& rOther) const
+	{
+		return iCount == rOther.iCount && std::equal(&puiIndices[0], &puiIndices[iCount], &rOther.puiIndices[0]);
+	}
+};
+
+} // namespace engine
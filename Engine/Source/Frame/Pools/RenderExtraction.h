@@ -0,0 +1,211 @@
+#pragma once
+
+namespace engine
+{
+
+// Pure CPU stages of RenderLightingMain() and RenderSmokeMain(), RenderBuckets() runs them on ranges of a pool
+// Everything they read is passed in, rBaseHeight(pVecPositions, iCount) moves positions to the base height in place like BaseHeightPositions()
+// and rTextureIndex(crc) gives the texture slot like CrcToIndex(), so the pool, info and layout types are template parameters and they can be tested without the renderer
+
+// InVisibleArea() without the adjustments, FrameBase.h includes every pool
+inline bool XM_CALLCONV InExtractionArea(const DirectX::XMFLOAT4& rf4Area, DirectX::FXMVECTOR vecPosition)
+{
+	DirectX::XMFLOAT4A f4Position;
+	DirectX::XMStoreFloat4A(&f4Position, vecPosition);
+	return !(f4Position.x < rf4Area.x || f4Position.x > rf4Area.z || f4Position.y > rf4Area.y || f4Position.y < rf4Area.w);
+}
+
+// Writes the visible area lights in [iStart, iEnd) to the start of the arrays, pVecPositions needs 4 entries per light
+// Returns the used and the visible light counts
+template<typename LIGHTS, typename VISIBLE_LAYOUT, typename AREA_LAYOUT, typename BASE_HEIGHT, typename TEXTURE_INDEX>
+std::pair<int64_t, int64_t> ExtractAreaLights(VISIBLE_LAYOUT* __restrict pVisibleLayouts, AREA_LAYOUT* __restrict pAreaLayouts, int64_t* __restrict piVisible, DirectX::XMVECTOR* __restrict pVecPositions, int64_t iStart, int64_t iEnd, const LIGHTS& __restrict rAreaLights, const DirectX::XMFLOAT4& rf4VisibleArea, const BASE_HEIGHT& rBaseHeight, const TEXTURE_INDEX& rTextureIndex)
+{
+	int64_t iUsed = 0;
+	int64_t iVisible = 0;
+	for (int64_t i = iStart; i < iEnd; ++i)
+	{
+		if (!rAreaLights.pbUsed[i])
+		{
+			continue;
+		}
+
+		const auto& rAreaLightInfo = rAreaLights.pObjectInfos[i];
+
+		++iUsed;
+
+		bool bInVisibleArea = rAreaLightInfo.bAlwaysVisible;
+		for (int64_t j = 0; j < 4; ++j)
+		{
+			bInVisibleArea |= InExtractionArea(rf4VisibleArea, rAreaLightInfo.pVecVisiblePositions[j]);
+			pVecPositions[4 * iVisible + j] = rAreaLightInfo.pVecLightingPositions[j];
+		}
+
+		piVisible[iVisible] = i;
+		iVisible += bInVisibleArea ? 1 : 0;
+	}
+
+	rBaseHeight(pVecPositions, 4 * iVisible);
+
+	for (int64_t i = 0; i < iVisible; ++i)
+	{
+		const auto& rAreaLightInfo = rAreaLights.pObjectInfos[piVisible[i]];
+		VISIBLE_LAYOUT& rVisibleLightQuadLayout = pVisibleLayouts[i];
+		AREA_LAYOUT& rAreaLightQuadLayout = pAreaLayouts[i];
+
+		for (int64_t j = 0; j < 4; ++j)
+		{
+			DirectX::XMFLOAT4A f4Position {};
+			DirectX::XMStoreFloat4A(&f4Position, rAreaLightInfo.pVecVisiblePositions[j]);
+			rVisibleLightQuadLayout.pf4Vertices[j] = {f4Position.x, f4Position.y, f4Position.z, f4Position.w};
+			rVisibleLightQuadLayout.pf4Texcoords[j] = {rAreaLightInfo.pf2Texcoords[j].x, rAreaLightInfo.pf2Texcoords[j].y, 0.0f, 0.0f};
+			rVisibleLightQuadLayout.puiColors[j] = rAreaLightInfo.puiColors[j];
+
+			DirectX::XMStoreFloat4A(&f4Position, pVecPositions[4 * i + j]);
+			rAreaLightQuadLayout.pf4VerticesTexcoords[j] = {f4Position.x, f4Position.y, rAreaLightInfo.pf2Texcoords[j].x, rAreaLightInfo.pf2Texcoords[j].y};
+		}
+
+		float fTextureIndex = rTextureIndex(rAreaLightInfo.crc);
+		rVisibleLightQuadLayout.fIntensity = rAreaLightInfo.fVisibleIntensity;
+		rVisibleLightQuadLayout.fRotation = 0.0f;
+		rVisibleLightQuadLayout.uiTextureIndex = static_cast<uint32_t>(fTextureIndex);
+
+		rAreaLightQuadLayout.pf4Misc[0] = rAreaLightQuadLayout.pf4Misc[1] = rAreaLightQuadLayout.pf4Misc[2] = rAreaLightQuadLayout.pf4Misc[3] = {fTextureIndex, rAreaLightInfo.fLightingIntensity, 0.0f, 0.0f};
+		DirectX::XMStoreFloat4(&rAreaLightQuadLayout.f4Misc, rAreaLightInfo.vecDirectionMultipliers);
+		rAreaLightQuadLayout.uiColor = rAreaLightInfo.puiColors[0];
+	}
+
+	return {iUsed, iVisible};
+}
+
+// Writes the visible point lights in [iStart, iEnd) to the start of the arrays
+// Returns the used and the visible light counts
+template<typename LIGHTS, typename VISIBLE_LAYOUT, typename POINT_LAYOUT, typename BASE_HEIGHT, typename TEXTURE_INDEX>
+std::pair<int64_t, int64_t> ExtractPointLights(VISIBLE_LAYOUT* __restrict pVisibleLayouts, POINT_LAYOUT* __restrict pPointLayouts, int64_t* __restrict piVisible, DirectX::XMVECTOR* __restrict pVecPositions, int64_t iStart, int64_t iEnd, const LIGHTS& __restrict rPointLights, const DirectX::XMFLOAT4& rf4VisibleArea, const BASE_HEIGHT& rBaseHeight, const TEXTURE_INDEX& rTextureIndex)
+{
+	int64_t iUsed = 0;
+	int64_t iVisible = 0;
+	for (int64_t i = iStart; i < iEnd; ++i)
+	{
+		if (!rPointLights.pbUsed[i])
+		{
+			continue;
+		}
+
+		++iUsed;
+
+		const DirectX::XMVECTOR& rVecPosition = rPointLights.pObjectInfos[i].vecPosition;
+		piVisible[iVisible] = i;
+		pVecPositions[iVisible] = rVecPosition;
+		iVisible += InExtractionArea(rf4VisibleArea, rVecPosition) ? 1 : 0;
+	}
+
+	rBaseHeight(pVecPositions, iVisible);
+
+	for (int64_t i = 0; i < iVisible; ++i)
+	{
+		const auto& rPointLightInfo = rPointLights.pObjectInfos[piVisible[i]];
+		float fTextureIndex = rTextureIndex(rPointLightInfo.crc);
+
+		// Visible
+		DirectX::XMFLOAT4A f4Position {};
+		DirectX::XMStoreFloat4A(&f4Position, rPointLightInfo.vecPosition);
+
+		DirectX::XMFLOAT4 f4VertexRect = {f4Position.x - rPointLightInfo.fVisibleArea, f4Position.y + rPointLightInfo.fVisibleArea, 2.0f * rPointLightInfo.fVisibleArea, -2.0f * rPointLightInfo.fVisibleArea};
+
+		VISIBLE_LAYOUT& rVisibleLightQuadLayout = pVisibleLayouts[i];
+		rVisibleLightQuadLayout.pf4Vertices[0] = {f4VertexRect.x, f4VertexRect.y, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Vertices[1] = {f4VertexRect.x + f4VertexRect.z, f4VertexRect.y, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Vertices[2] = {f4VertexRect.x, f4VertexRect.y + f4VertexRect.w, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Vertices[3] = {f4VertexRect.x + f4VertexRect.z, f4VertexRect.y + f4VertexRect.w, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[0] = {0.0f, 0.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[1] = {1.0f, 0.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[2] = {0.0f, 1.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[3] = {1.0f, 1.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.fIntensity = rPointLightInfo.fVisibleIntensity;
+		rVisibleLightQuadLayout.fRotation = rPointLightInfo.fRotation;
+		rVisibleLightQuadLayout.puiColors[0] = rVisibleLightQuadLayout.puiColors[1] = rVisibleLightQuadLayout.puiColors[2] = rVisibleLightQuadLayout.puiColors[3] = rPointLightInfo.uiColor;
+		rVisibleLightQuadLayout.uiTextureIndex = static_cast<uint32_t>(fTextureIndex);
+
+		// Lighting
+		DirectX::XMStoreFloat4A(&f4Position, pVecPositions[i]);
+
+		POINT_LAYOUT& rLightingQuadLayout = pPointLayouts[i];
+		rLightingQuadLayout.f4VertexRect = {f4Position.x - rPointLightInfo.fLightingArea, f4Position.y + rPointLightInfo.fLightingArea, 2.0f * rPointLightInfo.fLightingArea, -2.0f * rPointLightInfo.fLightingArea};
+		rLightingQuadLayout.f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
+		rLightingQuadLayout.f4Misc = {fTextureIndex, rPointLightInfo.fLightingIntensity, rPointLightInfo.fRotation, 0.0f};
+		rLightingQuadLayout.uiColor = rPointLightInfo.uiColor;
+	}
+
+	return {iUsed, iVisible};
+}
+
+// Writes the puffs in [iStart, iEnd) that are inside the smoke area to the start of the arrays
+// f4Misc.w is left for the caller to fill with a random rotation, returns the used and the visible puff counts
+template<typename PUFFS, typename LAYOUT, typename BASE_HEIGHT>
+std::pair<int64_t, int64_t> ExtractPuffs(LAYOUT* __restrict pLayouts, int64_t* __restrict piVisible, DirectX::XMVECTOR* __restrict pVecPositions, int64_t iStart, int64_t iEnd, const PUFFS& __restrict rPuffs, const DirectX::XMFLOAT4& rf4SmokeArea, const BASE_HEIGHT& rBaseHeight)
+{
+	int64_t iUsed = 0;
+	int64_t iVisible = 0;
+	for (int64_t i = iStart; i < iEnd; ++i)
+	{
+		if (!rPuffs.pbUsed[i])
+		{
+			continue;
+		}
+
+		++iUsed;
+
+		const DirectX::XMVECTOR& rVecPosition = rPuffs.pObjectInfos[i].vecPosition;
+		piVisible[iVisible] = i;
+		pVecPositions[iVisible] = rVecPosition;
+		iVisible += InExtractionArea(rf4SmokeArea, rVecPosition) ? 1 : 0;
+	}
+
+	rBaseHeight(pVecPositions, iVisible);
+
+	for (int64_t i = 0; i < iVisible; ++i)
+	{
+		const auto& rPuffInfo = rPuffs.pObjectInfos[piVisible[i]];
+
+		DirectX::XMFLOAT4A f4Position {};
+		DirectX::XMStoreFloat4A(&f4Position, pVecPositions[i]);
+
+		LAYOUT& rLayout = pLayouts[i];
+		rLayout.f4VertexRect = {f4Position.x - rPuffInfo.fArea, f4Position.y + rPuffInfo.fArea, 2.0f * rPuffInfo.fArea, -2.0f * rPuffInfo.fArea};
+		rLayout.f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
+		rLayout.f4Misc = {rPuffInfo.fIntensity, 1.0f, rPuffInfo.fCookie, 0.0f};
+	}
+
+	return {iUsed, iVisible};
+}
+
+// Gathers the trails inside the smoke area with their current and previous positions moved to the base height, pVecPositions needs 2 entries per trail
+// The quads draw from the random engine per trail and update the smoothed positions, so they are built serially by the caller
+// Returns the used and the visible trail counts
+template<typename TRAILS, typename BASE_HEIGHT>
+std::pair<int64_t, int64_t> ExtractTrails(int64_t* __restrict piVisible, DirectX::XMVECTOR* __restrict pVecPositions, const TRAILS& __restrict rTrails, const DirectX::XMVECTOR* __restrict pVecPreviousPositions, const DirectX::XMFLOAT4& rf4SmokeArea, const BASE_HEIGHT& rBaseHeight)
+{
+	int64_t iUsed = 0;
+	int64_t iVisible = 0;
+	for (int64_t i = 0; i <= static_cast<int64_t>(rTrails.uiMaxIndex); ++i)
+	{
+		if (!rTrails.pbUsed[i])
+		{
+			continue;
+		}
+
+		++iUsed;
+
+		const DirectX::XMVECTOR& rVecPosition = rTrails.pObjectInfos[i].vecPosition;
+		piVisible[iVisible] = i;
+		pVecPositions[2 * iVisible] = rVecPosition;
+		pVecPositions[2 * iVisible + 1] = pVecPreviousPositions[i];
+		iVisible += InExtractionArea(rf4SmokeArea, rVecPosition) ? 1 : 0;
+	}
+
+	rBaseHeight(pVecPositions, 2 * iVisible);
+
+	return {iUsed, iVisible};
+}
+
+} // namespace engine
@@ -1,6 +1,7 @@
 #include "Smoke.h"
 
 #include "Frame/Render.h"
+#include "Frame/Pools/RenderExtraction.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Islands.h"
 #include "Graphics/Managers/PipelineManager.h"
@@ -21,6 +22,9 @@ static float sfSmokePreviousUpdateTime = 0.0f;
 
 static DirectX::XMFLOAT4 sf4SmokeArea {};
 
+static constexpr int64_t kiPuffsBucketSize = 256;
+static constexpr int64_t kiPuffsMaxBuckets = 64;
+
 void RenderSmokeGlobal(int64_t iCommandBuffer, const game::Frame& __restrict rFrame)
 {
 	shaders::GlobalLayout& rGlobalLayout = *reinterpret_cast<shaders::GlobalLayout*>(&gpBufferManager->mGlobalLayoutUniformBuffers.at(iCommandBuffer).mpMappedMemory[0]);
@@ -133,73 +137,69 @@ void RenderSmokeMain(int64_t iCommandBuffer, const game::Frame& __restrict rFram
 	gbSmokeSpread = true;
 	sfSmokePreviousUpdateTime += kfSmokeUpdateInterval;
 
+	XMVECTOR vecEyePosition = rFrame.camera.vecEyePosition;
+	float fBaseHeight = gBaseHeight.Get();
+	auto baseHeight = [vecEyePosition, fBaseHeight](XMVECTOR* pVecPositions, int64_t iCount)
+	{
+		BaseHeightPositions(pVecPositions, pVecPositions, iCount, vecEyePosition, fBaseHeight);
+	};
+
+	// Puffs, see ExtractPuffs()
+	int64_t iPuffSlots = rFrame.puffs.uiMaxIndex + 1;
+	auto pVecPuffPositions = common::gpThreadLocal->GetWorkbuffer<XMVECTOR*>(iPuffSlots * (sizeof(XMVECTOR) + sizeof(shaders::AxisAlignedQuadLayout) + sizeof(int64_t)));
+	auto pPuffScratchLayouts = reinterpret_cast<shaders::AxisAlignedQuadLayout*>(pVecPuffPositions + iPuffSlots);
+	auto piPuffVisible = reinterpret_cast<int64_t*>(pPuffScratchLayouts + iPuffSlots);
+
+	int64_t piStarts[kiPuffsMaxBuckets + 1] {};
+	int64_t piUsedCounts[kiPuffsMaxBuckets] {};
+	int64_t piRenderedCounts[kiPuffsMaxBuckets] {};
+	int64_t iBuckets = RenderBuckets<kiPuffsBucketSize, kiPuffsMaxBuckets>(piStarts, iPuffSlots, [&](int64_t iBucket, int64_t iStart, int64_t iEnd)
+	{
+		std::tie(piUsedCounts[iBucket], piRenderedCounts[iBucket]) = ExtractPuffs(pPuffScratchLayouts + iStart, piPuffVisible + iStart, pVecPuffPositions + iStart, iStart, iEnd, rFrame.puffs, sf4SmokeArea, baseHeight);
+	});
+
+	// The rotations are drawn serially and in puff order so the random sequence doesn't depend on the bucket count
 	auto pPuffLayouts = reinterpret_cast<shaders::AxisAlignedQuadLayout*>(gpBufferManager->mSmokePuffsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
 	int64_t iPuffCount = 0;
 	int64_t iPuffsRendered = 0;
-	for (decltype(rFrame.puffs.uiMaxIndex) i = 0; i <= rFrame.puffs.uiMaxIndex; ++i)
+	for (int64_t i = 0; i < iBuckets; ++i)
 	{
-		if (!rFrame.puffs.pbUsed[i])
+		shaders::AxisAlignedQuadLayout* pBucketLayouts = &pPuffScratchLayouts[piStarts[i]];
+		for (int64_t j = 0; j < piRenderedCounts[i]; ++j)
 		{
-			continue;
+			pBucketLayouts[j].f4Misc.w = common::Random<XM_2PI>(sRandomEngine);
 		}
 
-		const engine::PuffInfo& rPuffInfo = rFrame.puffs.pObjectInfos[i];
-		
-		++iPuffCount;
-
-		XMFLOAT4A f4Position {};
-		XMStoreFloat4A(&f4Position, rPuffInfo.vecPosition);
-		if (f4Position.x < sf4SmokeArea.x || f4Position.x > sf4SmokeArea.z || f4Position.y > sf4SmokeArea.y || f4Position.y < sf4SmokeArea.w)
-		{
-			continue;
-		}
-
-		float fElevation = gpIslands->GlobalElevation(rPuffInfo.vecPosition);
-		auto vecBaseAreaPosition = common::ToBaseHeight(rPuffInfo.vecPosition, rFrame.camera.vecEyePosition, std::max(fElevation, gBaseHeight.Get()));
-		XMStoreFloat4A(&f4Position, vecBaseAreaPosition);
-
-		shaders::AxisAlignedQuadLayout& rLayout = pPuffLayouts[iPuffsRendered];
-		rLayout.f4VertexRect = {f4Position.x - rPuffInfo.fArea, f4Position.y + rPuffInfo.fArea, 2.0f * rPuffInfo.fArea, -2.0f * rPuffInfo.fArea};
-		rLayout.f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
-		rLayout.f4Misc = {rPuffInfo.fIntensity, 1.0f, rPuffInfo.fCookie, common::Random<XM_2PI>(sRandomEngine)};
-
-		++iPuffsRendered;
+		memcpy(&pPuffLayouts[iPuffsRendered], pBucketLayouts, piRenderedCounts[i] * sizeof(shaders::AxisAlignedQuadLayout));
+		iPuffCount += piUsedCounts[i];
+		iPuffsRendered += piRenderedCounts[i];
 	}
 	PROFILE_SET_COUNT(kCpuCounterSmokePuffs, iPuffCount);
 	PROFILE_SET_COUNT(kCpuCounterSmokePuffsRendered, iPuffsRendered);
 	gpPipelineManager->mpPipelines[kPipelineSmokePuffs].WriteIndirectBuffer(iCommandBuffer, iPuffsRendered);
 
-	auto pTrailLayouts = reinterpret_cast<shaders::QuadLayout*>(gpBufferManager->mSmokeTrailsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
-	int64_t iTrailCount = 0;
+	// Trails draw from the random engine per trail and update the smoothed positions, so only their elevations are batched and the rest stays serial
+	int64_t iTrailSlots = rFrame.trails.uiMaxIndex + 1;
+	auto pVecTrailPositions = common::gpThreadLocal->GetWorkbuffer<XMVECTOR*>(iTrailSlots * (2 * sizeof(XMVECTOR) + sizeof(shaders::QuadLayout) + sizeof(int64_t)));
+	auto pTrailScratchLayouts = reinterpret_cast<shaders::QuadLayout*>(pVecTrailPositions + 2 * iTrailSlots);
+	auto piTrailVisible = reinterpret_cast<int64_t*>(pTrailScratchLayouts + iTrailSlots);
+
+	auto [iTrailCount, iTrailsVisible] = ExtractTrails(piTrailVisible, pVecTrailPositions, rFrame.trails, Trails::smpVecTrailsPositionPrevious, sf4SmokeArea, baseHeight);
+
 	int64_t iTrailsRendered = 0;
-	for (decltype(rFrame.trails.uiMaxIndex) i = 0; i <= rFrame.trails.uiMaxIndex; ++i)
+	for (int64_t iVisible = 0; iVisible < iTrailsVisible; ++iVisible)
 	{
-		if (!rFrame.trails.pbUsed[i])
-		{
-			continue;
-		}
-
+		int64_t i = piTrailVisible[iVisible];
 		const engine::TrailInfo& rTrailInfo = rFrame.trails.pObjectInfos[i];
 		const engine::Trail& rTrail = rFrame.trails.pObjects[i];
-		
-		++iTrailCount;
-
-		XMFLOAT4A f4Position {};
-		XMStoreFloat4A(&f4Position, rTrailInfo.vecPosition);
-		if (f4Position.x < sf4SmokeArea.x || f4Position.x > sf4SmokeArea.z || f4Position.y > sf4SmokeArea.y || f4Position.y < sf4SmokeArea.w)
-		{
-			continue;
-		}
 
 		float fJitterOne = gSmokeTrailsSideJitter.Get() * common::Random(sRandomEngine);
 		fJitterOne = fJitterOne * fJitterOne;
 		float fJitterTwo = gSmokeTrailsSideJitter.Get() * common::Random(sRandomEngine);
 		fJitterTwo = fJitterTwo * fJitterTwo;
 
-		float fElevation = gpIslands->GlobalElevation(rTrailInfo.vecPosition);
-		auto vecBaseAreaPosition = common::ToBaseHeight(rTrailInfo.vecPosition, rFrame.camera.vecEyePosition, std::max(fElevation, gBaseHeight.Get()));
-		fElevation = gpIslands->GlobalElevation(Trails::smpVecTrailsPositionPrevious[i]);
-		auto vecBaseAreaPreviousPosition = common::ToBaseHeight(Trails::smpVecTrailsPositionPrevious[i], rFrame.camera.vecEyePosition, std::max(fElevation, gBaseHeight.Get()));
+		auto vecBaseAreaPosition = pVecTrailPositions[2 * iVisible];
+		auto vecBaseAreaPreviousPosition = pVecTrailPositions[2 * iVisible + 1];
 
 		auto vecToPrevious = vecBaseAreaPosition - vecBaseAreaPreviousPosition;
 		float fLengthScale = XMVectorGetX(XMVector3Length(vecToPrevious));
@@ -215,7 +215,6 @@ void RenderSmokeMain(int64_t iCommandBuffer, const game::Frame& __restrict rFram
 		}
 		auto vecToSmoothedNormal = XMVector3Normalize(vecToSmoothed);
 
-		auto vecToPreviousNormal = XMVector3Normalize(vecToPrevious);
 		auto vecLeftNormal = XMVector3Normalize(XMVector3Cross(vecToSmoothedNormal, XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f)));
 		auto vecPointOne = vecBaseAreaPosition + gSmokeTrailsWidthCurrent.Get() * rTrailInfo.fWidth *  vecLeftNormal;
 		auto vecPointTwo = vecBaseAreaPosition + gSmokeTrailsWidthCurrent.Get() * rTrailInfo.fWidth * -vecLeftNormal;
@@ -227,21 +226,24 @@ void RenderSmokeMain(int64_t iCommandBuffer, const game::Frame& __restrict rFram
 		auto vecPointThree = vecBaseAreaPreviousPosition + gSmokeTrailsWidthPrevious.Get() * fJitterOne * vecLeftNormal - fLength * fLengthScale * vecToSmoothedNormal;
 		auto vecPointFour = vecBaseAreaPreviousPosition + gSmokeTrailsWidthPrevious.Get() * fJitterTwo * -vecLeftNormal - fLength * fLengthScale * vecToSmoothedNormal;
 
+		shaders::QuadLayout& rLayout = pTrailScratchLayouts[iTrailsRendered];
+
+		XMFLOAT4A f4Position {};
 		XMStoreFloat4A(&f4Position, vecPointOne);
-		pTrailLayouts[iTrailsRendered].pf4VerticesTexcoords[0] = {f4Position.x, f4Position.y, 0.0f, 0.0f};
+		rLayout.pf4VerticesTexcoords[0] = {f4Position.x, f4Position.y, 0.0f, 0.0f};
 		XMStoreFloat4A(&f4Position, vecPointTwo);
-		pTrailLayouts[iTrailsRendered].pf4VerticesTexcoords[1] = {f4Position.x, f4Position.y, 1.0f, 0.0f};
+		rLayout.pf4VerticesTexcoords[1] = {f4Position.x, f4Position.y, 1.0f, 0.0f};
 		XMStoreFloat4A(&f4Position, vecPointThree);
-		pTrailLayouts[iTrailsRendered].pf4VerticesTexcoords[2] = {f4Position.x, f4Position.y, 0.0f, 1.0f};
+		rLayout.pf4VerticesTexcoords[2] = {f4Position.x, f4Position.y, 0.0f, 1.0f};
 		XMStoreFloat4A(&f4Position, vecPointFour);
-		pTrailLayouts[iTrailsRendered].pf4VerticesTexcoords[3] = {f4Position.x, f4Position.y, 1.0f, 1.0f};
+		rLayout.pf4VerticesTexcoords[3] = {f4Position.x, f4Position.y, 1.0f, 1.0f};
 
 		float fQuantity = rTrailInfo.fIntensity * gSmokeTrailsQuantity.Get() / fLengthScale;
 		ASSERT(!XMISNAN(fQuantity) && !XMISINF(fQuantity));
-		pTrailLayouts[iTrailsRendered].pf4Misc[0] = {fQuantity, 1.0f, 0.0f, 0.0f};
-		pTrailLayouts[iTrailsRendered].pf4Misc[1] = {fQuantity, 1.0f, 0.0f, 0.0f};
-		pTrailLayouts[iTrailsRendered].pf4Misc[2] = {fQuantity, 0.0f, 0.0f, 0.0f};
-		pTrailLayouts[iTrailsRendered].pf4Misc[3] = {fQuantity, 0.0f, 0.0f, 0.0f};
+		rLayout.pf4Misc[0] = {fQuantity, 1.0f, 0.0f, 0.0f};
+		rLayout.pf4Misc[1] = {fQuantity, 1.0f, 0.0f, 0.0f};
+		rLayout.pf4Misc[2] = {fQuantity, 0.0f, 0.0f, 0.0f};
+		rLayout.pf4Misc[3] = {fQuantity, 0.0f, 0.0f, 0.0f};
 
 		++iTrailsRendered;
 
@@ -249,6 +251,7 @@ void RenderSmokeMain(int64_t iCommandBuffer, const game::Frame& __restrict rFram
 		Trails::smpVecTrailsPositionPrevious[i] = rTrailInfo.vecPosition;
 		Trails::smpVecTrailsPositionSmoothed[i] = fPercent * Trails::smpVecTrailsPositionSmoothed[i] + (1.0f - fPercent) * rTrailInfo.vecPosition;
 	}
+	memcpy(gpBufferManager->mSmokeTrailsStorageBuffers.at(iCommandBuffer).mpMappedMemory, pTrailScratchLayouts, iTrailsRendered * sizeof(shaders::QuadLayout));
 	PROFILE_SET_COUNT(kCpuCounterSmokeTrails, iTrailCount);
 	PROFILE_SET_COUNT(kCpuCounterSmokeTrailsRendered, iTrailsRendered);
 	gpPipelineManager->mpPipelines[kPipelineSmokeTrails].WriteIndirectBuffer(iCommandBuffer, iTrailsRendered);
@@ -58,7 +58,9 @@ void Splashes::PostRender(game::Frame& __restrict rFrame, float fDeltaTime)
 		{
 			rSplash.fNextParticleTime = kfParticleSpawnInterval;
 
-			uint32_t uiParticleColor = 0x000000FF | ((25 + common::Random(50, rFrame.randomEngine)) << 24) | ((25 + common::Random(50, rFrame.randomEngine)) << 16) | ((200 + common::Random(55, rFrame.randomEngine)) << 8);
+			common::RandomStream randomStream = FrameRandomStream(rFrame, kRandomSplashes, i);
+
+			uint32_t uiParticleColor = 0x000000FF | ((25 + common::Random(50, randomStream)) << 24) | ((25 + common::Random(50, randomStream)) << 16) | ((200 + common::Random(55, randomStream)) << 8);
 
 			XMFLOAT4A f4Position {};
 			XMStoreFloat4A(&f4Position, rSplashInfo.vecPosition);
@@ -69,7 +71,7 @@ void Splashes::PostRender(game::Frame& __restrict rFrame, float fDeltaTime)
 			{
 				.i4Misc = {static_cast<int32_t>(uiParticleColor), kiParticleCookie, static_cast<int32_t>(0.0f), 0},
 				.f4MiscOne = {0.0f, 0.0f, kfParticleIntensityDecay, 0.0f},
-				.f4MiscTwo = {kfParticleWidth, kfParticleLength, kfParticleIntensityMin + common::Random<kfParticleIntensityRandom>(rFrame.randomEngine), kfParticleIntensityPower},
+				.f4MiscTwo = {kfParticleWidth, kfParticleLength, kfParticleIntensityMin + common::Random<kfParticleIntensityRandom>(randomStream), kfParticleIntensityPower},
 				.f4MiscThree = {},
 				.f4Position = f4Position,
 				.f4Velocity = f4Velocity,
@@ -29,22 +29,17 @@ struct TargetInfo
 {
 	TargetFlags_t flags;
 	DirectX::XMVECTOR vecPosition {};
-	float fBillboardSize = 0.055f;
 
 	bool operator==(const TargetInfo& rOther) const = default;
 };
 struct Target
 {
 	subscriber_t uiSubscribers = 0;
-	int64_t iBillboard = 0;
-	billboard_t uiBillboard = 0;
 
 	bool operator==(const Target& rOther) const = default;
 };
 struct Targets : public ObjectPool<TargetInfo, Target, target_t, kuiMaxTargets>
 {
-	static void Interpolate(game::Frame& __restrict rFrame);
-
 	void Remove(target_t& __restrict ruiIndex) = delete;
 	void Remove(game::Frame& __restrict rFrame, target_t& __restrict ruiIndex, TargetFlags_t flags);
 };
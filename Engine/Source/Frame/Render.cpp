@@ -345,73 +345,85 @@ void RenderFrameGlobal(int64_t iCommandBuffer, const game::Frame& __restrict rFr
 	rGlobalLayout.i4Water.y = static_cast<int>(gMediumCount.Get<int64_t>());
 }
 
-void RenderFrameMain(int64_t iCommandBuffer, const game::Frame& __restrict rFrame)
+struct WaterWaves
 {
-	RenderLightingMain(iCommandBuffer, rFrame);
-	RenderSmokeMain(iCommandBuffer, rFrame);
-	RenderMainList(iCommandBuffer, rFrame, UPDATE_LIST);
-
-	shaders::MainLayout& rMainLayout = *reinterpret_cast<shaders::MainLayout*>(&gpBufferManager->mMainLayoutUniformBuffers.at(iCommandBuffer).mpMappedMemory[0]);
+	decltype(shaders::MainLayout::pf4LowWavesOne) pf4LowWavesOne;
+	decltype(shaders::MainLayout::pf4LowWavesTwo) pf4LowWavesTwo;
 
-	// Camera shake
-	float fCameraShake = std::pow(rFrame.camera.fCameraShake, 1.0f);
-	constexpr float kfMaxRoll = 0.005f;
-	constexpr float kfMaxPitch = 0.005f;
-	constexpr float kfMaxYaw = 0.01f;
-	siv::BasicPerlinNoise<float> perlinRoll {0};
-	siv::BasicPerlinNoise<float> perlinPitch {1};
-	siv::BasicPerlinNoise<float> perlinYaw {2};
-	auto matCameraShake = XMMatrixRotationRollPitchYaw(kfMaxRoll  * fCameraShake * (-1.0f + 2.0f * perlinRoll.octave1D_01(8.0f * rFrame.fCurrentTime, 4)),
-	                                                   kfMaxPitch * fCameraShake * (-1.0f + 2.0f * perlinPitch.octave1D_01(8.0f * rFrame.fCurrentTime, 4)),
-	                                                   kfMaxYaw   * fCameraShake * (-1.0f + 2.0f * perlinYaw.octave1D_01(8.0f * rFrame.fCurrentTime, 4)));
-
-	XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(&rMainLayout.f4x4ViewProjection[0]), XMMatrixTranspose(XMMatrixMultiply(gMatView, XMMatrixMultiply(matCameraShake, gMatPerspective))));
+	decltype(shaders::MainLayout::pf4MediumWavesOne) pf4MediumWavesOne;
+	decltype(shaders::MainLayout::pf4MediumWavesTwo) pf4MediumWavesTwo;
+};
 
-	XMStoreFloat4(&rMainLayout.f4EyePosition, rFrame.camera.vecEyePosition);
-	XMStoreFloat4(&rMainLayout.f4ToEyeNormal, rFrame.camera.vecToEyeNormal);
+static common::crc_t WaterWavesCrc()
+{
+	const float pfSettings[] =
+	{
+		gLowCount.Get(),
+		gLowAngle.Get(),
+		gLowWavelength.Get(),
+		gLowAmplitude.Get(),
+		gLowSpeed.Get(),
+		gLowAngleAdjust.Get(),
+		gLowWavelengthAdjust.Get(),
+		gLowAmplitudeAdjust.Get(),
+		gLowSpeedAdjust.Get(),
+		gMediumCount.Get(),
+		gMediumWavelength.Get(),
+		gMediumAmplitude.Get(),
+		gMediumSpeed.Get(),
+		gMediumAngleAdjust.Get(),
+		gMediumWavelengthAdjust.Get(),
+		gMediumAmplitudeAdjust.Get(),
+		gMediumSpeedAdjust.Get(),
+	};
+
+	return common::Crc(std::string_view(reinterpret_cast<const char*>(&pfSettings[0]), sizeof(pfSettings)));
+}
 
+static void GenerateWaterWaves(WaterWaves& rWaterWaves)
+{
 	// Water low frequency
 	{
 		int64_t iCount = gLowCount.Get<int64_t>();
 
 		auto vecDirection = XMVector3Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(gLowAngle.Get()));
-		rMainLayout.pf4LowWavesOne[0].x = XMVectorGetX(vecDirection);
-		rMainLayout.pf4LowWavesOne[0].y = XMVectorGetY(vecDirection);
+		rWaterWaves.pf4LowWavesOne[0].x = XMVectorGetX(vecDirection);
+		rWaterWaves.pf4LowWavesOne[0].y = XMVectorGetY(vecDirection);
 
 		vecDirection = XMVector3Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(0.0f));
-		rMainLayout.pf4LowWavesOne[0].z = XMVectorGetX(vecDirection);
-		rMainLayout.pf4LowWavesOne[0].w = XMVectorGetY(vecDirection);
+		rWaterWaves.pf4LowWavesOne[0].z = XMVectorGetX(vecDirection);
+		rWaterWaves.pf4LowWavesOne[0].w = XMVectorGetY(vecDirection);
 
-		rMainLayout.pf4LowWavesTwo[0].x = (2.0f * XM_PI) / (gLowWavelength.Get()); // Omega
-		rMainLayout.pf4LowWavesTwo[0].y = gLowAmplitude.Get();
-		rMainLayout.pf4LowWavesTwo[0].z = gLowSpeed.Get() * rMainLayout.pf4LowWavesTwo[0].x; // Phi
-		rMainLayout.pf4LowWavesTwo[0].w = 0.0f;
+		rWaterWaves.pf4LowWavesTwo[0].x = (2.0f * XM_PI) / (gLowWavelength.Get()); // Omega
+		rWaterWaves.pf4LowWavesTwo[0].y = gLowAmplitude.Get();
+		rWaterWaves.pf4LowWavesTwo[0].z = gLowSpeed.Get() * rWaterWaves.pf4LowWavesTwo[0].x; // Phi
+		rWaterWaves.pf4LowWavesTwo[0].w = 0.0f;
 
 		common::RandomEngine randomEngine {};
 		for (int64_t i = 1; i < iCount; ++i)
 		{
 			float fAngleAdjust = ((i % 2) == 0 ? 1.0f : -1.0f) * gLowAngleAdjust.Get() * common::Random(randomEngine);
 			vecDirection = XMVector3Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(gLowAngle.Get() + fAngleAdjust));
-			rMainLayout.pf4LowWavesOne[i].x = XMVectorGetX(vecDirection);
-			rMainLayout.pf4LowWavesOne[i].y = XMVectorGetY(vecDirection);
+			rWaterWaves.pf4LowWavesOne[i].x = XMVectorGetX(vecDirection);
+			rWaterWaves.pf4LowWavesOne[i].y = XMVectorGetY(vecDirection);
 
 			vecDirection = XMVector3Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(XM_2PI * static_cast<float>(i) / static_cast<float>(iCount)));
-			rMainLayout.pf4LowWavesOne[i].z = XMVectorGetX(vecDirection);
-			rMainLayout.pf4LowWavesOne[i].w = XMVectorGetY(vecDirection);
+			rWaterWaves.pf4LowWavesOne[i].z = XMVectorGetX(vecDirection);
+			rWaterWaves.pf4LowWavesOne[i].w = XMVectorGetY(vecDirection);
 
 			float fAdjust = common::Random(randomEngine); // static_cast<float>(i) / static_cast<float>(iCount - 1);
 			float fWavelengthAdjust = fAdjust * gLowWavelengthAdjust.Get();
 			float fAmplitudeAdjust = (1.0f - fAdjust) * std::abs(gLowAmplitudeAdjust.Get()) * common::Random(randomEngine);
 			float fSpeedAdjust = fAdjust * gLowSpeedAdjust.Get();
-			rMainLayout.pf4LowWavesTwo[i].x = std::abs((2.0f * XM_PI) / (gLowWavelength.Get() + fWavelengthAdjust * gLowWavelength.Get())); // Omega
-			rMainLayout.pf4LowWavesTwo[i].y = std::abs(gLowAmplitude.Get() - fAmplitudeAdjust * gLowAmplitude.Get());
-			rMainLayout.pf4LowWavesTwo[i].y = std::min(rMainLayout.pf4LowWavesTwo[i].y, 0.1f * (1.0f / rMainLayout.pf4LowWavesTwo[i].x));
-			rMainLayout.pf4LowWavesTwo[i].z = (gLowSpeed.Get() + gLowSpeed.Get() * fSpeedAdjust * common::Random(randomEngine)) * rMainLayout.pf4LowWavesTwo[i].x; // Phi
-			rMainLayout.pf4LowWavesTwo[i].w = 0.0f; // common::Random(randomEngine);
+			rWaterWaves.pf4LowWavesTwo[i].x = std::abs((2.0f * XM_PI) / (gLowWavelength.Get() + fWavelengthAdjust * gLowWavelength.Get())); // Omega
+			rWaterWaves.pf4LowWavesTwo[i].y = std::abs(gLowAmplitude.Get() - fAmplitudeAdjust * gLowAmplitude.Get());
+			rWaterWaves.pf4LowWavesTwo[i].y = std::min(rWaterWaves.pf4LowWavesTwo[i].y, 0.1f * (1.0f / rWaterWaves.pf4LowWavesTwo[i].x));
+			rWaterWaves.pf4LowWavesTwo[i].z = (gLowSpeed.Get() + gLowSpeed.Get() * fSpeedAdjust * common::Random(randomEngine)) * rWaterWaves.pf4LowWavesTwo[i].x; // Phi
+			rWaterWaves.pf4LowWavesTwo[i].w = 0.0f; // common::Random(randomEngine);
 
 			if (i < 64 && (i % 3) == 0)
 			{
-				rMainLayout.pf4LowWavesTwo[i].y = 0.0f;
+				rWaterWaves.pf4LowWavesTwo[i].y = 0.0f;
 			}
 		}
 	}
@@ -425,17 +437,68 @@ void RenderFrameMain(int64_t iCommandBuffer, const game::Frame& __restrict rFram
 		{
 			float fAngleAdjust = gMediumAngleAdjust.Get() * common::Random(randomEngine);
 			auto vecDirection = XMVector3Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(fAngleAdjust));
-			rMainLayout.pf4MediumWavesOne[i].x = XMVectorGetX(vecDirection);
-			rMainLayout.pf4MediumWavesOne[i].y = XMVectorGetY(vecDirection);
+			rWaterWaves.pf4MediumWavesOne[i].x = XMVectorGetX(vecDirection);
+			rWaterWaves.pf4MediumWavesOne[i].y = XMVectorGetY(vecDirection);
 
 			float fWavelengthAdjust = -gMediumWavelengthAdjust.Get() + 2.0f * gMediumWavelengthAdjust.Get() * common::Random(randomEngine);
 			float fAmplitudeAdjust = -gMediumAmplitudeAdjust.Get() + 2.0f * gMediumAmplitudeAdjust.Get() * common::Random(randomEngine);
 			float fSpeedAdjust = -gMediumSpeedAdjust.Get() + 2.0f * gMediumSpeedAdjust.Get() * common::Random(randomEngine);
-			rMainLayout.pf4MediumWavesTwo[i].x = std::abs((2.0f * XM_PI) / (gMediumWavelength.Get() + fWavelengthAdjust * gMediumWavelength.Get())); // Omega
-			rMainLayout.pf4MediumWavesTwo[i].y = std::abs(gMediumAmplitude.Get() + fAmplitudeAdjust * gMediumAmplitude.Get());
-			rMainLayout.pf4MediumWavesTwo[i].y = std::min(rMainLayout.pf4MediumWavesTwo[i].y, 0.1f * (1.0f / rMainLayout.pf4MediumWavesTwo[i].x));
-			rMainLayout.pf4MediumWavesTwo[i].z = (gMediumSpeed.Get() + fSpeedAdjust * gMediumSpeed.Get()) * rMainLayout.pf4MediumWavesTwo[i].x; // Phi
-			rMainLayout.pf4MediumWavesTwo[i].w = 0.0f; // gMediumSteepness.Get();
+			rWaterWaves.pf4MediumWavesTwo[i].x = std::abs((2.0f * XM_PI) / (gMediumWavelength.Get() + fWavelengthAdjust * gMediumWavelength.Get())); // Omega
+			rWaterWaves.pf4MediumWavesTwo[i].y = std::abs(gMediumAmplitude.Get() + fAmplitudeAdjust * gMediumAmplitude.Get());
+			rWaterWaves.pf4MediumWavesTwo[i].y = std::min(rWaterWaves.pf4MediumWavesTwo[i].y, 0.1f * (1.0f / rWaterWaves.pf4MediumWavesTwo[i].x));
+			rWaterWaves.pf4MediumWavesTwo[i].z = (gMediumSpeed.Get() + fSpeedAdjust * gMediumSpeed.Get()) * rWaterWaves.pf4MediumWavesTwo[i].x; // Phi
+			rWaterWaves.pf4MediumWavesTwo[i].w = 0.0f; // gMediumSteepness.Get();
+		}
+	}
+}
+
+void RenderFrameMain(int64_t iCommandBuffer, const game::Frame& __restrict rFrame)
+{
+	RenderLightingMain(iCommandBuffer, rFrame);
+	RenderSmokeMain(iCommandBuffer, rFrame);
+	RenderMainList(iCommandBuffer, rFrame, UPDATE_LIST);
+
+	shaders::MainLayout& rMainLayout = *reinterpret_cast<shaders::MainLayout*>(&gpBufferManager->mMainLayoutUniformBuffers.at(iCommandBuffer).mpMappedMemory[0]);
+
+	// Camera shake
+	float fCameraShake = std::pow(rFrame.camera.fCameraShake, 1.0f);
+	constexpr float kfMaxRoll = 0.005f;
+	constexpr float kfMaxPitch = 0.005f;
+	constexpr float kfMaxYaw = 0.01f;
+	siv::BasicPerlinNoise<float> perlinRoll {0};
+	siv::BasicPerlinNoise<float> perlinPitch {1};
+	siv::BasicPerlinNoise<float> perlinYaw {2};
+	auto matCameraShake = XMMatrixRotationRollPitchYaw(kfMaxRoll  * fCameraShake * (-1.0f + 2.0f * perlinRoll.octave1D_01(8.0f * rFrame.fCurrentTime, 4)),
+	                                                   kfMaxPitch * fCameraShake * (-1.0f + 2.0f * perlinPitch.octave1D_01(8.0f * rFrame.fCurrentTime, 4)),
+	                                                   kfMaxYaw   * fCameraShake * (-1.0f + 2.0f * perlinYaw.octave1D_01(8.0f * rFrame.fCurrentTime, 4)));
+
+	XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(&rMainLayout.f4x4ViewProjection[0]), XMMatrixTranspose(XMMatrixMultiply(gMatView, XMMatrixMultiply(matCameraShake, gMatPerspective))));
+
+	XMStoreFloat4(&rMainLayout.f4EyePosition, rFrame.camera.vecEyePosition);
+	XMStoreFloat4(&rMainLayout.f4ToEyeNormal, rFrame.camera.vecToEyeNormal);
+
+	// Water waves only depend on their tuning variables, regenerate them when those change and copy them only into uniform buffers that are out of date
+	{
+		SCOPED_CPU_PROFILE(kCpuTimerWaterWaves);
+
+		static WaterWaves sWaterWaves {};
+		static common::crc_t sWaterWavesCrc = 0;
+
+		common::crc_t waterWavesCrc = WaterWavesCrc();
+		if (waterWavesCrc != sWaterWavesCrc) [[unlikely]]
+		{
+			GenerateWaterWaves(sWaterWaves);
+			sWaterWavesCrc = waterWavesCrc;
+		}
+
+		common::crc_t& rBufferWaterWavesCrc = gpBufferManager->mMainLayoutWaterWavesCrcs.at(iCommandBuffer);
+		if (rBufferWaterWavesCrc != waterWavesCrc) [[unlikely]]
+		{
+			memcpy(&rMainLayout.pf4LowWavesOne[0], &sWaterWaves.pf4LowWavesOne[0], sizeof(sWaterWaves.pf4LowWavesOne));
+			memcpy(&rMainLayout.pf4LowWavesTwo[0], &sWaterWaves.pf4LowWavesTwo[0], sizeof(sWaterWaves.pf4LowWavesTwo));
+			memcpy(&rMainLayout.pf4MediumWavesOne[0], &sWaterWaves.pf4MediumWavesOne[0], sizeof(sWaterWaves.pf4MediumWavesOne));
+			memcpy(&rMainLayout.pf4MediumWavesTwo[0], &sWaterWaves.pf4MediumWavesTwo[0], sizeof(sWaterWaves.pf4MediumWavesTwo));
+			rBufferWaterWavesCrc = waterWavesCrc;
 		}
 	}
 
@@ -578,6 +641,55 @@ void CalculateMatricesAndVisibleArea(const game::Frame& __restrict rFrame, bool
 	gf4RenderVisibleArea.w = gf4RenderVisibleArea.y - fQuadsY * gf2VisibleAreaQuadSize.y;
 }
 
+void XM_CALLCONV BaseHeightPositions(XMVECTOR* pVecBasePositions, const XMVECTOR* pVecPositions, int64_t iCount, FXMVECTOR vecEyePosition, float fBaseHeight)
+{
+	static constexpr int64_t kiBatchSize = 64;
+
+	auto vecBaseHeight = XMVectorReplicate(fBaseHeight);
+	auto vecEyeX = XMVectorSplatX(vecEyePosition);
+	auto vecEyeY = XMVectorSplatY(vecEyePosition);
+	auto vecEyeZ = XMVectorSplatZ(vecEyePosition);
+	auto vecEyeW = XMVectorSplatW(vecEyePosition);
+
+	alignas(16) float pfElevations[kiBatchSize] {};
+	for (int64_t iBatch = 0; iBatch < iCount; iBatch += kiBatchSize)
+	{
+		int64_t iBatchCount = std::min(kiBatchSize, iCount - iBatch);
+		const XMVECTOR* pVecBatchPositions = pVecPositions + iBatch;
+		XMVECTOR* pVecBatchBasePositions = pVecBasePositions + iBatch;
+		gpIslands->GlobalElevations(pfElevations, pVecBatchPositions, iBatchCount);
+
+		// Intersect the lines to the eye with the planes z = max(elevation, base height) four at a time
+		int64_t i = 0;
+		for (; i + 4 <= iBatchCount; i += 4)
+		{
+			auto matPositions = XMMatrixTranspose(XMMATRIX(pVecBatchPositions[i], pVecBatchPositions[i + 1], pVecBatchPositions[i + 2], pVecBatchPositions[i + 3]));
+			auto vecHeights = XMVectorMax(XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(&pfElevations[i])), vecBaseHeight);
+			auto vecDistanceZ = XMVectorSubtract(vecEyeZ, matPositions.r[2]);
+			auto vecT = XMVectorDivide(XMVectorSubtract(vecHeights, matPositions.r[2]), vecDistanceZ);
+
+			// Same as XMPlaneIntersectLine(), a line parallel to the plane has no intersection and gives NaN in every component
+			auto vecParallel = XMVectorNearEqual(vecDistanceZ, XMVectorZero(), g_XMEpsilon);
+
+			matPositions.r[0] = XMVectorSelect(XMVectorMultiplyAdd(vecT, XMVectorSubtract(vecEyeX, matPositions.r[0]), matPositions.r[0]), g_XMQNaN, vecParallel);
+			matPositions.r[1] = XMVectorSelect(XMVectorMultiplyAdd(vecT, XMVectorSubtract(vecEyeY, matPositions.r[1]), matPositions.r[1]), g_XMQNaN, vecParallel);
+			matPositions.r[2] = XMVectorSelect(vecHeights, g_XMQNaN, vecParallel);
+			matPositions.r[3] = XMVectorSelect(XMVectorMultiplyAdd(vecT, XMVectorSubtract(vecEyeW, matPositions.r[3]), matPositions.r[3]), g_XMQNaN, vecParallel);
+
+			matPositions = XMMatrixTranspose(matPositions);
+			pVecBatchBasePositions[i] = matPositions.r[0];
+			pVecBatchBasePositions[i + 1] = matPositions.r[1];
+			pVecBatchBasePositions[i + 2] = matPositions.r[2];
+			pVecBatchBasePositions[i + 3] = matPositions.r[3];
+		}
+
+		for (; i < iBatchCount; ++i)
+		{
+			pVecBatchBasePositions[i] = common::ToBaseHeight(pVecBatchPositions[i], vecEyePosition, std::max(pfElevations[i], fBaseHeight));
+		}
+	}
+}
+
 void XM_CALLCONV RenderObjects(shaders::ObjectLayout* pLayouts, int64_t iCommandBuffer, int64_t iCount, const XMVECTOR* pVecPositions, const XMVECTOR* pVecDirections, FXMMATRIX matScale, CXMMATRIX matRotation, [[maybe_unused]] CpuCounters eCounter, Pipelines ePipeline, Pipelines ePipelineShadow)
 {
 	PROFILE_SET_COUNT(eCounter, iCount);
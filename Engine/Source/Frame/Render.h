@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Frame/FrameBase.h"
 #include "Graphics/Managers/PipelineManager.h"
 
 namespace game
@@ -21,8 +22,35 @@ void RenderFrameMain(int64_t iCommandBuffer, const game::Frame& __restrict rFram
 
 DirectX::XMVECTOR XM_CALLCONV ScreenToWorld(DirectX::FXMVECTOR vecScreenPos, float fHeight);
 void CalculateMatricesAndVisibleArea(const game::Frame& __restrict rFrame, bool bWriteVisibleArea);
+// Batched Islands::GlobalElevation() and common::ToBaseHeight(), pVecBasePositions may be the same array as pVecPositions
+void XM_CALLCONV BaseHeightPositions(DirectX::XMVECTOR* pVecBasePositions, const DirectX::XMVECTOR* pVecPositions, int64_t iCount, DirectX::FXMVECTOR vecEyePosition, float fBaseHeight);
 void XM_CALLCONV RenderObjects(shaders::ObjectLayout* pLayouts, int64_t iCommandBuffer, int64_t iCount, const DirectX::XMVECTOR* pVecPositions, const DirectX::XMVECTOR* pVecDirections, DirectX::FXMMATRIX matScale, DirectX::CXMMATRIX matRotation, CpuCounters eCounter, Pipelines ePipeline, Pipelines ePipelineShadow = kPipelineCount);
 
+// Splits [0, iCount) into ranges of at least BUCKET_SIZE and runs function(iBucket, iStart, iEnd) on each through gpWorkerPool, the calling thread takes some of them
+// piStarts needs MAX_BUCKETS + 1 entries and receives the range boundaries, returns the bucket count
+template<int64_t BUCKET_SIZE, int64_t MAX_BUCKETS, typename T>
+int64_t RenderBuckets(int64_t* piStarts, int64_t iCount, const T& rFunction)
+{
+	int64_t iBuckets = std::clamp(iCount / BUCKET_SIZE, 1ll, std::min(giBackgroundThreadCount + 1, MAX_BUCKETS));
+	for (int64_t i = 0; i <= iBuckets; ++i)
+	{
+		piStarts[i] = (iCount * i) / iBuckets;
+	}
+
+	if (iBuckets == 1)
+	{
+		rFunction(0ll, piStarts[0], piStarts[1]);
+		return iBuckets;
+	}
+
+	gpWorkerPool->Run(iBuckets, [&rFunction, piStarts](int64_t i)
+	{
+		rFunction(i, piStarts[i], piStarts[i + 1]);
+	});
+
+	return iBuckets;
+}
+
 inline DirectX::XMMATRIX gMatView {};
 inline DirectX::XMMATRIX gMatPerspective {};
 
@@ -0,0 +1,88 @@
+#pragma once
+
+namespace engine
+{
+
+// Turns real elapsed time into whole fixed steps, whatever is left over is carried to the next call and used for interpolation
+// Holds no window or GPU state so the step accounting can be driven by hand, tick costs are passed in so a fake clock can drive the budget too
+class TickScheduler
+{
+public:
+
+	TickScheduler(std::chrono::nanoseconds stepNs, int64_t iMaxOwedTicks) noexcept
+	: mStepNs(stepNs)
+	, miMaxOwedTicks(iMaxOwedTicks)
+	{
+	}
+
+	int64_t Advance(std::chrono::nanoseconds realDeltaNs, int64_t iTimeMultiply, int64_t iTimeDivide) noexcept
+	{
+		mRemainderNs += (realDeltaNs * iTimeMultiply) / iTimeDivide;
+
+		int64_t iTicks = mRemainderNs / mStepNs;
+		mRemainderNs -= iTicks * mStepNs;
+
+		return iTicks;
+	}
+
+	int64_t SingleStep() noexcept
+	{
+		mRemainderNs = 0ns;
+		miOwedTicks = 0;
+		return 1;
+	}
+
+	// Adds the due ticks to the ones still owed and returns how many of them fit in budgetNs at the average tick cost, the rest are owed to the next frames
+	// iTicksInFlight are ticks handed to the simulation thread that it hasn't finished yet, they use up budget and count against miMaxOwedTicks
+	// At least one tick is always returned while any are owed and none are in flight so the simulation keeps moving, anything past miMaxOwedTicks is dropped and counted in miDroppedTicks
+	int64_t Budget(int64_t iDueTicks, std::chrono::nanoseconds budgetNs, int64_t iTicksInFlight = 0) noexcept
+	{
+		int64_t iOwedTicks = miOwedTicks + iDueTicks;
+		miOwedTicks = std::min(iOwedTicks, std::max<int64_t>(miMaxOwedTicks - iTicksInFlight, 0));
+		miDroppedTicks += iOwedTicks - miOwedTicks;
+		if (miOwedTicks == 0)
+		{
+			return 0;
+		}
+
+		int64_t iTicks = miOwedTicks;
+		if (mTickCostNs > 0ns)
+		{
+			iTicks = std::clamp<int64_t>(budgetNs / mTickCostNs - iTicksInFlight, iTicksInFlight > 0 ? 0 : 1, miOwedTicks);
+		}
+		miOwedTicks -= iTicks;
+
+		return iTicks;
+	}
+
+	// How far past the newest tick to render, ticks still owed are left out since the render would extrapolate past where the simulation is
+	std::chrono::nanoseconds Interpolation() const noexcept
+	{
+		return std::min(mRemainderNs, mStepNs - 1ns);
+	}
+
+	// Where Advance() and Budget() would leave the render after realDeltaNs, past the current tick, without changing anything
+	std::chrono::nanoseconds Estimate(std::chrono::nanoseconds realDeltaNs, int64_t iTimeMultiply, int64_t iTimeDivide, std::chrono::nanoseconds budgetNs) const noexcept
+	{
+		TickScheduler tickScheduler = *this;
+		int64_t iTicks = tickScheduler.Budget(tickScheduler.Advance(realDeltaNs, iTimeMultiply, iTimeDivide), budgetNs);
+		return iTicks * mStepNs + tickScheduler.Interpolation();
+	}
+
+	void MeasureTick(std::chrono::nanoseconds tickNs) noexcept
+	{
+		// Exponential moving average, a single slow tick only moves it by 1 / kiTickCostSmoothing
+		static constexpr int64_t kiTickCostSmoothing = 8;
+		mTickCostNs = mTickCostNs == 0ns ? tickNs : mTickCostNs + (tickNs - mTickCostNs) / kiTickCostSmoothing;
+	}
+
+	std::chrono::nanoseconds mStepNs;
+	std::chrono::nanoseconds mRemainderNs = 0ns;
+
+	int64_t miMaxOwedTicks = 0;
+	int64_t miOwedTicks = 0;
+	int64_t miDroppedTicks = 0;
+	std::chrono::nanoseconds mTickCostNs = 0ns;
+};
+
+} // namespace engine
@@ -12,6 +12,195 @@ struct FrameInputHeld;
 namespace engine
 {
 
+// Parts of the frame an update phase reads or writes, the game adds its own members starting at kAccessGameFirst
+enum FrameAccess : uint64_t
+{
+	kAccessNone        = 0,
+
+	kAccessGlobal      = 1ull << 0,
+	kAccessRandom      = 1ull << 1,
+	kAccessNavmesh     = 1ull << 2,
+	kAccessAreas       = 1ull << 3,
+	kAccessAreaLights  = 1ull << 4,
+	kAccessBillboards  = 1ull << 5,
+	kAccessExplosions  = 1ull << 6,
+	kAccessHexShields  = 1ull << 7,
+	kAccessPointLights = 1ull << 8,
+	kAccessPuffs       = 1ull << 9,
+	kAccessPullers     = 1ull << 10,
+	kAccessPushers     = 1ull << 11,
+	kAccessSounds      = 1ull << 12,
+	kAccessSplashes    = 1ull << 13,
+	kAccessTargets     = 1ull << 14,
+	kAccessTrails      = 1ull << 15,
+
+	kAccessGameFirst   = 1ull << 32,
+	kAccessAll         = ~0ull,
+
+	// Explosions::Add() also adds the explosion's lights, smoke, pusher and trails
+	kAccessSpawnExplosions = kAccessExplosions | kAccessPointLights | kAccessPuffs | kAccessPushers | kAccessTrails,
+};
+
+struct PhaseAccess
+{
+	uint64_t uiReads = kAccessNone;
+	uint64_t uiWrites = kAccessNone;
+
+	// Worth a thread of its own when it shares a level with other work, cheap phases always run on the calling thread
+	bool bConcurrent = false;
+
+	constexpr bool ConflictsWith(const PhaseAccess& rOther) const
+	{
+		return (uiWrites & (rOther.uiReads | rOther.uiWrites)) != 0 || (rOther.uiWrites & uiReads) != 0;
+	}
+};
+
+template<typename FRAME, typename INPUT>
+using phase_function_t = void (*)(FRAME& __restrict, const FRAME& __restrict, const INPUT& __restrict, float);
+
+// An entry's level is one past the deepest earlier entry it conflicts with, so entries sharing a level are independent
+// and running the levels in order keeps every conflicting pair in UPDATE_LIST order, which makes the result identical to running serially
+template<size_t COUNT>
+constexpr std::array<int64_t, COUNT> UpdateListLevels(const std::array<PhaseAccess, COUNT>& rAccesses)
+{
+	std::array<int64_t, COUNT> levels {};
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		for (size_t j = 0; j < i; ++j)
+		{
+			if (rAccesses[j].ConflictsWith(rAccesses[i]))
+			{
+				levels[i] = std::max(levels[i], levels[j] + 1);
+			}
+		}
+	}
+
+	return levels;
+}
+
+// One hash per FrameAccess bit, FRAME::HashAccess(rFrame, uiAccess, rHashes) fills the slots of the bits in uiAccess from the members they cover
+using access_hashes_t = std::array<uint64_t, 64>;
+
+// Bytes rather than operator== so a NaN that is carried along unchanged doesn't count as a write
+// Every step is a bijection of the running hash, so a member that changed in one place always hashes differently
+template<typename T>
+uint64_t HashBytes(const T& rValue, uint64_t uiHash)
+{
+	static constexpr uint64_t kuiPrime = 0x100000001b3;
+
+	const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(&rValue);
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= sizeof(T); i += sizeof(uint64_t))
+	{
+		uint64_t uiWord = 0;
+		memcpy(&uiWord, pBytes + i, sizeof(uint64_t));
+		uiHash = (uiHash ^ uiWord) * kuiPrime;
+	}
+	for (; i < sizeof(T); ++i)
+	{
+		uiHash = (uiHash ^ pBytes[i]) * kuiPrime;
+	}
+	return uiHash;
+}
+
+// Adds rMember to the slot of uiBit, members whose bit isn't in uiAccess are skipped so only what a phase must not write gets hashed
+template<typename T>
+void HashMember(access_hashes_t& rHashes, uint64_t uiAccess, uint64_t uiBit, const T& rMember)
+{
+	if ((uiAccess & uiBit) != 0)
+	{
+		uint64_t& ruiHash = rHashes[std::countr_zero(uiBit)];
+		ruiHash = HashBytes(rMember, ruiHash);
+	}
+}
+
+// Runs the entries one at a time in level order and ASSERTs that each one only changed what its kAccess declares
+// The members outside an entry's writes are hashed before and after it instead of copying the frame, undeclared reads can't be seen this way
+template<typename FRAME, typename INPUT, size_t COUNT>
+void RunUpdateListLevelsChecked(FRAME& __restrict rFrame, const FRAME& __restrict rPreviousFrame, const INPUT& __restrict rFrameInput, float fDeltaTime, const std::array<phase_function_t<FRAME, INPUT>, COUNT>& rpFunctions, const std::array<PhaseAccess, COUNT>& rAccesses, const std::array<int64_t, COUNT>& rLevels)
+{
+	int64_t iLevelCount = *std::max_element(rLevels.begin(), rLevels.end()) + 1;
+	for (int64_t iLevel = 0; iLevel < iLevelCount; ++iLevel)
+	{
+		for (size_t i = 0; i < COUNT; ++i)
+		{
+			if (rLevels[i] != iLevel)
+			{
+				continue;
+			}
+
+			uint64_t uiUnwritten = ~rAccesses[i].uiWrites;
+			access_hashes_t before {};
+			FRAME::HashAccess(rFrame, uiUnwritten, before);
+			rpFunctions[i](rFrame, rPreviousFrame, rFrameInput, fDeltaTime);
+			access_hashes_t after {};
+			FRAME::HashAccess(rFrame, uiUnwritten, after);
+
+			uint64_t uiUndeclared = kAccessNone;
+			for (size_t j = 0; j < before.size(); ++j)
+			{
+				uiUndeclared |= before[j] != after[j] ? 1ull << j : 0ull;
+			}
+			ASSERT(uiUndeclared == kAccessNone);
+		}
+	}
+}
+
+// Debug builds go through RunUpdateListLevelsChecked() instead, which runs everything on the calling thread
+// Without a pool every level runs on the calling thread too
+template<typename FRAME, typename INPUT, size_t COUNT>
+void RunUpdateListLevels(FRAME& __restrict rFrame, const FRAME& __restrict rPreviousFrame, const INPUT& __restrict rFrameInput, float fDeltaTime, const std::array<phase_function_t<FRAME, INPUT>, COUNT>& rpFunctions, const std::array<PhaseAccess, COUNT>& rAccesses, const std::array<int64_t, COUNT>& rLevels, [[maybe_unused]] common::WorkerPool* pWorkerPool)
+{
+#if defined(BT_DEBUG)
+	RunUpdateListLevelsChecked(rFrame, rPreviousFrame, rFrameInput, fDeltaTime, rpFunctions, rAccesses, rLevels);
+#else
+	int64_t iLevelCount = *std::max_element(rLevels.begin(), rLevels.end()) + 1;
+	for (int64_t iLevel = 0; iLevel < iLevelCount; ++iLevel)
+	{
+		size_t puiConcurrent[COUNT] {};
+		int64_t iConcurrent = 0;
+		for (size_t i = 0; i < COUNT; ++i)
+		{
+			if (rLevels[i] == iLevel && rAccesses[i].bConcurrent)
+			{
+				puiConcurrent[iConcurrent] = i;
+				++iConcurrent;
+			}
+		}
+
+		if (iConcurrent < 2 || pWorkerPool == nullptr)
+		{
+			for (size_t i = 0; i < COUNT; ++i)
+			{
+				if (rLevels[i] == iLevel)
+				{
+					rpFunctions[i](rFrame, rPreviousFrame, rFrameInput, fDeltaTime);
+				}
+			}
+			continue;
+		}
+
+		// Every concurrent entry is a job, the last job runs the cheap entries one after the other
+		pWorkerPool->Run(iConcurrent + 1, [&](int64_t iJob)
+		{
+			if (iJob < iConcurrent)
+			{
+				rpFunctions[puiConcurrent[iJob]](rFrame, rPreviousFrame, rFrameInput, fDeltaTime);
+				return;
+			}
+
+			for (size_t i = 0; i < COUNT; ++i)
+			{
+				if (rLevels[i] == iLevel && !rAccesses[i].bConcurrent)
+				{
+					rpFunctions[i](rFrame, rPreviousFrame, rFrameInput, fDeltaTime);
+				}
+			}
+		});
+	}
+#endif
+}
+
 struct UpdateList
 {
 	// Update
@@ -22,6 +211,12 @@ struct UpdateList
 	static void Spawn(game::Frame& __restrict, const game::Frame& __restrict, const game::FrameInput& __restrict, float) {};
 	static void Destroy(game::Frame& __restrict, const game::Frame& __restrict, const game::FrameInput& __restrict, float) {};
 
+	// Everything in UPDATE_LIST declares what its PostRender, Collide, Spawn and Destroy touch, phases that don't conflict run concurrently
+	static constexpr PhaseAccess kPostRenderAccess {};
+	static constexpr PhaseAccess kCollideAccess {};
+	static constexpr PhaseAccess kSpawnAccess {};
+	static constexpr PhaseAccess kDestroyAccess {};
+
 	// Render
 	static void RenderGlobal(int64_t, const game::Frame& __restrict) {};
 	static void RenderMain(int64_t, const game::Frame& __restrict) {};
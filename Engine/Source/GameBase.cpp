@@ -2,6 +2,7 @@
 
 #include "Audio/AudioManager.h"
 #include "Graphics/Graphics.h"
+#include "Graphics/Islands.h"
 
 #include "Frame/Frame.h"
 #include "Input/Input.h"
@@ -11,7 +12,19 @@ namespace engine
 
 using enum MenuFlags;
 
+// Never let the simulation fall further behind than it can catch up on, the excess real time is dropped instead of slowing down time
+// With the simulation thread the ticks it hasn't finished yet count as behind too
+static constexpr int64_t kiMaxTicksBehind = 25;
+
+// Part of a monitor refresh that catch up ticks may use
+static std::chrono::nanoseconds TickBudget()
+{
+	std::chrono::nanoseconds monitorRefreshTimeNs = 1'000'000'000ns / gpGraphics->miMonitorRefreshRate;
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(monitorRefreshTimeNs * gTickBudget.Get());
+}
+
 GameBase::GameBase()
+: mTickScheduler(kUpdateStepNs, kiMaxTicksBehind)
 {
 }
 
@@ -23,6 +36,8 @@ void GameBase::ResetRealTime()
 
 void GameBase::PreInputUpdate()
 {
+	ApplyIslandsFlip();
+
 	if (!ShouldUpdateFrame()) [[unlikely]]
 	{
 		gpGraphics->RenderGlobal(CurrentFrame());
@@ -31,10 +46,22 @@ void GameBase::PreInputUpdate()
 
 	// Estimate elapsed time (will be used to position visible area)
 	std::chrono::nanoseconds realDeltaNs = mRealTime.GetDeltaNs(false);
-	std::chrono::nanoseconds estimatedDeltaNs = mUpdateRemainderNs + (realDeltaNs * miTimeMultiply) / miTimeDivide;
+	std::chrono::nanoseconds estimatedDeltaNs = mTickScheduler.Estimate(realDeltaNs, miTimeMultiply, miTimeDivide, TickBudget());
+	const game::Frame* pFrom = &CurrentFrame();
+
+#if defined(ENABLE_SIMULATION_THREAD)
+	if (mpSimulationThread != nullptr)
+	{
+		// Same frames as the main render, which stays between the last two published ones
+		mpSimulationThread->Acquire();
+		int64_t iTicks = mpSimulationThread->TicksSincePrevious();
+		estimatedDeltaNs = iTicks * std::min(mTickScheduler.mRemainderNs + (realDeltaNs * miTimeMultiply) / miTimeDivide, kUpdateStepNs - 1ns);
+		pFrom = iTicks > 0 ? &mpSimulationThread->Previous() : &CurrentFrame();
+	}
+#endif
 
 	// Use global frame as a temporary frame to estimate visible area position, then use that to start global render
-	UpdateFrameBase(NextFrame(), CurrentFrame(), game::FrameInput(), common::NanosecondsToFloatSeconds<float>(estimatedDeltaNs), FrameType::kGlobal);
+	UpdateFrameBase(NextFrame(), *pFrom, game::FrameInput(), common::NanosecondsToFloatSeconds<float>(estimatedDeltaNs), FrameType::kGlobal);
 	gpGraphics->RenderGlobal(NextFrame());
 }
 
@@ -63,44 +90,54 @@ bool GameBase::Update(bool bSingleStep, bool bLostFocus, game::FrameInput& rFram
 	}
 	mAverageDelta = fDelta;
 
-	if (bSingleStep || bLostFocus) [[unlikely]]
+	int64_t iUpdates = bSingleStep || bLostFocus ? mTickScheduler.SingleStep() : mTickScheduler.Advance(realDeltaNs, miTimeMultiply, miTimeDivide);
+	int64_t iDroppedTicks = mTickScheduler.miDroppedTicks;
+
+	// Only run as many ticks as fit in the budget, the rest are spread over the next frames and the game is back to real time once they are done
+	std::chrono::nanoseconds budgetNs = TickBudget();
+
+#if defined(ENABLE_SIMULATION_THREAD)
+	if (mpSimulationThread == nullptr) [[unlikely]]
 	{
-		mUpdateRemainderNs = kUpdateStepNs;
+		mpSimulationThread = std::make_unique<SimulationThread>(*this, std::move(mpCurrentFrame));
 	}
-	else [[likely]]
+
+	if (mpSimulationThread->mbReplayEnded) [[unlikely]]
 	{
-		mUpdateRemainderNs += (realDeltaNs * miTimeMultiply) / miTimeDivide;
+		mpSimulationThread->Synchronize();
+		mpSimulationThread->mbReplayEnded = false;
+		EndReplay(rFrameInput);
 	}
 
-	int64_t iUpdates = 0;
-	while (mUpdateRemainderNs >= kUpdateStepNs)
+	// The ticks the simulation thread is still working on use up part of the budget
+	std::chrono::nanoseconds tickCostNs = mpSimulationThread->TakeAverageTickCost();
+	if (tickCostNs > 0ns)
 	{
-		mUpdateRemainderNs -= kUpdateStepNs;
-		++iUpdates;
+		mTickScheduler.MeasureTick(tickCostNs);
 	}
+	iUpdates = mTickScheduler.Budget(iUpdates, budgetNs, mpSimulationThread->TicksBehind());
 
-	common::Timer updateTimer;
-	for (int64_t i = 0; i < iUpdates; ++i)
+	if (iUpdates > 0)
 	{
-		if (mpDifferenceStreamWriter != nullptr) [[unlikely]]
+		mpSimulationThread->Submit(iUpdates, rFrameInput);
+		rFrameInput.pressedFlags.ClearAll();
+
+	#if defined(ENABLE_PROFILING)
+		for (int64_t i = 0; i < iUpdates; ++i)
 		{
-			mpDifferenceStreamWriter->Update(CurrentFrame().iFrame, rFrameInput);
+			gpProfileManager->mUpdatesInTheLastSecond.Set();
 		}
+	#endif
+	}
 
-		if (mpDifferenceStreamReader != nullptr && !mpDifferenceStreamReader->Update(CurrentFrame().iFrame, rFrameInput)) [[unlikely]]
+	mpSimulationThread->Acquire();
+#else
+	iUpdates = mTickScheduler.Budget(iUpdates, budgetNs);
+	for (int64_t i = 0; i < iUpdates; ++i)
+	{
+		common::Timer tickTimer;
+		if (!RecordOrReplay(CurrentFrame(), rFrameInput)) [[unlikely]]
 		{
-			LOG("End replay at {}", CurrentFrame().iFrame);
-
-			if constexpr (common::kbVerifyFrame)
-			{
-				bool bEqual = CurrentFrame() == mpDifferenceStreamReader->mHeader.savedEnd;
-				if (!bEqual && CurrentFrame().player != mpDifferenceStreamReader->mHeader.savedEnd.player)
-				{
-					DEBUG_BREAK();
-				}
-				common::BreakOnNotEqual(bEqual);
-			}
-
 			EndReplay(rFrameInput);
 		}
 
@@ -111,28 +148,85 @@ bool GameBase::Update(bool bSingleStep, bool bLostFocus, game::FrameInput& rFram
 		rFrameInput.pressedFlags.ClearAll();
 		std::swap(mpCurrentFrame, mpNextFrame);
 
-		std::chrono::nanoseconds monitorRefreshTimeNs = 1'000'000'000ns / gpGraphics->miMonitorRefreshRate;
-		if (updateTimer.GetDeltaNs() > monitorRefreshTimeNs)
+		mTickScheduler.MeasureTick(tickTimer.GetDeltaNs());
+	}
+#endif
+
+	if (mTickScheduler.miDroppedTicks > iDroppedTicks) [[unlikely]]
+	{
+		LOG("Dropped {} ticks, {} in total", mTickScheduler.miDroppedTicks - iDroppedTicks, mTickScheduler.miDroppedTicks);
+	}
+
+	// Restart() or a loaded frame may have changed the flip since PreInputUpdate()
+	ApplyIslandsFlip();
+
+	std::chrono::nanoseconds interpolateNs = mTickScheduler.Interpolation();
+	const game::Frame* pFrom = &CurrentFrame();
+
+#if defined(ENABLE_SIMULATION_THREAD)
+	// Never wait for the simulation thread, render a tick late between the last two published frames instead of extrapolating past the newest one
+	// More than one tick between them spreads the remainder over all of them, no published frame means there is nothing to move towards
+	int64_t iTicks = mpSimulationThread->TicksSincePrevious();
+	interpolateNs = iTicks * mTickScheduler.mRemainderNs;
+	pFrom = iTicks > 0 ? &mpSimulationThread->Previous() : &CurrentFrame();
+#endif
+
+	// Use temporary frame, interpolate positions and rotations for render
+	UpdateFrameBase(NextFrame(), *pFrom, rFrameInput, common::NanosecondsToFloatSeconds<float>(interpolateNs), FrameType::kMain);
+	gpGraphics->RenderMainImagePresentAcquire(NextFrame());
+
+	return true;
+}
+
+bool GameBase::RecordOrReplay(const game::Frame& rFrame, game::FrameInput& rFrameInput)
+{
+	if (mpDifferenceStreamWriter != nullptr) [[unlikely]]
+	{
+		mpDifferenceStreamWriter->Update(rFrame.iFrame, rFrameInput);
+	}
+
+	if (mpDifferenceStreamReader != nullptr && !mpDifferenceStreamReader->Update(rFrame.iFrame, rFrameInput)) [[unlikely]]
+	{
+		LOG("End replay at {}", rFrame.iFrame);
+
+		if constexpr (common::kbVerifyFrame)
 		{
-			// Slow down simulation if it means simulation will cause us to miss VSync
-			LOG("Slowing down simulation, deltaNs: {} ({}) iUpdates: {}", updateTimer.GetDeltaNs(), monitorRefreshTimeNs, iUpdates);
-			if (miTimeMultiply > 1)
+			bool bEqual = rFrame == mpDifferenceStreamReader->mHeader.savedEnd;
+			if (!bEqual && rFrame.player != mpDifferenceStreamReader->mHeader.savedEnd.player)
 			{
-				miTimeMultiply /= 2;
-				LOG("Time ratio: {}x", miTimeMultiply);
-				gpTextManager->UpdateTextArea(kTextDebug, std::string("Time ratio: ") + std::to_string(miTimeMultiply) + "x");
+				DEBUG_BREAK();
 			}
-			mUpdateRemainderNs = 0ns;
-			gpGraphics->RenderMainImagePresentAcquire(CurrentFrame());
-			return true;
+			common::BreakOnNotEqual(bEqual);
 		}
-	}
 
-	// Use temporary frame, interpolate positions and rotations for render
-	UpdateFrameBase(NextFrame(), CurrentFrame(), rFrameInput, common::NanosecondsToFloatSeconds<float>(mUpdateRemainderNs), FrameType::kMain);
-	gpGraphics->RenderMainImagePresentAcquire(NextFrame());
+		return false;
+	}
 
 	return true;
 }
 
+void GameBase::ApplyIslandsFlip()
+{
+	IslandsFlip eIslandsFlip = CurrentFrame().eIslandsFlip;
+	if (eIslandsFlip == gpIslands->meCurrentIslandsFlip) [[likely]]
+	{
+		return;
+	}
+
+	// Ticks only copy the flip of the frame before them, so a new one comes from a frame the main thread wrote and the simulation thread is normally idle already
+	// Waiting anyway keeps any tick from reading the flip tables while they change
+	SynchronizeSimulation();
+	gpIslands->SetIslandsFlip(eIslandsFlip);
+}
+
+void GameBase::SynchronizeSimulation()
+{
+#if defined(ENABLE_SIMULATION_THREAD)
+	if (mpSimulationThread != nullptr)
+	{
+		mpSimulationThread->Synchronize();
+	}
+#endif
+}
+
 } // namespace engine
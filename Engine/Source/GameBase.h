@@ -1,6 +1,8 @@
 #pragma once
 
 #include "File/DifferenceStream.h"
+#include "Frame/TickScheduler.h"
+#include "SimulationThread.h"
 
 namespace game
 {
@@ -38,8 +40,23 @@ public:
 	void PreInputUpdate();
 	bool Update(bool bSingleStep, bool bLostFocus, game::FrameInput& rFrameInput);
 
+	// Called before every kFull tick with the frame it will be based on, returns false when a replay has run out
+	bool RecordOrReplay(const game::Frame& rFrame, game::FrameInput& rFrameInput);
+
+	// Anything that writes to CurrentFrame() or the difference streams outside of a tick has to call this first
+	void SynchronizeSimulation();
+	// Main thread, applies the islands flip of CurrentFrame() to gpIslands
+	void ApplyIslandsFlip();
+
 	game::Frame& CurrentFrame()
 	{
+	#if defined(ENABLE_SIMULATION_THREAD)
+		if (mpSimulationThread != nullptr)
+		{
+			return mpSimulationThread->Front();
+		}
+	#endif
+
 		return *mpCurrentFrame;
 	}
 
@@ -51,7 +68,7 @@ public:
 	common::Timer mRealTime;
 	int64_t miTimeMultiply = 1;
 	int64_t miTimeDivide = 1;
-	std::chrono::nanoseconds mUpdateRemainderNs = 0ns;
+	TickScheduler mTickScheduler;
 	common::Smoothed<float, 256> mAverageDelta;
 
 	bool mbMainMenuMusic = true;
@@ -65,6 +82,10 @@ protected:
 
 	std::unique_ptr<game::Frame> mpCurrentFrame;
 	std::unique_ptr<game::Frame> mpNextFrame;
+
+#if defined(ENABLE_SIMULATION_THREAD)
+	std::unique_ptr<SimulationThread> mpSimulationThread;
+#endif
 };
 
 } // namespace engine
@@ -0,0 +1,162 @@
+#include "BuddyAllocator.h"
+
+namespace engine
+{
+
+BuddyAllocator::BuddyAllocator(int64_t iSize, int64_t iMinSize)
+: miSize(iSize)
+, miMinSize(iMinSize)
+{
+	ASSERT(std::has_single_bit(static_cast<uint64_t>(miSize)) && std::has_single_bit(static_cast<uint64_t>(miMinSize)) && miMinSize <= miSize);
+
+	miLevelCount = std::countr_zero(static_cast<uint64_t>(miSize / miMinSize)) + 1;
+	ASSERT(miLevelCount <= kuiSlotLevelMask);
+
+	mFreeOffsets.resize(miLevelCount);
+	mSlots.resize(miSize / miMinSize);
+	PushFree(0, 0);
+}
+
+int64_t BuddyAllocator::Allocate(int64_t iSize, int64_t iAlignment)
+{
+	ASSERT(iSize > 0 && std::has_single_bit(static_cast<uint64_t>(iAlignment)));
+
+	int64_t iBlockSize = static_cast<int64_t>(std::bit_ceil(static_cast<uint64_t>(std::max({iSize, iAlignment, miMinSize}))));
+	if (iBlockSize > miSize)
+	{
+		return kiInvalidOffset;
+	}
+	int64_t iLevel = std::countr_zero(static_cast<uint64_t>(miSize / iBlockSize));
+
+	// Smallest free block that fits, then split it down to the wanted level
+	int64_t iFoundLevel = iLevel;
+	while (iFoundLevel >= 0 && mFreeOffsets[iFoundLevel].empty())
+	{
+		--iFoundLevel;
+	}
+	if (iFoundLevel < 0)
+	{
+		return kiInvalidOffset;
+	}
+
+	int64_t iOffset = mFreeOffsets[iFoundLevel].back();
+	RemoveFree(iFoundLevel, iOffset);
+	while (iFoundLevel < iLevel)
+	{
+		++iFoundLevel;
+		PushFree(iFoundLevel, iOffset + LevelSize(iFoundLevel));
+	}
+
+	mSlots[iOffset / miMinSize] = kuiSlotUsed | static_cast<uint8_t>(iLevel);
+	miUsedBytes += iBlockSize;
+	++miAllocationCount;
+
+	return iOffset;
+}
+
+void BuddyAllocator::Free(int64_t iOffset)
+{
+	uint8_t& ruiSlot = mSlots[iOffset / miMinSize];
+	ASSERT(ruiSlot & kuiSlotUsed);
+
+	int64_t iLevel = ruiSlot & kuiSlotLevelMask;
+	ruiSlot = 0;
+	miUsedBytes -= LevelSize(iLevel);
+	--miAllocationCount;
+
+	// Merge with the buddy for as long as it is free and the same size
+	while (iLevel > 0)
+	{
+		int64_t iBuddyOffset = iOffset ^ LevelSize(iLevel);
+		if (mSlots[iBuddyOffset / miMinSize] != (kuiSlotFree | static_cast<uint8_t>(iLevel)))
+		{
+			break;
+		}
+
+		RemoveFree(iLevel, iBuddyOffset);
+		iOffset = std::min(iOffset, iBuddyOffset);
+		--iLevel;
+	}
+
+	PushFree(iLevel, iOffset);
+}
+
+int64_t BuddyAllocator::LargestFree() const
+{
+	for (int64_t i = 0; i < miLevelCount; ++i)
+	{
+		if (!mFreeOffsets[i].empty())
+		{
+			return LevelSize(i);
+		}
+	}
+
+	return 0;
+}
+
+float BuddyAllocator::Fragmentation() const
+{
+	int64_t iFreeBytes = miSize - miUsedBytes;
+	if (iFreeBytes == 0)
+	{
+		return 0.0f;
+	}
+
+	return 1.0f - static_cast<float>(LargestFree()) / static_cast<float>(iFreeBytes);
+}
+
+bool BuddyAllocator::Validate() const
+{
+	int64_t iFreeBytes = 0;
+	for (int64_t i = 0; i < miLevelCount; ++i)
+	{
+		for (int64_t iOffset : mFreeOffsets[i])
+		{
+			if (iOffset % LevelSize(i) != 0 || mSlots[iOffset / miMinSize] != (kuiSlotFree | static_cast<uint8_t>(i)))
+			{
+				return false;
+			}
+
+			// Two free buddies should always have been merged
+			int64_t iBuddyOffset = iOffset ^ LevelSize(i);
+			if (i > 0 && mSlots[iBuddyOffset / miMinSize] == (kuiSlotFree | static_cast<uint8_t>(i)))
+			{
+				return false;
+			}
+
+			iFreeBytes += LevelSize(i);
+		}
+	}
+
+	int64_t iUsedBytes = 0;
+	int64_t iAllocationCount = 0;
+	for (int64_t i = 0; i < static_cast<int64_t>(mSlots.size()); ++i)
+	{
+		if (mSlots[i] & kuiSlotUsed)
+		{
+			iUsedBytes += LevelSize(mSlots[i] & kuiSlotLevelMask);
+			++iAllocationCount;
+		}
+	}
+
+	return iFreeBytes + iUsedBytes == miSize && iUsedBytes == miUsedBytes && iAllocationCount == miAllocationCount;
+}
+
+void BuddyAllocator::PushFree(int64_t iLevel, int64_t iOffset)
+{
+	mFreeOffsets[iLevel].push_back(iOffset);
+	mSlots[iOffset / miMinSize] = kuiSlotFree | static_cast<uint8_t>(iLevel);
+}
+
+void BuddyAllocator::RemoveFree(int64_t iLevel, int64_t iOffset)
+{
+	std::vector<int64_t>& rFreeOffsets = mFreeOffsets[iLevel];
+	auto it = std::find(rFreeOffsets.begin(), rFreeOffsets.end(), iOffset);
+	ASSERT(it != rFreeOffsets.end());
+
+	*it = rFreeOffsets.back();
+	rFreeOffsets.pop_back();
+	mSlots[iOffset / miMinSize] = 0;
+}
+
+} // namespace engine
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace engine
+{
+
+// CPU only buddy allocation policy over an abstract range of miSize bytes, both sizes must be powers of two
+// Offsets of an allocation are aligned to its rounded up size, so any power of two alignment up to that size comes for free
+class BuddyAllocator
+{
+public:
+
+	static constexpr int64_t kiInvalidOffset = -1;
+
+	BuddyAllocator(int64_t iSize, int64_t iMinSize);
+
+	int64_t Allocate(int64_t iSize, int64_t iAlignment);
+	void Free(int64_t iOffset);
+
+	int64_t LargestFree() const;
+	float Fragmentation() const;
+	bool Validate() const;
+
+	int64_t miSize = 0;
+	int64_t miMinSize = 0;
+	int64_t miLevelCount = 0;
+
+	int64_t miUsedBytes = 0;
+	int64_t miAllocationCount = 0;
+
+private:
+
+	static constexpr uint8_t kuiSlotFree = 0x80;
+	static constexpr uint8_t kuiSlotUsed = 0x40;
+	static constexpr uint8_t kuiSlotLevelMask = 0x3F;
+
+	int64_t LevelSize(int64_t iLevel) const { return miSize >> iLevel; }
+	void PushFree(int64_t iLevel, int64_t iOffset);
+	void RemoveFree(int64_t iLevel, int64_t iOffset);
+
+	// Level 0 is the whole range, each level below halves the size
+	std::vector<std::vector<int64_t>> mFreeOffsets;
+	// One entry per miMinSize slot, only the first slot of a free or used block is marked
+	std::vector<uint8_t> mSlots;
+};
+
+} // namespace engine
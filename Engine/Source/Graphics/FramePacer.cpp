@@ -0,0 +1,90 @@
+#include "FramePacer.h"
+
+namespace engine
+{
+
+void FramePacer::SetRefreshRate(int64_t iHz) noexcept
+{
+	mRefreshPeriod = std::chrono::nanoseconds(1'000'000'000 / std::max<int64_t>(iHz, 1));
+}
+
+void FramePacer::EndFrame(Clock::time_point now, std::chrono::nanoseconds gpuTail) noexcept
+{
+	if (!mbStarted)
+	{
+		return;
+	}
+	mbStarted = false;
+
+	mpWork[miWorkNext] = (now - mStartTimePoint) + gpuTail;
+	miWorkNext = (miWorkNext + 1) % kiHistory;
+	miWorkCount = std::min(miWorkCount + 1, kiHistory);
+}
+
+void FramePacer::ImageAvailable(Clock::time_point now, bool bWaited) noexcept
+{
+	if (!mbImageAvailable)
+	{
+		mImageAvailableTimePoint = now;
+		mbImageAvailable = true;
+		return;
+	}
+
+	// Every frame that makes its refresh gets the next image one refresh after the last, two or more refreshes mean the frame in between missed
+	// With more than two swapchain images the image is often free before the loop gets there, that alone says nothing about the refresh
+	std::chrono::nanoseconds elapsed = now - mImageAvailableTimePoint;
+	int64_t iRefreshes = (elapsed + mRefreshPeriod / 2) / mRefreshPeriod;
+	if (iRefreshes > 1)
+	{
+		++miMisses;
+		mMargin = std::min(2 * mMargin, mRefreshPeriod / 2);
+	}
+	else
+	{
+		mMargin = std::max(mMargin - mMargin / kiMarginDecay, kMinimumMargin);
+	}
+
+	// A waited for image became free at a refresh, one that was already free did so at the last refresh before now, which is counted from the previous one
+	if (bWaited)
+	{
+		mImageAvailableTimePoint = now;
+	}
+	else
+	{
+		mImageAvailableTimePoint += (elapsed / mRefreshPeriod) * mRefreshPeriod;
+	}
+}
+
+FramePacer::Clock::time_point FramePacer::StartTime() const noexcept
+{
+	if (!mbImageAvailable || miWorkCount < kiMinimumHistory)
+	{
+		return mImageAvailableTimePoint;
+	}
+
+	std::chrono::nanoseconds slack = mRefreshPeriod - PredictedWork() - mMargin;
+	return mImageAvailableTimePoint + std::max(slack, std::chrono::nanoseconds::zero());
+}
+
+void FramePacer::StartFrame(Clock::time_point now) noexcept
+{
+	mStartTimePoint = now;
+	mbStarted = true;
+}
+
+std::chrono::nanoseconds FramePacer::PredictedWork() const noexcept
+{
+	if (miWorkCount == 0)
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	// Predicting a high percentile instead of the mean keeps the occasional slow frame from turning into a miss
+	std::chrono::nanoseconds pWork[kiHistory];
+	std::copy(mpWork, mpWork + miWorkCount, pWork);
+	int64_t iRank = std::min(static_cast<int64_t>(kfWorkPercentile * static_cast<float>(miWorkCount)), miWorkCount - 1);
+	std::nth_element(pWork, pWork + iRank, pWork + miWorkCount);
+	return pWork[iRank];
+}
+
+} // namespace engine
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace engine
+{
+
+// Picks the latest time a loop iteration can sample input and still have its image ready for the next refresh
+// Nothing here touches Vulkan or the OS, every time point is passed in so it can be driven by recorded or simulated traces
+class FramePacer
+{
+public:
+
+	using Clock = std::chrono::high_resolution_clock;
+
+	// Work is predicted from this many recent frames, pacing starts once kiMinimumHistory of them have been seen
+	static constexpr int64_t kiHistory = 64;
+	static constexpr int64_t kiMinimumHistory = 8;
+	static constexpr float kfWorkPercentile = 0.99f;
+
+	// Every miss doubles the margin up to half a refresh, every frame that makes it gives back 1 / kiMarginDecay of it
+	static constexpr std::chrono::nanoseconds kMinimumMargin = 500us;
+	static constexpr int64_t kiMarginDecay = 64;
+
+	void SetRefreshRate(int64_t iHz) noexcept;
+
+	// Call when the loop reaches the image wait, closes the frame opened by StartFrame(), gpuTail is the GPU work still queued behind the last submit
+	void EndFrame(Clock::time_point now, std::chrono::nanoseconds gpuTail) noexcept;
+	// Call once the image is available, bWaited is false if it already was when the loop got there
+	// A gap of two or more refreshes since the last image counts as a miss, an image that was already free doesn't by itself
+	void ImageAvailable(Clock::time_point now, bool bWaited) noexcept;
+	// Never earlier than the last ImageAvailable(), equal to it until there is enough history
+	Clock::time_point StartTime() const noexcept;
+	void StartFrame(Clock::time_point now) noexcept;
+
+	std::chrono::nanoseconds PredictedWork() const noexcept;
+	std::chrono::nanoseconds Margin() const noexcept
+	{
+		return mMargin;
+	}
+	int64_t Misses() const noexcept
+	{
+		return miMisses;
+	}
+
+private:
+
+	std::chrono::nanoseconds mRefreshPeriod = std::chrono::nanoseconds(1'000'000'000 / 60);
+	std::chrono::nanoseconds mMargin = kMinimumMargin;
+
+	std::chrono::nanoseconds mpWork[kiHistory] {};
+	int64_t miWorkNext = 0;
+	int64_t miWorkCount = 0;
+
+	Clock::time_point mImageAvailableTimePoint {};
+	Clock::time_point mStartTimePoint {};
+	bool mbImageAvailable = false;
+	bool mbStarted = false;
+	int64_t miMisses = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,72 @@
+#include "Glyphs.h"
+
+namespace engine
+{
+
+void AddFont(GlyphTable& rGlyphTable, const uint32_t* puiCharacterIds, const common::Character* pCharacters, int64_t iCharacters, int64_t iLineHeight, bool bEfigs)
+{
+	float fLineHeight = static_cast<float>(iLineHeight);
+	(bEfigs ? rGlyphTable.fLineHeightEfigs : rGlyphTable.fLineHeightChinese) = fLineHeight;
+
+	// Manual adjustments to match Efigs
+	float fAdjustedLineHeight = bEfigs ? fLineHeight : 1.4f * fLineHeight;
+	float fSizeAdjust = bEfigs ? 1.0f : 1.4f;
+	float fAdvanceAdjust = bEfigs ? 1.0f : 1.6f;
+	float fTextureSize = bEfigs ? kfEfigsSize : kfChineseSize;
+
+	std::vector<uint32_t> existing;
+	for (const Glyph& rGlyph : rGlyphTable.glyphs)
+	{
+		existing.push_back(rGlyph.uiChar);
+	}
+	std::sort(existing.begin(), existing.end());
+
+	for (int64_t i = 0; i < iCharacters; ++i)
+	{
+		if (std::binary_search(existing.begin(), existing.end(), puiCharacterIds[i]))
+		{
+			continue;
+		}
+
+		const common::Character& rCharacter = pCharacters[i];
+		rGlyphTable.glyphs.push_back(Glyph
+		{
+			.uiChar = puiCharacterIds[i],
+			.bEfigs = bEfigs,
+			.fWidth = fSizeAdjust * static_cast<float>(rCharacter.uiWidth) / fAdjustedLineHeight,
+			.fHeight = fSizeAdjust * static_cast<float>(rCharacter.uiHeight) / fAdjustedLineHeight,
+			.fXOffset = static_cast<float>(rCharacter.iXOffset) / fAdjustedLineHeight,
+			.fYOffset = static_cast<float>(rCharacter.iYOffset) / fAdjustedLineHeight,
+			.fAdvance = fAdvanceAdjust * static_cast<float>(rCharacter.iXAdvance) / fAdjustedLineHeight,
+			.fXAdvance = static_cast<float>(rCharacter.iXAdvance),
+			.f4TextureRect =
+			{
+				static_cast<float>(rCharacter.uiX) / fTextureSize,
+				static_cast<float>(rCharacter.uiY) / fTextureSize,
+				static_cast<float>(rCharacter.uiX + rCharacter.uiWidth) / fTextureSize,
+				static_cast<float>(rCharacter.uiY + rCharacter.uiHeight) / fTextureSize,
+			},
+		});
+	}
+}
+
+void SortGlyphTable(GlyphTable& rGlyphTable)
+{
+	std::sort(rGlyphTable.glyphs.begin(), rGlyphTable.glyphs.end(), [](const Glyph& rA, const Glyph& rB)
+	{
+		return rA.uiChar < rB.uiChar;
+	});
+
+	std::fill(std::begin(rGlyphTable.piDirectGlyphs), std::end(rGlyphTable.piDirectGlyphs), -1);
+	for (int64_t i = 0; i < static_cast<int64_t>(rGlyphTable.glyphs.size()); ++i)
+	{
+		if (rGlyphTable.glyphs[i].uiChar < kiDirectGlyphs)
+		{
+			rGlyphTable.piDirectGlyphs[rGlyphTable.glyphs[i].uiChar] = static_cast<int32_t>(i);
+		}
+	}
+	ASSERT(rGlyphTable.piDirectGlyphs['?'] >= 0);
+	rGlyphTable.iFallbackGlyph = rGlyphTable.piDirectGlyphs['?'];
+}
+
+} // namespace engine
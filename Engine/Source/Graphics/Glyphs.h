@@ -0,0 +1,96 @@
+#pragma once
+
+#include "DataFile.h"
+
+namespace engine
+{
+
+inline constexpr float kfEfigsSize = 2048.0f;
+inline constexpr float kfChineseSize = 8192.0f;
+
+// Width of every line of a text, or the x offset every line starts at, kept on the stack so measuring and writing text never allocates
+struct TextLines
+{
+	static constexpr int64_t kiMaxLines = 128;
+
+	int64_t iCount = 0;
+	float pfValues[kiMaxLines] {};
+
+	void Push(float fValue)
+	{
+		if (iCount < kiMaxLines)
+		{
+			pfValues[iCount++] = fValue;
+		}
+	}
+
+	float* begin() { return pfValues; }
+	float* end() { return pfValues + iCount; }
+	const float* begin() const { return pfValues; }
+	const float* end() const { return pfValues + iCount; }
+};
+
+// Metrics are in line heights with the Chinese adjustments folded in, the texture rect is already divided by the atlas size
+struct Glyph
+{
+	uint32_t uiChar = 0;
+	bool bEfigs = true;
+
+	float fWidth = 0.0f;
+	float fHeight = 0.0f;
+	float fXOffset = 0.0f;
+	float fYOffset = 0.0f;
+	float fAdvance = 0.0f;
+	// In pixels, MeasureQuads() divides by the line height of the whole text
+	float fXAdvance = 0.0f;
+
+	DirectX::XMFLOAT4 f4TextureRect {};
+};
+
+// Glyphs below this are looked up directly, the rest with a binary search over the sorted table
+inline constexpr int64_t kiDirectGlyphs = 0x800;
+
+// Both fonts merged and sorted by character, only needs the data file so it's built on a worker while Vulkan boots
+struct GlyphTable
+{
+	std::vector<Glyph> glyphs;
+	int32_t piDirectGlyphs[kiDirectGlyphs] {};
+	int64_t iFallbackGlyph = 0;
+
+	float fLineHeightEfigs = 0.0f;
+	float fLineHeightChinese = 0.0f;
+
+	// Characters neither font has get '?'
+	const Glyph& Find(uint32_t uiChar) const
+	{
+		if (uiChar < kiDirectGlyphs)
+		{
+			int32_t iGlyph = piDirectGlyphs[uiChar];
+			if (iGlyph >= 0) [[likely]]
+			{
+				return glyphs[iGlyph];
+			}
+		}
+		else
+		{
+			auto it = std::lower_bound(glyphs.begin(), glyphs.end(), uiChar, [](const Glyph& rGlyph, uint32_t uiChar)
+			{
+				return rGlyph.uiChar < uiChar;
+			});
+			if (it != glyphs.end() && it->uiChar == uiChar)
+			{
+				return *it;
+			}
+		}
+
+		DEBUG_BREAK();
+		return glyphs[iFallbackGlyph];
+	}
+};
+
+// Adds the characters of a font chunk the table doesn't have yet, so the font added first wins for characters both have
+void AddFont(GlyphTable& rGlyphTable, const uint32_t* puiCharacterIds, const common::Character* pCharacters, int64_t iCharacters, int64_t iLineHeight, bool bEfigs);
+// Call once every font is added, sorts the table and fills in the direct lookup
+void SortGlyphTable(GlyphTable& rGlyphTable);
+
+} // namespace engine
@@ -54,6 +54,13 @@ Graphics::Graphics(HINSTANCE hinstance, HWND hwnd)
 {
 	gpGraphics = this;
 
+	// Nothing in here needs a device, so it runs while Vulkan boots and is kept for when the managers are recreated
+	mGlyphTableFuture = std::async(std::launch::async, []()
+	{
+		common::ThreadLocal threadLocal(0, common::kThreadBootPreparation);
+		return BuildGlyphTable();
+	});
+
 	Create();
 
 	gpSwapchainManager->AcquireNextImage();
@@ -89,6 +96,7 @@ void Graphics::RenderGlobal(const game::Frame& __restrict rFrame)
 	CPU_PROFILE_START(kCpuTimerRenderGlobal);
 	CalculateMatricesAndVisibleArea(rFrame, true);
 	RenderFrameGlobal(iCommandBuffer, rFrame);
+	gpIslands->RenderGlobal(iCommandBuffer);
 	gpParticleManager->RenderGlobal(iCommandBuffer, rFrame);
 	CPU_PROFILE_STOP(kCpuTimerRenderGlobal);
 
@@ -119,17 +127,15 @@ void Graphics::RenderMainImagePresentAcquire(const game::Frame& __restrict rFram
 		// Renders per second
 		mRendersInTheLastSecond.Set();
 
-		UPDATE_PROFILE_TEXT();
-
 	#if defined(ENABLE_RENDER_THREAD)
-		CPU_PROFILE_START(kCpuTimerWaitPresentFuture);
-		if (gpSwapchainManager->mPresent.valid())
-		{
-			gpSwapchainManager->mPresent.get();
-		}
-		CPU_PROFILE_STOP(kCpuTimerWaitPresentFuture);
+		CPU_PROFILE_START(kCpuTimerWaitSubmissions);
+		gpCommandBufferManager->WaitForSubmissions();
+		CPU_PROFILE_STOP(kCpuTimerWaitSubmissions);
 	#endif
 
+		// The submission thread writes the submit, present and latency timers, it is idle until the next submit so they can be read and reset here
+		UPDATE_PROFILE_TEXT();
+
 		Create();
 
 		gpSwapchainManager->AcquireNextImage();
@@ -144,6 +150,7 @@ void Graphics::Create()
 
 	if (mpInstanceManager == nullptr) { mpInstanceManager = std::make_unique<InstanceManager>(mHinstance, mHwnd); }
 	if (mpDeviceManager == nullptr) { mpDeviceManager = std::make_unique<DeviceManager>(); }
+	if (mpMemoryManager == nullptr) { mpMemoryManager = std::make_unique<MemoryManager>(); }
 	if (mpShaderManager == nullptr) { mpShaderManager = std::make_unique<ShaderManager>(); }
 	if (mpSwapchainManager == nullptr) { mpSwapchainManager = std::make_unique<SwapchainManager>(); }
 	#if defined(ENABLE_PROFILING)
@@ -153,7 +160,7 @@ void Graphics::Create()
 	if (mpBufferManager == nullptr) { mpBufferManager = std::make_unique<BufferManager>(); }
 	if (mpIslands == nullptr) { mpIslands = std::make_unique<Islands>(); }
 	if (mpTextureManager == nullptr) { mpTextureManager = std::make_unique<TextureManager>(); }
-	if (mpTextManager == nullptr) { mpTextManager = std::make_unique<TextManager>(); }
+	if (mpTextManager == nullptr) { mpTextManager = std::make_unique<TextManager>(mGlyphTableFuture.get()); }
 	if (mpUiManager == nullptr) { mpUiManager = std::make_unique<UiManager>(); }
 	{
 		SCOPED_BOOT_TIMER(kBootTimerBuildGlobalHeightmap);
@@ -391,8 +398,10 @@ bool Graphics::Destroy()
 
 	LOG("Graphics::Destroy() {}", static_cast<int64_t>(meDestroyType));
 
+	// Ticks in flight can spawn particles and read the islands, let them finish before the managers go away
 	if (game::gpGame != nullptr)
 	{
+		game::gpGame->SynchronizeSimulation();
 		game::gpGame->mAverageDelta.miCount = 0;
 	}
 
@@ -426,6 +435,7 @@ bool Graphics::Destroy()
 		mpUiManager.reset();
 		mpIslands.reset();
 		mpShaderManager.reset();
+		mpMemoryManager.reset();
 		mpDeviceManager.reset();
 		mpInstanceManager.reset();
 	}
@@ -49,48 +49,95 @@ const shaders::AxisAlignedQuadLayout& XM_CALLCONV Islands::GetIsland(DirectX::FX
 	return mQuads.at(0);
 }
 
-float XM_CALLCONV Islands::GlobalElevation(DirectX::FXMVECTOR vecPosition)
-{
-	XMFLOAT4A f4Position {};
-	XMStoreFloat4A(&f4Position, vecPosition);
-
-#if 1
-	int64_t iX = static_cast<int64_t>(kfGlobalHeightmapSize * (f4Position.x - mf4GlobalArea.x) / (mf4GlobalArea.z - mf4GlobalArea.x));
-	int64_t iY = static_cast<int64_t>(kfGlobalHeightmapSize - kfGlobalHeightmapSize * (f4Position.y - mf4GlobalArea.w) / (mf4GlobalArea.y - mf4GlobalArea.w));
+// GlobalElevation() samples the nearest texel, GlobalElevations() only batches that and falls back to GlobalElevation() when filtering is switched on
+static constexpr bool kbFilteredElevation = false;
 
+// Nearest texel lookup shared by GlobalElevation() and GlobalElevations(), iX and iY are the truncated heightmap coordinates
+float Islands::ElevationTexel(int64_t iX, int64_t iY) const
+{
 	if (iX < 0 || iX >= kiGlobalHeightmapSize || iY < 0 || iY >= kiGlobalHeightmapSize) [[unlikely]]
 	{
 		return mfSeaFloorElevation;
 	}
 	else
 	{
-		return mppfElevations[iY][iX];
+		return mppfElevations[mpiFlipRows[iY]][mpiFlipColumns[iX]];
 	}
-#else
-	float fX = kfGlobalHeightmapSize * (f4Position.x - mf4GlobalArea.x) / (mf4GlobalArea.z - mf4GlobalArea.x);
-	int64_t iX = static_cast<int64_t>(std::floor(fX));
-	float fY = kfGlobalHeightmapSize - kfGlobalHeightmapSize * (f4Position.y - mf4GlobalArea.w) / (mf4GlobalArea.y - mf4GlobalArea.w);
-	int64_t iY = static_cast<int64_t>(std::floor(fY));
+}
+
+float XM_CALLCONV Islands::GlobalElevation(DirectX::FXMVECTOR vecPosition)
+{
+	XMFLOAT4A f4Position {};
+	XMStoreFloat4A(&f4Position, vecPosition);
 
-	if (iX < 1 || iX >= kiGlobalHeightmapSize - 2 || iY < 1 || iY >= kiGlobalHeightmapSize - 2)
+	if constexpr (!kbFilteredElevation)
 	{
-		return mfSeaFloorElevation;
+		int64_t iX = static_cast<int64_t>(kfGlobalHeightmapSize * (f4Position.x - mf4GlobalArea.x) / (mf4GlobalArea.z - mf4GlobalArea.x));
+		int64_t iY = static_cast<int64_t>(kfGlobalHeightmapSize - kfGlobalHeightmapSize * (f4Position.y - mf4GlobalArea.w) / (mf4GlobalArea.y - mf4GlobalArea.w));
+		return ElevationTexel(iX, iY);
 	}
 	else
 	{
-		float fTopLeft = mppfElevations[iY][iX];
-		float fTopRight = mppfElevations[iY][iX + 1];
-		float fBottomLeft = mppfElevations[iY - 1][iX];
-		float fBottomRight = mppfElevations[iY - 1][iX + 1];
+		float fX = kfGlobalHeightmapSize * (f4Position.x - mf4GlobalArea.x) / (mf4GlobalArea.z - mf4GlobalArea.x);
+		int64_t iX = static_cast<int64_t>(std::floor(fX));
+		float fY = kfGlobalHeightmapSize - kfGlobalHeightmapSize * (f4Position.y - mf4GlobalArea.w) / (mf4GlobalArea.y - mf4GlobalArea.w);
+		int64_t iY = static_cast<int64_t>(std::floor(fY));
+
+		if (iX < 1 || iX >= kiGlobalHeightmapSize - 2 || iY < 1 || iY >= kiGlobalHeightmapSize - 2)
+		{
+			return mfSeaFloorElevation;
+		}
+		else
+		{
+			float fTopLeft = mppfElevations[mpiFlipRows[iY]][mpiFlipColumns[iX]];
+			float fTopRight = mppfElevations[mpiFlipRows[iY]][mpiFlipColumns[iX + 1]];
+			float fBottomLeft = mppfElevations[mpiFlipRows[iY - 1]][mpiFlipColumns[iX]];
+			float fBottomRight = mppfElevations[mpiFlipRows[iY - 1]][mpiFlipColumns[iX + 1]];
+
+			float fPercentX = fX - static_cast<float>(iX);
+			float fPercentY = fY - static_cast<float>(iY);
+
+			float fTop = (1.0f - fPercentX) * fTopLeft + fPercentX * fTopRight;
+			float fBottom = (1.0f - fPercentX) * fBottomLeft + fPercentX * fBottomRight;
+			return (1.0f - fPercentY) * fBottom + fPercentY * fTop;
+		}
+	}
+}
 
-		float fPercentX = fX - static_cast<float>(iX);
-		float fPercentY = fY - static_cast<float>(iY);
+void Islands::GlobalElevations(float* __restrict pfElevations, const XMVECTOR* __restrict pVecPositions, int64_t iCount)
+{
+	int64_t i = 0;
+	if constexpr (!kbFilteredElevation)
+	{
+		auto vecSize = XMVectorReplicate(kfGlobalHeightmapSize);
+		auto vecAreaX = XMVectorReplicate(mf4GlobalArea.x);
+		auto vecAreaW = XMVectorReplicate(mf4GlobalArea.w);
+		auto vecAreaWidth = XMVectorReplicate(mf4GlobalArea.z - mf4GlobalArea.x);
+		auto vecAreaHeight = XMVectorReplicate(mf4GlobalArea.y - mf4GlobalArea.w);
+
+		// Same operations in the same order as GlobalElevation() so both truncate to the same texel
+		for (; i + 4 <= iCount; i += 4)
+		{
+			auto matPositions = XMMatrixTranspose(XMMATRIX(pVecPositions[i], pVecPositions[i + 1], pVecPositions[i + 2], pVecPositions[i + 3]));
+			auto vecX = XMVectorDivide(XMVectorMultiply(vecSize, XMVectorSubtract(matPositions.r[0], vecAreaX)), vecAreaWidth);
+			auto vecY = XMVectorSubtract(vecSize, XMVectorDivide(XMVectorMultiply(vecSize, XMVectorSubtract(matPositions.r[1], vecAreaW)), vecAreaHeight));
+
+			XMINT4 i4X {};
+			XMINT4 i4Y {};
+			XMStoreSInt4(&i4X, XMConvertVectorFloatToInt(vecX, 0));
+			XMStoreSInt4(&i4Y, XMConvertVectorFloatToInt(vecY, 0));
+
+			pfElevations[i] = ElevationTexel(i4X.x, i4Y.x);
+			pfElevations[i + 1] = ElevationTexel(i4X.y, i4Y.y);
+			pfElevations[i + 2] = ElevationTexel(i4X.z, i4Y.z);
+			pfElevations[i + 3] = ElevationTexel(i4X.w, i4Y.w);
+		}
+	}
 
-		float fTop = (1.0f - fPercentX) * fTopLeft + fPercentX * fTopRight;
-		float fBottom = (1.0f - fPercentX) * fBottomLeft + fPercentX * fBottomRight;
-		return (1.0f - fPercentY) * fBottom + fPercentY * fTop;
+	for (; i < iCount; ++i)
+	{
+		pfElevations[i] = GlobalElevation(pVecPositions[i]);
 	}
-#endif
 }
 
 DirectX::XMVECTOR XM_CALLCONV Islands::GlobalNormal(DirectX::FXMVECTOR vecPosition)
@@ -118,17 +165,15 @@ Islands::Islands()
 	miCount = game::Frame::kiIslandCount;
 	mQuads.resize(miCount);
 
-	FillQuads();
+	FillQuads(mbFlipX, mbFlipY);
+	FillGlobalArea();
+	FillFlipTables();
 
 	int64_t iIndex = 0;
-	auto& rChunkMap = gpFileManager->GetDataChunkMap();
-	for (auto& [rCrc, rChunk] : rChunkMap)
+	std::span<const Chunk> islands = gpFileManager->GetDataChunks(kChunkIslands);
+	ASSERT(!islands.empty() && static_cast<int64_t>(islands.size()) <= miCount);
+	for (const Chunk& rChunk : islands)
 	{
-		if (!(rChunk.pHeader->flags & common::ChunkFlags::kIsland))
-		{
-			continue;
-		}
-
 		uint16_t uiBeachElevation = rChunk.pHeader->islandHeader.uiBeachElevation;
 		mQuads[iIndex++].f4Misc.x = common::UnormToFloat(uiBeachElevation);
 		mfBeachElevation = common::UnormToFloat(uiBeachElevation);
@@ -140,17 +185,6 @@ Islands::Islands()
 		mQuads[iIndex].f4Misc.x = mQuads[iIndex - 1].f4Misc.x;
 		++iIndex;
 	}
-
-	mIslandsStorageBuffer.Create(
-	{
-		.pcName = "Islands",
-		.flags = {BufferFlags::kStorage, BufferFlags::kHostVisible},
-		.iCount = miCount,
-		.iVertexStride = sizeof(shaders::AxisAlignedQuadLayout),
-		.dataVkDeviceSize = miCount * sizeof(shaders::AxisAlignedQuadLayout),
-	});
-
-	memcpy(mIslandsStorageBuffer.mpMappedMemory, mQuads.data(), miCount * sizeof(shaders::AxisAlignedQuadLayout));
 }
 
 Islands::~Islands()
@@ -170,11 +204,15 @@ void Islands::SetIslandsFlip(IslandsFlip eIslandsFlip)
 	mbFlipX = meCurrentIslandsFlip == kFlipX || meCurrentIslandsFlip == kFlipXY ? true : false;
 	mbFlipY = meCurrentIslandsFlip == kFlipY || meCurrentIslandsFlip == kFlipXY ? true : false;
 
-	FillQuads();
-	memcpy(mIslandsStorageBuffer.mpMappedMemory, mQuads.data(), miCount * sizeof(shaders::AxisAlignedQuadLayout));
+	// The shaders flip through the texture rects and the normal multipliers, the heightmap through the flip tables, so nothing is rebuilt
+	// Frames still in flight keep reading their own storage buffer, RenderGlobal() writes the new rects to each one once its fence is done
+	FillQuads(mbFlipX, mbFlipY);
+	FillFlipTables();
+}
 
-	mbBuildGlobalHeightmap = true;
-	BuildGlobalHeightmap();
+void Islands::RenderGlobal(int64_t iCommandBuffer)
+{
+	memcpy(gpBufferManager->mIslandsStorageBuffers.at(iCommandBuffer).mpMappedMemory, mQuads.data(), miCount * sizeof(shaders::AxisAlignedQuadLayout));
 }
 
 void Islands::BuildGlobalHeightmap()
@@ -206,6 +244,19 @@ void Islands::BuildGlobalHeightmap()
 		.eTextureLayout = TextureLayout::kColorAttachment,
 	});
 
+	// Render the islands unflipped whatever the current flip is, from a buffer of its own so no frame's islands change under it
+	FillQuads(false, false);
+	Buffer unflippedStorageBuffer(
+	{
+		.pcName = "Islands unflipped",
+		.flags = {BufferFlags::kStorage, BufferFlags::kHostVisible},
+		.iCount = miCount,
+		.iVertexStride = sizeof(shaders::AxisAlignedQuadLayout),
+		.dataVkDeviceSize = miCount * sizeof(shaders::AxisAlignedQuadLayout),
+	});
+	memcpy(unflippedStorageBuffer.mpMappedMemory, mQuads.data(), miCount * sizeof(shaders::AxisAlignedQuadLayout));
+	FillQuads(mbFlipX, mbFlipY);
+
 	Pipeline globalElevationPipeline(
 	{
 		.pcName = "Global elevation",
@@ -217,24 +268,14 @@ void Islands::BuildGlobalHeightmap()
 		.pDescriptorInfos =
 		{
 			{.flags = DescriptorFlags::kPerCommandBufferUniformBuffers, .pBuffers = gpBufferManager->mGlobalLayoutUniformBuffers.data()},
-			{.flags = DescriptorFlags::kStorageBuffer, .pBuffers = &mIslandsStorageBuffer},
+			{.flags = DescriptorFlags::kStorageBuffer, .pBuffers = &unflippedStorageBuffer},
 			{.flags = DescriptorFlags::kCombinedSamplers, .iCount = gpIslands->miCount, .ppTextures = gpTextureManager->mElevationTextures.data()},
 		},
 	 });
 
 	shaders::GlobalLayout& rGlobalLayout = *reinterpret_cast<shaders::GlobalLayout*>(&gpBufferManager->mGlobalLayoutUniformBuffers.at(0).mpMappedMemory[0]);
-	mf4GlobalArea.x = std::numeric_limits<float>::max();
-	mf4GlobalArea.y = std::numeric_limits<float>::lowest();
-	mf4GlobalArea.z = std::numeric_limits<float>::lowest();
-	mf4GlobalArea.w = std::numeric_limits<float>::max();
-	for (int64_t i = 0; i < miCount; ++i)
-	{
-		mf4GlobalArea.x = std::min(mf4GlobalArea.x, mQuads[i].f4VertexRect.x);
-		mf4GlobalArea.y = std::max(mf4GlobalArea.y, mQuads[i].f4VertexRect.y);
-		mf4GlobalArea.z = std::max(mf4GlobalArea.z, mQuads[i].f4VertexRect.x + mQuads[i].f4VertexRect.z);
-		mf4GlobalArea.w = std::min(mf4GlobalArea.w, mQuads[i].f4VertexRect.y + mQuads[i].f4VertexRect.w);
-	}
 	rGlobalLayout.f4VisibleArea = mf4GlobalArea;
+
 	rGlobalLayout.f4Terrain.x = gIslandHeight.Get();
 	rGlobalLayout.f4TerrainTwo.x = gWaterDepth.Get();
 
@@ -276,7 +317,7 @@ void Islands::BuildGlobalHeightmap()
 	vkFreeMemory(gpDeviceManager->mVkDevice, cpuVkDeviceMemory, nullptr);
 }
 
-void Islands::FillQuads()
+void Islands::FillQuads(bool bFlipX, bool bFlipY)
 {
 	for (int64_t i = 0; i < miCount; ++i)
 	{
@@ -285,12 +326,37 @@ void Islands::FillQuads()
 		mQuads[i].f4VertexRect.z = game::Frame::kpfIslandPositions[i][2];
 		mQuads[i].f4VertexRect.w = game::Frame::kpfIslandPositions[i][3];
 
-		mQuads[i].f4TextureRect.x = mbFlipX ? 1.0f : 0.0f;
-		mQuads[i].f4TextureRect.z = mbFlipX ? 0.0f : 1.0f;
+		mQuads[i].f4TextureRect.x = bFlipX ? 1.0f : 0.0f;
+		mQuads[i].f4TextureRect.z = bFlipX ? 0.0f : 1.0f;
 
-		mQuads[i].f4TextureRect.y = mbFlipY ? 1.0f : 0.0f;
-		mQuads[i].f4TextureRect.w = mbFlipY ? 0.0f : 1.0f;
+		mQuads[i].f4TextureRect.y = bFlipY ? 1.0f : 0.0f;
+		mQuads[i].f4TextureRect.w = bFlipY ? 0.0f : 1.0f;
+	}
+}
+
+void Islands::FillGlobalArea()
+{
+	mf4GlobalArea.x = std::numeric_limits<float>::max();
+	mf4GlobalArea.y = std::numeric_limits<float>::lowest();
+	mf4GlobalArea.z = std::numeric_limits<float>::lowest();
+	mf4GlobalArea.w = std::numeric_limits<float>::max();
+	for (int64_t i = 0; i < miCount; ++i)
+	{
+		mf4GlobalArea.x = std::min(mf4GlobalArea.x, mQuads[i].f4VertexRect.x);
+		mf4GlobalArea.y = std::max(mf4GlobalArea.y, mQuads[i].f4VertexRect.y);
+		mf4GlobalArea.z = std::max(mf4GlobalArea.z, mQuads[i].f4VertexRect.x + mQuads[i].f4VertexRect.z);
+		mf4GlobalArea.w = std::min(mf4GlobalArea.w, mQuads[i].f4VertexRect.y + mQuads[i].f4VertexRect.w);
+	}
+}
+
+void Islands::FillFlipTables()
+{
+	std::vector<XMFLOAT4> vertexRects;
+	for (const shaders::AxisAlignedQuadLayout& rLayout : mQuads)
+	{
+		vertexRects.push_back(rLayout.f4VertexRect);
 	}
+	BuildFlipTables(mpiFlipRows, mpiFlipColumns, mbFlipX, mbFlipY, mf4GlobalArea, vertexRects);
 }
 
 } // namespace engine
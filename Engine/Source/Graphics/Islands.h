@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Graphics/IslandsFlip.h"
 #include "Graphics/Managers/BufferManager.h"
 
 namespace engine
@@ -7,21 +8,8 @@ namespace engine
 
 class Texture;
 
-inline constexpr int64_t kiGlobalHeightmapSize = 1024;
-inline constexpr float kfGlobalHeightmapSize = static_cast<float>(kiGlobalHeightmapSize);
-
 DirectX::XMVECTOR XM_CALLCONV TerrainCollision(DirectX::FXMVECTOR vecStart, DirectX::FXMVECTOR vecEnd, float fStepInterval);
 
-enum IslandsFlip
-{
-	kFlipNone = 0,
-	kFlipX = 1,
-	kFlipY = 2,
-	kFlipXY = 3,
-
-	kFlipCount = 4,
-};
-
 class Islands
 {
 public:
@@ -31,11 +19,16 @@ public:
 
 	void SetIslandsFlip(IslandsFlip eIslandsFlip);
 	void BuildGlobalHeightmap();
-	void FillQuads();
+	void FillQuads(bool bFlipX, bool bFlipY);
+	void FillGlobalArea();
+	void FillFlipTables();
+	void RenderGlobal(int64_t iCommandBuffer);
 
 	const shaders::AxisAlignedQuadLayout& XM_CALLCONV GetIsland(DirectX::FXMVECTOR vecPosition);
 	float XM_CALLCONV GlobalElevation(DirectX::FXMVECTOR vecPosition);
+	void GlobalElevations(float* __restrict pfElevations, const DirectX::XMVECTOR* __restrict pVecPositions, int64_t iCount);
 	DirectX::XMVECTOR XM_CALLCONV GlobalNormal(DirectX::FXMVECTOR vecPosition);
+	float ElevationTexel(int64_t iX, int64_t iY) const;
 
 	int64_t miCount = 0;
 	float mfBeachElevation = 0.0f;
@@ -47,10 +40,12 @@ public:
 	bool mbBuildGlobalHeightmap = true;
 
 	DirectX::XMFLOAT4 mf4GlobalArea {};
+	// Always built unflipped, the flip tables map a row or column of the flipped islands to the one holding its elevation
 	float mppfElevations[kiGlobalHeightmapSize][kiGlobalHeightmapSize] {};
+	int32_t mpiFlipRows[kiGlobalHeightmapSize] {};
+	int32_t mpiFlipColumns[kiGlobalHeightmapSize] {};
 
 	std::vector<shaders::AxisAlignedQuadLayout> mQuads;
-	Buffer mIslandsStorageBuffer;
 };
 
 inline Islands* gpIslands = nullptr;
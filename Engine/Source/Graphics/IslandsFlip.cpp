@@ -0,0 +1,42 @@
+#include "IslandsFlip.h"
+
+namespace engine
+{
+
+void BuildFlipTables(int32_t* piFlipRows, int32_t* piFlipColumns, bool bFlipX, bool bFlipY, const DirectX::XMFLOAT4& rf4GlobalArea, std::span<const DirectX::XMFLOAT4> vertexRects)
+{
+	for (int32_t i = 0; i < kiGlobalHeightmapSize; ++i)
+	{
+		piFlipRows[i] = i;
+		piFlipColumns[i] = i;
+	}
+
+	auto mirror = [](int32_t* piTable, int32_t iFirst, int32_t iLast)
+	{
+		iFirst = std::clamp(iFirst, 0, static_cast<int32_t>(kiGlobalHeightmapSize));
+		iLast = std::clamp(iLast, 0, static_cast<int32_t>(kiGlobalHeightmapSize));
+		for (int32_t i = iFirst; i < iLast; ++i)
+		{
+			ASSERT(piTable[i] == i || piTable[i] == iFirst + iLast - 1 - i);
+			piTable[i] = iFirst + iLast - 1 - i;
+		}
+	};
+
+	for (const DirectX::XMFLOAT4& rf4Rect : vertexRects)
+	{
+		if (bFlipX)
+		{
+			float fLeft = kfGlobalHeightmapSize * (rf4Rect.x - rf4GlobalArea.x) / (rf4GlobalArea.z - rf4GlobalArea.x);
+			float fRight = kfGlobalHeightmapSize * (rf4Rect.x + rf4Rect.z - rf4GlobalArea.x) / (rf4GlobalArea.z - rf4GlobalArea.x);
+			mirror(piFlipColumns, static_cast<int32_t>(std::round(fLeft)), static_cast<int32_t>(std::round(fRight)));
+		}
+		if (bFlipY)
+		{
+			float fTop = kfGlobalHeightmapSize - kfGlobalHeightmapSize * (rf4Rect.y - rf4GlobalArea.w) / (rf4GlobalArea.y - rf4GlobalArea.w);
+			float fBottom = kfGlobalHeightmapSize - kfGlobalHeightmapSize * (rf4Rect.y + rf4Rect.w - rf4GlobalArea.w) / (rf4GlobalArea.y - rf4GlobalArea.w);
+			mirror(piFlipRows, static_cast<int32_t>(std::round(fTop)), static_cast<int32_t>(std::round(fBottom)));
+		}
+	}
+}
+
+} // namespace engine
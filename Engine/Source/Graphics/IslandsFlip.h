@@ -0,0 +1,23 @@
+#pragma once
+
+namespace engine
+{
+
+inline constexpr int64_t kiGlobalHeightmapSize = 1024;
+inline constexpr float kfGlobalHeightmapSize = static_cast<float>(kiGlobalHeightmapSize);
+
+enum IslandsFlip
+{
+	kFlipNone = 0,
+	kFlipX = 1,
+	kFlipY = 2,
+	kFlipXY = 3,
+
+	kFlipCount = 4,
+};
+
+// Maps every row and column of the flipped islands to the one of the unflipped heightmap holding its elevation
+// Flipping the texture rect mirrors every island inside its own rows and columns, so islands sharing a row or a column must share all of them, which holds as long as they're laid out on a grid
+void BuildFlipTables(int32_t* piFlipRows, int32_t* piFlipColumns, bool bFlipX, bool bFlipY, const DirectX::XMFLOAT4& rf4GlobalArea, std::span<const DirectX::XMFLOAT4> vertexRects);
+
+} // namespace engine
@@ -36,15 +36,9 @@ BufferManager::BufferManager()
 		memcpy(reinterpret_cast<char*>(pData) + sizeof(puiQuads), pfQuads, sizeof(pfQuads));
 	});
 
-	auto& rChunkMap = gpFileManager->GetDataChunkMap();
-	for (auto& [rCrc, rChunk] : rChunkMap)
+	for (const Chunk& rChunk : gpFileManager->GetDataChunks(kChunkModels))
 	{
-		if (!(rChunk.pHeader->flags & common::ChunkFlags::kModel))
-		{
-			continue;
-		}
-
-		auto [it, bInserted] = mModelMap.try_emplace(rCrc, BufferInfo
+		auto [it, bInserted] = mModelMap.try_emplace(rChunk.pHeader->crc, BufferInfo
 		{
 			.pcName = rChunk.pHeader->pcPath,
 			.flags = {kIndexVertex, kDeviceLocal},
@@ -64,9 +58,11 @@ BufferManager::BufferManager()
 
 	mGlobalLayoutUniformBuffers.resize(iCommandBufferCount);
 	mMainLayoutUniformBuffers.resize(iCommandBufferCount);
+	mMainLayoutWaterWavesCrcs.resize(iCommandBufferCount);
 	mVisibleLightsStorageBuffers.resize(iCommandBufferCount);
 	mAreaLightsStorageBuffers.resize(iCommandBufferCount);
 	mPointLightsStorageBuffers.resize(iCommandBufferCount);
+	mIslandsStorageBuffers.resize(iCommandBufferCount);
 	mTextStorageBuffers.resize(iCommandBufferCount);
 	mPlayerStorageBuffers.resize(iCommandBufferCount);
 	mPlayerMissilesStorageBuffers.resize(iCommandBufferCount);
@@ -120,6 +116,15 @@ BufferManager::BufferManager()
 			.dataVkDeviceSize = kuiMaxPointLights * sizeof(shaders::AxisAlignedQuadLayout),
 		});
 
+		mIslandsStorageBuffers.at(i).Create(
+		{
+			.pcName = "Islands",
+			.flags = {kStorage, kHostVisible},
+			.iCount = game::Frame::kiIslandCount,
+			.iVertexStride = sizeof(shaders::AxisAlignedQuadLayout),
+			.dataVkDeviceSize = game::Frame::kiIslandCount * sizeof(shaders::AxisAlignedQuadLayout),
+		});
+
 		mTextStorageBuffers.at(i).Create(
 		{
 			.pcName = "Text",
@@ -22,11 +22,15 @@ public:
 
 	std::vector<Buffer> mGlobalLayoutUniformBuffers;
 	std::vector<Buffer> mMainLayoutUniformBuffers;
+	std::vector<common::crc_t> mMainLayoutWaterWavesCrcs;
 
 	std::vector<Buffer> mVisibleLightsStorageBuffers;
 	std::vector<Buffer> mAreaLightsStorageBuffers;
 	std::vector<Buffer> mPointLightsStorageBuffers;
 
+	// Written by Islands::RenderGlobal() once the command buffer's fence has been waited on
+	std::vector<Buffer> mIslandsStorageBuffers;
+
 	std::vector<Buffer> mHexShieldsStorageBuffers;
 	std::vector<Buffer> mBillboardsStorageBuffers;
 	std::vector<Buffer> mTextStorageBuffers;
@@ -31,6 +31,13 @@ CommandBufferManager::CommandBufferManager()
 
 	// Because one of the drawing commands involves binding the right VkFramebuffer, we'll actually have to record a command buffer for every image in the swap chain
 	mPerFramebufferCommandBuffers.resize(gpSwapchainManager->mFramebuffers.size());
+
+#if defined(ENABLE_RENDER_THREAD)
+	mpSubmissionThread = std::make_unique<SubmissionThread>([this](SubmitDescriptor& rSubmitDescriptor)
+	{
+		ProcessSubmit(rSubmitDescriptor);
+	});
+#endif
 }
 
 CommandBufferManager::~CommandBufferManager()
@@ -337,129 +344,147 @@ void CommandBufferManager::RecordCommandBuffer(int64_t iFramebuffer)
 
 void CommandBufferManager::SubmitGlobalCommandBuffer()
 {
-#if defined(ENABLE_RENDER_THREAD)
-	mSubmitGlobal = std::async(std::launch::async, [this]()
-	{
-		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
-#endif
-		CommandBuffers& rCommandBuffers = mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
+	CommandBuffers& rCommandBuffers = mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
 
-		std::vector<VkSemaphore> vkSemaphores;
-		std::vector<VkPipelineStageFlags> vkPipelineStageFlags;
+	SubmitDescriptor& rSubmitDescriptor = BeginSubmit(SubmitType::kGlobal);
+	rSubmitDescriptor.vkCommandBuffer = rCommandBuffers.mpGlobalCommandBuffers[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.signalVkSemaphore = rCommandBuffers.mpGlobalFinishedVkSemaphores[rCommandBuffers.miCurrentIndex];
+	EndSubmit(rSubmitDescriptor);
 
-		VkSubmitInfo vkSubmitInfo
-		{
-			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-			.pNext = nullptr,
-			.waitSemaphoreCount = static_cast<uint32_t>(vkSemaphores.size()),
-			.pWaitSemaphores = vkSemaphores.data(),
-			.pWaitDstStageMask = vkPipelineStageFlags.data(),
-			.commandBufferCount = 1,
-			.pCommandBuffers = &rCommandBuffers.mpGlobalCommandBuffers[rCommandBuffers.miCurrentIndex],
-			.signalSemaphoreCount = 1,
-			.pSignalSemaphores = &rCommandBuffers.mpGlobalFinishedVkSemaphores[rCommandBuffers.miCurrentIndex],
-		};
-
-		CPU_PROFILE_STOP_AND_SMOOTH(kCpuTimerAcquireToGlobal);
+	// Only read after the fence of this command buffer has been waited on, by then the submit has long been processed
+	rCommandBuffers.mpbExecuted[rCommandBuffers.miCurrentIndex] = true;
+}
 
-		CPU_PROFILE_START(kCpuTimerSubmitGlobal);
-		CHECK_VK(vkQueueSubmit(gpDeviceManager->mGraphicsVkQueue, 1, &vkSubmitInfo, VK_NULL_HANDLE));
-		CPU_PROFILE_STOP(kCpuTimerSubmitGlobal);
+void CommandBufferManager::SubmitMainCommandBuffer()
+{
+	CommandBuffers& rCommandBuffers = mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
+
+	SubmitDescriptor& rSubmitDescriptor = BeginSubmit(SubmitType::kMain);
+	rSubmitDescriptor.uiWaitSemaphoreCount = 1;
+	rSubmitDescriptor.pWaitVkSemaphores[0] = rCommandBuffers.mpGlobalFinishedVkSemaphores[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.pWaitVkPipelineStageFlags[0] = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	rSubmitDescriptor.vkCommandBuffer = rCommandBuffers.mpMainCommandBuffers[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.signalVkSemaphore = rCommandBuffers.mpMainFinishedVkSemaphores[rCommandBuffers.miCurrentIndex];
+	EndSubmit(rSubmitDescriptor);
+}
 
-		rCommandBuffers.mpbExecuted[rCommandBuffers.miCurrentIndex] = true;
-#if defined(ENABLE_RENDER_THREAD)
-	});
+void CommandBufferManager::SubmitImageCommandBuffer()
+{
+	CommandBuffers& rCommandBuffers = mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
+
+	SubmitDescriptor& rSubmitDescriptor = BeginSubmit(SubmitType::kImage);
+	rSubmitDescriptor.uiWaitSemaphoreCount = 2;
+	rSubmitDescriptor.pWaitVkSemaphores[0] = rCommandBuffers.mpMainFinishedVkSemaphores[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.pWaitVkPipelineStageFlags[0] = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	rSubmitDescriptor.pWaitVkSemaphores[1] = gpSwapchainManager->mImageAvailableVkSemaphore;
+	rSubmitDescriptor.pWaitVkPipelineStageFlags[1] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	rSubmitDescriptor.vkCommandBuffer = rCommandBuffers.mpImageCommandBuffers[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.signalVkSemaphore = rCommandBuffers.mpImageFinishedVkSemaphores[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.vkFence = rCommandBuffers.mpVkFences[rCommandBuffers.miCurrentIndex];
+
+#if defined(ENABLE_SCREENSHOTS)
+	if (mbSaveScreenshots && mScreenshotTimer.GetDeltaNs() > 2s)
+	{
+		mScreenshotTimer.Reset();
+		rSubmitDescriptor.bSaveScreenshot = true;
+	}
 #endif
+
+	EndSubmit(rSubmitDescriptor);
 }
 
-void CommandBufferManager::SubmitMainCommandBuffer()
+SubmitDescriptor& CommandBufferManager::BeginSubmit(SubmitType eSubmitType)
 {
 #if defined(ENABLE_RENDER_THREAD)
-	mSubmitMain = std::async(std::launch::async, [this]()
-	{
-		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+	SubmitDescriptor& rSubmitDescriptor = mpSubmissionThread->Back();
+#else
+	SubmitDescriptor& rSubmitDescriptor = mSubmitDescriptor;
 #endif
 
-		CommandBuffers& rCommandBuffers = gpCommandBufferManager->mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
-
-		std::vector<VkSemaphore> vkSemaphores;
-		std::vector<VkPipelineStageFlags> vkPipelineStageFlags;
-		vkSemaphores.emplace_back(rCommandBuffers.mpGlobalFinishedVkSemaphores[rCommandBuffers.miCurrentIndex]);
-		vkPipelineStageFlags.push_back(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+	// The slots are reused, so clear whatever the previous submit left behind
+	rSubmitDescriptor = SubmitDescriptor {.eSubmitType = eSubmitType};
+	return rSubmitDescriptor;
+}
 
-	#if defined(ENABLE_RENDER_THREAD)
-		mSubmitGlobal.get();
-	#endif
+void CommandBufferManager::EndSubmit(SubmitDescriptor& rSubmitDescriptor)
+{
+	rSubmitDescriptor.recordedTimePoint = std::chrono::high_resolution_clock::now();
 
-		VkSubmitInfo vkSubmitInfo
-		{
-			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-			.pNext = nullptr,
-			.waitSemaphoreCount = static_cast<uint32_t>(vkSemaphores.size()),
-			.pWaitSemaphores = vkSemaphores.data(),
-			.pWaitDstStageMask = vkPipelineStageFlags.data(),
-			.commandBufferCount = 1,
-			.pCommandBuffers = &rCommandBuffers.mpMainCommandBuffers[rCommandBuffers.miCurrentIndex],
-			.signalSemaphoreCount = 1,
-			.pSignalSemaphores = &rCommandBuffers.mpMainFinishedVkSemaphores[rCommandBuffers.miCurrentIndex],
-		};
-		CPU_PROFILE_START(kCpuTimerSubmitMain);
-		CHECK_VK(vkQueueSubmit(gpDeviceManager->mGraphicsVkQueue, 1, &vkSubmitInfo, VK_NULL_HANDLE));
-		CPU_PROFILE_STOP(kCpuTimerSubmitMain);
 #if defined(ENABLE_RENDER_THREAD)
-	});
+	mpSubmissionThread->Push();
+#else
+	ProcessSubmit(rSubmitDescriptor);
 #endif
 }
 
-void CommandBufferManager::SubmitImageCommandBuffer()
+void CommandBufferManager::WaitForSubmissions()
 {
 #if defined(ENABLE_RENDER_THREAD)
-	mSubmitImage = std::async(std::launch::async, [this]()
-	{
-		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+	mpSubmissionThread->WaitIdle();
 #endif
+}
 
-		CommandBuffers& rCommandBuffers = gpCommandBufferManager->mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
-
-		std::vector<VkSemaphore> vkSemaphores;
-		std::vector<VkPipelineStageFlags> vkPipelineStageFlags;
-		vkSemaphores.emplace_back(rCommandBuffers.mpMainFinishedVkSemaphores[rCommandBuffers.miCurrentIndex]);
-		vkPipelineStageFlags.push_back(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
-		vkSemaphores.emplace_back(gpSwapchainManager->mImageAvailableVkSemaphore);
-		vkPipelineStageFlags.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
-
-	#if defined(ENABLE_RENDER_THREAD)
-		mSubmitMain.get();
-	#endif
-
-		VkSubmitInfo vkSubmitInfo
+void CommandBufferManager::ProcessSubmit(SubmitDescriptor& rSubmitDescriptor)
+{
+	if (rSubmitDescriptor.eSubmitType == SubmitType::kPresent)
+	{
+		VkPresentInfoKHR vkPresentInfoKHR
 		{
-			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
 			.pNext = nullptr,
-			.waitSemaphoreCount = static_cast<uint32_t>(vkSemaphores.size()),
-			.pWaitSemaphores = vkSemaphores.data(),
-			.pWaitDstStageMask = vkPipelineStageFlags.data(),
-			.commandBufferCount = 1,
-			.pCommandBuffers = &rCommandBuffers.mpImageCommandBuffers[rCommandBuffers.miCurrentIndex],
-			.signalSemaphoreCount = 1,
-			.pSignalSemaphores = &rCommandBuffers.mpImageFinishedVkSemaphores[rCommandBuffers.miCurrentIndex],
+			.waitSemaphoreCount = rSubmitDescriptor.uiWaitSemaphoreCount,
+			.pWaitSemaphores = rSubmitDescriptor.pWaitVkSemaphores,
+			.swapchainCount = 1,
+			.pSwapchains = &rSubmitDescriptor.vkSwapchainKHR,
+			.pImageIndices = &rSubmitDescriptor.uiImageIndex,
+			.pResults = nullptr,
 		};
-		CPU_PROFILE_START(kCpuTimerSubmitImage);
-		CHECK_VK(vkResetFences(gpDeviceManager->mVkDevice, 1, &rCommandBuffers.mpVkFences[rCommandBuffers.miCurrentIndex]));
-		CHECK_VK(vkQueueSubmit(gpDeviceManager->mGraphicsVkQueue, 1, &vkSubmitInfo, rCommandBuffers.mpVkFences[rCommandBuffers.miCurrentIndex]));
-		CPU_PROFILE_STOP(kCpuTimerSubmitImage);
 
-	#if defined(ENABLE_SCREENSHOTS)
-		if (mbSaveScreenshots && mScreenshotTimer.GetDeltaNs() > 2s)
-		{
-			mScreenshotTimer.Reset();
-			SaveScreenshot();
-			game::gpGame->ResetRealTime();
-		}
-	#endif
-	
-#if defined(ENABLE_RENDER_THREAD)
-	});
+		CPU_PROFILE_START(kCpuTimerPresent);
+		CHECK_VK(vkQueuePresentKHR(gpDeviceManager->mPresentVkQueue, &vkPresentInfoKHR));
+		CPU_PROFILE_STOP(kCpuTimerPresent);
+
+		rSubmitDescriptor.pCommandBuffers->Next();
+		return;
+	}
+
+	[[maybe_unused]] static constexpr CpuTimers kpSubmitCpuTimers[] = {kCpuTimerSubmitGlobal, kCpuTimerSubmitMain, kCpuTimerSubmitImage};
+	[[maybe_unused]] CpuTimers eCpuTimer = kpSubmitCpuTimers[static_cast<int64_t>(rSubmitDescriptor.eSubmitType)];
+
+	VkSubmitInfo vkSubmitInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.pNext = nullptr,
+		.waitSemaphoreCount = rSubmitDescriptor.uiWaitSemaphoreCount,
+		.pWaitSemaphores = rSubmitDescriptor.pWaitVkSemaphores,
+		.pWaitDstStageMask = rSubmitDescriptor.pWaitVkPipelineStageFlags,
+		.commandBufferCount = 1,
+		.pCommandBuffers = &rSubmitDescriptor.vkCommandBuffer,
+		.signalSemaphoreCount = 1,
+		.pSignalSemaphores = &rSubmitDescriptor.signalVkSemaphore,
+	};
+
+	if (rSubmitDescriptor.eSubmitType == SubmitType::kGlobal)
+	{
+		CPU_PROFILE_STOP_AND_SMOOTH(kCpuTimerAcquireToGlobal);
+	}
+
+	CPU_PROFILE_START(eCpuTimer);
+	if (rSubmitDescriptor.vkFence != VK_NULL_HANDLE)
+	{
+		CHECK_VK(vkResetFences(gpDeviceManager->mVkDevice, 1, &rSubmitDescriptor.vkFence));
+	}
+	CHECK_VK(vkQueueSubmit(gpDeviceManager->mGraphicsVkQueue, 1, &vkSubmitInfo, rSubmitDescriptor.vkFence));
+	CPU_PROFILE_STOP(eCpuTimer);
+
+	CPU_PROFILE_ADD(kCpuTimerSubmitLatency, std::chrono::high_resolution_clock::now() - rSubmitDescriptor.recordedTimePoint);
+
+#if defined(ENABLE_SCREENSHOTS)
+	if (rSubmitDescriptor.bSaveScreenshot)
+	{
+		SaveScreenshot();
+		game::gpGame->ResetRealTime();
+	}
 #endif
 }
 
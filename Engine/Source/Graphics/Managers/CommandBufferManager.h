@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Graphics/Objects/CommandBuffers.h"
+#include "Graphics/SubmissionThread.h"
 
 namespace engine
 {
@@ -24,18 +25,28 @@ public:
 	void SubmitMainCommandBuffer();
 	void SubmitImageCommandBuffer();
 
-	std::vector<CommandBuffers> mPerFramebufferCommandBuffers;
+	// Submits and presents are processed in the order they are ended, on the submission thread when there is one
+	SubmitDescriptor& BeginSubmit(SubmitType eSubmitType);
+	void EndSubmit(SubmitDescriptor& rSubmitDescriptor);
+	void WaitForSubmissions();
 
-#if defined(ENABLE_RENDER_THREAD)
-	std::future<void> mSubmitGlobal;
-	std::future<void> mSubmitMain;
-	std::future<void> mSubmitImage;
-#endif
+	std::vector<CommandBuffers> mPerFramebufferCommandBuffers;
 
 #if defined(ENABLE_SCREENSHOTS)
 	common::Timer mScreenshotTimer;
 	bool mbSaveScreenshots = false;
 #endif
+
+private:
+
+	void ProcessSubmit(SubmitDescriptor& rSubmitDescriptor);
+
+#if defined(ENABLE_RENDER_THREAD)
+	// Declared after the command buffers so it is joined before the descriptors it holds point at nothing
+	std::unique_ptr<SubmissionThread> mpSubmissionThread;
+#else
+	SubmitDescriptor mSubmitDescriptor;
+#endif
 };
 
 inline CommandBufferManager* gpCommandBufferManager = nullptr;
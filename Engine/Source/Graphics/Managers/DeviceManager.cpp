@@ -1,6 +1,8 @@
 #include "DeviceManager.h"
 
+#include "File/FileManager.h"
 #include "Graphics/Graphics.h"
+#include "Graphics/PipelineCache.h"
 #include "Profile/ProfileManager.h"
 
 #include "Shaders/ShaderLayouts.h"
@@ -8,6 +10,11 @@
 namespace engine
 {
 
+using enum FileFlags;
+
+constexpr char kpcPipelineCacheFile[] = "PipelineCache.bin";
+constexpr char kpcPipelineCacheTempFile[] = "PipelineCache.bin.tmp";
+
 constexpr const char* kpcDeviceExtensionNames[]
 {
 	VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -197,10 +204,15 @@ DeviceManager::DeviceManager()
 		.pPoolSizes = pVkDescriptorPoolSizes,
 	};
 	CHECK_VK(vkCreateDescriptorPool(gpDeviceManager->mVkDevice, &vkDescriptorPoolCreateInfo, nullptr, &mVkDescriptorPool));
+
+	CreatePipelineCache();
 }
 
 DeviceManager::~DeviceManager()
 {
+	SavePipelineCache();
+	vkDestroyPipelineCache(mVkDevice, mVkPipelineCache, nullptr);
+
 	// No need to free the individual descriptor sets: "When a pool is destroyed, all descriptor sets allocated from the pool are implicitly freed and become invalid"
 	vkDestroyDescriptorPool(gpDeviceManager->mVkDevice, mVkDescriptorPool, nullptr);
 
@@ -209,4 +221,53 @@ DeviceManager::~DeviceManager()
 	gpDeviceManager = nullptr;
 }
 
+void DeviceManager::SavePipelineCache()
+{
+	size_t dataSize = 0;
+	CHECK_VK(vkGetPipelineCacheData(mVkDevice, mVkPipelineCache, &dataSize, nullptr));
+	std::vector<uint8_t> data(dataSize);
+	CHECK_VK(vkGetPipelineCacheData(mVkDevice, mVkPipelineCache, &dataSize, data.data()));
+
+	// Write next to the old cache and swap it in, a crash while writing leaves the previous cache intact
+	{
+		std::fstream fileStream = gpFileManager->OpenFile({kAppDataDirectory, kWrite}, kpcPipelineCacheTempFile);
+		if (!WritePipelineCache(fileStream, gpInstanceManager->mVkPhysicalDeviceProperties, data))
+		{
+			LOG("Failed to write pipeline cache");
+			return;
+		}
+	}
+	gpFileManager->RenameFile({kAppDataDirectory, kWrite}, kpcPipelineCacheTempFile, kpcPipelineCacheFile);
+}
+
+void DeviceManager::CreatePipelineCache()
+{
+	std::vector<uint8_t> data;
+	if (gpFileManager->Exists({kAppDataDirectory, kRead}, kpcPipelineCacheFile))
+	{
+		std::fstream fileStream = gpFileManager->OpenFile({kAppDataDirectory, kRead}, kpcPipelineCacheFile);
+		data = ReadPipelineCache(fileStream, gpInstanceManager->mVkPhysicalDeviceProperties);
+		LOG("Pipeline cache {}: {} bytes", data.empty() ? "discarded" : "loaded", data.size());
+	}
+
+	VkPipelineCacheCreateInfo vkPipelineCacheCreateInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.initialDataSize = data.size(),
+		.pInitialData = data.empty() ? nullptr : data.data(),
+	};
+	VkResult vkResult = vkCreatePipelineCache(mVkDevice, &vkPipelineCacheCreateInfo, nullptr, &mVkPipelineCache);
+	if (vkResult != VK_SUCCESS && !data.empty())
+	{
+		// The driver has the final say on its own data, start over with an empty cache
+		LOG("Pipeline cache rejected by the driver");
+		vkPipelineCacheCreateInfo.initialDataSize = 0;
+		vkPipelineCacheCreateInfo.pInitialData = nullptr;
+		vkResult = vkCreatePipelineCache(mVkDevice, &vkPipelineCacheCreateInfo, nullptr, &mVkPipelineCache);
+	}
+	CHECK_VK(vkResult);
+}
+
 } // namespace engine
@@ -21,8 +21,15 @@ public:
 
 	VkDescriptorPool mVkDescriptorPool = VK_NULL_HANDLE;
 
+	// Loaded at startup and written back after the pipelines are created, so later boots skip most of the shader compilation
+	void SavePipelineCache();
+
+	VkPipelineCache mVkPipelineCache = VK_NULL_HANDLE;
+
 private:
 
+	void CreatePipelineCache();
+
 #if defined(ENABLE_VULKAN_DEBUG_LAYERS)
 	VkDebugReportCallbackEXT mVkDebugReportCallbackEXT = nullptr;
 #endif
@@ -0,0 +1,172 @@
+#include "MemoryManager.h"
+
+#include "Graphics/Graphics.h"
+
+namespace engine
+{
+
+// Anything over half a block gets a dedicated allocation so a block is never wasted on a single resource
+constexpr int64_t kiMemoryBlockSize = 64 * 1024 * 1024;
+constexpr int64_t kiMemoryMinAllocationSize = 256;
+
+MemoryManager::MemoryManager()
+{
+	gpMemoryManager = this;
+}
+
+MemoryManager::~MemoryManager()
+{
+	LogStatistics();
+
+	for (Pool& rPool : mPools)
+	{
+		for (Block& rBlock : rPool.blocks)
+		{
+			if (rBlock.allocator.miAllocationCount > 0)
+			{
+				LOG("MemoryManager: {} allocations leaked in memory type {}", rBlock.allocator.miAllocationCount, rPool.iMemoryTypeIndex);
+				DEBUG_BREAK();
+			}
+
+			if (rBlock.pMappedMemory != nullptr)
+			{
+				vkUnmapMemory(gpDeviceManager->mVkDevice, rBlock.vkDeviceMemory);
+			}
+			vkFreeMemory(gpDeviceManager->mVkDevice, rBlock.vkDeviceMemory, nullptr);
+		}
+	}
+
+	if (miDedicatedCount > 0)
+	{
+		LOG("MemoryManager: {} dedicated allocations leaked", miDedicatedCount);
+		DEBUG_BREAK();
+	}
+
+	gpMemoryManager = nullptr;
+}
+
+MemoryAllocation MemoryManager::Allocate(const VkMemoryRequirements& rVkMemoryRequirements, VkMemoryPropertyFlags vkMemoryPropertyFlags, bool bOptimalImage, const VkMemoryDedicatedAllocateInfo* pVkMemoryDedicatedAllocateInfo)
+{
+	int64_t iMemoryTypeIndex = FindMemoryType(rVkMemoryRequirements.memoryTypeBits, vkMemoryPropertyFlags);
+	bool bHostVisible = gpInstanceManager->mVkPhysicalDeviceMemoryProperties.memoryTypes[iMemoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+
+	MemoryAllocation memoryAllocation {};
+	memoryAllocation.vkSize = rVkMemoryRequirements.size;
+
+	if (pVkMemoryDedicatedAllocateInfo != nullptr || static_cast<int64_t>(rVkMemoryRequirements.size) > kiMemoryBlockSize / 2)
+	{
+		memoryAllocation.vkDeviceMemory = AllocateDeviceMemory(iMemoryTypeIndex, rVkMemoryRequirements.size, bHostVisible, memoryAllocation.pMappedMemory, pVkMemoryDedicatedAllocateInfo);
+		++miDedicatedCount;
+		mDedicatedVkDeviceSize += rVkMemoryRequirements.size;
+
+		return memoryAllocation;
+	}
+
+	auto it = std::find_if(mPools.begin(), mPools.end(), [iMemoryTypeIndex, bOptimalImage](const Pool& rPool)
+	{
+		return rPool.iMemoryTypeIndex == iMemoryTypeIndex && rPool.bOptimalImage == bOptimalImage;
+	});
+	if (it == mPools.end())
+	{
+		mPools.push_back({.iMemoryTypeIndex = iMemoryTypeIndex, .bOptimalImage = bOptimalImage, .bHostVisible = bHostVisible});
+		it = mPools.end() - 1;
+	}
+	memoryAllocation.iPool = it - mPools.begin();
+	Pool& rPool = *it;
+
+	int64_t iOffset = BuddyAllocator::kiInvalidOffset;
+	int64_t iBlock = 0;
+	for (Block& rBlock : rPool.blocks)
+	{
+		iOffset = rBlock.allocator.Allocate(rVkMemoryRequirements.size, rVkMemoryRequirements.alignment);
+		if (iOffset != BuddyAllocator::kiInvalidOffset)
+		{
+			break;
+		}
+		++iBlock;
+	}
+
+	if (iOffset == BuddyAllocator::kiInvalidOffset)
+	{
+		Block& rBlock = rPool.blocks.emplace_back(Block {.allocator = BuddyAllocator(kiMemoryBlockSize, kiMemoryMinAllocationSize)});
+		rBlock.vkDeviceMemory = AllocateDeviceMemory(iMemoryTypeIndex, kiMemoryBlockSize, bHostVisible, rBlock.pMappedMemory, nullptr);
+
+		iOffset = rBlock.allocator.Allocate(rVkMemoryRequirements.size, rVkMemoryRequirements.alignment);
+		ASSERT(iOffset != BuddyAllocator::kiInvalidOffset);
+	}
+	memoryAllocation.iBlock = iBlock;
+	memoryAllocation.vkOffset = static_cast<VkDeviceSize>(iOffset);
+
+	const Block& rBlock = rPool.blocks[memoryAllocation.iBlock];
+	memoryAllocation.vkDeviceMemory = rBlock.vkDeviceMemory;
+	memoryAllocation.pMappedMemory = rBlock.pMappedMemory != nullptr ? rBlock.pMappedMemory + memoryAllocation.vkOffset : nullptr;
+
+	return memoryAllocation;
+}
+
+void MemoryManager::Free(MemoryAllocation& rMemoryAllocation) noexcept
+{
+	if (rMemoryAllocation.vkDeviceMemory == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	if (rMemoryAllocation.iPool < 0)
+	{
+		if (rMemoryAllocation.pMappedMemory != nullptr)
+		{
+			vkUnmapMemory(gpDeviceManager->mVkDevice, rMemoryAllocation.vkDeviceMemory);
+		}
+		vkFreeMemory(gpDeviceManager->mVkDevice, rMemoryAllocation.vkDeviceMemory, nullptr);
+		--miDedicatedCount;
+		mDedicatedVkDeviceSize -= rMemoryAllocation.vkSize;
+	}
+	else
+	{
+		BuddyAllocator& rAllocator = mPools[rMemoryAllocation.iPool].blocks[rMemoryAllocation.iBlock].allocator;
+		rAllocator.Free(static_cast<int64_t>(rMemoryAllocation.vkOffset));
+	#if defined(BT_DEBUG)
+		ASSERT(rAllocator.Validate());
+	#endif
+	}
+
+	rMemoryAllocation = {};
+}
+
+void MemoryManager::LogStatistics()
+{
+	LOG("MemoryManager: {} dedicated allocations, {} MB", miDedicatedCount, mDedicatedVkDeviceSize / (1024 * 1024));
+
+	for (const Pool& rPool : mPools)
+	{
+		for (const Block& rBlock : rPool.blocks)
+		{
+			[[maybe_unused]] const BuddyAllocator& rAllocator = rBlock.allocator;
+			LOG("    Memory type {} {}: {} allocations, {} KB used, {} KB largest free, {:.1f}% fragmented", rPool.iMemoryTypeIndex, rPool.bOptimalImage ? "optimal" : "linear", rAllocator.miAllocationCount, rAllocator.miUsedBytes / 1024, rAllocator.LargestFree() / 1024, 100.0f * rAllocator.Fragmentation());
+		}
+	}
+}
+
+VkDeviceMemory MemoryManager::AllocateDeviceMemory(int64_t iMemoryTypeIndex, VkDeviceSize vkDeviceSize, bool bHostVisible, char*& rpMappedMemory, const VkMemoryDedicatedAllocateInfo* pVkMemoryDedicatedAllocateInfo)
+{
+	VkMemoryAllocateInfo vkMemoryAllocateInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.pNext = pVkMemoryDedicatedAllocateInfo,
+		.allocationSize = vkDeviceSize,
+		.memoryTypeIndex = static_cast<uint32_t>(iMemoryTypeIndex),
+	};
+	VkDeviceMemory vkDeviceMemory = VK_NULL_HANDLE;
+	CHECK_VK(vkAllocateMemory(gpDeviceManager->mVkDevice, &vkMemoryAllocateInfo, nullptr, &vkDeviceMemory));
+
+	// Host visible memory stays mapped for its whole lifetime, a VkDeviceMemory can only be mapped once
+	rpMappedMemory = nullptr;
+	if (bHostVisible)
+	{
+		CHECK_VK(vkMapMemory(gpDeviceManager->mVkDevice, vkDeviceMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&rpMappedMemory)));
+	}
+
+	return vkDeviceMemory;
+}
+
+} // namespace engine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Graphics/BuddyAllocator.h"
+
+namespace engine
+{
+
+struct MemoryAllocation
+{
+	VkDeviceMemory vkDeviceMemory = VK_NULL_HANDLE;
+	VkDeviceSize vkOffset = 0;
+	VkDeviceSize vkSize = 0;
+	char* pMappedMemory = nullptr;
+
+	// iPool is -1 for dedicated allocations
+	int64_t iPool = -1;
+	int64_t iBlock = 0;
+};
+
+// Sub-allocates buffers and images out of large VkDeviceMemory blocks, one pool per memory type and per linear/optimal resource kind
+// Keeping linear and optimal resources in separate blocks means bufferImageGranularity never needs to be padded for
+class MemoryManager
+{
+public:
+
+	MemoryManager();
+	~MemoryManager();
+
+	MemoryAllocation Allocate(const VkMemoryRequirements& rVkMemoryRequirements, VkMemoryPropertyFlags vkMemoryPropertyFlags, bool bOptimalImage, const VkMemoryDedicatedAllocateInfo* pVkMemoryDedicatedAllocateInfo = nullptr);
+	void Free(MemoryAllocation& rMemoryAllocation) noexcept;
+
+	void LogStatistics();
+
+private:
+
+	struct Block
+	{
+		VkDeviceMemory vkDeviceMemory = VK_NULL_HANDLE;
+		char* pMappedMemory = nullptr;
+		BuddyAllocator allocator;
+	};
+
+	struct Pool
+	{
+		int64_t iMemoryTypeIndex = 0;
+		bool bOptimalImage = false;
+		bool bHostVisible = false;
+		std::vector<Block> blocks;
+	};
+
+	VkDeviceMemory AllocateDeviceMemory(int64_t iMemoryTypeIndex, VkDeviceSize vkDeviceSize, bool bHostVisible, char*& rpMappedMemory, const VkMemoryDedicatedAllocateInfo* pVkMemoryDedicatedAllocateInfo);
+
+	std::vector<Pool> mPools;
+
+	int64_t miDedicatedCount = 0;
+	VkDeviceSize mDedicatedVkDeviceSize = 0;
+};
+
+inline MemoryManager* gpMemoryManager = nullptr;
+
+} // namespace engine
@@ -27,6 +27,8 @@ void ParticleManager::Spawn(shaders::ParticlesSpawnLayout& rParticlesSpawnLayout
 	ASSERT(gCurrentFrameTypeProcessing == FrameType::kFull);
 #endif
 
+	std::lock_guard lockGuard(gpParticleManager->mSpawnMutex);
+
 	if (rParticlesSpawnLayout.i4Misc.x == shaders::kiMaxParticlesSpawn)
 	{
 		// Too many particles spawn on the same frame, decrease spawn count or increase kiMaxParticlesSpawn
@@ -55,6 +57,8 @@ void ParticleManager::RenderGlobal(int64_t iCommandBuffer, [[maybe_unused]] cons
 	rGlobalLayout.f4ParticlesOne.z = 2.0f;
 
 	// Spawn
+	std::lock_guard lockGuard(mSpawnMutex);
+
 	rLongParticlesSpawnLayout.i4Misc = mLongParticlesSpawnLayout.i4Misc;
 	memcpy(&rLongParticlesSpawnLayout.pParticles[0], &mLongParticlesSpawnLayout.pParticles[0], rLongParticlesSpawnLayout.i4Misc.x * sizeof(shaders::ParticleLayout));
 	mLongParticlesSpawnLayout.i4Misc.x = 0;
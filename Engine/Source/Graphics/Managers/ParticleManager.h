@@ -23,6 +23,8 @@ public:
 
 	bool mbReset = true;
 
+	// Spawn() is called from kFull ticks on the simulation thread, RenderGlobal() drains the spawn layouts on the main thread
+	std::mutex mSpawnMutex;
 	shaders::ParticlesSpawnLayout mLongParticlesSpawnLayout {};
 	shaders::ParticlesSpawnLayout mSquareParticlesSpawnLayout {};
 };
@@ -16,6 +16,8 @@ PipelineManager::PipelineManager()
 
 	SCOPED_BOOT_TIMER(kBootTimerPipelineManager);
 
+	Pipeline::BeginBatch();
+
 	CreateLightingPipelines();
 	CreateShadowPipelines();
 	CreateLightingShadowDependantPipelines();
@@ -62,7 +64,7 @@ PipelineManager::PipelineManager()
 		.pDescriptorInfos =
 		{
 			{.flags = kPerCommandBufferUniformBuffers, .pBuffers = gpBufferManager->mGlobalLayoutUniformBuffers.data()},
-			{.flags = kStorageBuffer, .pBuffers = &gpIslands->mIslandsStorageBuffer},
+			{.flags = kPerCommandBufferStorageBuffers, .pBuffers = gpBufferManager->mIslandsStorageBuffers.data()},
 			{.flags = kCombinedSamplers, .iCount = gpIslands->miCount, .ppTextures = gpTextureManager->mElevationTextures.data()},
 		},
 	});
@@ -78,7 +80,7 @@ PipelineManager::PipelineManager()
 		.pDescriptorInfos =
 		{
 			{.flags = kPerCommandBufferUniformBuffers, .pBuffers = gpBufferManager->mGlobalLayoutUniformBuffers.data()},
-			{.flags = kStorageBuffer, .pBuffers = &gpIslands->mIslandsStorageBuffer},
+			{.flags = kPerCommandBufferStorageBuffers, .pBuffers = gpBufferManager->mIslandsStorageBuffers.data()},
 			{.flags = kCombinedSamplers, .iCount = gpIslands->miCount, .ppTextures = gpTextureManager->mColorTextures.data()},
 		},
 	});
@@ -94,7 +96,7 @@ PipelineManager::PipelineManager()
 		.pDescriptorInfos =
 		{
 			{.flags = kPerCommandBufferUniformBuffers, .pBuffers = gpBufferManager->mGlobalLayoutUniformBuffers.data()},
-			{.flags = kStorageBuffer, .pBuffers = &gpIslands->mIslandsStorageBuffer},
+			{.flags = kPerCommandBufferStorageBuffers, .pBuffers = gpBufferManager->mIslandsStorageBuffers.data()},
 			{.flags = kCombinedSamplers, .iCount = gpIslands->miCount, .ppTextures = gpTextureManager->mNormalsTextures.data()},
 		},
 	});
@@ -110,7 +112,7 @@ PipelineManager::PipelineManager()
 		.pDescriptorInfos =
 		{
 			{.flags = kPerCommandBufferUniformBuffers, .pBuffers = gpBufferManager->mGlobalLayoutUniformBuffers.data()},
-			{.flags = kStorageBuffer, .pBuffers = &gpIslands->mIslandsStorageBuffer},
+			{.flags = kPerCommandBufferStorageBuffers, .pBuffers = gpBufferManager->mIslandsStorageBuffers.data()},
 			{.flags = kCombinedSamplers, .iCount = gpIslands->miCount, .ppTextures = gpTextureManager->mAmbientOcclusionTextures.data()},
 		},
 	});
@@ -355,6 +357,13 @@ PipelineManager::PipelineManager()
 
 	mGltfPipelines.CreateGltfShadowPipelines();
 	mGltfPipelines.CreateGltfPipelines();
+
+	{
+		SCOPED_BOOT_TIMER(kBootTimerPipelineCompilation);
+		Pipeline::EndBatch();
+	}
+
+	gpDeviceManager->SavePipelineCache();
 }
 
 PipelineManager::~PipelineManager()
@@ -531,7 +540,7 @@ void PipelineManager::CreateShadowPipelines()
 		.pDescriptorInfos =
 		{
 			{.flags = kPerCommandBufferUniformBuffers, .pBuffers = gpBufferManager->mGlobalLayoutUniformBuffers.data()},
-			{.flags = kStorageBuffer, .pBuffers = &gpIslands->mIslandsStorageBuffer},
+			{.flags = kPerCommandBufferStorageBuffers, .pBuffers = gpBufferManager->mIslandsStorageBuffers.data()},
 			{.flags = kCombinedSamplers, .iCount = gpIslands->miCount, .ppTextures = gpTextureManager->mElevationTextures.data()},
 		},
 	});
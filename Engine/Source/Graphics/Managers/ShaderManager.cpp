@@ -13,14 +13,8 @@ ShaderManager::ShaderManager()
 
 	SCOPED_BOOT_TIMER(kBootTimerShaderManager);
 
-	auto& rChunkMap = gpFileManager->GetDataChunkMap();
-	for (auto& [rCrc, rChunk] : rChunkMap)
+	for (const Chunk& rChunk : gpFileManager->GetDataChunks(kChunkShaders))
 	{
-		if (!(rChunk.pHeader->flags & common::ChunkFlags::kShaderCompute) && !(rChunk.pHeader->flags & common::ChunkFlags::kShaderFragment) && !(rChunk.pHeader->flags & common::ChunkFlags::kShaderVertex))
-		{
-			continue;
-		}
-
 	#if !defined(ENABLE_DEBUG_PRINTF_EXT)
 		if (strcmp(rChunk.pHeader->pcPath, "Shaders\\Log.vert") == 0)
 		{
@@ -28,7 +22,7 @@ ShaderManager::ShaderManager()
 		}
 	#endif
 
-		auto [it, bInserted] = mShaders.try_emplace(rCrc, ShaderInfo {.pChunkHeader = rChunk.pHeader}, rChunk.pData);
+		auto [it, bInserted] = mShaders.try_emplace(rChunk.pHeader->crc, ShaderInfo {.pChunkHeader = rChunk.pHeader}, rChunk.pData);
 		ASSERT(bInserted);
 	}
 }
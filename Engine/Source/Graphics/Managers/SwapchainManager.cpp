@@ -425,50 +425,59 @@ void SwapchainManager::AcquireNextImage()
 
 void SwapchainManager::Present()
 {
-#if defined(ENABLE_RENDER_THREAD)
-	mPresent = std::async(std::launch::async, [this]()
-	{
-		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
-#endif
-
-		CommandBuffers& rCommandBuffers = gpCommandBufferManager->mPerFramebufferCommandBuffers.at(gpSwapchainManager->miFramebufferIndex);
-
-		uint32_t uiCurrentFramebufferIndex = static_cast<uint32_t>(gpSwapchainManager->miFramebufferIndex);
-		VkPresentInfoKHR vkPresentInfoKHR
-		{
-			.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-			.pNext = nullptr,
-			.waitSemaphoreCount = 1,
-			.pWaitSemaphores = &rCommandBuffers.mpImageFinishedVkSemaphores[rCommandBuffers.miCurrentIndex],
-			.swapchainCount = 1,
-			.pSwapchains = &mVkSwapchainKHR,
-			.pImageIndices = &uiCurrentFramebufferIndex,
-			.pResults = nullptr,
-		};
-
-	#if defined(ENABLE_RENDER_THREAD)
-		gpCommandBufferManager->mSubmitImage.get();
-	#endif
-	
-		CPU_PROFILE_START(kCpuTimerPresent);
-		CHECK_VK(vkQueuePresentKHR(gpDeviceManager->mPresentVkQueue, &vkPresentInfoKHR));
-		CPU_PROFILE_STOP(kCpuTimerPresent);
-
-		rCommandBuffers.Next();
-	#if defined(ENABLE_RENDER_THREAD)
-	});
-#endif
+	CommandBuffers& rCommandBuffers = gpCommandBufferManager->mPerFramebufferCommandBuffers.at(miFramebufferIndex);
+
+	// Queued behind the image submit, the command buffers move on to the next index once the present has been processed
+	SubmitDescriptor& rSubmitDescriptor = gpCommandBufferManager->BeginSubmit(SubmitType::kPresent);
+	rSubmitDescriptor.uiWaitSemaphoreCount = 1;
+	rSubmitDescriptor.pWaitVkSemaphores[0] = rCommandBuffers.mpImageFinishedVkSemaphores[rCommandBuffers.miCurrentIndex];
+	rSubmitDescriptor.vkSwapchainKHR = mVkSwapchainKHR;
+	rSubmitDescriptor.uiImageIndex = static_cast<uint32_t>(miFramebufferIndex);
+	rSubmitDescriptor.pCommandBuffers = &rCommandBuffers;
+	gpCommandBufferManager->EndSubmit(rSubmitDescriptor);
 }
 
 void SwapchainManager::ReduceInputLag()
 {
-	if (gReduceInputLag.Get<bool>() && gpSwapchainManager->mCurrentImageAvailableVkFence != VK_NULL_HANDLE)
+	if (!gReduceInputLag.Get<bool>() || mCurrentImageAvailableVkFence == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	if (!kbPaceFrameStartAvailable || !gPaceFrameStart.Get<bool>())
 	{
 		// Block the CPU here to reduce input lag to a minimum
 		SCOPED_CPU_PROFILE(kCpuTimerReduceInputLagFence);
-		CHECK_VK(vkWaitForFences(gpDeviceManager->mVkDevice, 1, &gpSwapchainManager->mCurrentImageAvailableVkFence, VK_TRUE, kFenceTimeoutNs.count()));
+		CHECK_VK(vkWaitForFences(gpDeviceManager->mVkDevice, 1, &mCurrentImageAvailableVkFence, VK_TRUE, kFenceTimeoutNs.count()));
 		mCurrentImageAvailableVkFence = VK_NULL_HANDLE;
+		mFramePacer = {};
+		return;
+	}
+
+	// The image pass is what the GPU still has to do after the last submit of the frame
+	std::chrono::nanoseconds gpuTail = 0ns;
+#if defined(ENABLE_PROFILING)
+	gpuTail = std::chrono::microseconds(gpGpuTimers[kGpuTimerImage].smoothedMicroseconds.Get());
+#endif
+	mFramePacer.SetRefreshRate(gpGraphics->miMonitorRefreshRate);
+	mFramePacer.EndFrame(FramePacer::Clock::now(), gpuTail);
+
+	// The image becomes available around the refresh that put the previous frame on screen, which is what the next start is scheduled from
+	bool bWaited = vkGetFenceStatus(gpDeviceManager->mVkDevice, mCurrentImageAvailableVkFence) == VK_NOT_READY;
+	if (bWaited)
+	{
+		SCOPED_CPU_PROFILE(kCpuTimerReduceInputLagFence);
+		CHECK_VK(vkWaitForFences(gpDeviceManager->mVkDevice, 1, &mCurrentImageAvailableVkFence, VK_TRUE, kFenceTimeoutNs.count()));
+	}
+	mCurrentImageAvailableVkFence = VK_NULL_HANDLE;
+	mFramePacer.ImageAvailable(FramePacer::Clock::now(), bWaited);
+
+	{
+		// Sample input as late as the predicted work allows instead of right after the image is available
+		SCOPED_CPU_PROFILE(kCpuTimerReduceInputLagSleep);
+		common::SleepUntil(mFramePacer.StartTime());
 	}
+	mFramePacer.StartFrame(FramePacer::Clock::now());
 }
 
 } // namespace engine
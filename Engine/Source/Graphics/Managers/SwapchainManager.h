@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Graphics/FramePacer.h"
 #include "Graphics/Objects/Texture.h"
 
 namespace engine
@@ -43,9 +44,7 @@ public:
 
 	VkRenderPass mVkRenderPass = VK_NULL_HANDLE;
 
-#if defined(ENABLE_RENDER_THREAD)
-	std::future<void> mPresent;
-#endif
+	FramePacer mFramePacer;
 
 private:
 
@@ -16,7 +16,8 @@ static VkMappedMemoryRange sVkMappedMemoryRange
 	// .size
 };
 
-TextManager::TextManager()
+TextManager::TextManager(const GlyphTable& rGlyphTable)
+: mGlyphTable(rGlyphTable)
 {
 	gpTextManager = this;
 
@@ -36,37 +37,10 @@ TextManager::TextManager()
 		}
 	}
 
-	auto& rChunkMap = gpFileManager->GetDataChunkMap();
+	mfLineHeightEfigs = mGlyphTable.fLineHeightEfigs;
+	mfLineHeightChinese = mGlyphTable.fLineHeightChinese;
 
-	{
-		Chunk& rChunk = rChunkMap.at(data::kFontsNotoSansNotoSansRegularfntCrc);
-		int64_t iCharacters = rChunk.pHeader->fontHeader.iCharacters;
-		auto pCharacterIds = reinterpret_cast<uint32_t*>(rChunk.pData);
-		auto pCharacters = reinterpret_cast<common::Character*>(rChunk.pData + common::RoundUp(iCharacters * static_cast<int64_t>(sizeof(pCharacterIds[0])), common::kiAlignmentBytes));
-		LOG("Loading font {:#018x} with {} characters", data::kFontsNotoSansNotoSansRegularfntCrc, iCharacters);
-		mfLineHeightEfigs = static_cast<float>(rChunk.pHeader->fontHeader.iLineHeight);
-
-		for (int64_t i = 0; i < iCharacters; ++i)
-		{
-			auto [it, bInserted] = mCharacterMapEfigs.try_emplace(pCharacterIds[i], &pCharacters[i]);
-			ASSERT(bInserted);
-		}
-	}
-
-	{
-		Chunk& rChunk = rChunkMap.at(data::kFontsNotoSansSCNotoSansSCLightfntCrc);
-		int64_t iCharacters = rChunk.pHeader->fontHeader.iCharacters;
-		auto pCharacterIds = reinterpret_cast<uint32_t*>(rChunk.pData);
-		auto pCharacters = reinterpret_cast<common::Character*>(rChunk.pData + common::RoundUp(iCharacters * static_cast<int64_t>(sizeof(pCharacterIds[0])), common::kiAlignmentBytes));
-		LOG("Loading font {:#018x} with {} characters", data::kFontsNotoSansSCNotoSansSCLightfntCrc, iCharacters);
-		mfLineHeightChinese = static_cast<float>(rChunk.pHeader->fontHeader.iLineHeight);
-
-		for (int64_t i = 0; i < iCharacters; ++i)
-		{
-			auto [it, bInserted] = mCharacterMapChinese.try_emplace(pCharacterIds[i], &pCharacters[i]);
-			ASSERT(bInserted);
-		}
-	}
+	mScratchQuads.resize(kiMaxTextQuads);
 
 	gpTextManager->UpdateTextArea(kTextDebug, "");
 }
@@ -76,21 +50,37 @@ TextManager::~TextManager()
 	gpTextManager = nullptr;
 }
 
-std::tuple<common::Character*, bool> TextManager::GetCharacter(uint32_t uiChar)
+static void AddFontChunk(GlyphTable& rGlyphTable, const Chunk& rChunk, bool bEfigs)
 {
-	if (mCharacterMapEfigs.find(uiChar) != mCharacterMapEfigs.end())
-	{
-		return std::make_tuple(mCharacterMapEfigs.at(uiChar), true);
-	}
-	else if (mCharacterMapChinese.find(uiChar) != mCharacterMapChinese.end())
-	{
-		return std::make_tuple(mCharacterMapChinese.at(uiChar), false);
-	}
-	else
+	int64_t iCharacters = rChunk.pHeader->fontHeader.iCharacters;
+	auto pCharacterIds = reinterpret_cast<uint32_t*>(rChunk.pData);
+	auto pCharacters = reinterpret_cast<common::Character*>(rChunk.pData + common::RoundUp(iCharacters * static_cast<int64_t>(sizeof(pCharacterIds[0])), common::kiAlignmentBytes));
+	LOG("Loading font {:#018x} with {} characters", rChunk.pHeader->crc, iCharacters);
+
+	AddFont(rGlyphTable, pCharacterIds, pCharacters, iCharacters, rChunk.pHeader->fontHeader.iLineHeight, bEfigs);
+}
+
+GlyphTable BuildGlyphTable()
+{
+	gpFileManager->WaitForDataFile();
+	SCOPED_BOOT_TIMER(kBootTimerPrepareGlyphs);
+
+	GlyphTable glyphTable;
+
+	// Efigs first so it wins for characters both fonts have
+	std::span<const Chunk> fonts = gpFileManager->GetDataChunks(kChunkFonts);
+	for (common::crc_t crc : {data::kFontsNotoSansNotoSansRegularfntCrc, data::kFontsNotoSansSCNotoSansSCLightfntCrc})
 	{
-		DEBUG_BREAK();
-		return std::make_tuple(mCharacterMapEfigs.begin()->second, true);
+		auto it = std::find_if(fonts.begin(), fonts.end(), [=](const Chunk& rChunk)
+		{
+			return rChunk.pHeader->crc == crc;
+		});
+		ASSERT(it != fonts.end());
+		AddFontChunk(glyphTable, *it, crc == data::kFontsNotoSansNotoSansRegularfntCrc);
 	}
+	SortGlyphTable(glyphTable);
+
+	return glyphTable;
 }
 
 void TextManager::UpdateTextArea(TextAreas eTextArea, std::string_view pcCharacters)
@@ -104,14 +94,35 @@ void TextManager::UpdateTextArea(TextAreas eTextArea, std::string_view pcCharact
 
 void TextManager::RenderMain(int64_t iCommandBuffer)
 {
+	SCOPED_CPU_PROFILE(kCpuTimerTextRender);
+
 	auto pQuads = reinterpret_cast<shaders::AxisAlignedQuadLayout*>(gpBufferManager->mTextStorageBuffers.at(iCommandBuffer).mpMappedMemory);
 	int64_t iPos = 0;
 
-	for (const TextArea& rTextArea : gpTextAreas)
+	float fAspectRatio = gpSwapchainManager->mfAspectRatio;
+	for (int64_t i = 0; i < kTextAreasCount; ++i)
 	{
-		std::vector<float> xOffsets;
-		xOffsets.push_back(rTextArea.fX);
-		WriteQuads(xOffsets, rTextArea.fY, 0.25f * rTextArea.fSize, std::string_view(rTextArea.pcText, rTextArea.iCharacterCount), 0xFFFFFFFF, pQuads, iPos, kiMaxTextQuads);
+		const TextArea& rTextArea = gpTextAreas[i];
+		std::string_view pcText(rTextArea.pcText, rTextArea.iCharacterCount);
+		float fSize = 0.25f * rTextArea.fSize;
+
+		// The profile text only changes a few times a second, every other frame copies the quads laid out last time
+		TextRunKey textRunKey {.fX = rTextArea.fX, .fY = rTextArea.fY, .fSize = fSize, .fAspectRatio = fAspectRatio};
+		mpTextRuns[i].Update(textRunKey, pcText, std::span(mScratchQuads), [&](shaders::AxisAlignedQuadLayout* pScratchQuads, int64_t& riScratchQuads, int64_t iMaxScratchQuads)
+		{
+			TextLines xOffsets;
+			xOffsets.Push(rTextArea.fX);
+			WriteQuads(xOffsets, rTextArea.fY, fSize, pcText, 0xFFFFFFFF, pScratchQuads, riScratchQuads, iMaxScratchQuads);
+		});
+
+		std::span<const shaders::AxisAlignedQuadLayout> quads = mpTextRuns[i].Quads();
+		int64_t iQuads = std::min(static_cast<int64_t>(quads.size()), kiMaxTextQuads - iPos);
+		if (iQuads < static_cast<int64_t>(quads.size()))
+		{
+			LOG("riPos >= iMaxPos");
+		}
+		memcpy(&pQuads[iPos], quads.data(), iQuads * sizeof(shaders::AxisAlignedQuadLayout));
+		iPos += iQuads;
 	}
 
 	gpPipelineManager->mpPipelines[kPipelineProfileText].WriteIndirectBuffer(iCommandBuffer, iPos);
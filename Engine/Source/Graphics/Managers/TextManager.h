@@ -1,8 +1,10 @@
 #pragma once
 
+#include "Graphics/Glyphs.h"
 #include "Graphics/Managers/SwapchainManager.h"
 #include "Graphics/Managers/TextureManager.h"
 #include "Ui/Localization.h"
+#include "Ui/Retained.h"
 #include "Ui/UiManager.h"
 
 namespace engine
@@ -75,61 +77,60 @@ inline TextArea gpTextAreas[]
 };
 static_assert(std::size(gpTextAreas) == kTextAreasCount);
 
-inline constexpr float kfEfigsSize = 2048.0f;
-inline constexpr float kfChineseSize = 8192.0f;
-
 template<typename T>
 constexpr bool IsEfigs(std::basic_string_view<T> pcText)
 {
 	return pcText.size() == 0 ? true : pcText[0] < 0x4E00;
 }
 
+GlyphTable BuildGlyphTable();
+
 class TextManager
 {
 public:
 
-	TextManager();
+	TextManager(const GlyphTable& rGlyphTable);
 	~TextManager();
 
-	std::tuple<common::Character*, bool> GetCharacter(uint32_t uiChar);
+	const Glyph& FindGlyph(uint32_t uiChar) const
+	{
+		return mGlyphTable.Find(uiChar);
+	}
 
 	void UpdateTextArea(TextAreas eTextArea, std::string_view pcCharacters);
 	void RenderMain(int64_t iCommandBuffer);
 
 	template<typename T>
-	[[nodiscard]] std::vector<float> MeasureQuads(float fSize, std::basic_string_view<T> pcText)
+	[[nodiscard]] TextLines MeasureQuads(float fSize, std::basic_string_view<T> pcText) const
 	{
-		float fInverseLineHeight = 1.0f / (IsEfigs(pcText) ? mfLineHeightEfigs : mfLineHeightChinese);
-		float fInverseAspectRatio = 1.0f / gpSwapchainManager->mfAspectRatio;
+		float fScale = fSize / (gpSwapchainManager->mfAspectRatio * (IsEfigs(pcText) ? mfLineHeightEfigs : mfLineHeightChinese));
 
-		std::vector<float> widths;
+		TextLines widths;
 		float fCurrentX = 0.0f;
 		for (size_t iInPos = 0; iInPos < pcText.size(); ++iInPos)
 		{
 			if (pcText[iInPos] == '\n')
 			{
-				widths.push_back(fCurrentX);
+				widths.Push(fCurrentX);
 				fCurrentX = 0.0f;
 				continue;
 			}
 
-			auto [pCharacter, bEfigs] = GetCharacter(pcText[iInPos]);
-			float fAdvance = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->iXAdvance);
-
-			fCurrentX += fAdvance;
+			fCurrentX += fScale * FindGlyph(pcText[iInPos]).fXAdvance;
 		}
-		widths.push_back(fCurrentX);
+		widths.Push(fCurrentX);
 
 		return widths;
 	}
 
 	template<typename T, typename U>
-	void WriteQuads(const std::vector<float>& rXOffsets, float fY, float fSize, std::basic_string_view<T> pcText, uint32_t uiColor, U* pQuads, int64_t& riPos, int64_t iMaxPos)
+	void WriteQuads(const TextLines& rXOffsets, float fY, float fSize, std::basic_string_view<T> pcText, uint32_t uiColor, U* pQuads, int64_t& riPos, int64_t iMaxPos) const
 	{
-		float fInverseAspectRatio = 1.0f / gpSwapchainManager->mfAspectRatio;
+		float fScaleX = fSize / gpSwapchainManager->mfAspectRatio;
+		float fScaleY = fSize;
 
 		int64_t iCurrentX = 0;
-		float fCurrentX = rXOffsets.at(iCurrentX++);
+		float fCurrentX = rXOffsets.pfValues[iCurrentX++];
 		float fCurrentY = fY;
 		for (size_t iInPos = 0; iInPos < pcText.size(); ++iInPos)
 		{
@@ -141,51 +142,20 @@ public:
 
 			if (pcText[iInPos] == '\n')
 			{
-				fCurrentX = rXOffsets.size() == 1 ? rXOffsets.at(0) : rXOffsets.at(iCurrentX++);
+				fCurrentX = rXOffsets.iCount == 1 ? rXOffsets.pfValues[0] : rXOffsets.pfValues[std::min(iCurrentX++, rXOffsets.iCount - 1)];
 				fCurrentY += fSize;
 				continue;
 			}
 
-			auto [pCharacter, bEfigs] = GetCharacter(pcText[iInPos]);
-			float fLineHeight = bEfigs ? mfLineHeightEfigs : mfLineHeightChinese;
+			const Glyph& rGlyph = FindGlyph(pcText[iInPos]);
 
-			// Manual adjustments to match Efigs
-			if (!bEfigs)
-			{
-				fLineHeight *= 1.4f;
-			}
-
-			float fInverseLineHeight = 1.0f / fLineHeight;
-			float fWidth = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->uiWidth);
-			float fHeight = fSize * fInverseLineHeight * static_cast<float>(pCharacter->uiHeight);
-			float fXOffset = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->iXOffset);
-			float fYOffset = fSize * fInverseLineHeight * static_cast<float>(pCharacter->iYOffset);
-			float fAdvance = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->iXAdvance);
-
-			// Manual adjustments to match Efigs
-			if (!bEfigs)
-			{
-				fWidth *= 1.4f;
-				fHeight *= 1.4f;
-				fAdvance *= 1.6f;
-			}
-
-			pQuads[riPos].f4VertexRect = {-1.0f + 2.0f * (fCurrentX + fXOffset), 1.0f - 2.0f * (fCurrentY + fYOffset), 2.0f * fWidth, -2.0f * fHeight};
-			fCurrentX += fAdvance;
-
-			float fTextureHeight = bEfigs ? kfEfigsSize : kfChineseSize;
-			float fTextureWidth = bEfigs ? kfEfigsSize : kfChineseSize;
-			pQuads[riPos].f4TextureRect = DirectX::XMFLOAT4
-			(
-				static_cast<float>(pCharacter->uiX) / fTextureWidth,
-				static_cast<float>(pCharacter->uiY) / fTextureHeight,
-				static_cast<float>(pCharacter->uiX + pCharacter->uiWidth) / fTextureWidth,
-				static_cast<float>(pCharacter->uiY + pCharacter->uiHeight) / fTextureHeight
-			);
+			pQuads[riPos].f4VertexRect = {-1.0f + 2.0f * (fCurrentX + fScaleX * rGlyph.fXOffset), 1.0f - 2.0f * (fCurrentY + fScaleY * rGlyph.fYOffset), 2.0f * fScaleX * rGlyph.fWidth, -2.0f * fScaleY * rGlyph.fHeight};
+			pQuads[riPos].f4TextureRect = rGlyph.f4TextureRect;
+			fCurrentX += fScaleX * rGlyph.fAdvance;
 
 			if constexpr(std::is_same_v<U, shaders::WidgetLayout>)
 			{
-				pQuads[riPos].ui4Misc = {uiColor, UiCrcToIndex(bEfigs ? data::kTexturesUiBC4NotoSansRegularpngCrc : data::kTexturesUiBC4NotoSansSCLightpngCrc), 2, 0};
+				pQuads[riPos].ui4Misc = {uiColor, static_cast<uint32_t>(rGlyph.bEfigs ? data::kTexturesUiBC4NotoSansRegularpngIndex : data::kTexturesUiBC4NotoSansSCLightpngIndex), 2, 0};
 			}
 
 			++riPos;
@@ -197,8 +167,21 @@ public:
 
 private:
 
-	std::unordered_map<uint32_t, common::Character*> mCharacterMapEfigs;
-	std::unordered_map<uint32_t, common::Character*> mCharacterMapChinese;
+	// Everything a text area's quads are built from apart from the text
+	struct TextRunKey
+	{
+		float fX = 0.0f;
+		float fY = 0.0f;
+		float fSize = 0.0f;
+		float fAspectRatio = 0.0f;
+
+		bool operator==(const TextRunKey& rOther) const = default;
+	};
+
+	GlyphTable mGlyphTable;
+
+	RetainedQuads<TextRunKey, char, shaders::AxisAlignedQuadLayout> mpTextRuns[kTextAreasCount];
+	std::vector<shaders::AxisAlignedQuadLayout> mScratchQuads;
 };
 
 inline TextManager* gpTextManager = nullptr;
@@ -4,6 +4,7 @@
 #include "Graphics/Graphics.h"
 #include "Graphics/Islands.h"
 #include "Graphics/OneShotCommandBuffer.h"
+#include "Graphics/TextureUploader.h"
 #include "Profile/ProfileManager.h"
 #include "Frame/Pools/Smoke.h"
 
@@ -181,16 +182,12 @@ TextureManager::TextureManager()
 		.eTextureLayout = kShaderReadOnly,
 	});
 
-	auto& rChunkMap = gpFileManager->GetTexturesChunkMap();
+	std::span<const Chunk> textures = gpFileManager->GetTexturesChunks(kChunkTextures);
 
 	BOOT_TIMER_START(kBootTimerTextureUpload);
-	for (auto& [rCrc, rChunk] : rChunkMap)
+	TextureUploader textureUploader;
+	for (const Chunk& rChunk : textures)
 	{
-		if (!(rChunk.pHeader->flags & common::ChunkFlags::kTexture))
-		{
-			continue;
-		}
-
 		bool bCubemap = rChunk.pHeader->flags & common::ChunkFlags::kCubemap;
 		auto [it, bInserted] = mTextureMap.try_emplace(rChunk.pHeader->crc, TextureInfo
 		{
@@ -210,30 +207,51 @@ TextureManager::TextureManager()
 		[&](void* pData, int64_t iPosition, int64_t iSize)
 		{
 			memcpy(pData, &rChunk.pData[iPosition], iSize);
-		});
+		},
+		&textureUploader);
 		ASSERT(bInserted);
 	}
+	textureUploader.Submit();
 
 	// You need to manually change kiTextureCount/kiUiTextureCount in ShaderLayoutsBase.h to match the same values in Data.h
 	static_assert(data::kiTextureCount == shaders::kiTextureCount);
 	static_assert(data::kiUiTextureCount == shaders::kiUiTextureCount);
 	// DT: TODO In tools, can export textures before shaders, generate a texture header, then compile shaders after?
 
-	int64_t iIndex = 0;
+	// Descriptor slots are fixed at pack time, CrcToIndex()/UiCrcToIndex() resolve them from the tables in Data.h
 	for (const auto& rCrc : data::kpTextureCrcs)
 	{
 		mImageInfos.emplace_back(nullptr, mTextureMap.at(rCrc).mVkImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		mImageInfosMap.try_emplace(rCrc, iIndex++);
 	}
 	ASSERT(mImageInfos.size() == shaders::kiTextureCount);
-	iIndex = 0;
 	for (const auto& rCrc : data::kpUiTextureCrcs)
 	{
 		mUiImageInfos.emplace_back(nullptr, mTextureMap.at(rCrc).mVkImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		mUiImageInfosMap.try_emplace(rCrc, iIndex++);
 	}
 	ASSERT(mUiImageInfos.size() == shaders::kiUiTextureCount);
 
+#if defined(BT_DEBUG)
+	// A Data.h from a different pack than Textures.bin would silently sample the wrong textures, check every slot against what was loaded
+	for (int64_t i = 0; i < data::kiTextureCount; ++i)
+	{
+		ASSERT(CrcToIndex(data::kpTextureCrcs[i]) == static_cast<float>(i));
+		ASSERT(mImageInfos[i].imageView == mTextureMap.at(data::kpTextureCrcs[i]).mVkImageView);
+	}
+	for (int64_t i = 0; i < data::kiUiTextureCount; ++i)
+	{
+		ASSERT(UiCrcToIndex(data::kpUiTextureCrcs[i]) == static_cast<uint32_t>(i));
+		ASSERT(mUiImageInfos[i].imageView == mTextureMap.at(data::kpUiTextureCrcs[i]).mVkImageView);
+	}
+	for (const Chunk& rChunk : textures)
+	{
+		common::ChunkFlags_t flags = rChunk.pHeader->flags;
+		if (!(flags & common::ChunkFlags::kCubemap) && !(flags & common::ChunkFlags::kElevation) && std::string_view(rChunk.pHeader->pcPath).find("Gltf") == std::string_view::npos)
+		{
+			ASSERT(common::FindCrcIndex(data::kpTextureIndices, rChunk.pHeader->crc) >= 0 || common::FindCrcIndex(data::kpUiTextureIndices, rChunk.pHeader->crc) >= 0);
+		}
+	}
+#endif
+
 	for (int64_t i = 0; i < shaders::kiParticlesCookieCount; ++i)
 	{
 		mpSquareParticleTextures[i] = &mMissileTexture;
@@ -254,15 +272,10 @@ TextureManager::TextureManager()
 	mNormalsTextures.resize(game::Frame::kiIslandCount);
 	mAmbientOcclusionTextures.resize(game::Frame::kiIslandCount);
 
+	// Same order as Islands so every island gets its own textures
 	iIndex = 0;
-	auto& rDataChunkMap = gpFileManager->GetDataChunkMap();
-	for (auto& [rCrc, rChunk] : rDataChunkMap)
+	for (const Chunk& rChunk : gpFileManager->GetDataChunks(kChunkIslands))
 	{
-		if (!(rChunk.pHeader->flags & common::ChunkFlags::kIsland))
-		{
-			continue;
-		}
-
 		mElevationTextures[iIndex] = &gpTextureManager->mTextureMap.at(rChunk.pHeader->islandHeader.elevationCrc);
 		mColorTextures[iIndex] = &gpTextureManager->mTextureMap.at(rChunk.pHeader->islandHeader.colorsCrc);
 		mNormalsTextures[iIndex] = &gpTextureManager->mTextureMap.at(rChunk.pHeader->islandHeader.normalsCrc);
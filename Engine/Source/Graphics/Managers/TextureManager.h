@@ -43,9 +43,7 @@ public:
 
 	std::unordered_map<common::crc_t, Texture> mTextureMap;
 	std::vector<VkDescriptorImageInfo> mImageInfos;
-	std::unordered_map<common::crc_t, int64_t> mImageInfosMap;
 	std::vector<VkDescriptorImageInfo> mUiImageInfos;
-	std::unordered_map<common::crc_t, int64_t> mUiImageInfosMap;
 
 #if defined(ENABLE_DEBUG_PRINTF_EXT)
 	Texture mLogTexture;
@@ -92,19 +90,27 @@ public:
 
 inline TextureManager* gpTextureManager = nullptr;
 
-inline float CrcToIndex(common::crc_t crc)
+// Slots come from the sorted tables in Data.h, prefer the generated data::k*Index constants when the texture is known at compile time
+constexpr float CrcToIndex(common::crc_t crc)
 {
 	// Make sure non-Ui textures are not in the Data/Textures/Ui/ directory
-	return static_cast<float>(gpTextureManager->mImageInfosMap.at(crc));
+	int64_t iIndex = common::FindCrcIndex(data::kpTextureIndices, crc);
+	if (iIndex >= 0)
+	{
+		return static_cast<float>(iIndex);
+	}
+
+	DEBUG_BREAK();
+	return 0.0f;
 }
 
-inline uint32_t UiCrcToIndex(common::crc_t crc)
+constexpr uint32_t UiCrcToIndex(common::crc_t crc)
 {
 	// Make sure you add Ui textures to the Data/Textures/Ui/ directory
-	auto result = gpTextureManager->mUiImageInfosMap.find(crc);
-	if (result != gpTextureManager->mUiImageInfosMap.end())
+	int64_t iIndex = common::FindCrcIndex(data::kpUiTextureIndices, crc);
+	if (iIndex >= 0)
 	{
-		return static_cast<uint32_t>(result->second);
+		return static_cast<uint32_t>(iIndex);
 	}
 
 	DEBUG_BREAK();
@@ -8,7 +8,7 @@ namespace engine
 
 using enum BufferFlags;
 
-void Buffer::CreateBuffer([[maybe_unused]] std::string_view pcName, VkDeviceSize vkDeviceSize, VkBufferUsageFlags vkBufferUsageFlags, VkMemoryPropertyFlags vkMemoryPropertyFlags, VkBuffer& rVkBuffer, VkDeviceMemory& rVkDeviceMemory)
+static VkMemoryRequirements CreateVkBuffer([[maybe_unused]] std::string_view pcName, VkDeviceSize vkDeviceSize, VkBufferUsageFlags vkBufferUsageFlags, VkBuffer& rVkBuffer)
 {
 	VkDeviceSize roundedVkDeviceSize = common::RoundUp(vkDeviceSize, gpInstanceManager->mVkPhysicalDeviceProperties.limits.nonCoherentAtomSize);
 
@@ -28,6 +28,13 @@ void Buffer::CreateBuffer([[maybe_unused]] std::string_view pcName, VkDeviceSize
 
 	VkMemoryRequirements vkMemoryRequirements {};
 	vkGetBufferMemoryRequirements(gpDeviceManager->mVkDevice, rVkBuffer, &vkMemoryRequirements);
+
+	return vkMemoryRequirements;
+}
+
+void Buffer::CreateBuffer(std::string_view pcName, VkDeviceSize vkDeviceSize, VkBufferUsageFlags vkBufferUsageFlags, VkMemoryPropertyFlags vkMemoryPropertyFlags, VkBuffer& rVkBuffer, VkDeviceMemory& rVkDeviceMemory)
+{
+	VkMemoryRequirements vkMemoryRequirements = CreateVkBuffer(pcName, vkDeviceSize, vkBufferUsageFlags, rVkBuffer);
 	VkMemoryAllocateInfo vkMemoryAllocateInfo
 	{
 		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
@@ -42,6 +49,14 @@ void Buffer::CreateBuffer([[maybe_unused]] std::string_view pcName, VkDeviceSize
 	CHECK_VK(vkBindBufferMemory(gpDeviceManager->mVkDevice, rVkBuffer, rVkDeviceMemory, 0));
 }
 
+void Buffer::CreateBuffer(std::string_view pcName, VkDeviceSize vkDeviceSize, VkBufferUsageFlags vkBufferUsageFlags, VkMemoryPropertyFlags vkMemoryPropertyFlags, VkBuffer& rVkBuffer, MemoryAllocation& rMemoryAllocation)
+{
+	VkMemoryRequirements vkMemoryRequirements = CreateVkBuffer(pcName, vkDeviceSize, vkBufferUsageFlags, rVkBuffer);
+	rMemoryAllocation = gpMemoryManager->Allocate(vkMemoryRequirements, vkMemoryPropertyFlags, false);
+
+	CHECK_VK(vkBindBufferMemory(gpDeviceManager->mVkDevice, rVkBuffer, rMemoryAllocation.vkDeviceMemory, rMemoryAllocation.vkOffset));
+}
+
 void Buffer::RecordBarrier(VkCommandBuffer vkCommandBuffer, BufferBarrier eSource, BufferBarrier eDestination, VkBuffer vkBuffer)
 {
 	VkAccessFlags srcAccessMask = VK_ACCESS_NONE_KHR;
@@ -123,28 +138,26 @@ void Buffer::Create(const BufferInfo& rInfo, std::function<void(void*)> dataFunc
 		{
 			if (mInfo.flags & kHostVisible)
 			{
-				Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, vkBufferUsageFlagBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mHostVisibleVkBuffer, mHostVisibleVkDeviceMemory);
+				Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, vkBufferUsageFlagBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mHostVisibleVkBuffer, mHostVisibleMemoryAllocation);
 			}
 			else
 			{
-				Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, vkBufferUsageFlagBits | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mHostVisibleVkBuffer, mHostVisibleVkDeviceMemory);
+				Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, vkBufferUsageFlagBits | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mHostVisibleVkBuffer, mHostVisibleMemoryAllocation);
 			}
 
-			char* pMappedMemory = nullptr;
-			VkDeviceSize roundedVkDeviceSize = common::RoundUp(mInfo.dataVkDeviceSize, gpInstanceManager->mVkPhysicalDeviceProperties.limits.nonCoherentAtomSize);
-			CHECK_VK(vkMapMemory(gpDeviceManager->mVkDevice, mHostVisibleVkDeviceMemory, 0, roundedVkDeviceSize, 0, reinterpret_cast<void**>(&pMappedMemory)));
-			mpMappedMemory = pMappedMemory;
+			// Host visible blocks are persistently mapped by the MemoryManager
+			mpMappedMemory = mHostVisibleMemoryAllocation.pMappedMemory;
 		}
 
 		if (mInfo.flags & kDeviceLocal || mInfo.flags & kCopyToDeviceLocalEveryFrame)
 		{
-			Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, vkBufferUsageFlagBits | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mDeviceLocalVkBuffer, mDeviceLocalVkDeviceMemory);
+			Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, vkBufferUsageFlagBits | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mDeviceLocalVkBuffer, mDeviceLocalMemoryAllocation);
 		}
 	}
 	else
 	{
 		ASSERT(mInfo.flags & kIndexVertex);
-		Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mDeviceLocalVkBuffer, mDeviceLocalVkDeviceMemory);
+		Buffer::CreateBuffer(mInfo.pcName, mInfo.dataVkDeviceSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mDeviceLocalVkBuffer, mDeviceLocalMemoryAllocation);
 	}
 
 	if (mInfo.flags & kDeviceLocal)
@@ -178,26 +191,24 @@ void Buffer::Create(const BufferInfo& rInfo, std::function<void(void*)> dataFunc
 
 void Buffer::Destroy() noexcept
 {
-	if (mHostVisibleVkDeviceMemory != VK_NULL_HANDLE || mDeviceLocalVkDeviceMemory != VK_NULL_HANDLE)
+	if (mHostVisibleMemoryAllocation.vkDeviceMemory != VK_NULL_HANDLE || mDeviceLocalMemoryAllocation.vkDeviceMemory != VK_NULL_HANDLE)
 	{
 		vkDeviceWaitIdle(gpDeviceManager->mVkDevice);
 	}
 	
-	if (mHostVisibleVkDeviceMemory != VK_NULL_HANDLE)
+	if (mHostVisibleMemoryAllocation.vkDeviceMemory != VK_NULL_HANDLE)
 	{
 		vkDestroyBuffer(gpDeviceManager->mVkDevice, mHostVisibleVkBuffer, nullptr);
 		mHostVisibleVkBuffer = VK_NULL_HANDLE;
 		mpMappedMemory = nullptr;
-		vkFreeMemory(gpDeviceManager->mVkDevice, mHostVisibleVkDeviceMemory, nullptr);
-		mHostVisibleVkDeviceMemory = VK_NULL_HANDLE;
+		gpMemoryManager->Free(mHostVisibleMemoryAllocation);
 	}
 
-	if (mDeviceLocalVkDeviceMemory != VK_NULL_HANDLE)
+	if (mDeviceLocalMemoryAllocation.vkDeviceMemory != VK_NULL_HANDLE)
 	{
 		vkDestroyBuffer(gpDeviceManager->mVkDevice, mDeviceLocalVkBuffer, nullptr);
 		mDeviceLocalVkBuffer = VK_NULL_HANDLE;
-		vkFreeMemory(gpDeviceManager->mVkDevice, mDeviceLocalVkDeviceMemory, nullptr);
-		mDeviceLocalVkDeviceMemory = VK_NULL_HANDLE;
+		gpMemoryManager->Free(mDeviceLocalMemoryAllocation);
 	}
 }
 
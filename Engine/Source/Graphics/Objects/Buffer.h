@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Graphics/Managers/MemoryManager.h"
+
 namespace engine
 {
 
@@ -40,6 +42,7 @@ class Buffer
 public:
 
 	static void CreateBuffer(std::string_view pcName, VkDeviceSize vkDeviceSize, VkBufferUsageFlags vkBufferUsageFlags, VkMemoryPropertyFlags vkMemoryPropertyFlags, VkBuffer& rVkBuffer, VkDeviceMemory& rVkDeviceMemory);
+	static void CreateBuffer(std::string_view pcName, VkDeviceSize vkDeviceSize, VkBufferUsageFlags vkBufferUsageFlags, VkMemoryPropertyFlags vkMemoryPropertyFlags, VkBuffer& rVkBuffer, MemoryAllocation& rMemoryAllocation);
 	static void RecordBarrier(VkCommandBuffer vkCommandBuffer, BufferBarrier eSource, BufferBarrier eDestination, VkBuffer vkBuffer);
 
 	Buffer() = default;
@@ -59,11 +62,11 @@ public:
 	BufferInfo mInfo {};
 
 	VkBuffer mHostVisibleVkBuffer = VK_NULL_HANDLE;
-	VkDeviceMemory mHostVisibleVkDeviceMemory = VK_NULL_HANDLE;
+	MemoryAllocation mHostVisibleMemoryAllocation {};
 	char* mpMappedMemory = nullptr;
 
 	VkBuffer mDeviceLocalVkBuffer = VK_NULL_HANDLE;
-	VkDeviceMemory mDeviceLocalVkDeviceMemory = VK_NULL_HANDLE;
+	MemoryAllocation mDeviceLocalMemoryAllocation {};
 };
 
 } // namespace engine
@@ -198,6 +198,88 @@ static VkGraphicsPipelineCreateInfo sVkGraphicsPipelineCreateInfo
 	.basePipelineIndex = -1,
 }; 
 
+// Copy of the graphics create info chain, so the statics above can be filled in for the next pipeline while this one is still compiling
+struct GraphicsPipelineState
+{
+	GraphicsPipelineState()
+	: vkVertexInputBindingDescription(sVkVertexInputBindingDescription)
+	, vkPipelineVertexInputStateCreateInfo(sVkPipelineVertexInputStateCreateInfo)
+	, vkPipelineInputAssemblyStateCreateInfo(sVkPipelineInputAssemblyStateCreateInfo)
+	, vkViewport(sVkViewport)
+	, scissorVkRect2D(sScissorVkRect2D)
+	, vkPipelineViewportStateCreateInfo(sVkPipelineViewportStateCreateInfo)
+	, vkPipelineRasterizationStateCreateInfo(sVkPipelineRasterizationStateCreateInfo)
+	, vkPipelineMultisampleStateCreateInfo(sVkPipelineMultisampleStateCreateInfo)
+	, vkPipelineDepthStencilStateCreateInfo(sVkPipelineDepthStencilStateCreateInfo)
+	, vkPipelineColorBlendAttachmentState(sVkPipelineColorBlendAttachmentState)
+	, vkPipelineColorBlendStateCreateInfo(sVkPipelineColorBlendStateCreateInfo)
+	, vkGraphicsPipelineCreateInfo(sVkGraphicsPipelineCreateInfo)
+	{
+		std::copy(std::begin(spVkPipelineShaderStageCreateInfos), std::end(spVkPipelineShaderStageCreateInfos), std::begin(pVkPipelineShaderStageCreateInfos));
+
+		vkPipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = &vkVertexInputBindingDescription;
+		vkPipelineViewportStateCreateInfo.pViewports = &vkViewport;
+		vkPipelineViewportStateCreateInfo.pScissors = &scissorVkRect2D;
+		vkPipelineColorBlendStateCreateInfo.pAttachments = &vkPipelineColorBlendAttachmentState;
+
+		vkGraphicsPipelineCreateInfo.pStages = pVkPipelineShaderStageCreateInfos;
+		vkGraphicsPipelineCreateInfo.pVertexInputState = &vkPipelineVertexInputStateCreateInfo;
+		vkGraphicsPipelineCreateInfo.pInputAssemblyState = &vkPipelineInputAssemblyStateCreateInfo;
+		vkGraphicsPipelineCreateInfo.pViewportState = &vkPipelineViewportStateCreateInfo;
+		vkGraphicsPipelineCreateInfo.pRasterizationState = &vkPipelineRasterizationStateCreateInfo;
+		vkGraphicsPipelineCreateInfo.pMultisampleState = &vkPipelineMultisampleStateCreateInfo;
+		vkGraphicsPipelineCreateInfo.pDepthStencilState = &vkPipelineDepthStencilStateCreateInfo;
+		vkGraphicsPipelineCreateInfo.pColorBlendState = &vkPipelineColorBlendStateCreateInfo;
+	}
+	GraphicsPipelineState(const GraphicsPipelineState&) = delete;
+
+	VkPipelineShaderStageCreateInfo pVkPipelineShaderStageCreateInfos[std::size(spVkPipelineShaderStageCreateInfos)] {};
+	VkVertexInputBindingDescription vkVertexInputBindingDescription;
+	VkPipelineVertexInputStateCreateInfo vkPipelineVertexInputStateCreateInfo;
+	VkPipelineInputAssemblyStateCreateInfo vkPipelineInputAssemblyStateCreateInfo;
+	VkViewport vkViewport;
+	VkRect2D scissorVkRect2D;
+	VkPipelineViewportStateCreateInfo vkPipelineViewportStateCreateInfo;
+	VkPipelineRasterizationStateCreateInfo vkPipelineRasterizationStateCreateInfo;
+	VkPipelineMultisampleStateCreateInfo vkPipelineMultisampleStateCreateInfo;
+	VkPipelineDepthStencilStateCreateInfo vkPipelineDepthStencilStateCreateInfo;
+	VkPipelineColorBlendAttachmentState vkPipelineColorBlendAttachmentState;
+	VkPipelineColorBlendStateCreateInfo vkPipelineColorBlendStateCreateInfo;
+	VkGraphicsPipelineCreateInfo vkGraphicsPipelineCreateInfo;
+};
+
+static bool sbBatch = false;
+static std::vector<std::future<void>> sBatchFutures;
+
+// Layouts, descriptor sets and indirect buffers are still created in order, only the driver compile is handed to a worker
+template<typename CREATE>
+static void CreateOrDefer(CREATE&& create)
+{
+	if (sbBatch)
+	{
+		sBatchFutures.push_back(std::async(std::launch::async, std::forward<CREATE>(create)));
+	}
+	else
+	{
+		create();
+	}
+}
+
+void Pipeline::BeginBatch()
+{
+	ASSERT(!sbBatch);
+	sbBatch = true;
+}
+
+void Pipeline::EndBatch()
+{
+	ASSERT(sbBatch);
+	sbBatch = false;
+
+	common::WaitAll(sBatchFutures);
+	sBatchFutures.clear();
+}
+
 Pipeline::Pipeline(const PipelineInfo& rInfo)
 {
 	Create(rInfo);
@@ -301,14 +383,8 @@ void Pipeline::Destroy() noexcept
 		vkDestroyBuffer(gpDeviceManager->mVkDevice, mIndirectVkBuffer, nullptr);
 		mIndirectVkBuffer = VK_NULL_HANDLE;
 
-		if (mInfo.flags & kIndirectHostVisible)
-		{
-			mpIndirectMappedMemory = nullptr;
-			vkUnmapMemory(gpDeviceManager->mVkDevice, mIndirectVkDeviceMemory);
-		}
-
-		vkFreeMemory(gpDeviceManager->mVkDevice, mIndirectVkDeviceMemory, nullptr);
-		mIndirectVkDeviceMemory = VK_NULL_HANDLE;
+		mpIndirectMappedMemory = nullptr;
+		gpMemoryManager->Free(mIndirectMemoryAllocation);
 	}
 }
 
@@ -406,14 +482,12 @@ void Pipeline::CreatePipeline(const PipelineInfo& rPipelineInfo)
 	{
 		int64_t iCommandBufferCount = gpCommandBufferManager->CommandBufferCount();
 		VkDeviceSize vkDeviceSize = iCommandBufferCount * sizeof(VkDrawIndexedIndirectCommand);
-		Buffer::CreateBuffer(rPipelineInfo.pcName, vkDeviceSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mIndirectVkBuffer, mIndirectVkDeviceMemory);
-		char* pMappedMemory = nullptr;
-		CHECK_VK(vkMapMemory(gpDeviceManager->mVkDevice, mIndirectVkDeviceMemory, 0, vkDeviceSize, 0, reinterpret_cast<void**>(&pMappedMemory)));
-		mpIndirectMappedMemory = reinterpret_cast<VkDrawIndexedIndirectCommand*>(pMappedMemory);
+		Buffer::CreateBuffer(rPipelineInfo.pcName, vkDeviceSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mIndirectVkBuffer, mIndirectMemoryAllocation);
+		mpIndirectMappedMemory = reinterpret_cast<VkDrawIndexedIndirectCommand*>(mIndirectMemoryAllocation.pMappedMemory);
 	}
 	else if (mInfo.flags & kIndirectDeviceLocal)
 	{
-		Buffer::CreateBuffer(rPipelineInfo.pcName, sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mIndirectVkBuffer, mIndirectVkDeviceMemory);
+		Buffer::CreateBuffer(rPipelineInfo.pcName, sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mIndirectVkBuffer, mIndirectMemoryAllocation);
 	}
 
 	Shader* pVertexShader = rPipelineInfo.ppShaders[0];
@@ -519,8 +593,11 @@ void Pipeline::CreatePipeline(const PipelineInfo& rPipelineInfo)
 	sVkGraphicsPipelineCreateInfo.layout = mVkPipelineLayout;
 	sVkGraphicsPipelineCreateInfo.renderPass = mInfo.flags & kRenderTarget ? rPipelineInfo.vkRenderPass : gpSwapchainManager->mVkRenderPass;
 
-	CHECK_VK(vkCreateGraphicsPipelines(gpDeviceManager->mVkDevice, VK_NULL_HANDLE, 1, &sVkGraphicsPipelineCreateInfo, nullptr, &mVkPipeline));
-	VK_NAME(VK_OBJECT_TYPE_PIPELINE, mVkPipeline, mInfo.pcName.data());
+	CreateOrDefer([this, pState = std::make_unique<GraphicsPipelineState>()]()
+	{
+		CHECK_VK(vkCreateGraphicsPipelines(gpDeviceManager->mVkDevice, gpDeviceManager->mVkPipelineCache, 1, &pState->vkGraphicsPipelineCreateInfo, nullptr, &mVkPipeline));
+		VK_NAME(VK_OBJECT_TYPE_PIPELINE, mVkPipeline, mInfo.pcName.data());
+	});
 }
 
 void Pipeline::CreateComputePipeline(const PipelineInfo& rPipelineInfo)
@@ -531,7 +608,7 @@ void Pipeline::CreateComputePipeline(const PipelineInfo& rPipelineInfo)
 	}
 	else if (mInfo.flags & kIndirectDeviceLocal)
 	{
-		Buffer::CreateBuffer(rPipelineInfo.pcName, sizeof(VkDispatchIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mIndirectVkBuffer, mIndirectVkDeviceMemory);
+		Buffer::CreateBuffer(rPipelineInfo.pcName, sizeof(VkDispatchIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mIndirectVkBuffer, mIndirectMemoryAllocation);
 	}
 
 	Shader* pComputeShader = rPipelineInfo.ppShaders[0];
@@ -555,8 +632,11 @@ void Pipeline::CreateComputePipeline(const PipelineInfo& rPipelineInfo)
 	vkComputePipelineCreateInfo.stage.module = pComputeShader->mVkShaderModule;
 	vkComputePipelineCreateInfo.stage.pName = "main";
 	vkComputePipelineCreateInfo.layout = mVkPipelineLayout;
-	CHECK_VK(vkCreateComputePipelines(gpDeviceManager->mVkDevice, VK_NULL_HANDLE, 1, &vkComputePipelineCreateInfo, nullptr, &mVkPipeline));
-	VK_NAME(VK_OBJECT_TYPE_PIPELINE, mVkPipeline, mInfo.pcName.data());
+	CreateOrDefer([this, vkComputePipelineCreateInfo]()
+	{
+		CHECK_VK(vkCreateComputePipelines(gpDeviceManager->mVkDevice, gpDeviceManager->mVkPipelineCache, 1, &vkComputePipelineCreateInfo, nullptr, &mVkPipeline));
+		VK_NAME(VK_OBJECT_TYPE_PIPELINE, mVkPipeline, mInfo.pcName.data());
+	});
 }
 
 void Pipeline::WriteDescriptorSets(const PipelineInfo& rPipelineInfo)
@@ -93,6 +93,10 @@ public:
 	void Create(const PipelineInfo& rInfo, bool bFromMultimaterial = false);
 	void Destroy() noexcept;
 
+	// Pipelines created while a batch is open compile on worker threads, mVkPipeline is only valid after EndBatch()
+	static void BeginBatch();
+	static void EndBatch();
+
 	void RecordDraw(int64_t iCommandBuffer, VkCommandBuffer vkCommandBuffer, int64_t iInstanceCount, int64_t iFirstInstance, const DirectX::XMFLOAT4& f4PushConstants = {});
 	void RecordDrawIndirect(int64_t iCommandBuffer, VkCommandBuffer vkCommandBuffer, const DirectX::XMFLOAT4& f4PushConstants = {});
 	void RecordCompute(int64_t iCommandBuffer, VkCommandBuffer vkCommandBuffer, int64_t iGroupCountX, int64_t iGroupCountY = 1, int64_t iGroupCountZ = 1, const DirectX::XMFLOAT4& f4PushConstants = {});
@@ -110,7 +114,7 @@ public:
 	VkPipeline mVkPipeline = VK_NULL_HANDLE;
 
 	VkBuffer mIndirectVkBuffer = VK_NULL_HANDLE;
-	VkDeviceMemory mIndirectVkDeviceMemory = VK_NULL_HANDLE;
+	MemoryAllocation mIndirectMemoryAllocation {};
 	VkDrawIndexedIndirectCommand* mpIndirectMappedMemory = nullptr;
 
 	Buffer mGltfMaterialsStorageBuffer;
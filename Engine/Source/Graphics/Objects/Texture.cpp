@@ -2,6 +2,7 @@
 
 #include "Graphics/Graphics.h"
 #include "Graphics/OneShotCommandBuffer.h"
+#include "Graphics/TextureUploader.h"
 
 namespace engine
 {
@@ -42,9 +43,9 @@ void Texture::RecordEndRenderPass(VkCommandBuffer vkCommandBuffer, [[maybe_unuse
 	vkCmdEndRenderPass(vkCommandBuffer);
 }
 
-Texture::Texture(const TextureInfo& rInfo, std::function<void(void*,int64_t,int64_t)> dataFunction)
+Texture::Texture(const TextureInfo& rInfo, std::function<void(void*,int64_t,int64_t)> dataFunction, TextureUploader* pTextureUploader)
 {
-	Create(rInfo, dataFunction);
+	Create(rInfo, dataFunction, pTextureUploader);
 }
 
 Texture::~Texture()
@@ -60,7 +61,7 @@ void Texture::ReCreate()
 	Create(mInfo, nullptr);
 }
 
-void Texture::Create(const TextureInfo& rInfo, std::function<void(void*, int64_t, int64_t)> dataFunction)
+void Texture::Create(const TextureInfo& rInfo, std::function<void(void*, int64_t, int64_t)> dataFunction, TextureUploader* pTextureUploader)
 {
 	Destroy();
 
@@ -97,17 +98,10 @@ void Texture::Create(const TextureInfo& rInfo, std::function<void(void*, int64_t
 		.image = mVkImage,
 		.buffer = VK_NULL_HANDLE,
 	};
-	VkMemoryAllocateInfo vkMemoryAllocateInfo
-	{
-		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-		.pNext = mInfo.textureFlags & kRenderPass ? &vkMemoryDedicatedAllocateInfoKHR : nullptr,
-		.allocationSize = vkMemoryRequirements.size,
-		.memoryTypeIndex = 0,
-	};
-	int64_t iMemoryTypeIndex = FindMemoryType(vkMemoryRequirements.memoryTypeBits, mInfo.textureFlags & kHostVisible ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	vkMemoryAllocateInfo.memoryTypeIndex = static_cast<uint32_t>(iMemoryTypeIndex);
-	CHECK_VK(vkAllocateMemory(gpDeviceManager->mVkDevice, &vkMemoryAllocateInfo, nullptr, &mVkDeviceMemory));
-	CHECK_VK(vkBindImageMemory(gpDeviceManager->mVkDevice, mVkImage, mVkDeviceMemory, 0));
+	// Render targets keep their dedicated allocation, everything else is sub-allocated with linear images kept apart from optimal ones
+	VkMemoryPropertyFlags vkMemoryPropertyFlags = mInfo.textureFlags & kHostVisible ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	mMemoryAllocation = gpMemoryManager->Allocate(vkMemoryRequirements, vkMemoryPropertyFlags, !(mInfo.textureFlags & kHostVisible), mInfo.textureFlags & kRenderPass ? &vkMemoryDedicatedAllocateInfoKHR : nullptr);
+	CHECK_VK(vkBindImageMemory(gpDeviceManager->mVkDevice, mVkImage, mMemoryAllocation.vkDeviceMemory, mMemoryAllocation.vkOffset));
 
 	VkComponentMapping vkComponentMapping = {.r = VK_COMPONENT_SWIZZLE_R, .g = VK_COMPONENT_SWIZZLE_G, .b = VK_COMPONENT_SWIZZLE_B, .a = VK_COMPONENT_SWIZZLE_A};
 	if (!(mInfo.textureFlags & kRenderPass) && mInfo.format == VK_FORMAT_BC4_UNORM_BLOCK)
@@ -128,6 +122,13 @@ void Texture::Create(const TextureInfo& rInfo, std::function<void(void*, int64_t
 	CHECK_VK(vkCreateImageView(gpDeviceManager->mVkDevice, &vkImageViewCreateInfo, nullptr, &mVkImageView));
 	VK_NAME(VK_OBJECT_TYPE_IMAGE_VIEW, mVkImageView, mInfo.pcName.data());
 
+	if (dataFunction != nullptr && pTextureUploader != nullptr)
+	{
+		ASSERT(!(mInfo.textureFlags & kRenderPass));
+		pTextureUploader->Upload(*this, dataFunction);
+		return;
+	}
+
 	if (dataFunction != nullptr)
 	{
 		OneShotCommandBuffer oneShotCommandBufferTransition;
@@ -322,8 +323,7 @@ void Texture::Destroy() noexcept
 
 	vkDestroyImage(gpDeviceManager->mVkDevice, mVkImage, nullptr);
 	mVkImage = VK_NULL_HANDLE;
-	vkFreeMemory(gpDeviceManager->mVkDevice, mVkDeviceMemory, nullptr);
-	mVkDeviceMemory = VK_NULL_HANDLE;
+	gpMemoryManager->Free(mMemoryAllocation);
 	vkDestroyImageView(gpDeviceManager->mVkDevice, mVkImageView, nullptr);
 	mVkImageView = VK_NULL_HANDLE;
 
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "Graphics/Managers/MemoryManager.h"
+
 namespace engine
 {
 
+class TextureUploader;
+
 inline constexpr float kfMinDepth = 0.0f;
 inline constexpr float kfMaxDepth = 1.0f;
 
@@ -67,10 +71,11 @@ public:
 	Texture() = default;
 	Texture(const Texture&) = default;
 	Texture(Texture&&) noexcept = default;
-	Texture(const TextureInfo& rInfo, std::function<void(void*,int64_t,int64_t)> dataFunction = nullptr);
+	Texture(const TextureInfo& rInfo, std::function<void(void*,int64_t,int64_t)> dataFunction = nullptr, TextureUploader* pTextureUploader = nullptr);
 	~Texture();
 
-	void Create(const TextureInfo& rInfo, std::function<void(void*, int64_t, int64_t)> dataFunction = nullptr);
+	// With a TextureUploader the data upload and the final layout transition are deferred until TextureUploader::Submit()
+	void Create(const TextureInfo& rInfo, std::function<void(void*, int64_t, int64_t)> dataFunction = nullptr, TextureUploader* pTextureUploader = nullptr);
 	void ReCreate();
 	void Destroy() noexcept;
 
@@ -81,7 +86,7 @@ public:
 	TextureInfo mInfo {};
 
 	// Image
-	VkDeviceMemory mVkDeviceMemory = VK_NULL_HANDLE;
+	MemoryAllocation mMemoryAllocation {};
 	VkImage mVkImage = VK_NULL_HANDLE;
 	VkImageView mVkImageView = VK_NULL_HANDLE;
 
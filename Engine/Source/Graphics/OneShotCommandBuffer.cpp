@@ -82,4 +82,28 @@ void OneShotCommandBuffer::Execute(bool bWait)
 	}
 }
 
+void OneShotCommandBuffer::ExecuteDeferred()
+{
+	CHECK_VK(vkEndCommandBuffer(mVkCommandBuffer));
+	CHECK_VK(vkResetFences(gpDeviceManager->mVkDevice, 1, &mVkFence));
+
+	VkSubmitInfo vkSubmitInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.pNext = nullptr,
+		.waitSemaphoreCount = 0,
+		.pWaitSemaphores = nullptr,
+		.pWaitDstStageMask = nullptr,
+		.commandBufferCount = 1,
+		.pCommandBuffers = &mVkCommandBuffer,
+		.signalSemaphoreCount = 0,
+	};
+	CHECK_VK(vkQueueSubmit(gpDeviceManager->mGraphicsVkQueue, 1, &vkSubmitInfo, mVkFence));
+}
+
+void OneShotCommandBuffer::Wait()
+{
+	CHECK_VK(vkWaitForFences(gpDeviceManager->mVkDevice, 1, &mVkFence, VK_TRUE, kFenceTimeoutNs.count()));
+}
+
 } // namespace engine
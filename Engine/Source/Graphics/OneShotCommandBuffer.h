@@ -11,6 +11,9 @@ public:
 	~OneShotCommandBuffer();
 
 	void Execute(bool bWait);
+	// Submits with the fence and returns, Wait() has to be called before the destructor
+	void ExecuteDeferred();
+	void Wait();
 
 	VkCommandBuffer mVkCommandBuffer = VK_NULL_HANDLE;
 
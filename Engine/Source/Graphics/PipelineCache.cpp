@@ -0,0 +1,64 @@
+#include "PipelineCache.h"
+
+namespace engine
+{
+
+static common::crc_t DataCrc(std::span<const uint8_t> data) noexcept
+{
+	return common::Crc(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+}
+
+PipelineCacheHeader MakePipelineCacheHeader(const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties) noexcept
+{
+	PipelineCacheHeader header
+	{
+		.uiVendorId = rVkPhysicalDeviceProperties.vendorID,
+		.uiDeviceId = rVkPhysicalDeviceProperties.deviceID,
+		.uiDriverVersion = rVkPhysicalDeviceProperties.driverVersion,
+	};
+	std::copy(std::begin(rVkPhysicalDeviceProperties.pipelineCacheUUID), std::end(rVkPhysicalDeviceProperties.pipelineCacheUUID), std::begin(header.puiPipelineCacheUuid));
+
+	return header;
+}
+
+bool ValidPipelineCacheHeader(const PipelineCacheHeader& rHeader, const PipelineCacheHeader& rExpectedHeader) noexcept
+{
+	return rHeader.iMagic == rExpectedHeader.iMagic
+		&& rHeader.iVersion == rExpectedHeader.iVersion
+		&& rHeader.uiVendorId == rExpectedHeader.uiVendorId
+		&& rHeader.uiDeviceId == rExpectedHeader.uiDeviceId
+		&& rHeader.uiDriverVersion == rExpectedHeader.uiDriverVersion
+		&& std::equal(std::begin(rHeader.puiPipelineCacheUuid), std::end(rHeader.puiPipelineCacheUuid), std::begin(rExpectedHeader.puiPipelineCacheUuid))
+		&& rHeader.iDataSize > 0 && rHeader.iDataSize <= PipelineCacheHeader::kiMaxDataSize;
+}
+
+bool WritePipelineCache(std::ostream& rStream, const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties, std::span<const uint8_t> data)
+{
+	PipelineCacheHeader header = MakePipelineCacheHeader(rVkPhysicalDeviceProperties);
+	header.iDataSize = static_cast<int64_t>(data.size());
+	header.crc = DataCrc(data);
+
+	rStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	rStream.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return rStream.good();
+}
+
+std::vector<uint8_t> ReadPipelineCache(std::istream& rStream, const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties)
+{
+	PipelineCacheHeader header {};
+	rStream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (rStream.gcount() != sizeof(header) || !ValidPipelineCacheHeader(header, MakePipelineCacheHeader(rVkPhysicalDeviceProperties)))
+	{
+		return {};
+	}
+
+	std::vector<uint8_t> data(header.iDataSize);
+	rStream.read(reinterpret_cast<char*>(data.data()), header.iDataSize);
+	if (rStream.gcount() != header.iDataSize || DataCrc(data) != header.crc)
+	{
+		return {};
+	}
+	return data;
+}
+
+} // namespace engine
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace engine
+{
+
+// Written in front of the driver's data, a cache from another device, driver or a partial write is thrown away before the driver sees it
+struct PipelineCacheHeader
+{
+	static constexpr int64_t kiMagic = 0x6568636143707042; // BppCache
+	static constexpr int64_t kiVersion = 1;
+	static constexpr int64_t kiMaxDataSize = 256ll * 1024 * 1024;
+
+	int64_t iMagic = kiMagic;
+	int64_t iVersion = kiVersion;
+	uint32_t uiVendorId = 0;
+	uint32_t uiDeviceId = 0;
+	uint32_t uiDriverVersion = 0;
+	uint8_t puiPipelineCacheUuid[VK_UUID_SIZE] {};
+	int64_t iDataSize = 0;
+	common::crc_t crc = 0;
+};
+
+// The header of a cache saved on this device and driver, without the size and crc of the data
+PipelineCacheHeader MakePipelineCacheHeader(const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties) noexcept;
+
+// Same magic, version, device and driver as expected and a size that can be read, the data still has to match the crc
+bool ValidPipelineCacheHeader(const PipelineCacheHeader& rHeader, const PipelineCacheHeader& rExpectedHeader) noexcept;
+
+// Header and data, false if the stream failed
+bool WritePipelineCache(std::ostream& rStream, const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties, std::span<const uint8_t> data);
+
+// The driver's data if the stream holds a whole cache from this device and driver, empty otherwise
+std::vector<uint8_t> ReadPipelineCache(std::istream& rStream, const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties);
+
+} // namespace engine
@@ -83,8 +83,7 @@ void SaveScreenshot()
 
 	oneShotCommandBuffer.Execute(true);
 
-	const uint32_t* puiArgb = nullptr;
-	CHECK_VK(vkMapMemory(gpDeviceManager->mVkDevice, texture.mVkDeviceMemory, 0, VK_WHOLE_SIZE, 0, (void**)&puiArgb));
+	const uint32_t* puiArgb = reinterpret_cast<const uint32_t*>(texture.mMemoryAllocation.pMappedMemory);
 	std::vector<uint32_t> rgba(vkExtent3D.width * vkExtent3D.height);
 	uint32_t* puiAbgr = rgba.data();
 	for (int64_t y = 0; y < vkExtent3D.height; ++y)
@@ -110,8 +109,6 @@ void SaveScreenshot()
 		filename += ".jpg";
 		stbi_write_jpg(filename.c_str(), vkExtent3D.width, vkExtent3D.height, 4, puiAbgr, 80);
 	});
-
-	vkUnmapMemory(gpDeviceManager->mVkDevice, texture.mVkDeviceMemory);
 }
 
 } // namespace engine
@@ -0,0 +1,42 @@
+#include "StagingRing.h"
+
+namespace engine
+{
+
+StagingRing::StagingRing(int64_t iBlockSize, int64_t iBlockCount, int64_t iAlignment) noexcept
+: miBlockSize(iBlockSize)
+, miBlockCount(iBlockCount)
+, miAlignment(iAlignment)
+{
+}
+
+StagingRing::Allocation StagingRing::Allocate(int64_t iSize, int64_t iAlignment)
+{
+	ASSERT(iSize > 0 && iSize <= miBlockSize);
+	ASSERT(iAlignment > 0);
+
+	if (miCurrentBlock >= 0)
+	{
+		iAlignment = std::lcm(miAlignment, iAlignment);
+		int64_t iOffset = ((miCurrentUsed + iAlignment - 1) / iAlignment) * iAlignment;
+		if (iOffset + iSize <= miBlockSize)
+		{
+			miCurrentUsed = iOffset + iSize;
+			return {.iBlock = miCurrentBlock, .iOffset = iOffset, .bNewBlock = false};
+		}
+	}
+
+	miCurrentBlock = miBlocksStarted % miBlockCount;
+	miCurrentUsed = iSize;
+	++miBlocksStarted;
+	return {.iBlock = miCurrentBlock, .iOffset = 0, .bNewBlock = true};
+}
+
+void StagingRing::Clear() noexcept
+{
+	miCurrentBlock = -1;
+	miCurrentUsed = 0;
+	miBlocksStarted = 0;
+}
+
+} // namespace engine
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace engine
+{
+
+// CPU only, packs allocations into a ring of miBlockCount blocks of miBlockSize, allocations must fit in a block
+// Moving on to the next block sets bNewBlock, the caller has to retire whatever last read that block before writing to it
+class StagingRing
+{
+public:
+
+	struct Allocation
+	{
+		int64_t iBlock = 0;
+		int64_t iOffset = 0;
+		bool bNewBlock = false;
+	};
+
+	StagingRing(int64_t iBlockSize, int64_t iBlockCount, int64_t iAlignment) noexcept;
+
+	// Aligned to both miAlignment and iAlignment
+	Allocation Allocate(int64_t iSize, int64_t iAlignment = 1);
+	void Clear() noexcept;
+
+	int64_t miBlockSize = 0;
+	int64_t miBlockCount = 0;
+	int64_t miAlignment = 0;
+	int64_t miCurrentBlock = -1;
+	int64_t miCurrentUsed = 0;
+	int64_t miBlocksStarted = 0;
+};
+
+} // namespace engine
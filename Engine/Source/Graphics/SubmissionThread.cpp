@@ -0,0 +1,93 @@
+#include "SubmissionThread.h"
+
+namespace engine
+{
+
+SubmissionThread::SubmissionThread(ProcessFunction processFunction)
+: mProcessFunction(std::move(processFunction))
+{
+	mFuture = std::async(std::launch::async, [this]()
+	{
+		Run();
+	});
+}
+
+SubmissionThread::~SubmissionThread()
+{
+	if (mbRunning.load(std::memory_order_acquire))
+	{
+		mQueue.Back().eSubmitType = SubmitType::kStop;
+		mQueue.Push();
+	}
+
+	if (mFuture.valid())
+	{
+		mFuture.wait();
+	}
+}
+
+SubmitDescriptor& SubmissionThread::Back()
+{
+	ThrowIfStopped();
+
+	return mQueue.Back();
+}
+
+void SubmissionThread::Push()
+{
+	++miPushed;
+	mQueue.Push();
+}
+
+void SubmissionThread::WaitIdle()
+{
+	int64_t iProcessed = miProcessed.load(std::memory_order_acquire);
+	while (iProcessed < miPushed)
+	{
+		miProcessed.wait(iProcessed, std::memory_order_acquire);
+		iProcessed = miProcessed.load(std::memory_order_acquire);
+	}
+
+	ThrowIfStopped();
+}
+
+void SubmissionThread::Run()
+{
+	common::ThreadLocal threadLocal(0, common::kThreadSubmission);
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+	common::ScopedLambda stopRunning([this]()
+	{
+		// Releases WaitIdle() so it can rethrow whatever the thread died with
+		mbRunning.store(false, std::memory_order_release);
+		miProcessed.store(std::numeric_limits<int64_t>::max(), std::memory_order_release);
+		miProcessed.notify_all();
+	});
+
+	while (true)
+	{
+		SubmitDescriptor& rSubmitDescriptor = mQueue.Front();
+		if (rSubmitDescriptor.eSubmitType == SubmitType::kStop)
+		{
+			mQueue.Pop();
+			return;
+		}
+
+		mProcessFunction(rSubmitDescriptor);
+		mQueue.Pop();
+
+		miProcessed.fetch_add(1, std::memory_order_release);
+		miProcessed.notify_all();
+	}
+}
+
+void SubmissionThread::ThrowIfStopped()
+{
+	// Rethrows whatever the submission thread died with
+	if (!mbRunning.load(std::memory_order_acquire) && mFuture.valid())
+	{
+		mFuture.get();
+	}
+}
+
+} // namespace engine
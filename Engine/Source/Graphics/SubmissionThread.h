@@ -0,0 +1,70 @@
+#pragma once
+
+namespace engine
+{
+
+class CommandBuffers;
+
+enum class SubmitType : uint8_t
+{
+	kGlobal,
+	kMain,
+	kImage,
+	kPresent,
+	kStop,
+};
+
+// Everything one queue submit or present needs, filled in by the render thread once recording is done so the submission thread never reads manager state
+struct SubmitDescriptor
+{
+	SubmitType eSubmitType = SubmitType::kStop;
+	std::chrono::high_resolution_clock::time_point recordedTimePoint;
+
+	uint32_t uiWaitSemaphoreCount = 0;
+	VkSemaphore pWaitVkSemaphores[2] {};
+	VkPipelineStageFlags pWaitVkPipelineStageFlags[2] {};
+	VkCommandBuffer vkCommandBuffer = VK_NULL_HANDLE;
+	VkSemaphore signalVkSemaphore = VK_NULL_HANDLE;
+	VkFence vkFence = VK_NULL_HANDLE;
+
+	VkSwapchainKHR vkSwapchainKHR = VK_NULL_HANDLE;
+	uint32_t uiImageIndex = 0;
+
+	CommandBuffers* pCommandBuffers = nullptr;
+	bool bSaveScreenshot = false;
+};
+
+// One long lived thread that drains a bounded queue of preallocated submit descriptors in order, present goes through the same queue so it always follows the image submit
+// The thread only calls the function it was constructed with, so the queue and thread logic can be driven with a fake submit
+class SubmissionThread
+{
+public:
+
+	using ProcessFunction = std::function<void(SubmitDescriptor&)>;
+
+	SubmissionThread(ProcessFunction processFunction);
+	~SubmissionThread();
+
+	// Render thread, fill in the descriptor returned by Back() and then call Push()
+	SubmitDescriptor& Back();
+	void Push();
+	void WaitIdle();
+
+private:
+
+	static constexpr int64_t kiQueueSize = 8;
+
+	void Run();
+	void ThrowIfStopped();
+
+	ProcessFunction mProcessFunction;
+	common::SpscQueue<SubmitDescriptor, kiQueueSize> mQueue;
+
+	int64_t miPushed = 0;
+	std::atomic<int64_t> miProcessed = 0;
+	std::atomic<bool> mbRunning = true;
+
+	std::future<void> mFuture;
+};
+
+} // namespace engine
@@ -0,0 +1,48 @@
+#include "TextureCopies.h"
+
+namespace engine
+{
+
+int64_t TextureUploadSize(VkFormat vkFormat, VkExtent3D vkExtent3D, uint32_t uiMipLevels, uint32_t uiArrayLayers)
+{
+	int64_t iSize = 0;
+	for (uint32_t level = 0; level < uiMipLevels; ++level)
+	{
+		int64_t iWidth = std::max(vkExtent3D.width >> level, 1u);
+		int64_t iHeight = std::max(vkExtent3D.height >> level, 1u);
+		iSize += uiArrayLayers * vkExtent3D.depth * common::SizeInBytes(vkFormat, iWidth, iHeight);
+	}
+
+	return iSize;
+}
+
+void BuildTextureCopies(std::vector<VkBufferImageCopy>& rCopies, VkFormat vkFormat, VkExtent3D vkExtent3D, uint32_t uiMipLevels, uint32_t uiArrayLayers, int64_t iBufferOffset)
+{
+	for (uint32_t i = 0; i < uiArrayLayers; ++i)
+	{
+		for (uint32_t level = 0; level < uiMipLevels; ++level)
+		{
+			// The extent of a mip smaller than a block is the mip itself, the copy still reads a whole block
+			uint32_t uiWidth = std::max(vkExtent3D.width >> level, 1u);
+			uint32_t uiHeight = std::max(vkExtent3D.height >> level, 1u);
+			rCopies.push_back(VkBufferImageCopy
+			{
+				.bufferOffset = static_cast<VkDeviceSize>(iBufferOffset),
+				.bufferRowLength = 0,
+				.bufferImageHeight = 0,
+				.imageSubresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .mipLevel = level, .baseArrayLayer = i, .layerCount = 1},
+				.imageOffset = {0, 0, 0},
+				.imageExtent = {uiWidth, uiHeight, 1},
+			});
+
+			iBufferOffset += common::SizeInBytes(vkFormat, uiWidth, uiHeight);
+		}
+	}
+}
+
+int64_t TextureCopyAlignment(VkFormat vkFormat, int64_t iOptimalBufferCopyOffsetAlignment)
+{
+	return std::lcm(common::TexelBlockSize(vkFormat), std::max<int64_t>(iOptimalBufferCopyOffsetAlignment, 1));
+}
+
+} // namespace engine
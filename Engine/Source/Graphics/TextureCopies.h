@@ -0,0 +1,14 @@
+#pragma once
+
+namespace engine
+{
+
+// CPU only, the data of a texture is packed layer by layer and mip by mip, the same as in Textures.bin
+// Every mip starts on a texel block boundary, so a texture whose data starts at a multiple of TextureCopyAlignment() has valid copy offsets throughout
+int64_t TextureUploadSize(VkFormat vkFormat, VkExtent3D vkExtent3D, uint32_t uiMipLevels, uint32_t uiArrayLayers);
+void BuildTextureCopies(std::vector<VkBufferImageCopy>& rCopies, VkFormat vkFormat, VkExtent3D vkExtent3D, uint32_t uiMipLevels, uint32_t uiArrayLayers, int64_t iBufferOffset);
+
+// bufferOffset has to be a multiple of the texel block size, optimalBufferCopyOffsetAlignment is only a hint but costs a few bytes at most
+int64_t TextureCopyAlignment(VkFormat vkFormat, int64_t iOptimalBufferCopyOffsetAlignment);
+
+} // namespace engine
@@ -0,0 +1,180 @@
+#include "TextureUploader.h"
+
+#include "Graphics/Graphics.h"
+#include "Graphics/OneShotCommandBuffer.h"
+
+namespace engine
+{
+
+using enum TextureLayout;
+
+// Four blocks keep one filling while the copies of the others run, every upload is aligned for its own format and device in Upload()
+constexpr int64_t kiStagingBlockSize = 64 * 1024 * 1024;
+constexpr int64_t kiStagingBlockCount = 4;
+
+TextureUploader::TextureUploader() noexcept
+: mStagingRing(kiStagingBlockSize, kiStagingBlockCount, 1)
+, mBlocks(kiStagingBlockCount)
+{
+}
+
+TextureUploader::~TextureUploader()
+{
+	ASSERT(mPendingTextures.empty());
+
+	for (Block& rBlock : mBlocks)
+	{
+		if (rBlock.pOneShotCommandBuffer != nullptr)
+		{
+			rBlock.pOneShotCommandBuffer->Wait();
+			rBlock.pOneShotCommandBuffer.reset();
+		}
+		DestroyBlock(rBlock);
+	}
+}
+
+void TextureUploader::Upload(Texture& rTexture, const std::function<void(void*, int64_t, int64_t)>& dataFunction)
+{
+	const TextureInfo& rInfo = rTexture.mInfo;
+	int64_t iSize = TextureUploadSize(rInfo.format, rInfo.extent, rInfo.mipLevels, rInfo.arrayLayers);
+	if (iSize > kiStagingBlockSize) [[unlikely]]
+	{
+		UploadDedicated(rTexture, dataFunction, iSize);
+		return;
+	}
+
+	int64_t iAlignment = TextureCopyAlignment(rInfo.format, static_cast<int64_t>(gpInstanceManager->mVkPhysicalDeviceProperties.limits.optimalBufferCopyOffsetAlignment));
+	StagingRing::Allocation allocation = mStagingRing.Allocate(iSize, iAlignment);
+	if (allocation.bNewBlock)
+	{
+		SubmitPending();
+		RetireBlock(allocation.iBlock);
+		miPendingBlock = allocation.iBlock;
+
+		if (mBlocks[allocation.iBlock].vkBuffer == VK_NULL_HANDLE)
+		{
+			CreateBlock(mBlocks[allocation.iBlock], kiStagingBlockSize);
+		}
+	}
+
+	dataFunction(mBlocks[allocation.iBlock].pMappedMemory + allocation.iOffset, 0, iSize);
+
+	int64_t iCopyStart = static_cast<int64_t>(mCopies.size());
+	BuildTextureCopies(mCopies, rInfo.format, rInfo.extent, rInfo.mipLevels, rInfo.arrayLayers, allocation.iOffset);
+	mPendingTextures.push_back(
+	{
+		.pTexture = &rTexture,
+		.iCopyStart = iCopyStart,
+		.iCopyCount = static_cast<int64_t>(mCopies.size()) - iCopyStart,
+	});
+}
+
+void TextureUploader::Submit()
+{
+	SubmitPending();
+
+	for (int64_t i = 0; i < static_cast<int64_t>(mBlocks.size()); ++i)
+	{
+		RetireBlock(i);
+		DestroyBlock(mBlocks[i]);
+	}
+
+	mStagingRing.Clear();
+	miPendingBlock = -1;
+}
+
+void TextureUploader::UploadDedicated(Texture& rTexture, const std::function<void(void*, int64_t, int64_t)>& dataFunction, int64_t iSize)
+{
+	Block block;
+	CreateBlock(block, iSize);
+	dataFunction(block.pMappedMemory, 0, iSize);
+
+	// Recorded on its own so the pending textures of the current block are not affected
+	std::vector<VkBufferImageCopy> copies;
+	BuildTextureCopies(copies, rTexture.mInfo.format, rTexture.mInfo.extent, rTexture.mInfo.mipLevels, rTexture.mInfo.arrayLayers, 0);
+
+	OneShotCommandBuffer oneShotCommandBuffer;
+	rTexture.TransitionImageLayout(oneShotCommandBuffer.mVkCommandBuffer, kUndefined, kTransferDestination);
+	vkCmdCopyBufferToImage(oneShotCommandBuffer.mVkCommandBuffer, block.vkBuffer, rTexture.mVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copies.size()), copies.data());
+	if (rTexture.mInfo.eTextureLayout != kUndefined)
+	{
+		rTexture.TransitionImageLayout(oneShotCommandBuffer.mVkCommandBuffer, kTransferDestination, rTexture.mInfo.eTextureLayout);
+	}
+	oneShotCommandBuffer.Execute(true);
+
+	DestroyBlock(block);
+}
+
+void TextureUploader::RecordCopies(VkCommandBuffer vkCommandBuffer, VkBuffer vkBuffer)
+{
+	for (const PendingTexture& rPendingTexture : mPendingTextures)
+	{
+		rPendingTexture.pTexture->TransitionImageLayout(vkCommandBuffer, kUndefined, kTransferDestination);
+	}
+
+	for (const PendingTexture& rPendingTexture : mPendingTextures)
+	{
+		vkCmdCopyBufferToImage(vkCommandBuffer, vkBuffer, rPendingTexture.pTexture->mVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(rPendingTexture.iCopyCount), &mCopies[rPendingTexture.iCopyStart]);
+	}
+
+	for (const PendingTexture& rPendingTexture : mPendingTextures)
+	{
+		if (rPendingTexture.pTexture->mInfo.eTextureLayout != kUndefined)
+		{
+			rPendingTexture.pTexture->TransitionImageLayout(vkCommandBuffer, kTransferDestination, rPendingTexture.pTexture->mInfo.eTextureLayout);
+		}
+	}
+}
+
+void TextureUploader::SubmitPending()
+{
+	if (mPendingTextures.empty())
+	{
+		return;
+	}
+
+	Block& rBlock = mBlocks[miPendingBlock];
+	ASSERT(rBlock.pOneShotCommandBuffer == nullptr);
+	rBlock.pOneShotCommandBuffer = std::make_unique<OneShotCommandBuffer>();
+	RecordCopies(rBlock.pOneShotCommandBuffer->mVkCommandBuffer, rBlock.vkBuffer);
+	rBlock.pOneShotCommandBuffer->ExecuteDeferred();
+
+	mCopies.clear();
+	mPendingTextures.clear();
+}
+
+void TextureUploader::RetireBlock(int64_t iBlock)
+{
+	Block& rBlock = mBlocks[iBlock];
+	if (rBlock.pOneShotCommandBuffer != nullptr)
+	{
+		rBlock.pOneShotCommandBuffer->Wait();
+		rBlock.pOneShotCommandBuffer.reset();
+	}
+}
+
+void TextureUploader::CreateBlock(Block& rBlock, int64_t iSize)
+{
+	VkDeviceSize vkDeviceSize = static_cast<VkDeviceSize>(iSize);
+	Buffer::CreateBuffer("Texture staging", vkDeviceSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, rBlock.vkBuffer, rBlock.vkDeviceMemory);
+	void* pMappedMemory = nullptr;
+	CHECK_VK(vkMapMemory(gpDeviceManager->mVkDevice, rBlock.vkDeviceMemory, 0, vkDeviceSize, 0, &pMappedMemory));
+	rBlock.pMappedMemory = static_cast<std::byte*>(pMappedMemory);
+}
+
+void TextureUploader::DestroyBlock(Block& rBlock) noexcept
+{
+	if (rBlock.vkBuffer == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	vkUnmapMemory(gpDeviceManager->mVkDevice, rBlock.vkDeviceMemory);
+	vkDestroyBuffer(gpDeviceManager->mVkDevice, rBlock.vkBuffer, nullptr);
+	vkFreeMemory(gpDeviceManager->mVkDevice, rBlock.vkDeviceMemory, nullptr);
+	rBlock.vkBuffer = VK_NULL_HANDLE;
+	rBlock.vkDeviceMemory = VK_NULL_HANDLE;
+	rBlock.pMappedMemory = nullptr;
+}
+
+} // namespace engine
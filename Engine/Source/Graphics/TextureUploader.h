@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Graphics/Objects/Texture.h"
+#include "Graphics/OneShotCommandBuffer.h"
+#include "Graphics/StagingRing.h"
+#include "Graphics/TextureCopies.h"
+
+namespace engine
+{
+
+// Collects texture uploads into a ring of staging blocks, every filled block is copied by its own command buffer while the next one fills
+// Peak staging memory is the ring, not the sum of the uploads, textures larger than a block get a staging buffer of their own
+class TextureUploader
+{
+public:
+
+	TextureUploader() noexcept;
+	~TextureUploader();
+
+	void Upload(Texture& rTexture, const std::function<void(void*, int64_t, int64_t)>& dataFunction);
+	void Submit();
+
+private:
+
+	struct PendingTexture
+	{
+		Texture* pTexture = nullptr;
+		int64_t iCopyStart = 0;
+		int64_t iCopyCount = 0;
+	};
+
+	struct Block
+	{
+		VkBuffer vkBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory vkDeviceMemory = VK_NULL_HANDLE;
+		std::byte* pMappedMemory = nullptr;
+		// Set while a submitted copy still reads the block
+		std::unique_ptr<OneShotCommandBuffer> pOneShotCommandBuffer;
+	};
+
+	void UploadDedicated(Texture& rTexture, const std::function<void(void*, int64_t, int64_t)>& dataFunction, int64_t iSize);
+	void RecordCopies(VkCommandBuffer vkCommandBuffer, VkBuffer vkBuffer);
+	void SubmitPending();
+	void RetireBlock(int64_t iBlock);
+	void CreateBlock(Block& rBlock, int64_t iSize);
+	void DestroyBlock(Block& rBlock) noexcept;
+
+	StagingRing mStagingRing;
+	std::vector<Block> mBlocks;
+
+	// Textures in the current block that are not submitted yet
+	std::vector<VkBufferImageCopy> mCopies;
+	std::vector<PendingTexture> mPendingTextures;
+	int64_t miPendingBlock = -1;
+};
+
+} // namespace engine
@@ -39,6 +39,8 @@ void MainThread(HINSTANCE hinstance)
 
 	// Save one core for the main thread
 	giBackgroundThreadCount = std::max(1ll, common::HardwareCoreCount() - 1);
+	auto pWorkerPool = std::make_unique<common::WorkerPool>(giBackgroundThreadCount);
+	gpWorkerPool = pWorkerPool.get();
 
 	if (!DirectX::XMVerifyCPUSupport()) [[unlikely]]
 	{
@@ -243,6 +245,8 @@ void MainThread(HINSTANCE hinstance)
 	}
 	LOG("Exit main loop\n");
 
+	PROFILE_EXPORT_SUMMARY();
+
 	// Save settings
 	game::Game::SaveSoundSettings();
 
@@ -528,6 +532,7 @@ void HandleException(std::optional<std::exception*> pException = std::nullopt)
 	ofstream << "<End DxDiag>\n" << std::flush;
 
 	ofstream << "\n\n\n<Begin Log>\n" << std::flush;
+	common::TryFlushLog();
 	gpFileManager->WriteLogFile(ofstream);
 	ofstream << "<End Log>\n" << std::flush;
 
@@ -1,10 +1,16 @@
 #include "ProfileManager.h"
 
+#include "File/FileManager.h"
 #include "Graphics/Graphics.h"
 
 namespace engine
 {
 
+using enum FileFlags;
+
+constexpr char kpcProfileSummaryFile[] = "ProfileSummary.csv";
+constexpr char kpcProfileBaselineFile[] = "ProfileBaseline.csv";
+
 #if defined(ENABLE_PROFILING)
 
 ProfileManager::ProfileManager()
@@ -83,11 +89,18 @@ void ProfileManager::CpuStop(CpuTimers eCpuTimer, bool bSmoothNow)
 
 	if (bSmoothNow) [[unlikely]]
 	{
+		rCpuTimer.distribution.Record(rCpuTimer.iTotalFrameTimeNs / 1000);
 		rCpuTimer.smoothedMicroseconds = rCpuTimer.iTotalFrameTimeNs / 1000;
 		rCpuTimer.iTotalFrameTimeNs = 0;
 	}
 }
 
+void ProfileManager::CpuAdd(CpuTimers eCpuTimer, std::chrono::nanoseconds durationNs)
+{
+	// For spans that start and end on different threads, where a start time point can't be kept in the timer
+	gpCpuTimers[eCpuTimer].iTotalFrameTimeNs += durationNs.count();
+}
+
 void ProfileManager::ResetGlobalQueryPools(int64_t iCommandBuffer, VkCommandBuffer vkCommandBuffer)
 {
 	uint32_t uiIndex = static_cast<uint32_t>(2 * (kGpuTimerCount * iCommandBuffer + kGpuTimerGlobal));
@@ -158,6 +171,7 @@ void ProfileManager::GpuRead(int64_t iCommandBuffer, GpuTimers eStart, GpuTimers
 
 		GpuTimer& rGpuTimer = gpGpuTimers[eGpuTimer];
 		rGpuTimer.smoothedMicroseconds = static_cast<int64_t>((puiResults[1] - puiResults[0]) / 1000);
+		rGpuTimer.distribution.Record(static_cast<int64_t>((puiResults[1] - puiResults[0]) / 1000));
 	}
 }
 
@@ -223,17 +237,120 @@ void ProfileManager::LogTimers()
 	}
 
 	LOG("");
+
+	// Percentiles of the last closed window
+	auto logPercentiles = [](std::string_view name, const ProfilePercentiles& rPercentiles)
+	{
+		if (rPercentiles.iCount > 0)
+		{
+			LOG("{}: p50 {}, p90 {}, p99 {}, p99.9 {}, max {} ({} samples)", name, rPercentiles.iP50, rPercentiles.iP90, rPercentiles.iP99, rPercentiles.iP999, rPercentiles.iMax, rPercentiles.iCount);
+		}
+	};
+
+	logPercentiles("Frame", mFrameDistribution.windowPercentiles);
+	for (CpuTimer& rCpuTimer : gpCpuTimers)
+	{
+		logPercentiles(rCpuTimer.pcName, rCpuTimer.distribution.windowPercentiles);
+	}
+	for (GpuTimer& rGpuTimer : gpGpuTimers)
+	{
+		logPercentiles(rGpuTimer.pcName, rGpuTimer.distribution.windowPercentiles);
+	}
+
+	LOG("");
+}
+
+void ProfileManager::EndProfileWindow()
+{
+	mFrameDistribution.EndWindow();
+	for (CpuTimer& rCpuTimer : gpCpuTimers)
+	{
+		rCpuTimer.distribution.EndWindow();
+	}
+	for (GpuTimer& rGpuTimer : gpGpuTimers)
+	{
+		rGpuTimer.distribution.EndWindow();
+	}
+}
+
+void ProfileManager::ExportSummary()
+{
+	// Indentation only shows nesting in the profile text, the Cpu and Gpu prefixes keep names unique
+	auto summaryName = [](std::string_view prefix, std::string_view name)
+	{
+		return std::string(prefix) + std::string(name.substr(std::min(name.find_first_not_of(' '), name.size())));
+	};
+
+	std::vector<ProfileSummaryEntry> entries;
+	entries.push_back({.name = "Frame", .percentiles = Percentiles(mFrameDistribution.total)});
+	for (CpuTimer& rCpuTimer : gpCpuTimers)
+	{
+		entries.push_back({.name = summaryName("Cpu ", rCpuTimer.pcName), .percentiles = Percentiles(rCpuTimer.distribution.total)});
+	}
+	for (GpuTimer& rGpuTimer : gpGpuTimers)
+	{
+		entries.push_back({.name = summaryName("Gpu ", rGpuTimer.pcName), .percentiles = Percentiles(rGpuTimer.distribution.total)});
+	}
+
+	{
+		std::string summaryText = WriteProfileSummary(entries);
+		std::fstream fileStream = gpFileManager->OpenFile({kAppDataDirectory, kWrite}, kpcProfileSummaryFile);
+		fileStream.write(summaryText.data(), summaryText.size());
+		if (!fileStream.good())
+		{
+			LOG("Failed to write profile summary");
+		}
+	}
+
+	// Comparison mode, a summary copied to ProfileBaseline.csv is what later runs are held against
+	if (!gpFileManager->Exists({kAppDataDirectory, kRead}, kpcProfileBaselineFile))
+	{
+		return;
+	}
+
+	std::fstream fileStream = gpFileManager->OpenFile({kAppDataDirectory, kRead}, kpcProfileBaselineFile);
+	std::string baselineText((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+	std::vector<ProfileSummaryEntry> baseline = ReadProfileSummary(baselineText);
+
+	std::vector<ProfileRegression> regressions = CompareProfileSummaries(baseline, entries, kfProfileRegressionThreshold, kiProfileRegressionMinimumUs);
+	LOG("{} of {} timers regressed by more than {}% in p99 or p99.9 against the baseline", regressions.size(), entries.size(), static_cast<int64_t>(kfProfileRegressionThreshold * 100.0f));
+	for (const ProfileRegression& rRegression : regressions)
+	{
+		LOG("    {}: p99 {} -> {}, p99.9 {} -> {}", rRegression.name, rRegression.baseline.iP99, rRegression.current.iP99, rRegression.baseline.iP999, rRegression.current.iP999);
+	}
 }
 
 void ProfileManager::UpdateProfileText()
 {
 	SCOPED_CPU_PROFILE(kCpuTimerUpdateProfileText);
 
+	std::chrono::high_resolution_clock::time_point currentTimePoint = std::chrono::high_resolution_clock::now();
+	if (mFrameTimePoint != std::chrono::high_resolution_clock::time_point())
+	{
+		mFrameDistribution.Record(std::chrono::duration_cast<std::chrono::microseconds>(currentTimePoint - mFrameTimePoint).count());
+	}
+	else
+	{
+		mWindowStartTimePoint = currentTimePoint;
+	}
+	mFrameTimePoint = currentTimePoint;
+
+	if (currentTimePoint - mWindowStartTimePoint >= kProfileWindowDuration)
+	{
+		EndProfileWindow();
+		mWindowStartTimePoint = currentTimePoint;
+	}
+
 	for (int64_t i = 0; i < kCpuTimerCount; ++i)
 	{
 		CpuTimer& rCpuTimer = gpCpuTimers[i];
 		if (i > kCpuTimerAcquireToGlobal)
 		{
+			// Timers that didn't run this frame would only pile up zeros in the low buckets
+			if (rCpuTimer.iTotalFrameTimeNs > 0)
+			{
+				rCpuTimer.distribution.Record(rCpuTimer.iTotalFrameTimeNs / 1000);
+			}
 			rCpuTimer.smoothedMicroseconds = rCpuTimer.iTotalFrameTimeNs / 1000;
 			rCpuTimer.iTotalFrameTimeNs = 0;
 		}
@@ -366,6 +483,12 @@ void ProfileManager::UpdateProfileText()
 
 	fpsText += " updates: " + std::to_string(mUpdatesInTheLastSecond.Get());
 
+	const ProfilePercentiles& rFramePercentiles = mFrameDistribution.windowPercentiles;
+	if (rFramePercentiles.iCount > 0)
+	{
+		fpsText += " p99: " + std::to_string(rFramePercentiles.iP99) + " us";
+	}
+
 	gpTextManager->UpdateTextArea(kTextProfileFps, fpsText);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Profile/GameProfile.h"
+#include "Profile/ProfileSummary.h"
 
 namespace engine
 {
@@ -30,6 +31,7 @@ enum CpuCounters
 	kCpuCounterExplosions,
 	kCpuCounterPushers,
 	kCpuCounterSounds,
+	kCpuCounterWidgetsRebuilt,
 	CPU_COUNTERS_GAME_ENUM
 
 	kCpuCounterCount
@@ -51,6 +53,7 @@ inline CpuCounter gpCpuCounters[]
 	CpuCounter {.name = "Explosions" },
 	CpuCounter {.name = "Pushers" },
 	CpuCounter {.name = "Sounds" },
+	CpuCounter {.name = "Widgets rebuilt" },
 	CPU_COUNTERS_GAME
 };
 static_assert(std::size(gpCpuCounters) == kCpuCounterCount);
@@ -64,6 +67,7 @@ struct CpuTimer
 	int64_t iTotalFrameTimeNs = 0;
 
 	common::Smoothed<int64_t> smoothedMicroseconds;
+	ProfileDistribution distribution;
 };
 
 enum CpuTimers
@@ -73,17 +77,23 @@ enum CpuTimers
 	kCpuTimerFrameGlobal,
 	kCpuTimerRenderGlobal,
 	kCpuTimerReduceInputLagFence,
+	kCpuTimerReduceInputLagSleep,
 	kCpuTimerAudio,
 	kCpuTimerMessagesAndInput,
+		kCpuTimerUiUpdate,
 	CPU_TIMERS_GAME_ENUM
 	kCpuTimerWaitFence,
 	kCpuTimerRenderMain,
+		kCpuTimerWaterWaves,
+		kCpuTimerUiRender,
+		kCpuTimerTextRender,
 	kCpuTimerUpdateProfileText,
-	kCpuTimerWaitPresentFuture,
+	kCpuTimerWaitSubmissions,
 		kCpuTimerSubmitGlobal,
 		kCpuTimerSubmitMain,
 		kCpuTimerSubmitImage,
 		kCpuTimerPresent,
+		kCpuTimerSubmitLatency,
 	kCpuTimerAcquireImage,
 		kCpuTimerAcquireImageFence,
 
@@ -96,17 +106,23 @@ inline CpuTimer gpCpuTimers[]
 	CpuTimer {.pcName = "Frame global" },
 	CpuTimer {.pcName = "Render global" },
 	CpuTimer {.pcName = "Reduce input lag fence" },
+	CpuTimer {.pcName = "Reduce input lag sleep" },
 	CpuTimer {.pcName = "Audio" },
 	CpuTimer {.pcName = "Messages and input" },
+	CpuTimer {.pcName = "    Ui update" },
 	CPU_TIMERS_GAME
 	CpuTimer {.pcName = "Wait fence" },
 	CpuTimer {.pcName = "Render main" },
+	CpuTimer {.pcName = "    Water waves" },
+	CpuTimer {.pcName = "    Ui" },
+	CpuTimer {.pcName = "    Text" },
 	CpuTimer {.pcName = "Profile text" },
-	CpuTimer {.pcName = "Wait present future"},
+	CpuTimer {.pcName = "Wait submissions"},
 	CpuTimer {.pcName = "    Submit global" },
 	CpuTimer {.pcName = "    Submit main" },
 	CpuTimer {.pcName = "    Submit image" },
 	CpuTimer {.pcName = "    Present"},
+	CpuTimer {.pcName = "    Record to submit" },
 	CpuTimer {.pcName = "Acquire image" },
 	CpuTimer {.pcName = "    Fence" },
 };
@@ -148,6 +164,7 @@ struct GpuTimer
 {
 	std::string_view pcName;
 	common::Smoothed<int64_t> smoothedMicroseconds;
+	ProfileDistribution distribution;
 };
 inline GpuTimer gpGpuTimers[]
 {
@@ -186,6 +203,9 @@ enum BootTimers
 	kBootTimerTotal,
 		kBootTimerWaitForDataFile,
 		kBootTimerWaitForTexturesFile,
+		kBootTimerReadDataFile,
+		kBootTimerReadTexturesFile,
+		kBootTimerPrepareGlyphs,
 		kBootTimerVulkan,
 			kBootTimerInstanceManager,
 			kBootTimerDeviceManager,
@@ -193,6 +213,7 @@ enum BootTimers
 			kBootTimerSwapchainManager,
 			kBootTimerParticleManager,
 			kBootTimerPipelineManager,
+				kBootTimerPipelineCompilation,
 			kBootTimerCommandBufferManager,
 			kBootTimerBufferManager,
 			kBootTimerIslands,
@@ -217,13 +238,17 @@ inline BootTimer gpBootTimers[]
 	BootTimer {.name = "Total" },
 	BootTimer {.name = "    Wait for data file" },
 	BootTimer {.name = "    Wait for textures file" },
+	BootTimer {.name = "    Read data file (worker)" },
+	BootTimer {.name = "    Read textures file (worker)" },
+	BootTimer {.name = "    Prepare glyphs (worker)" },
 	BootTimer {.name = "    Vulkan" },
 	BootTimer {.name = "      InstanceManager" },
 	BootTimer {.name = "      DeviceManager" },
 	BootTimer {.name = "      ShaderManager" },
-	BootTimer {.name = "      ParticleManager" },
 	BootTimer {.name = "      SwapchainManager" },
+	BootTimer {.name = "      ParticleManager" },
 	BootTimer {.name = "      PipelineManager" },
+	BootTimer {.name = "          Wait for pipeline compilation" },
 	BootTimer {.name = "      CommandBufferManager" },
 	BootTimer {.name = "      BufferManager" },
 	BootTimer {.name = "      Islands" },
@@ -252,6 +277,7 @@ public:
 
 	void CpuStart(CpuTimers eCpuTimer, int64_t iThreads);
 	void CpuStop(CpuTimers eCpuTimer, bool bSmoothNow);
+	void CpuAdd(CpuTimers eCpuTimer, std::chrono::nanoseconds durationNs);
 
 	void ResetGlobalQueryPools(int64_t iCommandBuffer, VkCommandBuffer vkCommandBuffer);
 	void ResetMainQueryPools(int64_t iCommandBuffer, VkCommandBuffer vkCommandBuffer);
@@ -267,6 +293,7 @@ public:
 
 	void LogTimers();
 	void UpdateProfileText();
+	void ExportSummary();
 
 	common::InTheLastSecond mUpdatesInTheLastSecond;
 
@@ -278,7 +305,16 @@ public:
 
 private:
 
+	static constexpr std::chrono::seconds kProfileWindowDuration = 10s;
+
+	void EndProfileWindow();
+
 	VkQueryPool mVkQueryPool = VK_NULL_HANDLE;
+
+	// Time between two UpdateProfileText() calls, which happen once per rendered frame
+	ProfileDistribution mFrameDistribution;
+	std::chrono::high_resolution_clock::time_point mFrameTimePoint;
+	std::chrono::high_resolution_clock::time_point mWindowStartTimePoint;
 };
 
 inline ProfileManager* gpProfileManager = nullptr;
@@ -0,0 +1,119 @@
+#include "ProfileSummary.h"
+
+namespace engine
+{
+
+constexpr char kpcProfileSummaryHeader[] = "name,count,p50,p90,p99,p99.9,max";
+
+ProfilePercentiles Percentiles(const common::Histogram& rHistogram)
+{
+	return ProfilePercentiles
+	{
+		.iCount = rHistogram.Count(),
+		.iP50 = rHistogram.Percentile(0.5f),
+		.iP90 = rHistogram.Percentile(0.9f),
+		.iP99 = rHistogram.Percentile(0.99f),
+		.iP999 = rHistogram.Percentile(0.999f),
+		.iMax = rHistogram.Max(),
+	};
+}
+
+std::string WriteProfileSummary(std::span<const ProfileSummaryEntry> entries)
+{
+	std::string text(kpcProfileSummaryHeader);
+	text += "\n";
+
+	for (const ProfileSummaryEntry& rEntry : entries)
+	{
+		const ProfilePercentiles& rPercentiles = rEntry.percentiles;
+		text += std::format("{},{},{},{},{},{},{}\n", rEntry.name, rPercentiles.iCount, rPercentiles.iP50, rPercentiles.iP90, rPercentiles.iP99, rPercentiles.iP999, rPercentiles.iMax);
+	}
+
+	return text;
+}
+
+std::vector<ProfileSummaryEntry> ReadProfileSummary(std::string_view text)
+{
+	std::vector<ProfileSummaryEntry> entries;
+
+	while (!text.empty())
+	{
+		size_t lineEnd = text.find('\n');
+		std::string_view line = text.substr(0, lineEnd);
+		text = lineEnd == std::string_view::npos ? std::string_view() : text.substr(lineEnd + 1);
+
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.remove_suffix(1);
+		}
+
+		size_t nameEnd = line.find(',');
+		if (nameEnd == std::string_view::npos || nameEnd == 0 || line == kpcProfileSummaryHeader)
+		{
+			continue;
+		}
+
+		ProfileSummaryEntry entry {.name = std::string(line.substr(0, nameEnd)), .percentiles = {}};
+		int64_t* piValues[] = {&entry.percentiles.iCount, &entry.percentiles.iP50, &entry.percentiles.iP90, &entry.percentiles.iP99, &entry.percentiles.iP999, &entry.percentiles.iMax};
+
+		const char* pcCurrent = line.data() + nameEnd;
+		const char* pcEnd = line.data() + line.size();
+		bool bValid = true;
+		for (int64_t* piValue : piValues)
+		{
+			if (pcCurrent == pcEnd || *pcCurrent != ',')
+			{
+				bValid = false;
+				break;
+			}
+
+			auto [pcParsed, errc] = std::from_chars(pcCurrent + 1, pcEnd, *piValue);
+			if (errc != std::errc())
+			{
+				bValid = false;
+				break;
+			}
+			pcCurrent = pcParsed;
+		}
+
+		if (bValid && pcCurrent == pcEnd)
+		{
+			entries.push_back(std::move(entry));
+		}
+	}
+
+	return entries;
+}
+
+std::vector<ProfileRegression> CompareProfileSummaries(std::span<const ProfileSummaryEntry> baseline, std::span<const ProfileSummaryEntry> current, float fThreshold, int64_t iMinimumUs)
+{
+	auto regressed = [=](int64_t iBaseline, int64_t iCurrent)
+	{
+		return iCurrent - iBaseline >= iMinimumUs && static_cast<float>(iCurrent) > static_cast<float>(iBaseline) * (1.0f + fThreshold);
+	};
+
+	std::vector<ProfileRegression> regressions;
+
+	for (const ProfileSummaryEntry& rCurrent : current)
+	{
+		auto baselineIt = std::find_if(baseline.begin(), baseline.end(), [&](const ProfileSummaryEntry& rBaseline)
+		{
+			return rBaseline.name == rCurrent.name;
+		});
+		if (baselineIt == baseline.end() || baselineIt->percentiles.iCount == 0 || rCurrent.percentiles.iCount == 0)
+		{
+			continue;
+		}
+
+		const ProfilePercentiles& rBaselinePercentiles = baselineIt->percentiles;
+		const ProfilePercentiles& rCurrentPercentiles = rCurrent.percentiles;
+		if (regressed(rBaselinePercentiles.iP99, rCurrentPercentiles.iP99) || regressed(rBaselinePercentiles.iP999, rCurrentPercentiles.iP999))
+		{
+			regressions.push_back({.name = rCurrent.name, .baseline = rBaselinePercentiles, .current = rCurrentPercentiles});
+		}
+	}
+
+	return regressions;
+}
+
+} // namespace engine
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace engine
+{
+
+// Relative growth of p99 or p99.9 over the baseline that counts as a regression, differences under kiProfileRegressionMinimumUs are noise
+inline constexpr float kfProfileRegressionThreshold = 0.1f;
+inline constexpr int64_t kiProfileRegressionMinimumUs = 50;
+
+// All values in microseconds
+struct ProfilePercentiles
+{
+	int64_t iCount = 0;
+	int64_t iP50 = 0;
+	int64_t iP90 = 0;
+	int64_t iP99 = 0;
+	int64_t iP999 = 0;
+	int64_t iMax = 0;
+};
+ProfilePercentiles Percentiles(const common::Histogram& rHistogram);
+
+// The window is closed and reset every few seconds for the profile text and log, the total covers the whole run and is what gets exported
+struct ProfileDistribution
+{
+	void Record(int64_t iMicroseconds) noexcept
+	{
+		window.Record(iMicroseconds);
+		total.Record(iMicroseconds);
+	}
+
+	void EndWindow()
+	{
+		windowPercentiles = Percentiles(window);
+		window.Reset();
+	}
+
+	common::Histogram window;
+	common::Histogram total;
+	ProfilePercentiles windowPercentiles;
+};
+
+struct ProfileSummaryEntry
+{
+	std::string name;
+	ProfilePercentiles percentiles;
+};
+
+struct ProfileRegression
+{
+	std::string name;
+	ProfilePercentiles baseline;
+	ProfilePercentiles current;
+};
+
+// One header line and one comma separated line per timer, names must not contain commas or new lines
+std::string WriteProfileSummary(std::span<const ProfileSummaryEntry> entries);
+// Lines that don't parse are skipped, so a summary written by an older build with other timers still loads
+std::vector<ProfileSummaryEntry> ReadProfileSummary(std::string_view text);
+// Timers missing from either side or without samples are not compared
+std::vector<ProfileRegression> CompareProfileSummaries(std::span<const ProfileSummaryEntry> baseline, std::span<const ProfileSummaryEntry> current, float fThreshold, int64_t iMinimumUs);
+
+} // namespace engine
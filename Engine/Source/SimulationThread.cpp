@@ -0,0 +1,176 @@
+#include "SimulationThread.h"
+
+#include "GameBase.h"
+
+#include "Frame/Frame.h"
+#include "Input/Input.h"
+
+namespace engine
+{
+
+struct SimulationThread::TickRequest
+{
+	int64_t iTickCount = 0;
+	game::FrameInput frameInput;
+};
+
+SimulationThread::SimulationThread(GameBase& rGameBase, std::unique_ptr<game::Frame> pFrame)
+: mrGameBase(rGameBase)
+{
+	// The TripleBuffer starts with the last slot as both front and latest, so the frame the game was rendering stays in place
+	for (int64_t i = 0; i < std::ssize(mFrames.mSlots) - 1; ++i)
+	{
+		mFrames.mSlots[i].pFrame = std::make_unique<game::Frame>(*pFrame);
+	}
+	mFrames.mSlots.back().pFrame = std::move(pFrame);
+
+	mFuture = std::async(std::launch::async, [this]()
+	{
+		Run();
+	});
+}
+
+SimulationThread::~SimulationThread()
+{
+	{
+		std::lock_guard lockGuard(mMutex);
+		mbStop = true;
+	}
+	mRequestConditionVariable.notify_one();
+
+	if (mFuture.valid())
+	{
+		mFuture.wait();
+	}
+}
+
+void SimulationThread::Submit(int64_t iTickCount, const game::FrameInput& rFrameInput)
+{
+	ThrowIfStopped();
+
+	{
+		std::lock_guard lockGuard(mMutex);
+		mTickRequests.push_back({.iTickCount = iTickCount, .frameInput = rFrameInput});
+		miPendingTicks += iTickCount;
+	}
+	mRequestConditionVariable.notify_one();
+
+	miSubmittedTicks += iTickCount;
+}
+
+void SimulationThread::Synchronize()
+{
+	{
+		std::unique_lock uniqueLock(mMutex);
+		mPublishConditionVariable.wait(uniqueLock, [this]()
+		{
+			return miPendingTicks == 0 || !mbRunning;
+		});
+	}
+	ThrowIfStopped();
+
+	// The simulation thread is idle now, so the front frame can be written to until the next Submit()
+	// Whatever is written to it isn't a tick after the previous frame, so there is nothing to interpolate from until the next one is acquired
+	mFrames.Acquire();
+	miSubmittedTicks = mFrames.Front().iTick;
+	mFrames.Previous().iTick = miSubmittedTicks;
+}
+
+bool SimulationThread::Acquire()
+{
+	return mFrames.Acquire();
+}
+
+std::chrono::nanoseconds SimulationThread::TakeAverageTickCost()
+{
+	std::lock_guard lockGuard(mMutex);
+	if (miMeasuredTicks == 0)
+	{
+		return 0ns;
+	}
+
+	std::chrono::nanoseconds averageNs = mMeasuredTicksNs / miMeasuredTicks;
+	mMeasuredTicksNs = 0ns;
+	miMeasuredTicks = 0;
+	return averageNs;
+}
+
+void SimulationThread::Run()
+{
+	common::ThreadLocal threadLocal(0, common::kThreadSimulation);
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+
+	common::ScopedLambda stopRunning([this]()
+	{
+		std::lock_guard lockGuard(mMutex);
+		mbRunning = false;
+		mPublishConditionVariable.notify_all();
+	});
+
+	std::unique_lock uniqueLock(mMutex);
+	while (true)
+	{
+		mRequestConditionVariable.wait(uniqueLock, [this]()
+		{
+			return mbStop || !mTickRequests.empty();
+		});
+		if (mbStop)
+		{
+			return;
+		}
+
+		TickRequest tickRequest = mTickRequests.front();
+		mTickRequests.erase(mTickRequests.begin());
+		uniqueLock.unlock();
+
+		for (int64_t i = 0; i < tickRequest.iTickCount && !mbReplayEnded; ++i)
+		{
+			common::Timer tickTimer;
+			FrameSlot& rBack = mFrames.Back();
+			const FrameSlot& rLatest = mFrames.Latest();
+
+			if (!mrGameBase.RecordOrReplay(*rLatest.pFrame, tickRequest.frameInput)) [[unlikely]]
+			{
+				mbReplayEnded = true;
+				break;
+			}
+
+			UpdateFrameBase(*rBack.pFrame, *rLatest.pFrame, tickRequest.frameInput, kfDeltaTime, FrameType::kFull);
+			tickRequest.frameInput.pressedFlags.ClearAll();
+			rBack.iTick = rLatest.iTick + 1;
+			mFrames.Publish();
+
+			std::lock_guard lockGuard(mMutex);
+			--miPendingTicks;
+			mMeasuredTicksNs += tickTimer.GetDeltaNs();
+			++miMeasuredTicks;
+			mPublishConditionVariable.notify_all();
+		}
+
+		uniqueLock.lock();
+		if (mbReplayEnded) [[unlikely]]
+		{
+			// Ticks queued after the end of a replay were meant for a timeline that no longer exists
+			mTickRequests.clear();
+			miPendingTicks = 0;
+			mPublishConditionVariable.notify_all();
+		}
+	}
+}
+
+void SimulationThread::ThrowIfStopped()
+{
+	bool bRunning = true;
+	{
+		std::lock_guard lockGuard(mMutex);
+		bRunning = mbRunning;
+	}
+
+	// Rethrows whatever the simulation thread died with
+	if (!bRunning && mFuture.valid())
+	{
+		mFuture.get();
+	}
+}
+
+} // namespace engine
@@ -0,0 +1,87 @@
+#pragma once
+
+namespace game
+{
+
+struct Frame;
+struct FrameInput;
+
+}
+
+namespace engine
+{
+
+class GameBase;
+
+// Runs the kFull ticks on a dedicated thread and hands finished frames to the main thread through a TripleBuffer
+// The main thread renders between Previous() and Front() and only writes to Front() after Synchronize(), so a slow tick delays one published frame instead of present
+class SimulationThread
+{
+public:
+
+	SimulationThread(GameBase& rGameBase, std::unique_ptr<game::Frame> pFrame);
+	~SimulationThread();
+
+	// Main thread, every tick in a submit uses the same input and the pressed flags only apply to the first one
+	void Submit(int64_t iTickCount, const game::FrameInput& rFrameInput);
+	void Synchronize();
+	bool Acquire();
+	// Average cost of the ticks finished since the last call, zero when none were
+	std::chrono::nanoseconds TakeAverageTickCost();
+
+	int64_t TicksBehind()
+	{
+		return miSubmittedTicks - mFrames.Front().iTick;
+	}
+
+	game::Frame& Front()
+	{
+		return *mFrames.Front().pFrame;
+	}
+
+	// The front Acquire() last replaced, the render interpolates from it towards Front()
+	const game::Frame& Previous()
+	{
+		return *mFrames.Previous().pFrame;
+	}
+
+	// Zero until a tick has been acquired after the start or a Synchronize()
+	int64_t TicksSincePrevious()
+	{
+		return mFrames.Front().iTick - mFrames.Previous().iTick;
+	}
+
+	// Set by the simulation thread when a replay runs out, remaining ticks are dropped until the main thread calls Synchronize()
+	std::atomic<bool> mbReplayEnded = false;
+
+private:
+
+	struct TickRequest;
+
+	struct FrameSlot
+	{
+		std::unique_ptr<game::Frame> pFrame;
+		int64_t iTick = 0;
+	};
+
+	void Run();
+	void ThrowIfStopped();
+
+	GameBase& mrGameBase;
+	common::TripleBuffer<FrameSlot, true> mFrames;
+	int64_t miSubmittedTicks = 0;
+
+	std::mutex mMutex;
+	std::condition_variable mRequestConditionVariable;
+	std::condition_variable mPublishConditionVariable;
+	std::vector<TickRequest> mTickRequests;
+	int64_t miPendingTicks = 0;
+	std::chrono::nanoseconds mMeasuredTicksNs = 0ns;
+	int64_t miMeasuredTicks = 0;
+	bool mbStop = false;
+	bool mbRunning = true;
+
+	std::future<void> mFuture;
+};
+
+} // namespace engine
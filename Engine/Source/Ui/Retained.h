@@ -0,0 +1,86 @@
+#pragma once
+
+namespace engine
+{
+
+// Quads built from a key and a text, kept until either changes so an unchanged widget or text area costs a copy instead of a rebuild
+// TKey holds every callback result and rect the quads are built from and compares with operator==
+template<typename TKey, typename TChar, typename TQuad>
+class RetainedQuads
+{
+public:
+
+	// rBuild(TQuad* pQuads, int64_t& riQuads, int64_t iMaxQuads) writes to the scratch memory, pass mapped GPU memory only to the final copy so it's never read back
+	// Returns true if the quads were built again
+	template<typename TBuild>
+	bool Update(const TKey& rKey, std::basic_string_view<TChar> pcText, std::span<TQuad> scratch, TBuild&& rBuild)
+	{
+		if (mbValid && rKey == mKey && pcText == mText)
+		{
+			return false;
+		}
+
+		int64_t iQuads = 0;
+		rBuild(scratch.data(), iQuads, static_cast<int64_t>(scratch.size()));
+		mQuads.assign(scratch.begin(), scratch.begin() + iQuads);
+
+		mKey = rKey;
+		mText = pcText;
+		mbValid = true;
+		return true;
+	}
+
+	void Invalidate()
+	{
+		mbValid = false;
+	}
+
+	std::span<const TQuad> Quads() const
+	{
+		return mQuads;
+	}
+
+private:
+
+	TKey mKey {};
+	std::basic_string<TChar> mText;
+	bool mbValid = false;
+	std::vector<TQuad> mQuads;
+};
+
+// What Widget::Layout() was given and produced last time, a clean subtree given the same rects lays out exactly the same and its children still hold theirs
+struct RetainedLayout
+{
+	// Restores the last output and returns true if nothing changed, otherwise remembers the inputs for Store()
+	bool Reuse(bool bDirty, DirectX::XMFLOAT4& rf4Rect, const DirectX::XMFLOAT4& rf4ParentRect)
+	{
+		if (bValid && !bDirty && SameRect(rf4Rect, f4Input) && SameRect(rf4ParentRect, f4Parent))
+		{
+			rf4Rect = f4Output;
+			return true;
+		}
+
+		f4Input = rf4Rect;
+		f4Parent = rf4ParentRect;
+		return false;
+	}
+
+	// Call once the rect is final, before laying out the children
+	void Store(const DirectX::XMFLOAT4& rf4Rect)
+	{
+		f4Output = rf4Rect;
+		bValid = true;
+	}
+
+	static bool SameRect(const DirectX::XMFLOAT4& rA, const DirectX::XMFLOAT4& rB)
+	{
+		return rA.x == rB.x && rA.y == rB.y && rA.z == rB.z && rA.w == rB.w;
+	}
+
+	DirectX::XMFLOAT4 f4Input {};
+	DirectX::XMFLOAT4 f4Parent {};
+	DirectX::XMFLOAT4 f4Output {};
+	bool bValid = false;
+};
+
+} // namespace engine
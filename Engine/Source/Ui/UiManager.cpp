@@ -22,6 +22,8 @@ UiManager::UiManager()
 
 	mRootWidget = game::BuildUi();
 	mRootWidget.mf4Rect = {0.0f, 0.0f, 1.0f, 1.0f};
+
+	mScratchQuads.resize(shaders::kiMaxWidgets);
 }
 
 UiManager::~UiManager()
@@ -31,6 +33,8 @@ UiManager::~UiManager()
 
 void UiManager::Update(const game::MenuInput& rMenuInput)
 {
+	SCOPED_CPU_PROFILE(kCpuTimerUiUpdate);
+
 	mRootWidget.SetEnabled();
 
 	// Unfocus if disabled
@@ -80,14 +84,21 @@ void UiManager::Update(const game::MenuInput& rMenuInput)
 	}
 		
 	mRootWidget.Input(rMenuInput);
+
+	// Only subtrees whose sizes, texts or enabled state changed are laid out again
+	mRootWidget.CheckLayout();
 	mRootWidget.Layout(mRootWidget.mf4Rect);
 }
 
 void UiManager::RenderMain(int64_t iCommandBuffer)
 {
+	SCOPED_CPU_PROFILE(kCpuTimerUiRender);
+
 	auto pQuads = reinterpret_cast<shaders::WidgetLayout*>(gpBufferManager->mWidgetsStorageBuffers.at(iCommandBuffer).mpMappedMemory);
 	int64_t iQuads = 0;
+	miWidgetsRebuilt = 0;
 	mRootWidget.WriteUniformBuffer(pQuads, iQuads);
+	PROFILE_SET_COUNT(kCpuCounterWidgetsRebuilt, miWidgetsRebuilt);
 	gpPipelineManager->mpPipelines[kPipelineWidgets].WriteIndirectBuffer(iCommandBuffer, iQuads);
 }
 
@@ -22,6 +22,10 @@ public:
 	Widget* mpCapturedWidget = nullptr;
 	Widget* mpFocusedWidget = nullptr;
 
+	// Widgets build their quads here before caching them, sized for the whole widget buffer
+	std::vector<shaders::WidgetLayout> mScratchQuads;
+	int64_t miWidgetsRebuilt = 0;
+
 private:
 
 	Widget mRootWidget {};
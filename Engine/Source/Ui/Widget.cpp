@@ -93,7 +93,7 @@ XMFLOAT2 Widget::Size() const
 		ASSERT(mInfo.eString != game::kStringsCount || mInfo.pcText.length() > 0 || mInfo.Text);
 		std::u32string_view pcText = mInfo.eString != game::kStringsCount ? game::TranslatedString(mInfo.eString) : (mInfo.Text ? mInfo.Text() : mInfo.pcText);
 		float fSize = mf4Rect.w * mInfo.fTextSize;
-		std::vector<float> widths = gpTextManager->MeasureQuads(fSize, pcText);
+		TextLines widths = gpTextManager->MeasureQuads(fSize, pcText);
 		float fMaxWidth = *std::max_element(widths.begin(), widths.end());
 		f2Size.x = mInfo.f2Size.x + fMaxWidth;
 	}
@@ -221,8 +221,50 @@ void Widget::Input(const game::MenuInput& rMenuInput)
 	}
 }
 
+bool Widget::CheckLayout()
+{
+	LayoutKey layoutKey {.fAspectRatio = gpSwapchainManager->mfAspectRatio, .bEnabled = mbEnabled};
+	bool bTextChanged = false;
+	if (mbEnabled)
+	{
+		XMFLOAT2 f2Size = mInfo.Size ? mInfo.Size() : mInfo.f2Size;
+		layoutKey.pfSize[0] = f2Size.x;
+		layoutKey.pfSize[1] = f2Size.y;
+
+		// Size() measures the text at the current height
+		if (mInfo.flags & kMatchTextWidth)
+		{
+			layoutKey.fRectHeight = mf4Rect.w;
+
+			std::u32string_view pcText = Text();
+			if (pcText != mLayoutText)
+			{
+				mLayoutText = pcText;
+				bTextChanged = true;
+			}
+		}
+	}
+
+	bool bDirty = !mRetainedLayout.bValid || bTextChanged || layoutKey != mLayoutKey;
+	mLayoutKey = layoutKey;
+
+	for (Widget& rChild : mChildren)
+	{
+		bDirty |= rChild.CheckLayout();
+	}
+
+	mbLayoutDirty = bDirty;
+	return bDirty;
+}
+
 void Widget::Layout(DirectX::XMFLOAT4& rParentRect)
 {
+	// Parents assign mf4Rect right before calling this
+	if (mRetainedLayout.Reuse(mbLayoutDirty, mf4Rect, rParentRect))
+	{
+		return;
+	}
+
 	auto enabledChildren = mChildren | std::views::filter(widgetEnabled);
 
 	if (mInfo.flags & kWidthEqualsHeight)
@@ -335,6 +377,8 @@ void Widget::Layout(DirectX::XMFLOAT4& rParentRect)
 		}
 	}
 
+	mRetainedLayout.Store(mf4Rect);
+
 	for (Widget& rChild : enabledChildren)
 	{
 		rChild.Layout(mf4Rect);
@@ -467,34 +511,61 @@ void Widget::FocusSearch(const game::MenuInput& rMenuInput, Widget* pFocusedWidg
 	}
 }
 
-void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads) const
+void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 {
-	if (!mInfo.Enabled())
+	if (!mbEnabled)
 	{
 		return;
 	}
 
-	if (gpUiManager->mpCapturedWidget != nullptr && gpUiManager->mpCapturedWidget->mInfo.flags & kCaptureHides && gpUiManager->mpCapturedWidget != this && (gpUiManager->mpCapturedWidget->mInfo.iLinkId != mInfo.iLinkId))
+	if (!(gpUiManager->mpCapturedWidget != nullptr && gpUiManager->mpCapturedWidget->mInfo.flags & kCaptureHides && gpUiManager->mpCapturedWidget != this && (gpUiManager->mpCapturedWidget->mInfo.iLinkId != mInfo.iLinkId)))
 	{
-		for (const Widget& rWidget : mChildren)
+		// Each callback is evaluated once per frame, the quads are only rebuilt when one of them, the rect or the focus changed
+		DrawKey drawKey
 		{
-			rWidget.WriteUniformBuffer(pQuads, riQuads);
-		}
+			.pfRect = {mf4Rect.x, mf4Rect.y, mf4Rect.z, mf4Rect.w},
+			.fAspectRatio = gpSwapchainManager->mfAspectRatio,
+			.bFocused = mbFocused,
+			.uiBackground = mInfo.BackgroundColor ? mInfo.BackgroundColor() : mInfo.uiBackground,
+			.backgroundTexture = mInfo.flags & kBackgroundTexture ? mInfo.BackgroundTexture() : 0,
+			.rotaryInfo = mInfo.flags & kRotary ? mInfo.RotaryInfo() : RotaryInfo {},
+			.fPercent = mInfo.flags & kSlider ? mInfo.pWrapper->Percent() : 0.0f,
+			.uiTextColor = mInfo.TextColor ? mInfo.TextColor() : mInfo.uiTextColor,
+			.uiShadowColor = mInfo.ShadowColor ? mInfo.ShadowColor() : mInfo.uiShadowColor,
+		};
+		std::u32string_view pcText = Text();
 
-		return;
+		bool bRebuilt = mRetainedQuads.Update(drawKey, pcText, std::span(gpUiManager->mScratchQuads), [&](shaders::WidgetLayout* pScratchQuads, int64_t& riScratchQuads, int64_t iMaxScratchQuads)
+		{
+			WriteQuads(drawKey, pcText, pScratchQuads, riScratchQuads, std::min(iMaxScratchQuads, shaders::kiMaxWidgets - riQuads));
+		});
+		gpUiManager->miWidgetsRebuilt += bRebuilt;
+
+		std::span<const shaders::WidgetLayout> quads = mRetainedQuads.Quads();
+		ASSERT(riQuads + static_cast<int64_t>(quads.size()) <= shaders::kiMaxWidgets);
+		memcpy(&pQuads[riQuads], quads.data(), quads.size_bytes());
+		riQuads += quads.size();
 	}
 
-	float fAspectRatio = gpSwapchainManager->mfAspectRatio;
+	for (Widget& rWidget : mChildren)
+	{
+		rWidget.WriteUniformBuffer(pQuads, riQuads);
+	}
+}
+
+void Widget::WriteQuads(const DrawKey& rDrawKey, std::u32string_view pcText, shaders::WidgetLayout* pQuads, int64_t& riQuads, int64_t iMaxQuads) const
+{
+	float fAspectRatio = rDrawKey.fAspectRatio;
 
 	if (mInfo.flags & kBackgroundTexture)
 	{
 		float fFocusSize = mbFocused && mInfo.flags & kFocusSize ? 0.02f * mf4Rect.w : 0.0f;
 
-		uint32_t uiIndex = UiCrcToIndex(mInfo.BackgroundTexture());
+		uint32_t uiIndex = UiCrcToIndex(rDrawKey.backgroundTexture);
 		shaders::WidgetLayout* pFinalQuads = pQuads;
 		int64_t& riFinalQuads = riQuads;
 
-		ASSERT(riFinalQuads < shaders::kiMaxWidgets);
+		ASSERT(riFinalQuads < iMaxQuads);
 		pFinalQuads[riFinalQuads].f4VertexRect = {-1.0f + 2.0f * (mf4Rect.x - fFocusSize / fAspectRatio), 1.0f - 2.0f * (mf4Rect.y - fFocusSize), 2.0f * (mf4Rect.z + 2.0f * fFocusSize / fAspectRatio), -2.0f * (mf4Rect.w + 2.0f * fFocusSize)};
 		pFinalQuads[riFinalQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 		pFinalQuads[riFinalQuads].ui4Misc = {0xFFFFFFFF, uiIndex, mInfo.flags & kRoundedEdges ? 3u : 0u, 0};
@@ -503,7 +574,7 @@ void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 
 	if (mInfo.flags & kRotary)
 	{
-		RotaryInfo rotaryInfo = mInfo.RotaryInfo();
+		const RotaryInfo& rotaryInfo = rDrawKey.rotaryInfo;
 
 		float fAngleDelta = -XM_2PI / static_cast<float>(rotaryInfo.iTotal);
 		for (int64_t i = 0; i < rotaryInfo.iTotal; ++i)
@@ -520,39 +591,39 @@ void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 			float fCenterX = mf4Rect.x + 0.5f * mf4Rect.z + XMVectorGetX(vecOffset) / fAspectRatio;
 			float fCenterY = mf4Rect.y + 0.5f * mf4Rect.w + XMVectorGetY(vecOffset);
 
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {-1.0f + 2.0f * (fCenterX - 0.5f * rotaryInfo.fSize / fAspectRatio), 1.0f - 2.0f * (fCenterY - 0.5f * rotaryInfo.fSize), 2.0f * (rotaryInfo.fSize / fAspectRatio), -2.0f * (rotaryInfo.fSize)};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
-			pQuads[riQuads].ui4Misc = {bActive ? rotaryInfo.uiActiveColor : rotaryInfo.uiInactiveColor, UiCrcToIndex(data::kTexturesUiBC7CirclepngCrc), 0, 0};
+			pQuads[riQuads].ui4Misc = {bActive ? rotaryInfo.uiActiveColor : rotaryInfo.uiInactiveColor, static_cast<uint32_t>(data::kTexturesUiBC7CirclepngIndex), 0, 0};
 			++riQuads;
 		}
 	}
 
 	if (mInfo.flags & kSlider)
 	{
-		uint32_t uiBackgroundColor = mInfo.BackgroundColor ? mInfo.BackgroundColor() : mInfo.uiBackground;
+		uint32_t uiBackgroundColor = rDrawKey.uiBackground;
 
 		if (mbFocused)
 		{
 			float fFocusSize = 0.001f + 0.01f * mf4Rect.w;
 
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {-1.0f + 2.0f * (mf4Rect.x - fFocusSize), 1.0f - 2.0f * ((mf4Rect.y + 0.25f * mf4Rect.w) - fAspectRatio * fFocusSize), 2.0f * (mf4Rect.z + 2.0f * fFocusSize), -2.0f * ((0.5f * mf4Rect.w) + 2.0f * fAspectRatio * fFocusSize)};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 			pQuads[riQuads].ui4Misc = {0xFFFFFFFF, 0, 1, 0};
 			++riQuads;
 		}
 
- 		ASSERT(riQuads < shaders::kiMaxWidgets);
+ 		ASSERT(riQuads < iMaxQuads);
 		pQuads[riQuads].f4VertexRect = {-1.0f + 2.0f * mf4Rect.x, 1.0f - 2.0f * (mf4Rect.y + 0.25f * mf4Rect.w), 2.0f * mf4Rect.z, -2.0f * (0.5f * mf4Rect.w)};
 		pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 		pQuads[riQuads].ui4Misc = {uiBackgroundColor, 0, 1, 0};
 		++riQuads;
 
-		float fPercent = mInfo.pWrapper->Percent();
+		float fPercent = rDrawKey.fPercent;
 		float fSliderWidth = 0.02f * mf4Rect.z;
 		float fX = std::clamp(mf4Rect.x + fPercent * mf4Rect.z - 0.5f * fSliderWidth, mf4Rect.x, mf4Rect.x + mf4Rect.z - fSliderWidth);
-		ASSERT(riQuads < shaders::kiMaxWidgets);
+		ASSERT(riQuads < iMaxQuads);
 		pQuads[riQuads].f4VertexRect = {-1.0f + 2.0f * fX, 1.0f - 2.0f * mf4Rect.y, 2.0f * fSliderWidth, -2.0f * mf4Rect.w};
 		pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 		pQuads[riQuads].ui4Misc = {(~uiBackgroundColor) | 0x000000FF, 0, 1, 0};
@@ -569,25 +640,25 @@ void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 			float fTop = 1.0f - 2.0f * mf4Rect.y;
 			float fBottom = fTop - 2.0f * mf4Rect.w;
 
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {fLeft - fFocusSize, fTop + fAspectRatio * fFocusSize, fFocusSize, -2.0f * (mf4Rect.w + fAspectRatio * fFocusSize)};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 			pQuads[riQuads].ui4Misc = {0xFFFFFFFF, 0, 1, 0};
 			++riQuads;
 
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {fLeft - fFocusSize, fTop + fAspectRatio * fFocusSize, 2.0f * (mf4Rect.z + fFocusSize), -fAspectRatio * fFocusSize};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 			pQuads[riQuads].ui4Misc = {0xFFFFFFFF, 0, 1, 0};
 			++riQuads;
 
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {fRight, fTop + fAspectRatio * fFocusSize, fFocusSize, -2.0f * (mf4Rect.w + fAspectRatio * fFocusSize)};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 			pQuads[riQuads].ui4Misc = {0xFFFFFFFF, 0, 1, 0};
 			++riQuads;
 
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {fLeft - fFocusSize, fBottom, 2.0f * (mf4Rect.z + fFocusSize), -fAspectRatio * fFocusSize};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 			pQuads[riQuads].ui4Misc = {0xFFFFFFFF, 0, 1, 0};
@@ -596,8 +667,8 @@ void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 
 		if ((mbFocused && mInfo.flags & kFocusBackground) || mInfo.flags & kBackground)
 		{
-			uint32_t uiBackgroundColor = mInfo.BackgroundColor ? mInfo.BackgroundColor() : mInfo.uiBackground;
-			ASSERT(riQuads < shaders::kiMaxWidgets);
+			uint32_t uiBackgroundColor = rDrawKey.uiBackground;
+			ASSERT(riQuads < iMaxQuads);
 			pQuads[riQuads].f4VertexRect = {-1.0f + 2.0f * mf4Rect.x, 1.0f - 2.0f * mf4Rect.y, 2.0f * mf4Rect.z, -2.0f * mf4Rect.w};
 			pQuads[riQuads].f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
 			pQuads[riQuads].ui4Misc = {uiBackgroundColor, 0, 1, 0};
@@ -605,7 +676,6 @@ void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 		}
 	}
 
-	std::u32string_view pcText = Text();
 	if (pcText.size() > 0)
 	{
 		float fSize = mf4Rect.w * mInfo.fTextSize;
@@ -613,27 +683,22 @@ void Widget::WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads)
 		if (mInfo.fShadowOffset != 0.0f)
 		{
 			float fShadowOffset = mInfo.fShadowOffset * fSize;
-			std::vector<float> xOffsets = gpTextManager->MeasureQuads(fSize, pcText);
+			TextLines xOffsets = gpTextManager->MeasureQuads(fSize, pcText);
 			for (float& rXOffset : xOffsets)
 			{
 				rXOffset = fShadowOffset + mf4Rect.x + (mInfo.flags & kTextAlignLeft ? 0.0f : 0.5f * (mf4Rect.z - rXOffset));
 			}
-			uint32_t uiShadowColor = mInfo.ShadowColor ? mInfo.ShadowColor() : mInfo.uiShadowColor;
-			gpTextManager->WriteQuads(xOffsets, gpSwapchainManager->mfAspectRatio * fShadowOffset + mf4Rect.y + 0.5f * (mf4Rect.w - fSize), fSize, pcText, uiShadowColor, pQuads, riQuads, shaders::kiMaxWidgets);
+			uint32_t uiShadowColor = rDrawKey.uiShadowColor;
+			gpTextManager->WriteQuads(xOffsets, gpSwapchainManager->mfAspectRatio * fShadowOffset + mf4Rect.y + 0.5f * (mf4Rect.w - fSize), fSize, pcText, uiShadowColor, pQuads, riQuads, iMaxQuads);
 		}
 
-		std::vector<float> xOffsets = gpTextManager->MeasureQuads(fSize, pcText);
+		TextLines xOffsets = gpTextManager->MeasureQuads(fSize, pcText);
 		for (float& rXOffset : xOffsets)
 		{
 			rXOffset = mf4Rect.x + (mInfo.flags & kTextAlignLeft ? 0.0f : 0.5f * (mf4Rect.z - rXOffset));
 		}
-		uint32_t uiTextColor = mInfo.TextColor ? mInfo.TextColor() : mInfo.uiTextColor;
-		gpTextManager->WriteQuads(xOffsets, mf4Rect.y + 0.5f * (mf4Rect.w - fSize), fSize, pcText, uiTextColor, pQuads, riQuads, shaders::kiMaxWidgets);
-	}
-
-	for (const Widget& rWidget : mChildren)
-	{
-		rWidget.WriteUniformBuffer(pQuads, riQuads);
+		uint32_t uiTextColor = rDrawKey.uiTextColor;
+		gpTextManager->WriteQuads(xOffsets, mf4Rect.y + 0.5f * (mf4Rect.w - fSize), fSize, pcText, uiTextColor, pQuads, riQuads, iMaxQuads);
 	}
 }
 
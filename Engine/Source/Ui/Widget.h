@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Ui/Localization.h"
+#include "Ui/Retained.h"
 #include "Ui/Wrapper.h"
 #include "Ui/Ui.h"
 
@@ -60,6 +61,8 @@ struct RotaryInfo
 
 	uint32_t uiActiveColor = 0xFFFFFFFF;
 	uint32_t uiInactiveColor = 0x00000000;
+
+	bool operator==(const RotaryInfo& rOther) const = default;
 };
 
 struct WidgetInfo
@@ -124,12 +127,14 @@ public:
 
 	void SetEnabled(bool bEnabled = true);
 	void Input(const game::MenuInput& rMenuInput);
+	// Returns true if anything Layout() depends on changed in this subtree since the last call
+	bool CheckLayout();
 	void Layout(DirectX::XMFLOAT4& rParentRect);
 
 	bool FindFirstFocus(const game::MenuInput& rMenuInput);
 	void FocusSearch(const game::MenuInput& rMenuInput, Widget* pFocusedWidget, Widget*& rpOtherWidget, bool bIgnoreBox);
 
-	void WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads) const;
+	void WriteUniformBuffer(shaders::WidgetLayout* pQuads, int64_t& riQuads);
 
 	DirectX::XMFLOAT2 Center() const
 	{
@@ -142,6 +147,44 @@ public:
 	DirectX::XMFLOAT4 mf4Rect {}; // Left, Top, Width, Height
 	bool mbEnabled = false;
 	bool mbFocused = false;
+
+private:
+
+	// Everything Layout() reads from this widget, children report their own through CheckLayout()
+	struct LayoutKey
+	{
+		float pfSize[2] {};
+		float fRectHeight = 0.0f;
+		float fAspectRatio = 0.0f;
+		bool bEnabled = false;
+
+		bool operator==(const LayoutKey& rOther) const = default;
+	};
+
+	// Everything the widget's own quads are built from apart from the text, when it matches last frame the cached quads are copied instead
+	struct DrawKey
+	{
+		float pfRect[4] {};
+		float fAspectRatio = 0.0f;
+		bool bFocused = false;
+		uint32_t uiBackground = 0;
+		common::crc_t backgroundTexture = 0;
+		RotaryInfo rotaryInfo;
+		float fPercent = 0.0f;
+		uint32_t uiTextColor = 0;
+		uint32_t uiShadowColor = 0;
+
+		bool operator==(const DrawKey& rOther) const = default;
+	};
+
+	void WriteQuads(const DrawKey& rDrawKey, std::u32string_view pcText, shaders::WidgetLayout* pQuads, int64_t& riQuads, int64_t iMaxQuads) const;
+
+	LayoutKey mLayoutKey;
+	std::u32string mLayoutText;
+	bool mbLayoutDirty = true;
+	RetainedLayout mRetainedLayout;
+
+	RetainedQuads<DrawKey, char32_t, shaders::WidgetLayout> mRetainedQuads;
 };
 
 inline auto widgetEnabled = [](const Widget& rWidget) { return rWidget.mbEnabled; };
@@ -191,6 +191,14 @@ private:
 inline Wrapper gFullscreen(true);
 inline Wrapper gPresentMode(VK_PRESENT_MODE_FIFO_KHR, std::move(std::vector<VkPresentModeKHR> {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR}));
 inline Wrapper gReduceInputLag(true);
+inline Wrapper gPaceFrameStart(false); // With gReduceInputLag, sleep after the image wait so input is sampled as late as the predicted frame work allows, trades some missed refreshes for latency
+// Pacing predicts the GPU part of a frame from the image pass timer, which only the profiler measures, without it gPaceFrameStart is ignored
+#if defined(ENABLE_PROFILING)
+inline constexpr bool kbPaceFrameStartAvailable = true;
+#else
+inline constexpr bool kbPaceFrameStartAvailable = false;
+#endif
+inline Wrapper gTickBudget(0.5f, 0.1f, 1.0f); // Part of a monitor refresh that catch up ticks may use
 inline Wrapper gMultisampling(true);
 inline Wrapper gSampleCount(VK_SAMPLE_COUNT_2_BIT, std::move(std::vector<VkSampleCountFlagBits> {VK_SAMPLE_COUNT_2_BIT, VK_SAMPLE_COUNT_4_BIT, VK_SAMPLE_COUNT_8_BIT, VK_SAMPLE_COUNT_16_BIT, VK_SAMPLE_COUNT_32_BIT, VK_SAMPLE_COUNT_64_BIT}));
 inline Wrapper gAnisotropy(true);
@@ -39,6 +39,11 @@ struct alignas(64) Camera
 	static void Spawn(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 	static void Destroy(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 
+	static constexpr engine::PhaseAccess kPostRenderAccess {.uiReads = kAccessCamera, .uiWrites = kAccessCamera};
+	static constexpr engine::PhaseAccess kCollideAccess {};
+	static constexpr engine::PhaseAccess kSpawnAccess {};
+	static constexpr engine::PhaseAccess kDestroyAccess {};
+
 	// Render
 	static void RenderGlobal(int64_t iCommandBuffer, const Frame& __restrict rFrame);
 	static void RenderMain(int64_t iCommandBuffer, const Frame& __restrict rFrame);
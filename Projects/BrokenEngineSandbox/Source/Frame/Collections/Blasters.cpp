@@ -206,6 +206,7 @@ void Blasters::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unu
 void XM_CALLCONV Blasters::CollisionEffect(Frame& __restrict rFrame, int64_t i, bool bSmoke)
 {
 	Blasters& rCurrent = rFrame.blasters;
+	common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomBlastersEffects, i);
 
 	auto vecPosition = rCurrent.pVecPositions[i];
 
@@ -237,8 +238,8 @@ void XM_CALLCONV Blasters::CollisionEffect(Frame& __restrict rFrame, int64_t i,
 		},
 		.pObjectInfos =
 		{
-			{.vecPosition = vecPosition, .fVisibleArea = 0.5f, .fVisibleIntensity = 2.0f, .fLightingArea = 1.25f, .fLightingIntensity = 2000.0f, .crc = data::kTexturesBlasterBC71pngCrc, .fRotation = common::Random<XM_2PI>(rFrame.randomEngine)},
-			{.vecPosition = vecPosition, .fVisibleArea = 0.0f, .fVisibleIntensity = 2.0f, .fLightingArea = 0.0f, .fLightingIntensity = 2000.0f, .crc = data::kTexturesBlasterBC71pngCrc, .fRotation = common::Random<XM_2PI>(rFrame.randomEngine)},
+			{.vecPosition = vecPosition, .fVisibleArea = 0.5f, .fVisibleIntensity = 2.0f, .fLightingArea = 1.25f, .fLightingIntensity = 2000.0f, .crc = data::kTexturesBlasterBC71pngCrc, .fRotation = common::Random<XM_2PI>(randomStream)},
+			{.vecPosition = vecPosition, .fVisibleArea = 0.0f, .fVisibleIntensity = 2.0f, .fLightingArea = 0.0f, .fLightingIntensity = 2000.0f, .crc = data::kTexturesBlasterBC71pngCrc, .fRotation = common::Random<XM_2PI>(randomStream)},
 		},
 	});
 }
@@ -261,6 +262,8 @@ void Blasters::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused
 			continue;
 		}
 
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomBlastersCollide, i);
+
 		auto vecInitialPosition = rPreviousFrame.blasters.pVecPositions[i];
 		static constexpr int64_t kiSteps = 32;
 		static constexpr float kfStepPercent = 1.0f / static_cast<float>(kiSteps);
@@ -278,7 +281,7 @@ void Blasters::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused
 		}
 
 		static constexpr float kfJitterPosition = 0.25f;
-		vecCollisionPosition = XMVectorAdd(XMVectorSet(-kfJitterPosition + common::Random<2.0f * kfJitterPosition>(rFrame.randomEngine), -kfJitterPosition + common::Random<2.0f * kfJitterPosition>(rFrame.randomEngine), 0.0f, 0.0f), vecCollisionPosition);
+		vecCollisionPosition = XMVectorAdd(XMVectorSet(-kfJitterPosition + common::Random<2.0f * kfJitterPosition>(randomStream), -kfJitterPosition + common::Random<2.0f * kfJitterPosition>(randomStream), 0.0f, 0.0f), vecCollisionPosition);
 
 		static constexpr float kfExplosionSize = 0.7f;
 		static constexpr float kfExplosionTime = 0.1f;
@@ -294,7 +297,7 @@ void Blasters::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused
 			},
 			.pObjectInfos =
 			{
-				{.vecPosition = vecCollisionPosition, .uiColor = 0xFFFFFFFF, .fVisibleArea = 0.5f * kfExplosionSize, .fVisibleIntensity = 2.0f, .fLightingArea = 2.0f * kfExplosionSize, .fLightingIntensity = kfTerrainCraterIntensityImpact, .crc = data::kTexturesBlasterBC7TerrainImpactpngCrc, .fRotation = common::Random<XM_2PI>(rFrame.randomEngine)},
+				{.vecPosition = vecCollisionPosition, .uiColor = 0xFFFFFFFF, .fVisibleArea = 0.5f * kfExplosionSize, .fVisibleIntensity = 2.0f, .fLightingArea = 2.0f * kfExplosionSize, .fLightingIntensity = kfTerrainCraterIntensityImpact, .crc = data::kTexturesBlasterBC7TerrainImpactpngCrc, .fRotation = common::Random<XM_2PI>(randomStream)},
 				{.vecPosition = vecCollisionPosition, .uiColor = 0xFFFFFFFF, .fVisibleArea = 0.3f * kfExplosionSize, .fVisibleIntensity = 1.0f, .fLightingArea = 2.0f * kfExplosionSize, .fLightingIntensity = kfTerrainCraterIntensityGlow,   .crc = data::kTexturesBlasterBC7TerrainImpactpngCrc, .fRotation = 0.0f},
 				{.vecPosition = vecCollisionPosition, .uiColor = 0xFFFFFFFF, .fVisibleArea = 0.2f * kfExplosionSize, .fVisibleIntensity = 0.0f, .fLightingArea = 2.0f * kfExplosionSize, .fLightingIntensity = 0.0f,                           .crc = data::kTexturesBlasterBC7TerrainImpactpngCrc, .fRotation = 0.0f},
 			},
@@ -311,7 +314,7 @@ void Blasters::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused
 			.pObjectInfos =
 			{
 				{.vecPosition = vecCollisionPosition, .fIntensity = 2.0f / (kfExplosionTime * kfExplosionSize), .fArea = kfExplosionSize / 4.0f, .fCookie = 4.0f},
-				{.vecPosition = vecCollisionPosition, .fIntensity = 0.5f / (kfExplosionTime * kfExplosionSize), .fArea = kfExplosionSize / 3.0f + (kfExplosionSize / 3.0f) * common::Random(rFrame.randomEngine), .fCookie = 4.0f},
+				{.vecPosition = vecCollisionPosition, .fIntensity = 0.5f / (kfExplosionTime * kfExplosionSize), .fArea = kfExplosionSize / 3.0f + (kfExplosionSize / 3.0f) * common::Random(randomStream), .fCookie = 4.0f},
 			},
 		});
 
@@ -351,7 +354,8 @@ void Blasters::Spawn([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused]]
 		rCurrent.pfDamages[i] = rCurrent.pSpawns[j].fDamage;
 		static constexpr float kfPitchMin = 0.75f;
 		static constexpr float kfPitchRandom = 0.5f;
-		rCurrent.pfPitches[i] = kfPitchMin + common::Random<kfPitchRandom>(rFrame.randomEngine);
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomBlastersSpawn, i);
+		rCurrent.pfPitches[i] = kfPitchMin + common::Random<kfPitchRandom>(randomStream);
 		rCurrent.puiSounds[i] = 0;
 		rCurrent.pf4Decays[i] = rCurrent.pSpawns[j].f4Decays;
 	}
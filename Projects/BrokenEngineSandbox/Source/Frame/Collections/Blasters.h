@@ -79,6 +79,16 @@ struct alignas(64) Blasters : public engine::Spawnable<SpawnBlaster, kiMaxSpawnB
 	static void Destroy(Frame& __restrict rFrame, int64_t i);
 	static void Destroy(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 
+	static constexpr engine::PhaseAccess kPostRenderAccess {.uiWrites = engine::kAccessSounds | kAccessBlasters, .bConcurrent = true};
+	static constexpr engine::PhaseAccess kCollideAccess
+	{
+		.uiReads = engine::kAccessGlobal,
+		.uiWrites = engine::kAccessPointLights | engine::kAccessPuffs | kAccessBlasters,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kSpawnAccess {.uiWrites = kAccessBlasters};
+	static constexpr engine::PhaseAccess kDestroyAccess {.uiWrites = engine::kAccessAreaLights | engine::kAccessSounds | kAccessBlasters};
+
 	// Render
 	static void RenderGlobal(int64_t iCommandBuffer, const Frame& __restrict rFrame);
 	static void RenderMain(int64_t iCommandBuffer, const Frame& __restrict rFrame);
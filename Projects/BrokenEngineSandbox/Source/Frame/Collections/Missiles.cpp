@@ -228,7 +228,7 @@ void Missiles::Interpolate([[maybe_unused]] Frame& __restrict rFrame, [[maybe_un
 	}
 }
 
-void XM_CALLCONV SpawnMissileExplosion(Frame& __restrict rFrame, float fPercent, FXMVECTOR vecPosition, FXMVECTOR vecDirection, MissileFlags_t flags)
+void XM_CALLCONV SpawnMissileExplosion(Frame& __restrict rFrame, common::RandomStream& rRandomStream, float fPercent, FXMVECTOR vecPosition, FXMVECTOR vecDirection, MissileFlags_t flags)
 {
 	ASSERT(fPercent > 0.0f);
 
@@ -240,7 +240,7 @@ void XM_CALLCONV SpawnMissileExplosion(Frame& __restrict rFrame, float fPercent,
 		.vecDirection = vecDirection,
 		.uiParticleCount = static_cast<uint32_t>(fPercent * (flags & kDirectional ? 0.6f : 1.0f) * kfExplosionParticleCount),
 		.fParticleAngle = flags & kDirectional ? XM_PI : XM_2PI,
-		.uiTrailCount = static_cast<uint32_t>(fPercent * (kfExplosionTrailCountMin + common::Random<kfExplosionTrailCountRandom>(rFrame.randomEngine))),
+		.uiTrailCount = static_cast<uint32_t>(fPercent * (kfExplosionTrailCountMin + common::Random<kfExplosionTrailCountRandom>(rRandomStream))),
 		.fTrailAngle = XM_PI,
 		.fLightPercent = 1.0f,
 		.fPusherPercent = 0.0f,
@@ -257,6 +257,8 @@ void Missiles::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unu
 
 	for (int64_t i = 0; i < rCurrent.iCount; ++i)
 	{
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomMissilesPostRender, i);
+
 		// Load
 		MissileFlags_t flags = rPrevious.pFlags[i];
 		auto vecVelocity = rPrevious.pVecVelocities[i];
@@ -296,14 +298,14 @@ void Missiles::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unu
 		// Jitter direction
 		if (fNextJitter < 0.0f)
 		{
-			fNextJitter = common::Random<kfJitterIntervalRandom>(rFrame.randomEngine);
+			fNextJitter = common::Random<kfJitterIntervalRandom>(randomStream);
 
-			uint32_t uiRandom = common::Random(2, rFrame.randomEngine);
+			uint32_t uiRandom = common::Random(2, randomStream);
 			float fDeltaAnglePercentExtra = 1.0f + 3.0f * fDeltaAnglePercent;
 			float fDeltaAngleJitter = uiTarget == 0 ? kfDeltaAngleJitterRandom : kfDeltaAngleJitterRandomWithTarget;
-			if (uiRandom == 0) { vecVelocity = XMVector3Rotate(vecVelocity, XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, fDeltaAnglePercentExtra * (-kfDirectionJitterRandom + common::Random<2.0f * kfDirectionJitterRandom>(rFrame.randomEngine)))); };
-			if (uiRandom == 1) { fDeltaRotation += fDeltaAnglePercentExtra * (-fDeltaAngleJitter + fDeltaAngleJitter * common::Random<2.0f>(rFrame.randomEngine)); }
-			if (uiRandom == 2) { rCurrent.pVecPositions[i] += XMVectorSet(-kfPositionJitterRandom + common::Random<2.0f * kfPositionJitterRandom>(rFrame.randomEngine), -kfPositionJitterRandom + common::Random<2.0f * kfPositionJitterRandom>(rFrame.randomEngine), 0.0f, 0.0f); }
+			if (uiRandom == 0) { vecVelocity = XMVector3Rotate(vecVelocity, XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, fDeltaAnglePercentExtra * (-kfDirectionJitterRandom + common::Random<2.0f * kfDirectionJitterRandom>(randomStream)))); };
+			if (uiRandom == 1) { fDeltaRotation += fDeltaAnglePercentExtra * (-fDeltaAngleJitter + fDeltaAngleJitter * common::Random<2.0f>(randomStream)); }
+			if (uiRandom == 2) { rCurrent.pVecPositions[i] += XMVectorSet(-kfPositionJitterRandom + common::Random<2.0f * kfPositionJitterRandom>(randomStream), -kfPositionJitterRandom + common::Random<2.0f * kfPositionJitterRandom>(randomStream), 0.0f, 0.0f); }
 		}
 
 		// Increase delta rotation towards target
@@ -336,8 +338,8 @@ void Missiles::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unu
 			fExplosionTime = kfDestroyExplosionInterval;
 
 			float fPercent = std::max(rCurrent.pfDestroyedTimes[i] / kfDestroyTime, 0.1f);
-			auto vecPosition = XMVectorAdd(fExplosionRadius * XMVectorSet(-kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(rFrame.randomEngine), -kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(rFrame.randomEngine), 0.0f, 0.0f), rCurrent.pVecPositions[i]);
-			SpawnMissileExplosion(rFrame, fPercent, vecPosition, vecExplosionDirections, flags);
+			auto vecPosition = XMVectorAdd(fExplosionRadius * XMVectorSet(-kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(randomStream), -kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(randomStream), 0.0f, 0.0f), rCurrent.pVecPositions[i]);
+			SpawnMissileExplosion(rFrame, randomStream, fPercent, vecPosition, vecExplosionDirections, flags);
 		}
 
 		// Apply pushers (at reduced intensity)
@@ -412,7 +414,8 @@ void Missiles::Explode(Frame& __restrict rFrame, const FrameInput& __restrict rF
 
 	rFrame.targets.Remove(rFrame, rCurrent.puiTargets[i], engine::TargetFlags::kSubscriber);
 
-	SpawnMissileExplosion(rFrame, 1.0f, rCurrent.pVecPositions[i], rCurrent.pVecExplosionDirections[i], rCurrent.pFlags[i]);
+	common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomMissilesExplode, i);
+	SpawnMissileExplosion(rFrame, randomStream, 1.0f, rCurrent.pVecPositions[i], rCurrent.pVecExplosionDirections[i], rCurrent.pFlags[i]);
 }
 
 void Missiles::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused]] const Frame& __restrict rPreviousFrame, [[maybe_unused]] const FrameInput& __restrict rFrameInput, [[maybe_unused]] float fDeltaTime)
@@ -546,6 +549,7 @@ void Missiles::Spawn([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused]]
 		}
 
 		int64_t i = rCurrent.iCount++;
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomMissilesSpawn, i);
 
 		rCurrent.pVecPositions[i] = rCurrent.pSpawns[j].vecPosition;
 		rCurrent.pVecDirections[i] = rCurrent.pSpawns[j].vecDirection;
@@ -560,17 +564,17 @@ void Missiles::Spawn([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused]]
 		rCurrent.puiTargets[i] = rCurrent.pSpawns[j].uiTarget;
 		rCurrent.pfExplosionRadii[i] = 0.0f;
 		rCurrent.pfTimes[i] = 0.0f;
-		rCurrent.pfDeltaRotationDelays[i] = 0.5f * kfDeltaRotationDelay + common::Random<kfDeltaRotationDelay>(rFrame.randomEngine);
+		rCurrent.pfDeltaRotationDelays[i] = 0.5f * kfDeltaRotationDelay + common::Random<kfDeltaRotationDelay>(randomStream);
 		rCurrent.pfDeltaRotations[i] = 0.0f;
 		rCurrent.pfExaustDelays[i] = kfExhaustDelay;
 		rCurrent.pfNextJitter[i] = 0.0f;
-		rCurrent.pfDeltaRotationMax[i] = kfDeltaRotationLimitMin + common::Random<kfDeltaRotationLimitRandom>(rFrame.randomEngine);
+		rCurrent.pfDeltaRotationMax[i] = kfDeltaRotationLimitMin + common::Random<kfDeltaRotationLimitRandom>(randomStream);
 		rCurrent.pfDestroyedTimes[i] = 0;
 		rCurrent.pfExplosionTimes[i] = 0;
 		rCurrent.pfAccelerations[i] = rCurrent.pSpawns[j].fAcceleration;
 		static constexpr float kfPitchMin = 0.75f;
 		static constexpr float kfPitchRandom = 0.5f;
-		rCurrent.pfPitches[i] = kfPitchMin + common::Random<kfPitchRandom>(rFrame.randomEngine);
+		rCurrent.pfPitches[i] = kfPitchMin + common::Random<kfPitchRandom>(randomStream);
 		rCurrent.puiSounds[i] = 0;
 	}
 
@@ -85,6 +85,20 @@ struct alignas(64) Missiles : public engine::Spawnable<SpawnMissile, kiMaxSpawnM
 	static void Destroy(Frame& __restrict rFrame, int64_t i);
 	static void Destroy(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 
+	static constexpr engine::PhaseAccess kPostRenderAccess
+	{
+		.uiWrites = engine::kAccessSpawnExplosions | engine::kAccessSounds | engine::kAccessTargets | kAccessMissiles,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kCollideAccess
+	{
+		.uiReads = engine::kAccessGlobal,
+		.uiWrites = engine::kAccessAreas | engine::kAccessBillboards | engine::kAccessSpawnExplosions | engine::kAccessTargets | kAccessBlasters | kAccessMissiles | kAccessPlayer | kAccessSpaceships,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kSpawnAccess {.uiWrites = kAccessMissiles};
+	static constexpr engine::PhaseAccess kDestroyAccess {.uiWrites = engine::kAccessAreaLights | engine::kAccessPushers | engine::kAccessSounds | engine::kAccessTargets | engine::kAccessTrails | kAccessMissiles};
+
 	// Render
 	static void RenderGlobal(int64_t iCommandBuffer, const Frame& __restrict rFrame);
 	static void RenderMain(int64_t iCommandBuffer, const Frame& __restrict rFrame);
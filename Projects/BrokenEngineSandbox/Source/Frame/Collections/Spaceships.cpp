@@ -255,15 +255,15 @@ void Spaceships::Interpolate([[maybe_unused]] Frame& __restrict rFrame, [[maybe_
 	}
 }
 
-void XM_CALLCONV SpawnSpaceshipExplosion(Frame& __restrict rFrame, int64_t i, float fPercent, FXMVECTOR vecDirection)
+void XM_CALLCONV SpawnSpaceshipExplosion(Frame& __restrict rFrame, common::RandomStream& rRandomStream, int64_t i, float fPercent, FXMVECTOR vecDirection)
 {
 	Spaceships& rCurrent = rFrame.spaceships;
 
 	static constexpr float kfPositionJitter = 0.75f;
-	auto vecPosition = XMVectorAdd(XMVectorSet(-kfPositionJitter + common::Random<2.0f * kfPositionJitter>(rFrame.randomEngine), -kfPositionJitter + common::Random<2.0f * kfPositionJitter>(rFrame.randomEngine), 0.0f, 0.0f), rCurrent.pVecPositions[i]);
+	auto vecPosition = XMVectorAdd(XMVectorSet(-kfPositionJitter + common::Random<2.0f * kfPositionJitter>(rRandomStream), -kfPositionJitter + common::Random<2.0f * kfPositionJitter>(rRandomStream), 0.0f, 0.0f), rCurrent.pVecPositions[i]);
 
 	static constexpr float kfDirectionJitter = 0.5f;
-	auto vecFinalDirection = XMVector3Normalize(XMVectorAdd(XMVectorSet(-kfDirectionJitter + common::Random<2.0f * kfDirectionJitter>(rFrame.randomEngine), -kfDirectionJitter + common::Random<2.0f * kfDirectionJitter>(rFrame.randomEngine), 0.0f, 0.0f), vecDirection));
+	auto vecFinalDirection = XMVector3Normalize(XMVectorAdd(XMVectorSet(-kfDirectionJitter + common::Random<2.0f * kfDirectionJitter>(rRandomStream), -kfDirectionJitter + common::Random<2.0f * kfDirectionJitter>(rRandomStream), 0.0f, 0.0f), vecDirection));
 
 	engine::explosion_t uiExplosion = 0;
 	rFrame.explosions.Add(uiExplosion, rFrame,
@@ -292,6 +292,8 @@ void Spaceships::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_u
 
 	for (int64_t i = 0; i < rCurrent.iCount; ++i)
 	{
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomSpaceshipsPostRender, i);
+
 		// Load
 		auto vecVelocity = rPrevious.pVecVelocities[i];
 		float fDeltaRotation = rPrevious.pfDeltaRotations[i];
@@ -394,14 +396,14 @@ void Spaceships::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_u
 			fDestroyedExplosionTime = kfDestroyExplosionInterval;
 
 			float fPercent = rCurrent.pfDestroyedTimes[i] / kfDestroyTime;
-			SpawnSpaceshipExplosion(rFrame, i, fPercent, XMVector3Normalize(vecVelocity));
+			SpawnSpaceshipExplosion(rFrame, randomStream, i, fPercent, XMVector3Normalize(vecVelocity));
 		}
 
 		// Spawn damage particles
 		if (!(rCurrent.pFlags[i] & kExploding) && fHealth < 0.5f)
 		{
 			float fPercent = rPrevious.pfHealths[i] / (0.5f * EnemyHealthMultiplier(rFrame) * kfSpaceshipHealth);
-			SpawnDamageParticles(rFrame, rCurrent.pVecPositions[i], rCurrent.pVecDirections[i], fPercent);
+			SpawnDamageParticles(rFrame, randomStream, rCurrent.pVecPositions[i], rCurrent.pVecDirections[i], fPercent);
 		}
 
 		// Fire blasters?
@@ -427,7 +429,7 @@ void Spaceships::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_u
 
 			auto vecDirection = rCurrent.pVecDirections[i];
 			auto vecBlasterVelocity = XMVectorMultiply(XMVectorSet(kfBlastersSpeed, kfBlastersSpeed, 0.0f, 0.0f), XMVector3Normalize(vecDirection));
-			auto vecPosition = XMVectorAdd(rCurrent.pVecPositions[i] + kfBlastersSpawnPreMove * vecBlasterVelocity, XMVectorSet(-kfBlastersSpawnPositionJitter + common::Random<2.0f * kfBlastersSpawnPositionJitter>(rFrame.randomEngine), -kfBlastersSpawnPositionJitter + common::Random<2.0f * kfBlastersSpawnPositionJitter>(rFrame.randomEngine), 0.0f, 0.0f));
+			auto vecPosition = XMVectorAdd(rCurrent.pVecPositions[i] + kfBlastersSpawnPreMove * vecBlasterVelocity, XMVectorSet(-kfBlastersSpawnPositionJitter + common::Random<2.0f * kfBlastersSpawnPositionJitter>(randomStream), -kfBlastersSpawnPositionJitter + common::Random<2.0f * kfBlastersSpawnPositionJitter>(randomStream), 0.0f, 0.0f));
 
 			rFrame.blasters.AddSpawn(
 			{
@@ -570,9 +572,10 @@ void XM_CALLCONV Spaceships::Explode(Frame& __restrict rFrame, int64_t i, [[mayb
 	rCurrent.pfDestroyedExplosionTimes[i] = kfDestroyExplosionInterval;
 	rCurrent.pVecVelocities[i] = XMVectorMultiply(XMVectorReplicate(kfDestroyVelocity), vecDirection);
 
-	SpawnSpaceshipExplosion(rFrame, i, 1.0f, XMVector3Normalize(vecDirection));
+	common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomSpaceshipsExplode, i);
+	SpawnSpaceshipExplosion(rFrame, randomStream, i, 1.0f, XMVector3Normalize(vecDirection));
 
-	Frame::SpawnPickup(rFrame, rCurrent.pVecPositions[i], kfSpaceshipArmorShardChance);
+	Frame::SpawnPickup(rFrame, randomStream, rCurrent.pVecPositions[i], kfSpaceshipArmorShardChance);
 }
 
 void Spaceships::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused]] const Frame& __restrict rPreviousFrame, [[maybe_unused]] const FrameInput& __restrict rFrameInput, [[maybe_unused]] float fDeltaTime)
@@ -62,6 +62,21 @@ struct alignas(64) Spaceships
 	static void Spawn(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 	static void Destroy(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 
+	static constexpr engine::PhaseAccess kPostRenderAccess
+	{
+		.uiReads = engine::kAccessGlobal,
+		.uiWrites = engine::kAccessSpawnExplosions | engine::kAccessPullers | kAccessCamera | kAccessPlayer | kAccessBlasters | kAccessSpaceships,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kCollideAccess
+	{
+		.uiReads = engine::kAccessGlobal,
+		.uiWrites = engine::kAccessAreas | engine::kAccessBillboards | engine::kAccessSpawnExplosions | engine::kAccessTargets | kAccessCamera | kAccessPlayer | kAccessBlasters | kAccessMissiles | kAccessSpaceships,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kSpawnAccess {};
+	static constexpr engine::PhaseAccess kDestroyAccess {.uiWrites = engine::kAccessBillboards | engine::kAccessPushers | engine::kAccessTargets | engine::kAccessTrails | kAccessSpaceships};
+
 	// Render
 	static void RenderGlobal(int64_t iCommandBuffer, const Frame& __restrict rFrame);
 	static void RenderMain(int64_t iCommandBuffer, const Frame& __restrict rFrame);
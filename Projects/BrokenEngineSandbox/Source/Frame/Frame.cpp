@@ -387,13 +387,20 @@ void XM_CALLCONV Frame::BlasterImpact(Frame& __restrict rFrame, int64_t i, Direc
 	ASSERT(XMVectorGetZ(rFrame.blasters.pVecVelocities[i]) == 0.0f);
 }
 
-void XM_CALLCONV Frame::SpawnPickup(Frame& __restrict rFrame, DirectX::FXMVECTOR vecPosition, float fChance, bool bForce)
+void XM_CALLCONV Frame::SpawnPickup(Frame& __restrict rFrame, common::RandomStream& rRandomStream, DirectX::FXMVECTOR vecPosition, float fChance, bool bForce)
 {
-	if (!bForce && common::Random(rFrame.randomEngine) > fChance)
+	if (!bForce && common::Random(rRandomStream) > fChance)
 	{
 		return;
 	}
 
+	Player& rPlayer = rFrame.player;
+	if (rPlayer.armorPickups.Full()) [[unlikely]]
+	{
+		engine::billboard_t uiOldest = rPlayer.armorPickups.TakeOldest();
+		rFrame.billboards.Remove(uiOldest);
+	}
+
 	engine::billboard_t uiBillboard = 0;
 	rFrame.billboards.Add(uiBillboard,
 	{
@@ -404,6 +411,14 @@ void XM_CALLCONV Frame::SpawnPickup(Frame& __restrict rFrame, DirectX::FXMVECTOR
 		.fRotation = 0.0f,
 		.vecPosition = vecPosition,
 	});
+
+	// A full billboard pool already broke in Add()
+	if (uiBillboard == 0) [[unlikely]]
+	{
+		return;
+	}
+
+	rPlayer.armorPickups.Add(uiBillboard);
 }
 
 void Frame::End(Frame& __restrict rFrame, bool bRemoveAutosave)
@@ -415,7 +430,27 @@ void Frame::End(Frame& __restrict rFrame, bool bRemoveAutosave)
 	}
 }
 
-void XM_CALLCONV SpawnDamageParticles(Frame& __restrict rFrame, DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecDirection, float fPercent)
+void Frame::HashAccess(const Frame& rFrame, uint64_t uiAccess, engine::access_hashes_t& rHashes)
+{
+	engine::HashAccess(rFrame, uiAccess, rHashes);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.flags);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.fEndTime);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.fWaveDisplayTimeLeft);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.bNextWave);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.iWave);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.iLastSpawn);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.iClumpsLeft);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.iClumpSize);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.iNextClumpSpawn);
+	engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.fNextClumpSpawnTime);
+	engine::HashMember(rHashes, uiAccess, kAccessCamera, rFrame.camera);
+	engine::HashMember(rHashes, uiAccess, kAccessPlayer, rFrame.player);
+	engine::HashMember(rHashes, uiAccess, kAccessBlasters, rFrame.blasters);
+	engine::HashMember(rHashes, uiAccess, kAccessMissiles, rFrame.missiles);
+	engine::HashMember(rHashes, uiAccess, kAccessSpaceships, rFrame.spaceships);
+}
+
+void XM_CALLCONV SpawnDamageParticles(Frame& __restrict rFrame, common::RandomStream& rRandomStream, DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecDirection, float fPercent)
 {
 	static constexpr int32_t kiDamageParticleCount = 1;
 	static constexpr float kfDamageParticlePositionJitter = 0.2f;
@@ -436,25 +471,25 @@ void XM_CALLCONV SpawnDamageParticles(Frame& __restrict rFrame, DirectX::FXMVECT
 
 	for (int64_t j = 0; j < kiDamageParticleCount; ++j)
 	{
-		int32_t iDamageParticleCookie = 36 + common::Random(3, rFrame.randomEngine);
+		int32_t iDamageParticleCookie = 36 + common::Random(3, rRandomStream);
 
 		auto vecDamageParticlePosition = XMVectorMultiplyAdd(XMVectorReplicate(0.75f * kfDamageParticleOffset), vecDirection, vecPosition);
-		vecDamageParticlePosition = XMVectorAdd(vecDamageParticlePosition, XMVectorSet(-kfDamageParticlePositionJitter + common::Random<2.0f * kfDamageParticlePositionJitter>(rFrame.randomEngine), -kfDamageParticlePositionJitter + common::Random<2.0f * kfDamageParticlePositionJitter>(rFrame.randomEngine), -kfDamageParticlePositionJitter + common::Random<2.0f * kfDamageParticlePositionJitter>(rFrame.randomEngine), 0.0f));
+		vecDamageParticlePosition = XMVectorAdd(vecDamageParticlePosition, XMVectorSet(-kfDamageParticlePositionJitter + common::Random<2.0f * kfDamageParticlePositionJitter>(rRandomStream), -kfDamageParticlePositionJitter + common::Random<2.0f * kfDamageParticlePositionJitter>(rRandomStream), -kfDamageParticlePositionJitter + common::Random<2.0f * kfDamageParticlePositionJitter>(rRandomStream), 0.0f));
 		XMFLOAT4A f4Position {};
 		XMStoreFloat4A(&f4Position, vecDamageParticlePosition);
 
-		auto vecDamageParticleVelocity = XMVectorSet(-kfDamageParticleVelocityJitter + common::Random<2.0f * kfDamageParticleVelocityJitter>(rFrame.randomEngine), -kfDamageParticleVelocityJitter + common::Random<2.0f * kfDamageParticleVelocityJitter>(rFrame.randomEngine), -kfDamageParticleVelocityJitter + common::Random<2.0f * kfDamageParticleVelocityJitter>(rFrame.randomEngine), 0.0f);
+		auto vecDamageParticleVelocity = XMVectorSet(-kfDamageParticleVelocityJitter + common::Random<2.0f * kfDamageParticleVelocityJitter>(rRandomStream), -kfDamageParticleVelocityJitter + common::Random<2.0f * kfDamageParticleVelocityJitter>(rRandomStream), -kfDamageParticleVelocityJitter + common::Random<2.0f * kfDamageParticleVelocityJitter>(rRandomStream), 0.0f);
 		XMFLOAT4A f4Velocity {};
 		XMStoreFloat4A(&f4Velocity, vecDamageParticleVelocity);
 
-		uint32_t uiParticleColor = 0xFF0000FF | ((25 + common::Random(125, rFrame.randomEngine)) << 16) | ((common::Random(50, rFrame.randomEngine)) << 8);
+		uint32_t uiParticleColor = 0xFF0000FF | ((25 + common::Random(125, rRandomStream)) << 16) | ((common::Random(50, rRandomStream)) << 8);
 
 		engine::ParticleManager::Spawn(engine::gpParticleManager->mSquareParticlesSpawnLayout,
 		{
 			.i4Misc = {static_cast<int32_t>(uiParticleColor), iDamageParticleCookie, static_cast<int32_t>(kfDamageParticleLightingIntesnity), 0},
 			.f4MiscOne = {kfDamageParticleVelocityDecay, 0.0f, kfDamageParticleIntensityDecayMin, kfDamageParticleLightingSize},
-			.f4MiscTwo = {kfDamageParticleSizeMin + common::Random<kfDamageParticleSizeRandom>(rFrame.randomEngine), 0.0f, kfDamageParticleIntensityMin + (1.0f - fPercent) * common::Random<kfDamageParticleIntensityRandom>(rFrame.randomEngine), kfDamageParticleIntensityPower},
-			.f4MiscThree = {kfDamageParticleSizeDecay, -kfDamageParticleRotationDelta + common::Random<2.0f * kfDamageParticleRotationDelta>(rFrame.randomEngine), common::Random<XM_2PI>(rFrame.randomEngine), kfDamageParticleRotationDeltaDecay},
+			.f4MiscTwo = {kfDamageParticleSizeMin + common::Random<kfDamageParticleSizeRandom>(rRandomStream), 0.0f, kfDamageParticleIntensityMin + (1.0f - fPercent) * common::Random<kfDamageParticleIntensityRandom>(rRandomStream), kfDamageParticleIntensityPower},
+			.f4MiscThree = {kfDamageParticleSizeDecay, -kfDamageParticleRotationDelta + common::Random<2.0f * kfDamageParticleRotationDelta>(rRandomStream), common::Random<XM_2PI>(rRandomStream), kfDamageParticleRotationDeltaDecay},
 			.f4Position = f4Position,
 			.f4Velocity = f4Velocity,
 		});
@@ -3,6 +3,7 @@
 #include "Frame/HealthDamage.h"
 
 #include "Frame/FrameBase.h"
+#include "Frame/FrameAccess.h"
 
 #include "Frame/Collections/Blasters.h"
 #include "Frame/Collections/Missiles.h"
@@ -48,6 +49,22 @@ enum class FrameFlags : uint64_t
 };
 using FrameFlags_t = common::Flags<FrameFlags>;
 
+// Game part of the common::RandomStream subsystem ids, UPDATE_LIST phases draw from their own streams so they don't need kAccessRandom
+enum RandomSubsystem : uint32_t
+{
+	kRandomBlastersCollide = engine::kRandomGameFirst,
+	kRandomBlastersEffects,
+	kRandomBlastersSpawn,
+	kRandomMissilesExplode,
+	kRandomMissilesPostRender,
+	kRandomMissilesSpawn,
+	kRandomPlayerBlasterImpacts,
+	kRandomPlayerCollide,
+	kRandomPlayerPostRender,
+	kRandomSpaceshipsExplode,
+	kRandomSpaceshipsPostRender,
+};
+
 inline constexpr float kfAutoDestroyDistance = 80.0f;
 inline constexpr float kfPickupSize = 0.0175f;
 
@@ -92,8 +109,9 @@ struct alignas(64) Frame : public engine::FrameBase
 	static [[nodiscard]] engine::target_t XM_CALLCONV GetMissileTarget(Frame& __restrict rFrame, const FrameInput& __restrict rFrameInput, DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecDirection, engine::TargetFlags_t targetFlags);
 	static void XM_CALLCONV AreaDamage(Frame& __restrict rFrame, const FrameInput& __restrict rFrameInput, DirectX::FXMVECTOR vecPosition, float fDamage, float fRadius);
 	static void XM_CALLCONV BlasterImpact(Frame& __restrict rFrame, int64_t i, DirectX::FXMVECTOR vecImpactPosition);
-	static void XM_CALLCONV SpawnPickup(Frame& __restrict rFrame, DirectX::FXMVECTOR vecPosition, float fChance = 1.0f, bool bForce = false);
+	static void XM_CALLCONV SpawnPickup(Frame& __restrict rFrame, common::RandomStream& rRandomStream, DirectX::FXMVECTOR vecPosition, float fChance = 1.0f, bool bForce = false);
 	static void End(Frame& __restrict rFrame, bool bRemoveAutosave);
+	static void HashAccess(const Frame& rFrame, uint64_t uiAccess, engine::access_hashes_t& rHashes);
 
 	Frame(FrameFlags_t initialFlags, engine::IslandsFlip eInitialIslandsFlip);
 	~Frame() = default;
@@ -178,7 +196,7 @@ void CollectionSlow(DirectX::FXMVECTOR vecPosition, float fRadius, float fSlow,
 	}
 }
 
-void XM_CALLCONV SpawnDamageParticles(Frame& __restrict rFrame, DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecDirection, float fPercent);
+void XM_CALLCONV SpawnDamageParticles(Frame& __restrict rFrame, common::RandomStream& rRandomStream, DirectX::FXMVECTOR vecPosition, DirectX::FXMVECTOR vecDirection, float fPercent);
 
 inline float Damage(Damages eDamage)
 {
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace game
+{
+
+// Game members of the frame, used together with engine::FrameAccess to declare what UPDATE_LIST phases touch
+// Frame level values like flags and the wave counters fall under engine::kAccessGlobal
+inline constexpr uint64_t kAccessCamera     = engine::kAccessGameFirst << 0;
+inline constexpr uint64_t kAccessPlayer     = engine::kAccessGameFirst << 1;
+inline constexpr uint64_t kAccessBlasters   = engine::kAccessGameFirst << 2;
+inline constexpr uint64_t kAccessMissiles   = engine::kAccessGameFirst << 3;
+inline constexpr uint64_t kAccessSpaceships = engine::kAccessGameFirst << 4;
+
+} // namespace game
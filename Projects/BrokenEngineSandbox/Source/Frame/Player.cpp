@@ -178,20 +178,10 @@ void Player::Interpolate([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unus
 	}
 
 	// Armor pull
-	for (decltype(rFrame.billboards.uiMaxIndex) i = 0; i <= rFrame.billboards.uiMaxIndex; ++i)
+	for (int64_t i = 0; i < rCurrent.armorPickups.iCount; ++i)
 	{
-		if (!rFrame.billboards.pbUsed[i])
-		{
-			continue;
-		}
-
-		engine::BillboardInfo& rBillboardInfo = rFrame.billboards.pObjectInfos[i];
-		engine::Billboard& rBillboard = rFrame.billboards.pObjects[i];
-		
-		if (!(rBillboardInfo.flags & engine::BillboardFlags::kTypeArmor))
-		{
-			continue;
-		}
+		engine::BillboardInfo& rBillboardInfo = rFrame.billboards.GetInfo(rCurrent.armorPickups.puiIndices[i]);
+		engine::Billboard& rBillboard = rFrame.billboards.Get(rCurrent.armorPickups.puiIndices[i]);
 
 		rBillboard.fTime += fDeltaTime;
 		if (rBillboard.fTime < kfArmorPickupDelay)
@@ -325,12 +315,12 @@ void Player::Interpolate([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unus
 	InterpolateDash(rFrame, rPreviousFrame, rFrameInputHeld, fDeltaTime);
 }
 
-void XM_CALLCONV SpawnPlayerExplosion(Frame& __restrict rFrame, float fPercent, FXMVECTOR vecDirection)
+void XM_CALLCONV SpawnPlayerExplosion(Frame& __restrict rFrame, common::RandomStream& rRandomStream, float fPercent, FXMVECTOR vecDirection)
 {
 	Player& rCurrent = rFrame.player;
 
-	auto vecPosition = XMVectorAdd(XMVectorSet(-kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(rFrame.randomEngine), -kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(rFrame.randomEngine), 0.0f, 0.0f), rCurrent.vecPosition);
-	auto vecFinalDirection = XMVector3Normalize(XMVectorAdd(XMVectorSet(-kfExplosionDirectionJitter + common::Random<2.0f * kfExplosionDirectionJitter>(rFrame.randomEngine), -kfExplosionDirectionJitter + common::Random<2.0f * kfExplosionDirectionJitter>(rFrame.randomEngine), 0.0f, 0.0f), vecDirection));
+	auto vecPosition = XMVectorAdd(XMVectorSet(-kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(rRandomStream), -kfExplosionPositionJitter + common::Random<2.0f * kfExplosionPositionJitter>(rRandomStream), 0.0f, 0.0f), rCurrent.vecPosition);
+	auto vecFinalDirection = XMVector3Normalize(XMVectorAdd(XMVectorSet(-kfExplosionDirectionJitter + common::Random<2.0f * kfExplosionDirectionJitter>(rRandomStream), -kfExplosionDirectionJitter + common::Random<2.0f * kfExplosionDirectionJitter>(rRandomStream), 0.0f, 0.0f), vecDirection));
 
 	float fAdjustedPercent = (std::pow((1.0f - fPercent) + 1.0f, 0.3f) - 1.0f) * kfExplosionsRadius;
 	vecPosition = XMVectorMultiplyAdd(vecFinalDirection, XMVectorReplicate(fAdjustedPercent), vecPosition);
@@ -531,42 +521,30 @@ void Player::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unuse
 		rCurrent.fArmor += MaxArmor(rFrame) - MaxArmor(rPreviousFrame);
 	}
 
-	// Armor pickup
-	for (decltype(rFrame.billboards.uiMaxIndex) i = 0; i <= rFrame.billboards.uiMaxIndex; ++i)
+	// Armor pickup, the pickups that are left stay in the order they were spawned
+	rCurrent.armorPickups.Compact([&](engine::billboard_t uiBillboard)
 	{
-		if (!rFrame.billboards.pbUsed[i])
-		{
-			continue;
-		}
-
-		engine::BillboardInfo& rBillboardInfo = rFrame.billboards.pObjectInfos[i];
-		engine::Billboard& rBillboard = rFrame.billboards.pObjects[i];
-
-		if (!(rBillboardInfo.flags & engine::BillboardFlags::kTypeArmor))
-		{
-			continue;
-		}
+		engine::BillboardInfo& rBillboardInfo = rFrame.billboards.GetInfo(uiBillboard);
+		engine::Billboard& rBillboard = rFrame.billboards.Get(uiBillboard);
 
 		if (rBillboardInfo.fAlpha <= 0.0f)
 		{
-			rFrame.billboards.Remove(i);
-			continue;
+			rFrame.billboards.Remove(uiBillboard);
+			return false;
 		}
 
 		float fDistance = common::Distance(rCurrent.vecPosition, rBillboardInfo.vecPosition);
 		rBillboardInfo.fSize = kfPickupSize * std::max(std::min(fDistance / kfArmorPickupSizeRadius, 1.0f), kfArmorPickupSizeMin);
 
-		if (rBillboard.fTime < kfArmorPickupDelay)
+		if (rBillboard.fTime >= kfArmorPickupDelay && fDistance < kfArmorPickupRadius)
 		{
-			continue;
-		}
-
-		if (fDistance < kfArmorPickupRadius)
-		{
-			rFrame.billboards.Remove(i);
+			rFrame.billboards.Remove(uiBillboard);
 			rCurrent.fArmor = std::min(rCurrent.fArmor + kfArmorPickupRegen, MaxArmor(rFrame));
+			return false;
 		}
-	}
+
+		return true;
+	});
 
 	// Regenerate shield
 	if (rCurrent.fShieldCooldown < 0.0f)
@@ -584,9 +562,10 @@ void Player::PostRender([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unuse
 	{
 		rCurrent.fDestroyedExplosionTime = kfDestroyExplosionInterval;
 
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomPlayerPostRender, 0);
 		float fPercent = rCurrent.fDestroyedTime / kfDestroyTime;
-		auto vecDirection = XMVector4Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(common::Random<XM_2PI>(rFrame.randomEngine)));
-		SpawnPlayerExplosion(rFrame, fPercent, vecDirection);
+		auto vecDirection = XMVector4Transform(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMMatrixRotationZ(common::Random<XM_2PI>(randomStream)));
+		SpawnPlayerExplosion(rFrame, randomStream, fPercent, vecDirection);
 	}
 
 	// Apply pushers
@@ -743,6 +722,8 @@ std::tuple<float, XMVECTOR> Player::CollideBlasters(Frame& __restrict rFrame, co
 		// Damage
 		fDamage += rFrame.blasters.pfDamages[j];
 
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomPlayerBlasterImpacts, j);
+
 		// Impact effect
 		rFrame.puffControllers2.Add(rFrame.puffs, rFrame.fCurrentTime,
 		{
@@ -769,32 +750,32 @@ std::tuple<float, XMVECTOR> Player::CollideBlasters(Frame& __restrict rFrame, co
 			},
 			.pObjectInfos =
 			{
-				{.vecPosition = vecImpactPosition, .fVisibleArea = 0.75f, .fVisibleIntensity = 1.0f, .fLightingArea = 1.5f, .fLightingIntensity = 40.0f, .crc = data::kTexturesBC7ExplosionpngCrc, .fRotation = common::Random<XM_2PI>(rFrame.randomEngine)},
-				{.vecPosition = vecImpactPosition, .fVisibleArea = 0.0f,  .fVisibleIntensity = 0.5f, .fLightingArea = 0.0f, .fLightingIntensity = 10.0f, .crc = data::kTexturesBC7ExplosionpngCrc, .fRotation = common::Random<XM_2PI>(rFrame.randomEngine)},
+				{.vecPosition = vecImpactPosition, .fVisibleArea = 0.75f, .fVisibleIntensity = 1.0f, .fLightingArea = 1.5f, .fLightingIntensity = 40.0f, .crc = data::kTexturesBC7ExplosionpngCrc, .fRotation = common::Random<XM_2PI>(randomStream)},
+				{.vecPosition = vecImpactPosition, .fVisibleArea = 0.0f,  .fVisibleIntensity = 0.5f, .fLightingArea = 0.0f, .fLightingIntensity = 10.0f, .crc = data::kTexturesBC7ExplosionpngCrc, .fRotation = common::Random<XM_2PI>(randomStream)},
 			},
 		});
 
 		for (int64_t k = 0; k < kiImpactParticleCount; ++k)
 		{
 			auto vecParticlesPosition = vecImpactPosition;
-			vecParticlesPosition = XMVectorAdd(vecParticlesPosition, XMVectorSet(-kfImpactParticlePositionRandom + common::Random<2.0f * kfImpactParticlePositionRandom>(rFrame.randomEngine), -kfImpactParticlePositionRandom + common::Random<2.0f * kfImpactParticlePositionRandom>(rFrame.randomEngine), 0.0f, 0.0f));
+			vecParticlesPosition = XMVectorAdd(vecParticlesPosition, XMVectorSet(-kfImpactParticlePositionRandom + common::Random<2.0f * kfImpactParticlePositionRandom>(randomStream), -kfImpactParticlePositionRandom + common::Random<2.0f * kfImpactParticlePositionRandom>(randomStream), 0.0f, 0.0f));
 			XMFLOAT4A f4Position {};
 			XMStoreFloat4A(&f4Position, vecParticlesPosition);
 
 			auto vecPaticlesDirection = -vecToPreviousPositionNormal;
-			auto vecVelocity = XMVectorMultiply(XMVectorReplicate(-kfImpactParticleVelocityMin - common::Random<kfImpactParticleVelocityRandom>(rFrame.randomEngine)), vecPaticlesDirection);
-			vecVelocity = XMVector3Rotate(vecVelocity, XMQuaternionRotationRollPitchYaw(-0.5f * kfImpactParticleAngle + common::Random<kfImpactParticleAngle>(rFrame.randomEngine), -0.5f * kfImpactParticleAngle + common::Random<kfImpactParticleAngle>(rFrame.randomEngine), -0.5f * kfImpactParticleAngle + common::Random<kfImpactParticleAngle>(rFrame.randomEngine)));
-			vecVelocity = XMVectorSetZ(vecVelocity, common::Random<kfImpactParticleVerticalVelocity>(rFrame.randomEngine));
+			auto vecVelocity = XMVectorMultiply(XMVectorReplicate(-kfImpactParticleVelocityMin - common::Random<kfImpactParticleVelocityRandom>(randomStream)), vecPaticlesDirection);
+			vecVelocity = XMVector3Rotate(vecVelocity, XMQuaternionRotationRollPitchYaw(-0.5f * kfImpactParticleAngle + common::Random<kfImpactParticleAngle>(randomStream), -0.5f * kfImpactParticleAngle + common::Random<kfImpactParticleAngle>(randomStream), -0.5f * kfImpactParticleAngle + common::Random<kfImpactParticleAngle>(randomStream)));
+			vecVelocity = XMVectorSetZ(vecVelocity, common::Random<kfImpactParticleVerticalVelocity>(randomStream));
 			XMFLOAT4A f4Velocity {};
 			XMStoreFloat4A(&f4Velocity, vecVelocity);
 
-			uint32_t uiParticleColor = 0xFF0000FF | ((0 + common::Random(70, rFrame.randomEngine)) << 16);
+			uint32_t uiParticleColor = 0xFF0000FF | ((0 + common::Random(70, randomStream)) << 16);
 
 			engine::ParticleManager::Spawn(engine::gpParticleManager->mLongParticlesSpawnLayout,
 			{
 				.i4Misc = {static_cast<int32_t>(uiParticleColor), kiImpactParticleCookie, static_cast<int32_t>(kfImpactParticleLightingIntesnity), 0},
 				.f4MiscOne = {kfImpactParticleVelocityDecay, kfImpactParticleGravity, kfImpactParticleIntensityDecay, kfImpactParticleLightingSize},
-				.f4MiscTwo = {kfImpactParticleWidth, kfImpactParticleLength, kfImpactParticleIntensityMin + common::Random<kfImpactParticleIntensityRandom>(rFrame.randomEngine), kfImpactParticleIntensityPower},
+				.f4MiscTwo = {kfImpactParticleWidth, kfImpactParticleLength, kfImpactParticleIntensityMin + common::Random<kfImpactParticleIntensityRandom>(randomStream), kfImpactParticleIntensityPower},
 				.f4MiscThree = {},
 				.f4Position = f4Position,
 				.f4Velocity = f4Velocity,
@@ -846,7 +827,8 @@ void Player::Collide([[maybe_unused]] Frame& __restrict rFrame, [[maybe_unused]]
 		rCurrent.fDestroyedTime = kfDestroyTime;
 		rCurrent.fDestroyedExplosionTime = kfDestroyExplosionInterval;
 
-		SpawnPlayerExplosion(rFrame, 1.0f, XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f));
+		common::RandomStream randomStream = engine::FrameRandomStream(rFrame, kRandomPlayerCollide, 0);
+		SpawnPlayerExplosion(rFrame, randomStream, 1.0f, XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f));
 
 		Frame::End(rFrame, true);
 	}
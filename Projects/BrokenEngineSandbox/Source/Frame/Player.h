@@ -2,6 +2,7 @@
 
 #include "Frame/HealthDamage.h"
 #include "Frame/Pools/Lighting.h"
+#include "Frame/Pools/PoolIndexList.h"
 #include "Frame/Pools/Smoke.h"
 
 namespace engine
@@ -23,6 +24,9 @@ enum class PlayerFlags : uint8_t
 using PlayerFlags_t = common::Flags<PlayerFlags>;
 
 constexpr float kfMissileDamagePlayerRadius = 1.5f;
+// Pickups only drop from one in ten destroyed spaceships and are gone about 2.5 seconds later unless pulled in, filling this takes thousands of kills in that time
+// SpawnPickup() removes the oldest one to make room if it does fill
+constexpr int64_t kiMaxArmorPickups = 256;
 
 struct alignas(64) Player
 {
@@ -72,6 +76,9 @@ struct alignas(64) Player
 
 	float fShieldDownSoundCooldown = 0.0f;
 
+	// Armor pickup billboards in the order they were spawned, so picking them up doesn't need a sweep over the whole billboard pool
+	engine::PoolIndexList<engine::billboard_t, kiMaxArmorPickups> armorPickups;
+
 	float fDestroyedTime = 0.0f;
 	float fDestroyedExplosionTime = 0.0f;
 
@@ -98,6 +105,21 @@ struct alignas(64) Player
 
 	static void Destroy(Frame& __restrict rFrame, const Frame& __restrict rPreviousFrame, const FrameInput& __restrict rFrameInput, float fDeltaTime);
 
+	static constexpr engine::PhaseAccess kPostRenderAccess
+	{
+		.uiReads = engine::kAccessGlobal,
+		.uiWrites = engine::kAccessGlobal | engine::kAccessBillboards | engine::kAccessSpawnExplosions | engine::kAccessTargets | kAccessPlayer | kAccessBlasters | kAccessMissiles,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kCollideAccess
+	{
+		.uiReads = engine::kAccessGlobal,
+		.uiWrites = engine::kAccessGlobal | engine::kAccessBillboards | engine::kAccessSpawnExplosions | engine::kAccessTargets | kAccessCamera | kAccessPlayer | kAccessBlasters | kAccessMissiles | kAccessSpaceships,
+		.bConcurrent = true,
+	};
+	static constexpr engine::PhaseAccess kSpawnAccess {};
+	static constexpr engine::PhaseAccess kDestroyAccess {};
+
 	// Render
 	static void RenderGlobal(int64_t iCommandBuffer, const Frame& __restrict rFrame);
 	static void RenderMain(int64_t iCommandBuffer, const Frame& __restrict rFrame);
@@ -80,6 +80,7 @@ bool Game::Update(const engine::RawInput& rRawInput, bool bLostFocus)
 #if defined(ENABLE_DEBUG_INPUT)
 	if (gpGame->meUiState == UiState::kTweaks)
 	{
+		SynchronizeSimulation();
 		CurrentFrame().fSunAngle = engine::gSunAngleOverride.Get();
 	}
 
@@ -88,6 +89,7 @@ bool Game::Update(const engine::RawInput& rRawInput, bool bLostFocus)
 	if (!bUpdateFrame) [[unlikely]]
 #endif
 	{
+		SynchronizeSimulation();
 		engine::gpRawInputManager->SetVibration(0, 0.0f, 0.0f);
 		engine::gpGraphics->RenderMainImagePresentAcquire(CurrentFrame());
 		return true;
@@ -112,7 +114,7 @@ void Game::Reset()
 	mpDifferenceStreamWriter.reset();
 	mpDifferenceStreamReader.reset();
 
-	engine::gSunAngleOverride.Reset(mpCurrentFrame->fSunAngle);
+	engine::gSunAngleOverride.Reset(CurrentFrame().fSunAngle);
 
 	engine::gbSmokeClear = true;
 
@@ -148,6 +150,8 @@ void Game::EndReplay(FrameInput& rFrameInput)
 
 void Game::Restart()
 {
+	SynchronizeSimulation();
+
 	new (&CurrentFrame()) Frame(kGame, NextIslandsFlip());
 	
 	Reset();
@@ -163,6 +167,8 @@ void Game::ChangeFrame(FrameFlags_t flags)
 		return;
 	}
 
+	SynchronizeSimulation();
+
 	mbMainMenuMusic = flags & kMainMenu;
 
 	WriteAutosave();
@@ -193,6 +199,8 @@ void Game::WriteAutosave()
 		return;
 	}
 
+	SynchronizeSimulation();
+
 	if (CurrentFrame().flags & kDeathScreen)
 	{
 		gpGame->RemoveAutosave();
@@ -325,6 +333,11 @@ void Game::ProcessSavesAndReplays([[maybe_unused]] const MenuInput& rMenuInput,
 	}
 
 #if defined(ENABLE_DEBUG_INPUT)
+	if (rMenuInput.flags & MenuInputFlags_t {kSaveReplay, kLoadReplay, kQuicksave, kQuickload, kResetFrame}) [[unlikely]]
+	{
+		SynchronizeSimulation();
+	}
+
 	if (rMenuInput.flags & kSaveReplay && mpDifferenceStreamWriter == nullptr)
 	{
 		mpDifferenceStreamReader.reset();
@@ -377,7 +390,7 @@ void Game::ProcessSavesAndReplays([[maybe_unused]] const MenuInput& rMenuInput,
 		}
 		else
 		{
-			new (mpCurrentFrame.get()) Frame(kGame, NextIslandsFlip());
+			new (&CurrentFrame()) Frame(kGame, NextIslandsFlip());
 		}
 
 		meUiState = kNone;
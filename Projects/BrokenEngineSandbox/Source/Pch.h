@@ -3,6 +3,7 @@
 #define ENABLE_LOGGING
 #define ENABLE_DXDIAG
 #define ENABLE_RENDER_THREAD
+#define ENABLE_SIMULATION_THREAD
 
 // #define ENABLE_DEBUG_INPUT
 
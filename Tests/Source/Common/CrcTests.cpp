@@ -0,0 +1,87 @@
+using common::Crc;
+using common::CrcIndex;
+using common::FindCrcIndex;
+
+namespace
+{
+
+// Sorted like the tables DataPacker writes into the data header
+inline constexpr CrcIndex kpTable[] = {{.crc = 3, .iIndex = 2}, {.crc = 17, .iIndex = 0}, {.crc = 40, .iIndex = 1}, {.crc = ~0ull, .iIndex = 3}};
+static_assert(FindCrcIndex(kpTable, 3) == 2);
+static_assert(FindCrcIndex(kpTable, 40) == 1);
+static_assert(FindCrcIndex(kpTable, ~0ull) == 3);
+static_assert(FindCrcIndex(kpTable, 0) == -1);
+static_assert(FindCrcIndex(kpTable, 18) == -1);
+static_assert(FindCrcIndex(std::span<const CrcIndex>(), 3) == -1);
+static_assert(Crc("Textures/Ui/Button.png") != Crc("Textures/Ui/Button.jpg"));
+
+// The same steps as writeIndexTable() in DataPacker's Main.cpp
+std::vector<CrcIndex> MakeTable(const std::vector<common::crc_t>& rCrcs)
+{
+	std::vector<CrcIndex> table;
+	for (int64_t i = 0; i < static_cast<int64_t>(rCrcs.size()); ++i)
+	{
+		table.push_back({.crc = rCrcs[i], .iIndex = i});
+	}
+	std::sort(table.begin(), table.end(), [](const CrcIndex& rA, const CrcIndex& rB)
+	{
+		return rA.crc < rB.crc;
+	});
+	return table;
+}
+
+void MatchesHashMap()
+{
+	// Texture names hashed like the packer does, and the map the tables replaced
+	std::vector<common::crc_t> crcs;
+	std::unordered_map<common::crc_t, int64_t> map;
+	for (int64_t i = 0; i < 2000; ++i)
+	{
+		common::crc_t crc = Crc("Textures/Texture" + std::to_string(i) + ".png");
+		map.emplace(crc, static_cast<int64_t>(crcs.size()));
+		crcs.push_back(crc);
+	}
+	CHECK(map.size() == crcs.size());
+	std::vector<CrcIndex> table = MakeTable(crcs);
+
+	for (common::crc_t crc : crcs)
+	{
+		CHECK(FindCrcIndex(table, crc) == map.at(crc));
+	}
+
+	// Misses, next to every entry and at both ends
+	int64_t iFalseHits = 0;
+	for (const CrcIndex& rEntry : table)
+	{
+		for (common::crc_t crc : {rEntry.crc - 1, rEntry.crc + 1})
+		{
+			iFalseHits += !map.contains(crc) && FindCrcIndex(table, crc) != -1;
+		}
+	}
+	CHECK(iFalseHits == 0);
+	CHECK(FindCrcIndex(table, 0) == -1);
+	CHECK(FindCrcIndex(table, ~0ull) == -1);
+	CHECK(FindCrcIndex(table, Crc("Textures/Missing.png")) == -1);
+}
+
+void SmallTables()
+{
+	CHECK(FindCrcIndex({}, Crc("A")) == -1);
+
+	std::vector<CrcIndex> one = MakeTable({Crc("A")});
+	CHECK(FindCrcIndex(one, Crc("A")) == 0);
+	CHECK(FindCrcIndex(one, Crc("B")) == -1);
+
+	std::vector<CrcIndex> two = MakeTable({Crc("A"), Crc("B")});
+	CHECK(FindCrcIndex(two, Crc("A")) == 0);
+	CHECK(FindCrcIndex(two, Crc("B")) == 1);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(MatchesHashMap);
+	RUN_TEST(SmallTables);
+	return test::Result();
+}
@@ -0,0 +1,136 @@
+using common::Histogram;
+
+namespace
+{
+
+void BucketsCoverEveryValue()
+{
+	// Exact below kiSubBucketCount, then consecutive buckets whose ranges touch without gaps
+	for (uint64_t i = 0; i < Histogram::kiSubBucketCount; ++i)
+	{
+		CHECK(Histogram::BucketIndex(i) == static_cast<int64_t>(i));
+		CHECK(Histogram::BucketMax(static_cast<int64_t>(i)) == i);
+	}
+
+	for (int64_t i = 1; i < Histogram::kiBucketCount; ++i)
+	{
+		uint64_t uiLowest = Histogram::BucketMax(i - 1) + 1;
+		CHECK(Histogram::BucketIndex(uiLowest) == i);
+		CHECK(Histogram::BucketIndex(Histogram::BucketMax(i)) == i);
+		CHECK(Histogram::BucketMax(i) >= uiLowest);
+	}
+	CHECK(Histogram::BucketMax(Histogram::kiBucketCount - 1) == ~0ull);
+}
+
+void BucketWidthIsBounded()
+{
+	std::mt19937_64 random {1234};
+	for (int64_t i = 0; i < 100000; ++i)
+	{
+		// Spread over every magnitude, not just the top bits
+		uint64_t uiValue = random() >> (random() % 64);
+		int64_t iBucket = Histogram::BucketIndex(uiValue);
+		uint64_t uiMax = Histogram::BucketMax(iBucket);
+		uint64_t uiLowest = iBucket == 0 ? 0 : Histogram::BucketMax(iBucket - 1) + 1;
+
+		CHECK(uiValue >= uiLowest && uiValue <= uiMax);
+		if (uiValue >= Histogram::kiSubBucketCount)
+		{
+			CHECK(uiMax - uiLowest + 1 <= uiLowest / Histogram::kiSubBucketCount);
+		}
+	}
+}
+
+void PercentilesNeverUnderstate()
+{
+	std::mt19937_64 random {5678};
+	std::lognormal_distribution<double> distribution(6.0, 1.5);
+
+	auto pHistogram = std::make_unique<Histogram>();
+	std::vector<int64_t> values;
+	for (int64_t i = 0; i < 20000; ++i)
+	{
+		int64_t iValue = static_cast<int64_t>(distribution(random));
+		values.push_back(iValue);
+		pHistogram->Record(iValue);
+	}
+	std::sort(values.begin(), values.end());
+
+	CHECK(pHistogram->Count() == static_cast<int64_t>(values.size()));
+	CHECK(pHistogram->Max() == values.back());
+
+	for (float fPercentile : {0.0f, 0.5f, 0.9f, 0.99f, 0.999f, 1.0f})
+	{
+		size_t rank = std::clamp<size_t>(static_cast<size_t>(std::ceil(static_cast<double>(fPercentile) * static_cast<double>(values.size()))), 1, values.size());
+		int64_t iExact = values[rank - 1];
+		int64_t iPercentile = pHistogram->Percentile(fPercentile);
+
+		CHECK(iPercentile >= iExact);
+		CHECK(iPercentile <= iExact + iExact / Histogram::kiSubBucketCount);
+	}
+	CHECK(pHistogram->Percentile(1.0f) == values.back());
+}
+
+void NegativeValuesCountAsZero()
+{
+	auto pHistogram = std::make_unique<Histogram>();
+	pHistogram->Record(-5);
+	pHistogram->Record(3);
+	CHECK(pHistogram->Count() == 2);
+	CHECK(pHistogram->Percentile(0.5f) == 0);
+	CHECK(pHistogram->Max() == 3);
+}
+
+void ResetEmpties()
+{
+	auto pHistogram = std::make_unique<Histogram>();
+	CHECK(pHistogram->Percentile(0.5f) == 0);
+
+	pHistogram->Record(1000);
+	pHistogram->Reset();
+	CHECK(pHistogram->Count() == 0);
+	CHECK(pHistogram->Max() == 0);
+	CHECK(pHistogram->Percentile(0.99f) == 0);
+
+	pHistogram->Record(7);
+	CHECK(pHistogram->Percentile(0.99f) == 7);
+}
+
+void RecordsFromManyThreads()
+{
+	static constexpr int64_t kiThreads = 4;
+	static constexpr int64_t kiPerThread = 100000;
+
+	auto pHistogram = std::make_unique<Histogram>();
+	std::vector<std::thread> threads;
+	for (int64_t i = 0; i < kiThreads; ++i)
+	{
+		threads.emplace_back([&rHistogram = *pHistogram, i]()
+		{
+			for (int64_t j = 0; j < kiPerThread; ++j)
+			{
+				rHistogram.Record(i * kiPerThread + j);
+			}
+		});
+	}
+	for (std::thread& rThread : threads)
+	{
+		rThread.join();
+	}
+
+	CHECK(pHistogram->Count() == kiThreads * kiPerThread);
+	CHECK(pHistogram->Max() == kiThreads * kiPerThread - 1);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(BucketsCoverEveryValue);
+	RUN_TEST(BucketWidthIsBounded);
+	RUN_TEST(PercentilesNeverUnderstate);
+	RUN_TEST(NegativeValuesCountAsZero);
+	RUN_TEST(ResetEmpties);
+	RUN_TEST(RecordsFromManyThreads);
+	return test::Result();
+}
@@ -0,0 +1,69 @@
+#include "MathUtils.h"
+
+using namespace DirectX;
+
+namespace
+{
+
+// XMVectorACos() is a polynomial that is good to about 1e-6 radians, but acos() is steep next to +-1 so the rounding of the cosine is amplified there
+// A cosine one float step off 1 is already about 5e-4 radians off, the two paths normalize in a different order so they can land a step apart
+inline constexpr double kdTolerance = 1e-3;
+inline constexpr double kdToleranceAwayFromAxis = 1e-5;
+inline constexpr float kfAxisCos = 0.99f;
+
+void CheckBatch(const XMVECTOR* pVecPositions)
+{
+	auto matPositions = XMMatrixTranspose(XMMATRIX(pVecPositions[0], pVecPositions[1], pVecPositions[2], pVecPositions[3]));
+
+	XMFLOAT4 f4Rotations {};
+	XMStoreFloat4(&f4Rotations, common::RotationsFromPositions(matPositions.r[0], matPositions.r[1], matPositions.r[2]));
+	const float pfRotations[4] = {f4Rotations.x, f4Rotations.y, f4Rotations.z, f4Rotations.w};
+
+	for (int64_t i = 0; i < 4; ++i)
+	{
+		auto vecNormal = XMVector3Normalize(pVecPositions[i]);
+		float fExpected = common::RotationFromPosition(vecNormal);
+		float fCos = XMVectorGetX(vecNormal) / std::sqrt(XMVectorGetX(vecNormal) * XMVectorGetX(vecNormal) + XMVectorGetY(vecNormal) * XMVectorGetY(vecNormal));
+		CHECK_NEAR(pfRotations[i], fExpected, std::abs(fCos) < kfAxisCos ? kdToleranceAwayFromAxis : kdTolerance);
+	}
+}
+
+void MatchesScalarOnRandomPositions()
+{
+	std::mt19937 random {1234};
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	for (int64_t iBatch = 0; iBatch < 100000; ++iBatch)
+	{
+		XMVECTOR pVecPositions[4] {};
+		for (XMVECTOR& rVecPosition : pVecPositions)
+		{
+			// Every third batch hugs the x axis, where the approximation is at its worst
+			float fY = distribution(random) * (iBatch % 3 == 0 ? 1e-4f : 1.0f);
+			rVecPosition = XMVectorSet(distribution(random), fY, distribution(random), 1.0f);
+		}
+		CheckBatch(pVecPositions);
+	}
+}
+
+void MatchesScalarOnAxes()
+{
+	// Positions like the projected billboards, z and w past the divide
+	const XMVECTOR pVecPositions[4] =
+	{
+		XMVectorSet(1.0f, 0.0f, 0.5f, 1.0f),
+		XMVectorSet(-1.0f, 0.0f, 0.5f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.5f, 1.0f),
+		XMVectorSet(0.0f, -1.0f, 0.5f, 1.0f),
+	};
+	CheckBatch(pVecPositions);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(MatchesScalarOnRandomPositions);
+	RUN_TEST(MatchesScalarOnAxes);
+	return test::Result();
+}
@@ -0,0 +1,219 @@
+using common::MpscQueue;
+
+namespace
+{
+
+void FullRingRefusesPush()
+{
+	MpscQueue<int64_t, 4> queue;
+	int64_t iPopped = -1;
+	auto pop = [&](int64_t iValue)
+	{
+		iPopped = iValue;
+	};
+	CHECK(!queue.TryPop(pop));
+
+	for (int64_t i = 0; i < 4; ++i)
+	{
+		CHECK(queue.TryPush([i](int64_t& rValue){ rValue = i; }));
+	}
+	CHECK(!queue.TryPush([](int64_t& rValue){ rValue = 99; }));
+
+	// Popping frees the oldest slot, the ring wraps around
+	CHECK(queue.TryPop(pop) && iPopped == 0);
+	CHECK(queue.TryPush([](int64_t& rValue){ rValue = 4; }));
+	for (int64_t i = 1; i <= 4; ++i)
+	{
+		CHECK(queue.TryPop(pop) && iPopped == i);
+	}
+	CHECK(!queue.TryPop(pop));
+}
+
+void KeepsOrderPerProducer()
+{
+	static constexpr int64_t kiProducers = 4;
+	static constexpr int64_t kiPerProducer = 100000;
+
+	struct Entry
+	{
+		int64_t iProducer = 0;
+		int64_t iSequence = 0;
+	};
+	auto pQueue = std::make_unique<MpscQueue<Entry, 256>>();
+
+	std::vector<std::thread> producers;
+	for (int64_t p = 0; p < kiProducers; ++p)
+	{
+		producers.emplace_back([&rQueue = *pQueue, p]()
+		{
+			for (int64_t i = 0; i < kiPerProducer; ++i)
+			{
+				while (!rQueue.TryPush([&](Entry& rEntry){ rEntry = {.iProducer = p, .iSequence = i}; }))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	std::array<int64_t, kiProducers> piNext {};
+	int64_t iOutOfOrder = 0;
+	int64_t iPopped = 0;
+	while (iPopped < kiProducers * kiPerProducer)
+	{
+		bool bPopped = pQueue->TryPop([&](const Entry& rEntry)
+		{
+			iOutOfOrder += rEntry.iSequence != piNext[rEntry.iProducer];
+			piNext[rEntry.iProducer] = rEntry.iSequence + 1;
+		});
+		if (bPopped)
+		{
+			++iPopped;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	for (std::thread& rThread : producers)
+	{
+		rThread.join();
+	}
+
+	CHECK(iOutOfOrder == 0);
+	CHECK(std::all_of(piNext.begin(), piNext.end(), [](int64_t iNext){ return iNext == kiPerProducer; }));
+	CHECK(!pQueue->TryPop([](const Entry&){}));
+}
+
+// Not a pass or fail check, prints how long a logging thread is held up per line
+// The ring is pushed the way LogWriter::Push() does it and drained to a file flushed once per batch, against the old synchronous write and flush under a mutex
+void BenchmarkProducerLatency()
+{
+	static constexpr int64_t kiSlotSize = 512;
+	static constexpr int64_t kiCapacity = 2048;
+	static constexpr int64_t kiLines = 20000;
+	static constexpr std::string_view kLine = "3: Update UpdateList 1234 objects, 56 removed, 7 added, 0.123 ms in 4 jobs, flushed 89 transforms\n";
+
+	struct Record
+	{
+		char pcText[kiSlotSize];
+	};
+
+	auto report = [](const char* pcName, int64_t iProducers, const common::Histogram& rHistogram)
+	{
+		std::printf("%s, %lld producers: p50 %lld ns, p99 %lld ns, p99.9 %lld ns, max %lld ns\n", pcName, static_cast<long long>(iProducers),
+			static_cast<long long>(rHistogram.Percentile(0.5f)), static_cast<long long>(rHistogram.Percentile(0.99f)),
+			static_cast<long long>(rHistogram.Percentile(0.999f)), static_cast<long long>(rHistogram.Max()));
+	};
+
+	for (int64_t iProducers : {1, 4})
+	{
+		FILE* pFile = std::tmpfile();
+		CHECK(pFile != nullptr);
+		if (pFile == nullptr)
+		{
+			return;
+		}
+
+		// Ring, one writer thread
+		{
+			auto pQueue = std::make_unique<MpscQueue<Record, kiCapacity>>();
+			auto pHistogram = std::make_unique<common::Histogram>();
+			std::atomic<uint32_t> uiWakeups = 0;
+			std::atomic<bool> bStop = false;
+
+			std::thread writer([&]()
+			{
+				while (true)
+				{
+					bool bStopping = bStop.load(std::memory_order_relaxed);
+					uint32_t uiSeen = uiWakeups.load(std::memory_order_acquire);
+					while (pQueue->TryPop([&](const Record& rRecord){ std::fputs(rRecord.pcText, pFile); }))
+					{
+					}
+					std::fflush(pFile);
+					if (bStopping)
+					{
+						return;
+					}
+					uiWakeups.wait(uiSeen, std::memory_order_acquire);
+				}
+			});
+
+			std::vector<std::thread> producers;
+			for (int64_t p = 0; p < iProducers; ++p)
+			{
+				producers.emplace_back([&]()
+				{
+					for (int64_t i = 0; i < kiLines; ++i)
+					{
+						auto start = std::chrono::high_resolution_clock::now();
+						while (!pQueue->TryPush([](Record& rRecord){ std::copy_n(kLine.data(), kLine.size(), rRecord.pcText); rRecord.pcText[kLine.size()] = 0; }))
+						{
+							uiWakeups.fetch_add(1, std::memory_order_release);
+							uiWakeups.notify_one();
+							std::this_thread::yield();
+						}
+						uiWakeups.fetch_add(1, std::memory_order_release);
+						uiWakeups.notify_one();
+						pHistogram->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count());
+					}
+				});
+			}
+			for (std::thread& rThread : producers)
+			{
+				rThread.join();
+			}
+
+			bStop.store(true, std::memory_order_relaxed);
+			uiWakeups.fetch_add(1, std::memory_order_release);
+			uiWakeups.notify_one();
+			writer.join();
+
+			CHECK(pHistogram->Count() == iProducers * kiLines);
+			report("Ring", iProducers, *pHistogram);
+		}
+
+		// Old, every line written and flushed by the thread that logs it
+		{
+			auto pHistogram = std::make_unique<common::Histogram>();
+			std::mutex mutex;
+
+			std::vector<std::thread> producers;
+			for (int64_t p = 0; p < iProducers; ++p)
+			{
+				producers.emplace_back([&]()
+				{
+					for (int64_t i = 0; i < kiLines; ++i)
+					{
+						auto start = std::chrono::high_resolution_clock::now();
+						{
+							std::lock_guard lockGuard(mutex);
+							std::fputs(kLine.data(), pFile);
+							std::fflush(pFile);
+						}
+						pHistogram->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count());
+					}
+				});
+			}
+			for (std::thread& rThread : producers)
+			{
+				rThread.join();
+			}
+
+			report("Synchronous", iProducers, *pHistogram);
+		}
+
+		std::fclose(pFile);
+	}
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(FullRingRefusesPush);
+	RUN_TEST(KeepsOrderPerProducer);
+	RUN_TEST(BenchmarkProducerLatency);
+	return test::Result();
+}
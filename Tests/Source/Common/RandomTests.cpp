@@ -0,0 +1,171 @@
+using common::RandomStream;
+
+namespace
+{
+
+inline constexpr int64_t kiDraws = 1 << 20;
+inline constexpr int64_t kiBuckets = 256;
+
+// 255 degrees of freedom, exceeded by chance one time in a thousand, the seeds are fixed so a pass stays a pass
+inline constexpr double kdChiSquareLimit = 330.5;
+
+// Buckets the top 8 bits of every value
+template<typename T>
+double ChiSquare(const T& rDraw)
+{
+	std::vector<int64_t> counts(kiBuckets);
+	for (int64_t i = 0; i < kiDraws; ++i)
+	{
+		++counts[rDraw(i) >> 24];
+	}
+
+	double dExpected = static_cast<double>(kiDraws) / kiBuckets;
+	double dChiSquare = 0.0;
+	for (int64_t iCount : counts)
+	{
+		dChiSquare += (static_cast<double>(iCount) - dExpected) * (static_cast<double>(iCount) - dExpected) / dExpected;
+	}
+	return dChiSquare;
+}
+
+void UniformWithinStream()
+{
+	RandomStream randomStream(1234, 1, 0);
+	double dChiSquare = ChiSquare([&](int64_t i){ return randomStream.Bits(static_cast<uint32_t>(i)); });
+	std::printf("Within a stream: chi-square %.1f\n", dChiSquare);
+	CHECK(dChiSquare < kdChiSquareLimit);
+}
+
+void UniformAcrossEntitiesAndTicks()
+{
+	// The first draw of neighbouring keys, what a subsystem sees when every entity draws once per tick
+	double dEntities = ChiSquare([](int64_t i){ return RandomStream(1234, 1, static_cast<uint64_t>(i)).Bits(0); });
+	double dTicks = ChiSquare([](int64_t i){ return RandomStream(static_cast<uint64_t>(i), 1, 7).Bits(0); });
+	double dSubsystems = ChiSquare([](int64_t i){ return RandomStream(1234, static_cast<uint64_t>(i), 7).Bits(0); });
+	std::printf("Across entities: chi-square %.1f, across ticks: %.1f, across subsystems: %.1f\n", dEntities, dTicks, dSubsystems);
+	CHECK(dEntities < kdChiSquareLimit);
+	CHECK(dTicks < kdChiSquareLimit);
+	CHECK(dSubsystems < kdChiSquareLimit);
+}
+
+void BitsAreBalancedAndUncorrelated()
+{
+	RandomStream randomStream(99, 2, 3);
+	RandomStream neighbour(99, 2, 4);
+
+	std::array<int64_t, 32> piOnes {};
+	double dSerial = 0.0;
+	double dNeighbour = 0.0;
+	double dPrevious = 0.0;
+	for (int64_t i = 0; i < kiDraws; ++i)
+	{
+		uint32_t uiBits = randomStream.Bits(static_cast<uint32_t>(i));
+		for (int64_t b = 0; b < 32; ++b)
+		{
+			piOnes[b] += (uiBits >> b) & 1;
+		}
+
+		// Centered on zero, so the sums of products are covariances
+		double dValue = static_cast<double>(uiBits) / 4294967296.0 - 0.5;
+		dSerial += dValue * dPrevious;
+		dNeighbour += dValue * (static_cast<double>(neighbour.Bits(static_cast<uint32_t>(i))) / 4294967296.0 - 0.5);
+		dPrevious = dValue;
+	}
+
+	// A fair bit has a standard deviation of sqrt(n) / 2 ones
+	double dWorstZ = 0.0;
+	for (int64_t iOnes : piOnes)
+	{
+		dWorstZ = std::max(dWorstZ, std::abs(static_cast<double>(iOnes) - kiDraws / 2.0) / (std::sqrt(static_cast<double>(kiDraws)) / 2.0));
+	}
+
+	// Divided by the variance of a uniform in [-0.5, 0.5), which is 1 / 12
+	double dSerialCorrelation = dSerial / kiDraws * 12.0;
+	double dNeighbourCorrelation = dNeighbour / kiDraws * 12.0;
+	std::printf("Worst bit z %.2f, serial correlation %.5f, neighbouring entity correlation %.5f\n", dWorstZ, dSerialCorrelation, dNeighbourCorrelation);
+
+	// 1 / sqrt(n) is about 0.001
+	CHECK(dWorstZ < 4.0);
+	CHECK(std::abs(dSerialCorrelation) < 0.005);
+	CHECK(std::abs(dNeighbourCorrelation) < 0.005);
+}
+
+void DrawsDontRepeat()
+{
+	// Both rounds are bijections of the counter
+	RandomStream randomStream(5, 6, 7);
+	std::vector<uint32_t> draws(kiDraws);
+	for (int64_t i = 0; i < kiDraws; ++i)
+	{
+		draws[i] = randomStream.Bits(static_cast<uint32_t>(i));
+	}
+	std::sort(draws.begin(), draws.end());
+	CHECK(std::adjacent_find(draws.begin(), draws.end()) == draws.end());
+}
+
+void DrawsAreIndexed()
+{
+	// Random() is Bits() of the counter, drawing in a different order gives the same values
+	RandomStream randomStream(10, 20, 30);
+	CHECK(randomStream == RandomStream(10, 20, 30));
+	CHECK(!(randomStream == RandomStream(10, 20, 31)));
+
+	std::vector<uint32_t> forwards;
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		forwards.push_back(common::Random(999, randomStream));
+	}
+	CHECK(randomStream.uiCounter == 100);
+	for (int64_t i = 99; i >= 0; --i)
+	{
+		CHECK(randomStream.Bits(static_cast<uint32_t>(i)) % 1000 == forwards[i]);
+	}
+
+	// Floats are in [0, MAX)
+	RandomStream floatStream(10, 20, 30);
+	float fLowest = 1.0f;
+	float fHighest = 0.0f;
+	for (int64_t i = 0; i < 100000; ++i)
+	{
+		float fValue = common::Random<2.0f>(floatStream);
+		fLowest = std::min(fLowest, fValue);
+		fHighest = std::max(fHighest, fValue);
+	}
+	CHECK(fLowest >= 0.0f && fLowest < 0.001f);
+	CHECK(fHighest < 2.0f && fHighest > 1.999f);
+}
+
+void SimdMatchesScalar()
+{
+	// Every tail length and a counter that wraps inside the vector loop
+	for (uint32_t uiStart : {0u, 5u, 0xfffffffeu})
+	{
+		for (int64_t iCount = 0; iCount <= 9; ++iCount)
+		{
+			RandomStream simdStream(1, 2, 3);
+			simdStream.uiCounter = uiStart;
+			RandomStream scalarStream = simdStream;
+
+			std::vector<float> values(iCount);
+			common::RandomFloats(simdStream, values, 3.0f);
+			for (int64_t i = 0; i < iCount; ++i)
+			{
+				CHECK(values[i] == common::Random<3.0f>(scalarStream));
+			}
+			CHECK(simdStream.uiCounter == scalarStream.uiCounter);
+		}
+	}
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(UniformWithinStream);
+	RUN_TEST(UniformAcrossEntitiesAndTicks);
+	RUN_TEST(BitsAreBalancedAndUncorrelated);
+	RUN_TEST(DrawsDontRepeat);
+	RUN_TEST(DrawsAreIndexed);
+	RUN_TEST(SimdMatchesScalar);
+	return test::Result();
+}
@@ -0,0 +1,185 @@
+#include "TripleBuffer.h"
+
+using common::TripleBuffer;
+
+namespace
+{
+
+struct Payload
+{
+	int64_t iTick = 0;
+	std::array<int64_t, 15> piCopies {};
+};
+
+void HandsOffLatest()
+{
+	TripleBuffer<int64_t> tripleBuffer;
+	CHECK(&tripleBuffer.Front() == &tripleBuffer.Latest());
+	CHECK(!tripleBuffer.Acquire());
+
+	tripleBuffer.Back() = 1;
+	tripleBuffer.Publish();
+	CHECK(tripleBuffer.Latest() == 1);
+	CHECK(tripleBuffer.Acquire());
+	CHECK(tripleBuffer.Front() == 1);
+	CHECK(!tripleBuffer.Acquire());
+
+	// Two publishes without an acquire, the consumer only sees the second one
+	tripleBuffer.Back() = 2;
+	tripleBuffer.Publish();
+	tripleBuffer.Back() = 3;
+	tripleBuffer.Publish();
+	CHECK(tripleBuffer.Acquire());
+	CHECK(tripleBuffer.Front() == 3);
+}
+
+void BackNeverAliasesLatestOrFront()
+{
+	TripleBuffer<int64_t> tripleBuffer;
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		CHECK(&tripleBuffer.Back() != &tripleBuffer.Latest());
+		CHECK(&tripleBuffer.Back() != &tripleBuffer.Front());
+
+		tripleBuffer.Back() = i;
+		tripleBuffer.Publish();
+		if (i % 3 == 0)
+		{
+			tripleBuffer.Acquire();
+		}
+	}
+}
+
+// The simulation thread publishes ticks while the main thread acquires, a frame must never be seen half written or older than one already seen
+void ConcurrentHandoff()
+{
+	static constexpr int64_t kiTicks = 200'000;
+
+	TripleBuffer<Payload> tripleBuffer;
+	std::atomic<bool> bDone = false;
+
+	std::thread producer([&]()
+	{
+		for (int64_t i = 1; i <= kiTicks; ++i)
+		{
+			Payload& rPayload = tripleBuffer.Back();
+			rPayload.iTick = i;
+			rPayload.piCopies.fill(i);
+			tripleBuffer.Publish();
+		}
+		bDone.store(true, std::memory_order_release);
+	});
+
+	int64_t iLastTick = 0;
+	int64_t iAcquired = 0;
+	bool bTorn = false;
+	bool bBackwards = false;
+	while (true)
+	{
+		bool bProducerDone = bDone.load(std::memory_order_acquire);
+		if (tripleBuffer.Acquire())
+		{
+			const Payload& rPayload = tripleBuffer.Front();
+			bTorn |= std::any_of(rPayload.piCopies.begin(), rPayload.piCopies.end(), [&](int64_t iCopy){ return iCopy != rPayload.iTick; });
+			bBackwards |= rPayload.iTick <= iLastTick;
+			iLastTick = rPayload.iTick;
+			++iAcquired;
+		}
+		else if (bProducerDone)
+		{
+			break;
+		}
+	}
+	producer.join();
+
+	CHECK(!bTorn);
+	CHECK(!bBackwards);
+	CHECK(iLastTick == kiTicks);
+	CHECK(iAcquired > 0);
+}
+
+// GameBase interpolates between the last two frames it took, the producer must never write to either of them
+void KeepsPrevious()
+{
+	TripleBuffer<int64_t, true> tripleBuffer;
+	CHECK(&tripleBuffer.Previous() != &tripleBuffer.Front());
+
+	int64_t iFront = 0;
+	for (int64_t i = 1; i < 100; ++i)
+	{
+		CHECK(&tripleBuffer.Back() != &tripleBuffer.Latest());
+		CHECK(&tripleBuffer.Back() != &tripleBuffer.Front());
+		CHECK(&tripleBuffer.Back() != &tripleBuffer.Previous());
+
+		tripleBuffer.Back() = i;
+		tripleBuffer.Publish();
+		if (i % 3 != 0)
+		{
+			int64_t iOldFront = iFront;
+			CHECK(tripleBuffer.Acquire());
+			iFront = tripleBuffer.Front();
+			CHECK(iFront == i);
+			CHECK(tripleBuffer.Previous() == iOldFront);
+		}
+	}
+}
+
+void ConcurrentHandoffKeepsPrevious()
+{
+	static constexpr int64_t kiTicks = 200'000;
+
+	TripleBuffer<Payload, true> tripleBuffer;
+	std::atomic<bool> bDone = false;
+
+	std::thread producer([&]()
+	{
+		for (int64_t i = 1; i <= kiTicks; ++i)
+		{
+			Payload& rPayload = tripleBuffer.Back();
+			rPayload.iTick = i;
+			rPayload.piCopies.fill(i);
+			tripleBuffer.Publish();
+		}
+		bDone.store(true, std::memory_order_release);
+	});
+
+	int64_t iLastTick = 0;
+	bool bTorn = false;
+	bool bWrongPrevious = false;
+	while (true)
+	{
+		bool bProducerDone = bDone.load(std::memory_order_acquire);
+		if (tripleBuffer.Acquire())
+		{
+			const Payload& rPrevious = tripleBuffer.Previous();
+			const Payload& rFront = tripleBuffer.Front();
+			for (const Payload* pPayload : {&rPrevious, &rFront})
+			{
+				bTorn |= std::any_of(pPayload->piCopies.begin(), pPayload->piCopies.end(), [&](int64_t iCopy){ return iCopy != pPayload->iTick; });
+			}
+			bWrongPrevious |= rPrevious.iTick != iLastTick;
+			iLastTick = rFront.iTick;
+		}
+		else if (bProducerDone)
+		{
+			break;
+		}
+	}
+	producer.join();
+
+	CHECK(!bTorn);
+	CHECK(!bWrongPrevious);
+	CHECK(iLastTick == kiTicks);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(HandsOffLatest);
+	RUN_TEST(BackNeverAliasesLatestOrFront);
+	RUN_TEST(ConcurrentHandoff);
+	RUN_TEST(KeepsPrevious);
+	RUN_TEST(ConcurrentHandoffKeepsPrevious);
+	return test::Result();
+}
@@ -0,0 +1,127 @@
+using common::WorkerPool;
+
+namespace
+{
+
+void RunsEveryJobOnce()
+{
+	WorkerPool pool(3);
+	for (int64_t iCount : {1, 2, 3, 4, 7, 64, 1000})
+	{
+		std::vector<std::atomic<int64_t>> runs(iCount);
+		pool.Run(iCount, [&runs](int64_t i)
+		{
+			runs[i].fetch_add(1, std::memory_order_relaxed);
+		});
+
+		int64_t iWrong = 0;
+		for (const std::atomic<int64_t>& rRuns : runs)
+		{
+			iWrong += rRuns.load() != 1;
+		}
+		CHECK(iWrong == 0);
+	}
+
+	// Nothing to do returns right away
+	pool.Run(0, [](int64_t){ CHECK(false); });
+}
+
+// Without workers the caller runs the whole batch itself
+void CallerRunsJobs()
+{
+	WorkerPool pool(0);
+	std::thread::id caller = std::this_thread::get_id();
+	int64_t iSum = 0;
+	pool.Run(10, [&](int64_t i)
+	{
+		CHECK(std::this_thread::get_id() == caller);
+		iSum += i;
+	});
+	CHECK(iSum == 45);
+}
+
+// Every job of the outer batch blocks all workers for a while and starts an inner batch, the threads running outer jobs finish the inner ones themselves
+void NestedRunsFinish()
+{
+	WorkerPool pool(2);
+	std::atomic<int64_t> iInner = 0;
+	pool.Run(8, [&](int64_t)
+	{
+		std::this_thread::sleep_for(1ms);
+		pool.Run(16, [&](int64_t)
+		{
+			iInner.fetch_add(1, std::memory_order_relaxed);
+		});
+	});
+	CHECK(iInner.load() == 8 * 16);
+}
+
+// The main and the simulation thread both split work over the same pool
+void ConcurrentCallers()
+{
+	static constexpr int64_t kiCallers = 4;
+	static constexpr int64_t kiRuns = 2000;
+
+	WorkerPool pool(3);
+	std::array<int64_t, kiCallers> piSums {};
+	std::vector<std::thread> callers;
+	for (int64_t c = 0; c < kiCallers; ++c)
+	{
+		callers.emplace_back([&pool, &rSum = piSums[c]]()
+		{
+			for (int64_t iRun = 0; iRun < kiRuns; ++iRun)
+			{
+				std::array<int64_t, 5> piValues {};
+				pool.Run(5, [&piValues](int64_t i)
+				{
+					piValues[i] = i + 1;
+				});
+				rSum += std::accumulate(piValues.begin(), piValues.end(), 0ll);
+			}
+		});
+	}
+	for (std::thread& rCaller : callers)
+	{
+		rCaller.join();
+	}
+
+	for (int64_t iSum : piSums)
+	{
+		CHECK(iSum == 15 * kiRuns);
+	}
+}
+
+// A failed ASSERT in a bucket reaches the caller like it did through std::future::get(), after the other jobs are done
+void RethrowsJobException()
+{
+	WorkerPool pool(3);
+	std::atomic<int64_t> iRan = 0;
+	CHECK_THROWS(pool.Run(32, [&iRan](int64_t i)
+	{
+		iRan.fetch_add(1, std::memory_order_relaxed);
+		ASSERT(i != 5);
+	}));
+	CHECK(iRan.load() == 32);
+
+	// Still usable afterwards
+	int64_t iCount = 0;
+	std::mutex mutex;
+	pool.Run(8, [&](int64_t)
+	{
+		std::scoped_lock lock(mutex);
+		++iCount;
+	});
+	CHECK(iCount == 8);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(RunsEveryJobOnce);
+	RUN_TEST(CallerRunsJobs);
+	RUN_TEST(NestedRunsFinish);
+	RUN_TEST(ConcurrentCallers);
+	RUN_TEST(RethrowsJobException);
+	return test::Result();
+}
@@ -0,0 +1,118 @@
+#include "Exr.h"
+#include "MathUtils.h"
+
+#define OPENEXR_EXPORT
+#include "openexr/src/lib/OpenEXRCore/openexr.h"
+
+namespace
+{
+
+std::filesystem::path gPath;
+
+// What Texture did before the chunks were decoded in parallel, one scanline at a time into planar B, G, R and then a scalar interleave
+// Returns false for files with more than one scanline per chunk, which it couldn't read
+bool OldReadExr(std::vector<float>& rPixels, int64_t& riWidth, int64_t& riHeight, const std::filesystem::path& rPath, bool bFromGamma)
+{
+	exr_context_initializer_t ctxtinit = EXR_DEFAULT_CONTEXT_INITIALIZER;
+	exr_context_t f {};
+	exr_result_t rv = exr_start_read(&f, rPath.string().c_str(), &ctxtinit);
+	ASSERT(rv == EXR_ERR_SUCCESS);
+	common::ScopedLambda releaseExrContext([=]()
+	{
+		exr_context_t exrContextCopy = f;
+		exr_finish(&exrContextCopy);
+	});
+
+	exr_attr_box2i_t dw {};
+	exr_get_data_window(f, 0, &dw);
+	int32_t scansperchunk = 0;
+	exr_get_scanlines_per_chunk(f, 0, &scansperchunk);
+	if (scansperchunk != 1)
+	{
+		return false;
+	}
+
+	riWidth = dw.max.x + 1;
+	riHeight = dw.max.y + 1;
+	std::vector<float> pixelsR(riWidth * riHeight);
+	std::vector<float> pixelsG(riWidth * riHeight);
+	std::vector<float> pixelsB(riWidth * riHeight);
+
+	for (int y = dw.min.y; y <= dw.max.y; y += scansperchunk)
+	{
+		exr_chunk_info_t cinfo;
+		exr_read_scanline_chunk_info(f, 0, y, &cinfo);
+
+		exr_decode_pipeline_t decoder {};
+		exr_decoding_initialize(f, 0, &cinfo, &decoder);
+
+		float* ppfPlanes[3] = {pixelsB.data(), pixelsG.data(), pixelsR.data()};
+		for (int64_t c = 0; c < 3; ++c)
+		{
+			decoder.channels[c].user_data_type = EXR_PIXEL_FLOAT;
+			decoder.channels[c].decode_to_ptr = reinterpret_cast<uint8_t*>(ppfPlanes[c] + y * riWidth);
+			decoder.channels[c].user_pixel_stride = 4;
+			decoder.channels[c].user_line_stride = static_cast<int32_t>(4 * riWidth);
+			decoder.channels[c].user_bytes_per_element = 4;
+		}
+
+		exr_decoding_choose_default_routines(f, 0, &decoder);
+		exr_decoding_run(f, 0, &decoder);
+		exr_decoding_destroy(f, &decoder);
+	}
+
+	rPixels.assign(3 * riWidth * riHeight, 0.0f);
+	for (int64_t i = 0; i < riWidth * riHeight; ++i)
+	{
+		const float pfSrc[3] = {pixelsR[i], pixelsG[i], pixelsB[i]};
+		for (int64_t c = 0; c < 3; ++c)
+		{
+			rPixels[3 * i + c] = bFromGamma ? 255.0f * common::FromGamma(pfSrc[c]) : 255.0f * pfSrc[c];
+		}
+	}
+	return true;
+}
+
+void MatchesOldDecoder()
+{
+	for (bool bFromGamma : {false, true})
+	{
+		std::vector<float> expected;
+		int64_t iExpectedWidth = 0;
+		int64_t iExpectedHeight = 0;
+		if (!OldReadExr(expected, iExpectedWidth, iExpectedHeight, gPath, bFromGamma))
+		{
+			std::printf("%s has more than one scanline per chunk, only checking that thread counts agree\n", gPath.string().c_str());
+			ReadExr(expected, iExpectedWidth, iExpectedHeight, gPath, bFromGamma, 1);
+		}
+
+		// One band, and more bands than a small file has chunks
+		for (int64_t iThreads : {1, 3, 64})
+		{
+			std::vector<float> pixels;
+			int64_t iWidth = 0;
+			int64_t iHeight = 0;
+			ReadExr(pixels, iWidth, iHeight, gPath, bFromGamma, iThreads);
+
+			CHECK(iWidth == iExpectedWidth && iHeight == iExpectedHeight);
+			CHECK(pixels.size() == expected.size());
+			CHECK(pixels.size() == expected.size() && std::memcmp(pixels.data(), expected.data(), sizeof(float) * pixels.size()) == 0);
+		}
+	}
+}
+
+} // namespace
+
+// The packer deletes its EXR inputs once they're exported so the repository has none, pass one with -DBT_TEST_EXR=<path>
+int main(int iArgc, char** ppcArgv)
+{
+	if (iArgc < 2 || !std::filesystem::exists(ppcArgv[1]))
+	{
+		std::printf("No EXR given, skipping\n");
+		return test::kiSkipped;
+	}
+	gPath = ppcArgv[1];
+
+	RUN_TEST(MatchesOldDecoder);
+	return test::Result();
+}
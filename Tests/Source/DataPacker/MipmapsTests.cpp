@@ -0,0 +1,171 @@
+#include "Mipmaps.h"
+
+namespace
+{
+
+std::vector<float> RandomLevel(int64_t iWidth, int64_t iHeight, int64_t iChannels, uint32_t uiSeed)
+{
+	std::mt19937 random {uiSeed};
+	std::uniform_real_distribution<float> distribution(0.0f, 255.0f);
+	std::vector<float> level(iChannels * iWidth * iHeight);
+	for (float& rfValue : level)
+	{
+		rfValue = distribution(random);
+	}
+	return level;
+}
+
+// What Texture::MakeMipmaps() did before the separable filter, every level was RGBA and a 2x2 average of the previous one
+void OldDownsample(float* pfPixels, const float* pfPreviousPixels, int64_t iPreviousWidth, int64_t iPreviousHeight)
+{
+	int64_t iWidth = iPreviousWidth / 2;
+	int64_t iHeight = iPreviousHeight / 2;
+	for (int64_t j = 0; j < iHeight; ++j)
+	{
+		for (int64_t i = 0; i < iWidth; ++i)
+		{
+			int64_t iTopLeft     = (2 * j + 0) * 4 * iPreviousWidth + (2 * i + 0) * 4;
+			int64_t iTopRight    = (2 * j + 0) * 4 * iPreviousWidth + (2 * i + 1) * 4;
+			int64_t iBottomLeft  = (2 * j + 1) * 4 * iPreviousWidth + (2 * i + 0) * 4;
+			int64_t iBottomRight = (2 * j + 1) * 4 * iPreviousWidth + (2 * i + 1) * 4;
+
+			for (int64_t c = 0; c < 4; ++c)
+			{
+				pfPixels[j * 4 * iWidth + 4 * i + c] = 0.25f * (pfPreviousPixels[iTopLeft + c] + pfPreviousPixels[iTopRight + c] + pfPreviousPixels[iBottomLeft + c] + pfPreviousPixels[iBottomRight + c]);
+			}
+		}
+	}
+}
+
+// Level 0 and every level down to 4 x 4 like the BC4 island exports, returns the bytes of all levels which is also the peak for non color textures
+template<typename T>
+int64_t MakeChain(std::vector<std::vector<float>>& rLevels, int64_t iSize, int64_t iChannels, const T& rDownsample)
+{
+	int64_t iBytes = static_cast<int64_t>(sizeof(float) * rLevels.front().size());
+	for (int64_t iPrevious = iSize; iPrevious / 2 >= 4; iPrevious /= 2)
+	{
+		std::vector<float>& rLevel = rLevels.emplace_back(iChannels * (iPrevious / 2) * (iPrevious / 2));
+		rDownsample(rLevel.data(), rLevels[rLevels.size() - 2].data(), iPrevious);
+		iBytes += static_cast<int64_t>(sizeof(float) * rLevel.size());
+	}
+	return iBytes;
+}
+
+void BoxMatchesOldAverage()
+{
+	static constexpr int64_t kiSize = 64;
+	std::vector<float> source = RandomLevel(kiSize, kiSize, 4, 1234);
+
+	std::vector<float> expected(4 * (kiSize / 2) * (kiSize / 2));
+	OldDownsample(expected.data(), source.data(), kiSize, kiSize);
+
+	// Same values as RGBA and as four separate single channel levels
+	std::vector<float> box(expected.size());
+	Downsample(box.data(), source.data(), kiSize, kiSize, 4, GetMipKernel(MipFilter::kBox));
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		CHECK_NEAR(box[i], expected[i], 1e-3);
+	}
+
+	for (int64_t c = 0; c < 4; ++c)
+	{
+		std::vector<float> channel(kiSize * kiSize);
+		for (size_t i = 0; i < channel.size(); ++i)
+		{
+			channel[i] = source[4 * i + c];
+		}
+
+		std::vector<float> channelBox(channel.size() / 4);
+		Downsample(channelBox.data(), channel.data(), kiSize, kiSize, 1, GetMipKernel(MipFilter::kBox));
+		for (size_t i = 0; i < channelBox.size(); ++i)
+		{
+			CHECK_NEAR(channelBox[i], expected[4 * i + c], 1e-3);
+		}
+	}
+}
+
+void SincsKeepFlatAndClamp()
+{
+	static constexpr int64_t kiSize = 64;
+
+	for (MipFilter eMipFilter : {MipFilter::kKaiser, MipFilter::kLanczos})
+	{
+		const MipKernel& rMipKernel = GetMipKernel(eMipFilter);
+		float fTotal = 0.0f;
+		for (int64_t t = 0; t < rMipKernel.iTapCount; ++t)
+		{
+			fTotal += rMipKernel.pfWeights[t];
+		}
+		CHECK_NEAR(fTotal, 1.0f, 1e-5);
+
+		for (int64_t iChannels : {1, 3, 4})
+		{
+			// A flat level stays flat, also at the edges where the taps are clamped
+			std::vector<float> flat(iChannels * kiSize * kiSize, 100.0f);
+			std::vector<float> flatMip(flat.size() / 4);
+			Downsample(flatMip.data(), flat.data(), kiSize, kiSize, iChannels, rMipKernel);
+			for (float fValue : flatMip)
+			{
+				CHECK_NEAR(fValue, 100.0f, 1e-3);
+			}
+
+			// Hard edges ring, the ringing is clamped to the stored range
+			std::vector<float> stripes(iChannels * kiSize * kiSize);
+			for (size_t i = 0; i < stripes.size(); ++i)
+			{
+				stripes[i] = (i / iChannels / 3) % 2 == 0 ? 0.0f : 255.0f;
+			}
+			std::vector<float> stripesMip(stripes.size() / 4);
+			Downsample(stripesMip.data(), stripes.data(), kiSize, kiSize, iChannels, rMipKernel);
+			CHECK(std::all_of(stripesMip.begin(), stripesMip.end(), [](float fValue)
+			{
+				return fValue >= 0.0f && fValue <= 255.0f;
+			}));
+		}
+	}
+}
+
+// Not a pass or fail check, prints the time and memory of a full chain for a 4096 x 4096 single channel island input against the RGBA chain it replaced
+void BenchmarkIslandChain()
+{
+	static constexpr int64_t kiSize = 4096;
+
+	auto run = [](const char* pcName, int64_t iChannels, auto downsample)
+	{
+		std::chrono::nanoseconds best = std::chrono::nanoseconds::max();
+		int64_t iBytes = 0;
+		for (int64_t i = 0; i < 3; ++i)
+		{
+			std::vector<std::vector<float>> levels;
+			levels.push_back(RandomLevel(kiSize, kiSize, iChannels, 5678));
+
+			auto start = std::chrono::high_resolution_clock::now();
+			iBytes = MakeChain(levels, kiSize, iChannels, downsample);
+			best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start));
+		}
+		std::printf("%s: %lld ms, peak %lld MB\n", pcName, static_cast<long long>(best.count() / 1'000'000), static_cast<long long>(iBytes / (1024 * 1024)));
+	};
+
+	run("Old RGBA box", 4, [](float* pfDest, const float* pfSrc, int64_t iPrevious)
+	{
+		OldDownsample(pfDest, pfSrc, iPrevious, iPrevious);
+	});
+	run("R32 box", 1, [](float* pfDest, const float* pfSrc, int64_t iPrevious)
+	{
+		Downsample(pfDest, pfSrc, iPrevious, iPrevious, 1, GetMipKernel(MipFilter::kBox));
+	});
+	run("R32 Kaiser", 1, [](float* pfDest, const float* pfSrc, int64_t iPrevious)
+	{
+		Downsample(pfDest, pfSrc, iPrevious, iPrevious, 1, GetMipKernel(MipFilter::kKaiser));
+	});
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(BoxMatchesOldAverage);
+	RUN_TEST(SincsKeepFlatAndClamp);
+	RUN_TEST(BenchmarkIslandChain);
+	return test::Result();
+}
@@ -0,0 +1,241 @@
+#include "File/ChunkFile.h"
+
+using engine::Chunk;
+using engine::ChunkKind;
+using engine::ChunkLists;
+using enum common::ChunkFlags;
+
+namespace
+{
+
+std::filesystem::path gDataFile;
+
+struct TestChunk
+{
+	common::ChunkFlags_t flags;
+	int64_t iSize = 0;
+};
+
+// Every flag combination the packer writes, plus the flags nothing reads yet
+const std::vector<TestChunk>& TestChunks()
+{
+	static const std::vector<TestChunk> sChunks
+	{
+		{common::ChunkFlags_t(kFont), 100},
+		{common::ChunkFlags_t(kModel), 17},
+		{common::ChunkFlags_t({kModel, kNormals, kFaceNormals}), 16},
+		{common::ChunkFlags_t({kModel, kGltfModel, kNormals, kTexcoords}), 1},
+		{common::ChunkFlags_t(kIsland), 15},
+		{common::ChunkFlags_t(kShaderCompute), 64},
+		{common::ChunkFlags_t(kShaderFragment), 0},
+		{common::ChunkFlags_t(kShaderVertex), 33},
+		{common::ChunkFlags_t(kTexture), 48},
+		{common::ChunkFlags_t({kTexture, kCubemap}), 31},
+		{common::ChunkFlags_t({kTexture, kRawTexture}), 2},
+		{common::ChunkFlags_t(kGltf), 5},
+		{common::ChunkFlags_t(kElevation), 7},
+		{common::ChunkFlags_t(kAudio), 9},
+		{common::ChunkFlags_t(kFont), 3},
+	};
+	return sChunks;
+}
+
+// Writes the file the way the packer's Main.cpp and ExportJob::AllocateHeaderAndData() do, every payload byte is its chunk index
+void WriteChunkFile(const std::filesystem::path& rFile, const std::vector<TestChunk>& rChunks)
+{
+	std::fstream fileStream(rFile, std::ios::out | std::ios::binary | std::ios::trunc);
+	common::DataHeader dataHeader {};
+	dataHeader.iChunkCount = static_cast<int64_t>(rChunks.size());
+	fileStream.write(reinterpret_cast<char*>(&dataHeader), sizeof(dataHeader));
+	common::AlignOutputStream(fileStream);
+
+	for (int64_t i = 0; i < static_cast<int64_t>(rChunks.size()); ++i)
+	{
+		int64_t iDataOffset = common::RoundUp(static_cast<int64_t>(sizeof(common::ChunkHeader)), common::kiAlignmentBytes);
+		std::vector<byte> headerAndData(iDataOffset + common::RoundUp(rChunks[i].iSize, common::kiAlignmentBytes));
+		std::fill(headerAndData.begin() + iDataOffset, headerAndData.begin() + iDataOffset + rChunks[i].iSize, static_cast<byte>(i));
+
+		auto pChunkHeader = reinterpret_cast<common::ChunkHeader*>(headerAndData.data());
+		pChunkHeader->iMagic = common::ChunkHeader::kiMagic;
+		pChunkHeader->flags = rChunks[i].flags;
+		pChunkHeader->crc = common::Crc("Chunk" + std::to_string(i));
+		pChunkHeader->iSize = rChunks[i].iSize;
+
+		fileStream.write(reinterpret_cast<char*>(headerAndData.data()), headerAndData.size());
+		common::AlignOutputStream(fileStream);
+	}
+}
+
+// What each manager filtered the whole chunk map by before the lists, TextManager looked its two fonts up by crc
+bool OldFilter(ChunkKind eChunkKind, const common::ChunkFlags_t& rFlags)
+{
+	switch (eChunkKind)
+	{
+	case engine::kChunkModels: return rFlags & kModel;
+	case engine::kChunkIslands: return rFlags & kIsland;
+	case engine::kChunkFonts: return rFlags & kFont;
+	case engine::kChunkShaders: return rFlags & kShaderCompute || rFlags & kShaderFragment || rFlags & kShaderVertex;
+	case engine::kChunkTextures: return rFlags & kTexture;
+	default: return false;
+	}
+}
+
+// Every chunk is in exactly one list in file order, the lists and the map agree and every manager gets the chunks its old filter picked
+// Returns the chunks more than one old filter picked, which now only go to the first list
+int64_t CheckChunks(const std::vector<byte>& rData, const std::unordered_map<common::crc_t, Chunk>& rChunkMap, const ChunkLists& rChunkLists)
+{
+	int64_t iListed = 0;
+	for (int64_t i = 0; i < engine::kChunkKindCount; ++i)
+	{
+		const byte* pPrevious = nullptr;
+		for (const Chunk& rChunk : rChunkLists[i])
+		{
+			CHECK(engine::ClassifyChunk(rChunk.pHeader->flags) == static_cast<ChunkKind>(i));
+			CHECK(reinterpret_cast<const byte*>(rChunk.pHeader) > pPrevious);
+			pPrevious = reinterpret_cast<const byte*>(rChunk.pHeader);
+			CHECK(rChunk.pData >= rData.data() && rChunk.pData + rChunk.pHeader->iSize <= rData.data() + rData.size());
+
+			auto it = rChunkMap.find(rChunk.pHeader->crc);
+			CHECK(it != rChunkMap.end() && it->second.pHeader == rChunk.pHeader && it->second.pData == rChunk.pData);
+			++iListed;
+		}
+	}
+	CHECK(iListed == static_cast<int64_t>(rChunkMap.size()));
+
+	int64_t iShared = 0;
+	for (const auto& [crc, rChunk] : rChunkMap)
+	{
+		int64_t iOldFilters = 0;
+		for (int64_t i = 0; i < engine::kChunkOther; ++i)
+		{
+			iOldFilters += OldFilter(static_cast<ChunkKind>(i), rChunk.pHeader->flags);
+		}
+		ChunkKind eChunkKind = engine::ClassifyChunk(rChunk.pHeader->flags);
+		CHECK(iOldFilters == 0 ? eChunkKind == engine::kChunkOther : OldFilter(eChunkKind, rChunk.pHeader->flags));
+		if (iOldFilters > 1)
+		{
+			std::printf("%s (%#018llx) flags %#llx matched %lld old filters\n", rChunk.pHeader->pcPath, static_cast<unsigned long long>(crc), static_cast<unsigned long long>(rChunk.pHeader->flags.muiUnderlying), static_cast<long long>(iOldFilters));
+			++iShared;
+		}
+	}
+	return iShared;
+}
+
+void ReadsWhatThePackerWrites()
+{
+	std::filesystem::path file = std::filesystem::temp_directory_path() / "ChunkFileTests.bin";
+	WriteChunkFile(file, TestChunks());
+
+	std::vector<byte> data;
+	std::unordered_map<common::crc_t, Chunk> chunkMap;
+	ChunkLists chunkLists;
+	engine::ReadChunkFile(file, data, chunkMap, chunkLists);
+	std::filesystem::remove(file);
+
+	CHECK(static_cast<int64_t>(chunkMap.size()) == static_cast<int64_t>(TestChunks().size()));
+	CHECK(CheckChunks(data, chunkMap, chunkLists) == 0);
+
+	const int64_t piExpected[engine::kChunkKindCount] {3, 1, 2, 3, 3, 3};
+	for (int64_t i = 0; i < engine::kChunkKindCount; ++i)
+	{
+		CHECK(static_cast<int64_t>(chunkLists[i].size()) == piExpected[i]);
+	}
+
+	// Payloads survive the alignment padding, including the empty one
+	for (int64_t i = 0; i < static_cast<int64_t>(TestChunks().size()); ++i)
+	{
+		auto it = chunkMap.find(common::Crc("Chunk" + std::to_string(i)));
+		CHECK(it != chunkMap.end());
+		const Chunk& rChunk = it->second;
+		CHECK(rChunk.pHeader->iSize == TestChunks()[i].iSize);
+		CHECK(reinterpret_cast<uintptr_t>(rChunk.pData) % common::kiAlignmentBytes == reinterpret_cast<uintptr_t>(data.data()) % common::kiAlignmentBytes);
+		CHECK(std::all_of(rChunk.pData, rChunk.pData + rChunk.pHeader->iSize, [=](byte b){ return b == static_cast<byte>(i); }));
+	}
+
+	// Fonts in file order, TextManager finds them by crc within the list
+	CHECK(chunkLists[engine::kChunkFonts][0].pHeader->crc == common::Crc("Chunk0"));
+	CHECK(chunkLists[engine::kChunkFonts][1].pHeader->crc == common::Crc("Chunk14"));
+}
+
+// The packer never writes these, the order decides which single list they end up in
+void SharedFlagsGoToTheFirstKind()
+{
+	CHECK(engine::ClassifyChunk(common::ChunkFlags_t({kModel, kShaderVertex})) == engine::kChunkShaders);
+	CHECK(engine::ClassifyChunk(common::ChunkFlags_t({kModel, kIsland})) == engine::kChunkModels);
+	CHECK(engine::ClassifyChunk(common::ChunkFlags_t({kIsland, kFont})) == engine::kChunkIslands);
+	CHECK(engine::ClassifyChunk(common::ChunkFlags_t({kFont, kTexture})) == engine::kChunkFonts);
+	CHECK(engine::ClassifyChunk(common::ChunkFlags_t()) == engine::kChunkOther);
+}
+
+void RejectsBadFiles()
+{
+	std::filesystem::path file = std::filesystem::temp_directory_path() / "ChunkFileTests.bin";
+	std::vector<byte> data;
+	std::unordered_map<common::crc_t, Chunk> chunkMap;
+	ChunkLists chunkLists;
+
+	{
+		std::fstream fileStream(file, std::ios::out | std::ios::binary | std::ios::trunc);
+		common::DataHeader dataHeader {};
+		dataHeader.iVersion = common::DataHeader::kiVersion - 1;
+		fileStream.write(reinterpret_cast<char*>(&dataHeader), sizeof(dataHeader));
+		common::AlignOutputStream(fileStream);
+	}
+	CHECK_THROWS(engine::ReadChunkFile(file, data, chunkMap, chunkLists));
+
+	// Two chunks with the same crc
+	std::vector<TestChunk> chunks {{common::ChunkFlags_t(kModel), 4}, {common::ChunkFlags_t(kModel), 4}};
+	WriteChunkFile(file, chunks);
+	std::fstream fileStream(file, std::ios::in | std::ios::out | std::ios::binary);
+	int64_t iSecondHeader = common::RoundUp(static_cast<int64_t>(sizeof(common::DataHeader)), common::kiAlignmentBytes) + common::RoundUp(static_cast<int64_t>(sizeof(common::ChunkHeader)), common::kiAlignmentBytes) + common::kiAlignmentBytes;
+	common::crc_t crc = common::Crc("Chunk0");
+	fileStream.seekp(iSecondHeader + offsetof(common::ChunkHeader, crc));
+	fileStream.write(reinterpret_cast<char*>(&crc), sizeof(crc));
+	fileStream.close();
+	data.clear();
+	chunkMap.clear();
+	chunkLists = {};
+	CHECK_THROWS(engine::ReadChunkFile(file, data, chunkMap, chunkLists));
+
+	std::filesystem::remove(file);
+}
+
+// The headless run against a packed Data.bin or Textures.bin, skipped without one
+void RealFileMatchesOldFilters()
+{
+	if (gDataFile.empty())
+	{
+		std::printf("No data file given, pass one with -DBT_TEST_DATA=<path>\n");
+		return;
+	}
+
+	std::vector<byte> data;
+	std::unordered_map<common::crc_t, Chunk> chunkMap;
+	ChunkLists chunkLists;
+	auto start = std::chrono::high_resolution_clock::now();
+	engine::ReadChunkFile(gDataFile, data, chunkMap, chunkLists);
+	double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::printf("%s: %lld chunks, %lld bytes read in %.2f ms\n", gDataFile.string().c_str(), static_cast<long long>(chunkMap.size()), static_cast<long long>(data.size()), dMs);
+	std::printf("%zu models, %zu islands, %zu fonts, %zu shaders, %zu textures, %zu other\n", chunkLists[engine::kChunkModels].size(), chunkLists[engine::kChunkIslands].size(), chunkLists[engine::kChunkFonts].size(), chunkLists[engine::kChunkShaders].size(), chunkLists[engine::kChunkTextures].size(), chunkLists[engine::kChunkOther].size());
+
+	// A chunk two managers used to pick up would now only reach one of them
+	CHECK(CheckChunks(data, chunkMap, chunkLists) == 0);
+}
+
+} // namespace
+
+// The packer output isn't in the repository, the synthetic file always runs and a real one is checked too when given
+int main(int iArgc, char** ppcArgv)
+{
+	if (iArgc >= 2 && std::filesystem::exists(ppcArgv[1]))
+	{
+		gDataFile = ppcArgv[1];
+	}
+
+	RUN_TEST(ReadsWhatThePackerWrites);
+	RUN_TEST(SharedFlagsGoToTheFirstKind);
+	RUN_TEST(RejectsBadFiles);
+	RUN_TEST(RealFileMatchesOldFilters);
+	return test::Result();
+}
@@ -0,0 +1,155 @@
+#include "MathUtils.h"
+#include "Frame/Pools/BillboardProjection.h"
+
+using namespace DirectX;
+
+namespace
+{
+
+// ProjectBillboards() gets its rotations from RotationsFromPositions(), see MathUtilsTests for why this is looser away from the axes than needed
+inline constexpr double kdRotationTolerance = 1e-3;
+
+struct Billboards
+{
+	std::vector<XMFLOAT4A> positions;
+	std::vector<float> sizes;
+	std::vector<float> extras;
+	std::vector<float> rotations;
+	std::vector<float> alphas;
+	std::vector<float> textureIndices;
+	std::vector<uint32_t> offscreenOnly;
+	std::vector<uint32_t> offscreenRotate;
+
+	engine::BillboardsSoA SoA()
+	{
+		return {reinterpret_cast<XMVECTOR*>(positions.data()), sizes.data(), extras.data(), rotations.data(), alphas.data(), textureIndices.data(), offscreenOnly.data(), offscreenRotate.data()};
+	}
+};
+
+// Positions on and well off screen, fOffscreenOnly and fOffscreenRotate are the chances of each flag
+Billboards MakeBillboards(std::mt19937& rRandom, int64_t iCount, float fOffscreenOnly, float fOffscreenRotate)
+{
+	auto value = [&rRandom](float fMin, float fMax)
+	{
+		return std::uniform_real_distribution<float>(fMin, fMax)(rRandom);
+	};
+
+	Billboards billboards;
+	for (int64_t i = 0; i < iCount; ++i)
+	{
+		billboards.positions.push_back({value(-150.0f, 150.0f), value(-100.0f, 100.0f), value(0.0f, 10.0f), 1.0f});
+		billboards.sizes.push_back(value(0.01f, 0.1f));
+		billboards.extras.push_back(value(0.0f, 0.2f));
+		billboards.rotations.push_back(value(0.0f, XM_2PI));
+		billboards.alphas.push_back(value(0.0f, 1.0f));
+		billboards.textureIndices.push_back(std::floor(value(0.0f, 64.0f)));
+		billboards.offscreenOnly.push_back(value(0.0f, 1.0f) < fOffscreenOnly ? 0xFFFFFFFF : 0);
+		billboards.offscreenRotate.push_back(value(0.0f, 1.0f) < fOffscreenRotate ? 0xFFFFFFFF : 0);
+	}
+	return billboards;
+}
+
+// The camera of a game frame looking down at the islands
+XMMATRIX ViewProjection()
+{
+	auto matView = XMMatrixLookAtRH(XMVectorSet(3.0f, -20.0f, 80.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f));
+	return XMMatrixMultiply(matView, XMMatrixPerspectiveFovRH(XM_PIDIV4, 16.0f / 9.0f, 1.0f, 1000.0f));
+}
+
+// Both write to the next free slot, so the slots past what was rendered may differ and aren't compared
+void CheckMatchesScalar(Billboards& rBillboards, int64_t& riRendered)
+{
+	static constexpr float kfAspectRatio = 16.0f / 9.0f;
+
+	int64_t iCount = static_cast<int64_t>(rBillboards.positions.size());
+	engine::BillboardsSoA billboards = rBillboards.SoA();
+	XMMATRIX matViewProjection = ViewProjection();
+
+	std::vector<engine::ProjectedBillboard> scalar(iCount);
+	int64_t iScalarRendered = 0;
+	std::vector<int64_t> scalarIndices;
+	for (int64_t i = 0; i < iCount; ++i)
+	{
+		if (engine::ProjectBillboard(scalar.data() + iScalarRendered, billboards, i, matViewProjection, kfAspectRatio) == 1)
+		{
+			scalarIndices.push_back(i);
+			++iScalarRendered;
+		}
+	}
+
+	std::vector<engine::ProjectedBillboard> batched(iCount);
+	int64_t iRendered = engine::ProjectBillboards(batched.data(), billboards, iCount, matViewProjection, kfAspectRatio);
+	CHECK(iRendered == iScalarRendered);
+	if (iRendered != iScalarRendered)
+	{
+		return;
+	}
+
+	int64_t iMismatches = 0;
+	for (int64_t i = 0; i < iRendered; ++i)
+	{
+		const engine::ProjectedBillboard& rScalar = scalar[i];
+		const engine::ProjectedBillboard& rBatched = batched[i];
+
+		// Same operations in the same order, so only the rotation may be off
+		iMismatches += memcmp(&rScalar.f4Position, &rBatched.f4Position, sizeof(XMFLOAT4)) != 0;
+		iMismatches += rScalar.f4Misc.x != rBatched.f4Misc.x || rScalar.f4Misc.y != rBatched.f4Misc.y || rScalar.f4Misc.w != rBatched.f4Misc.w;
+		if (rBillboards.offscreenRotate[scalarIndices[i]] != 0)
+		{
+			CHECK_NEAR(rBatched.f4Misc.z, rScalar.f4Misc.z, kdRotationTolerance);
+		}
+		else
+		{
+			iMismatches += rScalar.f4Misc.z != rBatched.f4Misc.z;
+		}
+	}
+	CHECK(iMismatches == 0);
+
+	riRendered += iRendered;
+}
+
+void MatchesScalarOnRandomBillboards()
+{
+	std::mt19937 random {1234};
+	int64_t iRendered = 0;
+	int64_t iTotal = 0;
+
+	// Counts around the batch size and ones that leave every possible remainder
+	for (int64_t iCount : {0, 1, 2, 3, 4, 5, 7, 8, 9, 63, 64, 66, 1001, 4095})
+	{
+		for (int64_t iRun = 0; iRun < 8; ++iRun)
+		{
+			Billboards billboards = MakeBillboards(random, iCount, 0.4f, 0.4f);
+			CheckMatchesScalar(billboards, iRendered);
+			iTotal += iCount;
+		}
+	}
+
+	// Some are culled and some drawn, otherwise the comparison proves little
+	CHECK(iRendered > 0 && iRendered < iTotal);
+}
+
+// Every billboard offscreen only, like the pointers to enemies outside the view, so most batches mix culled and clamped ones
+void MatchesScalarOffscreenOnly()
+{
+	std::mt19937 random {5678};
+	int64_t iRendered = 0;
+	for (int64_t iCount : {1, 3, 4, 6, 13, 257, 2046})
+	{
+		Billboards billboards = MakeBillboards(random, iCount, 1.0f, 1.0f);
+		CheckMatchesScalar(billboards, iRendered);
+
+		billboards = MakeBillboards(random, iCount, 1.0f, 0.0f);
+		CheckMatchesScalar(billboards, iRendered);
+	}
+	CHECK(iRendered > 0);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(MatchesScalarOnRandomBillboards);
+	RUN_TEST(MatchesScalarOffscreenOnly);
+	return test::Result();
+}
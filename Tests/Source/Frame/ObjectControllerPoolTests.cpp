@@ -0,0 +1,302 @@
+namespace common
+{
+
+// ObjectPool::operator== reports through this, the real one is in Utils.h which needs Windows
+inline void BreakOnNotEqual(bool) {}
+
+} // namespace common
+
+#include "Frame/Pools/ObjectControllerPool.h"
+
+namespace
+{
+
+struct LightInfo
+{
+	float fIntensity = 0.0f;
+
+	static LightInfo Lerp(const LightInfo& rFrom, const LightInfo& rTo, float fPercent)
+	{
+		return {.fIntensity = (1.0f - fPercent) * rFrom.fIntensity + fPercent * rTo.fIntensity};
+	}
+
+	bool operator==(const LightInfo& rOther) const = default;
+};
+
+using light_t = uint32_t;
+inline constexpr light_t kuiMaxLights = 4094;
+using light_controller_t = uint32_t;
+inline constexpr light_controller_t kuiMaxLightControllers = 2046;
+
+using Lights = engine::ObjectPool<LightInfo, int32_t, light_t, kuiMaxLights>;
+using LightControllers = engine::ObjectControllerPool<LightInfo, int32_t, light_t, kuiMaxLights, 3, light_controller_t, kuiMaxLightControllers>;
+using LightControllerInfo = LightControllers::CONTROLLER_T;
+
+inline constexpr float kfDeltaTime = 1.0f / 60.0f;
+
+LightControllerInfo MakeInfo(bool bDestroysSelf, float fDuration)
+{
+	return
+	{
+		.bDestroysSelf = bDestroysSelf,
+		.pfTimes = {0.0f, 0.25f * fDuration, fDuration},
+		.pObjectInfos = {{.fIntensity = 0.0f}, {.fIntensity = 4.0f}, {.fIntensity = 1.0f}},
+	};
+}
+
+// What UpdateMain() did before the heap, every pass checks the end time of every used controller
+void ExpireLinear(LightControllers& rControllers, Lights& rLights, float fCurrentTime)
+{
+	for (light_controller_t i = 1; i <= rControllers.uiMaxIndex; ++i)
+	{
+		if (!rControllers.pbUsed[i] || !rControllers.pObjectInfos[i].bDestroysSelf)
+		{
+			continue;
+		}
+
+		if (fCurrentTime > LightControllers::EndTime(rControllers, i))
+		{
+			light_controller_t uiController = i;
+			rControllers.Remove(rLights, uiController);
+		}
+	}
+}
+
+struct Setup
+{
+	std::unique_ptr<LightControllers> pCurrent = std::make_unique<LightControllers>();
+	std::unique_ptr<LightControllers> pPrevious = std::make_unique<LightControllers>();
+	std::unique_ptr<Lights> pLights = std::make_unique<Lights>();
+	std::mt19937 random {1234};
+	float fTime = 0.0f;
+
+	float Duration()
+	{
+		return std::uniform_real_distribution<float>(0.05f, 5.0f)(random);
+	}
+
+	void Tick()
+	{
+		fTime += kfDeltaTime;
+		LightControllers::UpdateMain(*pCurrent, *pPrevious, *pLights, fTime);
+		std::swap(pCurrent, pPrevious);
+	}
+};
+
+void ExpiresLikeLinearScan()
+{
+	Setup setup;
+
+	// Controllers the test owns, removed early at random or replaced in place with a new duration
+	std::vector<light_controller_t> ownedControllers(64, 0);
+	std::unordered_map<light_controller_t, float> expectedEndTimes;
+
+	for (int64_t iTick = 0; iTick < 3000; ++iTick)
+	{
+		LightControllers& rControllers = *setup.pPrevious;
+
+		for (int64_t i = 0; i < 8; ++i)
+		{
+			float fDuration = setup.Duration();
+			light_controller_t uiController = 0;
+			rControllers.Add(*setup.pLights, uiController, setup.fTime, MakeInfo(true, fDuration));
+			if (uiController != 0)
+			{
+				expectedEndTimes[uiController] = setup.fTime + fDuration;
+			}
+		}
+
+		light_controller_t& ruiOwned = ownedControllers[iTick % ownedControllers.size()];
+		if (iTick % 3 == 0 && ruiOwned != 0)
+		{
+			expectedEndTimes.erase(ruiOwned);
+			rControllers.Remove(*setup.pLights, ruiOwned);
+		}
+		else if (iTick % 3 == 1)
+		{
+			// Turning an owned controller into a self destroying one or back leaves a stale heap entry behind
+			bool bDestroysSelf = iTick % 2 == 0;
+			float fDuration = setup.Duration();
+			bool bNew = ruiOwned == 0;
+			rControllers.Add(*setup.pLights, ruiOwned, setup.fTime, MakeInfo(bDestroysSelf, fDuration));
+			if (ruiOwned != 0)
+			{
+				float fStartTime = bNew ? setup.fTime : rControllers.Get(ruiOwned).fStartTime;
+				expectedEndTimes[ruiOwned] = bDestroysSelf ? fStartTime + fDuration : std::numeric_limits<float>::infinity();
+			}
+		}
+
+		setup.Tick();
+
+		std::erase_if(expectedEndTimes, [&](const auto& rPair)
+		{
+			return setup.fTime > rPair.second;
+		});
+		for (light_controller_t& ruiController : ownedControllers)
+		{
+			if (ruiController != 0 && !expectedEndTimes.contains(ruiController))
+			{
+				ruiController = 0;
+			}
+		}
+
+		const LightControllers& rUpdated = *setup.pPrevious;
+		int64_t iUsed = 0;
+		for (light_controller_t i = 1; i <= rUpdated.uiMaxIndex; ++i)
+		{
+			iUsed += rUpdated.pbUsed[i] ? 1 : 0;
+			CHECK(rUpdated.pbUsed[i] == expectedEndTimes.contains(i));
+		}
+		CHECK(iUsed == static_cast<int64_t>(expectedEndTimes.size()));
+		CHECK(rUpdated.iExpiryCount <= LightControllers::kiMaxExpiries);
+	}
+}
+
+// Expiring by end time instead of by index must leave the same slots in use, otherwise later adds would get other indices and replays would diverge
+void FreesSameSlotsAsLinearScan()
+{
+	Setup setup;
+
+	for (int64_t iTick = 0; iTick < 2000; ++iTick)
+	{
+		// Durations in whole ticks, so controllers added together often end together and expire in the same tick as others
+		for (int64_t i = 0; i < 8; ++i)
+		{
+			float fDuration = kfDeltaTime * std::round(setup.Duration() / (4.0f * kfDeltaTime));
+			setup.pPrevious->Add(*setup.pLights, setup.fTime, MakeInfo(true, fDuration));
+		}
+
+		auto pLinear = std::make_unique<LightControllers>(*setup.pPrevious);
+		auto pLinearLights = std::make_unique<Lights>(*setup.pLights);
+
+		setup.Tick();
+		ExpireLinear(*pLinear, *pLinearLights, setup.fTime);
+
+		const LightControllers& rUpdated = *setup.pPrevious;
+		CHECK(rUpdated.uiMaxIndex == pLinear->uiMaxIndex);
+		CHECK(setup.pLights->uiMaxIndex == pLinearLights->uiMaxIndex);
+		CHECK(memcmp(rUpdated.pbUsed, pLinear->pbUsed, sizeof(rUpdated.pbUsed)) == 0);
+		CHECK(memcmp(setup.pLights->pbUsed, pLinearLights->pbUsed, sizeof(pLinearLights->pbUsed)) == 0);
+	}
+}
+
+void LerpsFromCachedKeyframe()
+{
+	Setup setup;
+
+	light_controller_t uiController = 0;
+	setup.pPrevious->Add(*setup.pLights, uiController, setup.fTime, MakeInfo(false, 1.0f));
+	const light_t uiLight = setup.pPrevious->Get(uiController).objectIndex;
+
+	// Keyframes at 0, 0.25 and 1 seconds with intensities 0, 4 and 1
+	for (int64_t iTick = 0; iTick < 90; ++iTick)
+	{
+		setup.Tick();
+
+		float fElapsed = setup.fTime;
+		float fExpected = fElapsed < 0.25f ? 4.0f * fElapsed / 0.25f : fElapsed < 1.0f ? 4.0f - 3.0f * (fElapsed - 0.25f) / 0.75f : 1.0f;
+		if (fElapsed < 1.0f)
+		{
+			CHECK_NEAR(setup.pLights->GetInfo(uiLight).fIntensity, fExpected, 1e-4);
+		}
+	}
+
+	// Past the last keyframe the object keeps the last lerped value and the controller stays
+	CHECK(setup.pPrevious->pbUsed[uiController]);
+}
+
+// The simulation thread runs its Multithread<> buckets while the main thread adds to and removes from the kMain frame
+void GuardIsPerThread()
+{
+	Setup setup;
+
+	std::atomic<bool> bRaised = false;
+	std::atomic<bool> bDone = false;
+	std::thread simulation([&]()
+	{
+		++engine::giMultithreading;
+		bRaised = true;
+		while (!bDone)
+		{
+			std::this_thread::yield();
+		}
+		--engine::giMultithreading;
+	});
+	while (!bRaised)
+	{
+		std::this_thread::yield();
+	}
+
+	light_controller_t uiController = 0;
+	setup.pPrevious->Add(*setup.pLights, uiController, setup.fTime, MakeInfo(false, 1.0f));
+	CHECK(uiController != 0);
+	setup.pPrevious->Remove(*setup.pLights, uiController);
+	CHECK(uiController == 0);
+
+	bDone = true;
+	simulation.join();
+
+	// From inside a bucket on this thread it still has to fail
+	++engine::giMultithreading;
+	CHECK_THROWS(setup.pPrevious->Add(*setup.pLights, uiController, setup.fTime, MakeInfo(false, 1.0f)));
+	--engine::giMultithreading;
+}
+
+// Not a pass or fail check, prints the cost of a pass with the heap against the linear end time scan it replaced
+void BenchmarkExpiry()
+{
+	static constexpr int64_t kiTicks = 600;
+
+	auto run = [](bool bLinear)
+	{
+		Setup setup;
+		std::chrono::nanoseconds total {};
+		for (int64_t iTick = 0; iTick < kiTicks; ++iTick)
+		{
+			// Keep the pool close to full, like a heavy fight
+			while (setup.pPrevious->uiMaxIndex < kuiMaxLightControllers - 8)
+			{
+				setup.pPrevious->Add(*setup.pLights, setup.fTime, MakeInfo(true, setup.Duration()));
+			}
+			for (int64_t i = 0; i < 8; ++i)
+			{
+				setup.pPrevious->Add(*setup.pLights, setup.fTime, MakeInfo(true, setup.Duration()));
+			}
+
+			auto start = std::chrono::high_resolution_clock::now();
+			if (bLinear)
+			{
+				// The old pass, the heap is emptied so UpdateMain() only does the copy and the lerps
+				setup.pPrevious->iExpiryCount = 0;
+				ExpireLinear(*setup.pPrevious, *setup.pLights, setup.fTime + kfDeltaTime);
+			}
+			setup.Tick();
+			total += std::chrono::high_resolution_clock::now() - start;
+		}
+		return total / kiTicks;
+	};
+
+	// Warm up, then take the faster of a few runs
+	run(false);
+	std::chrono::nanoseconds heap = std::chrono::nanoseconds::max();
+	std::chrono::nanoseconds linear = std::chrono::nanoseconds::max();
+	for (int64_t i = 0; i < 3; ++i)
+	{
+		heap = std::min(heap, run(false));
+		linear = std::min(linear, run(true));
+	}
+
+	std::printf("UpdateMain() with %u controllers: heap %lld ns, linear scan %lld ns\n", static_cast<unsigned>(kuiMaxLightControllers), static_cast<long long>(heap.count()), static_cast<long long>(linear.count()));
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(ExpiresLikeLinearScan);
+	RUN_TEST(FreesSameSlotsAsLinearScan);
+	RUN_TEST(LerpsFromCachedKeyframe);
+	RUN_TEST(GuardIsPerThread);
+	RUN_TEST(BenchmarkExpiry);
+	return test::Result();
+}
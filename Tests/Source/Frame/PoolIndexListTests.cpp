@@ -0,0 +1,196 @@
+namespace common
+{
+
+// ObjectPool::operator== reports through this, the real one is in Utils.h which needs Windows
+inline void BreakOnNotEqual(bool) {}
+
+} // namespace common
+
+#include "Frame/Pools/ObjectPool.h"
+#include "Frame/Pools/PoolIndexList.h"
+
+namespace
+{
+
+// What the armor pickups need from BillboardInfo and Billboard
+struct PickupInfo
+{
+	bool bArmor = false;
+	float fAlpha = 1.0f;
+	int64_t iSpawn = 0;
+
+	bool operator==(const PickupInfo& rOther) const = default;
+};
+
+struct Pickup
+{
+	float fTime = 0.0f;
+
+	bool operator==(const Pickup& rOther) const = default;
+};
+
+// Release pool size, with the index type of ENABLE_NAVMESH_DISPLAY builds
+using billboard_t = uint32_t;
+inline constexpr billboard_t kuiMaxBillboards = 2046;
+inline constexpr int64_t kiMaxPickups = 256;
+
+using Billboards = engine::ObjectPool<PickupInfo, Pickup, billboard_t, kuiMaxBillboards>;
+using Pickups = engine::PoolIndexList<billboard_t, kiMaxPickups>;
+
+// What Player::PostRender() did before the list, every used armor billboard in index order
+std::vector<billboard_t> SweepArmor(const Billboards& rBillboards)
+{
+	std::vector<billboard_t> armor;
+	for (billboard_t i = 1; i <= rBillboards.uiMaxIndex; ++i)
+	{
+		if (rBillboards.pbUsed[i] && rBillboards.pObjectInfos[i].bArmor)
+		{
+			armor.push_back(i);
+		}
+	}
+	return armor;
+}
+
+struct Game
+{
+	std::unique_ptr<Billboards> pBillboards = std::make_unique<Billboards>();
+	Pickups pickups;
+	std::vector<billboard_t> otherBillboards;
+	std::mt19937 random {1234};
+	int64_t iSpawns = 0;
+
+	bool Chance(float fChance)
+	{
+		return std::uniform_real_distribution<float>(0.0f, 1.0f)(random) < fChance;
+	}
+
+	// Same as Frame::SpawnPickup()
+	void SpawnPickup()
+	{
+		if (pickups.Full())
+		{
+			billboard_t uiOldest = pickups.TakeOldest();
+			pBillboards->Remove(uiOldest);
+		}
+
+		billboard_t uiBillboard = 0;
+		pBillboards->Add(uiBillboard, {.bArmor = true, .iSpawn = iSpawns++});
+		if (uiBillboard != 0)
+		{
+			pickups.Add(uiBillboard);
+		}
+	}
+
+	// Spaceship and navmesh billboards come and go in between the pickups
+	void SpawnOther()
+	{
+		billboard_t uiBillboard = 0;
+		pBillboards->Add(uiBillboard, {});
+		otherBillboards.push_back(uiBillboard);
+	}
+
+	// Same structure as Player::Interpolate() and Player::PostRender(), fading and pickup decided at random
+	void Tick(float fPickupChance)
+	{
+		for (int64_t i = 0; i < pickups.iCount; ++i)
+		{
+			pBillboards->Get(pickups.puiIndices[i]).fTime += 1.0f / 60.0f;
+			if (Chance(0.05f))
+			{
+				pBillboards->GetInfo(pickups.puiIndices[i]).fAlpha = 0.0f;
+			}
+		}
+
+		pickups.Compact([&](billboard_t uiBillboard)
+		{
+			if (pBillboards->GetInfo(uiBillboard).fAlpha <= 0.0f || Chance(fPickupChance))
+			{
+				pBillboards->Remove(uiBillboard);
+				return false;
+			}
+			return true;
+		});
+	}
+};
+
+void MatchesPoolSweep()
+{
+	Game game;
+	for (int64_t iTick = 0; iTick < 5000; ++iTick)
+	{
+		// Bursts of kills now and then
+		int64_t iSpawns = iTick % 500 < 20 ? 12 : 1;
+		for (int64_t i = 0; i < iSpawns; ++i)
+		{
+			if (game.Chance(0.5f))
+			{
+				game.SpawnPickup();
+			}
+			if (game.Chance(0.5f))
+			{
+				game.SpawnOther();
+			}
+		}
+		if (!game.otherBillboards.empty() && game.Chance(0.8f))
+		{
+			size_t uiOther = std::uniform_int_distribution<size_t>(0, game.otherBillboards.size() - 1)(game.random);
+			game.pBillboards->Remove(game.otherBillboards[uiOther]);
+			game.otherBillboards.erase(game.otherBillboards.begin() + static_cast<ptrdiff_t>(uiOther));
+		}
+
+		game.Tick(0.02f);
+
+		// Same billboards as the sweep finds, in the order they were spawned
+		std::vector<billboard_t> listed(&game.pickups.puiIndices[0], &game.pickups.puiIndices[game.pickups.iCount]);
+		for (size_t i = 1; i < listed.size(); ++i)
+		{
+			CHECK(game.pBillboards->GetInfo(listed[i - 1]).iSpawn < game.pBillboards->GetInfo(listed[i]).iSpawn);
+		}
+		std::sort(listed.begin(), listed.end());
+		CHECK(listed == SweepArmor(*game.pBillboards));
+	}
+}
+
+// Nothing is picked up or fades, a full list drops the oldest pickup from the pool and keeps the newest ones
+void FullListDropsOldest()
+{
+	Game game;
+	for (int64_t i = 0; i < kiMaxPickups + 10; ++i)
+	{
+		game.SpawnPickup();
+	}
+
+	CHECK(game.pickups.iCount == kiMaxPickups);
+	CHECK(game.pBillboards->GetInfo(game.pickups.puiIndices[0]).iSpawn == 10);
+	CHECK(game.pBillboards->GetInfo(game.pickups.puiIndices[kiMaxPickups - 1]).iSpawn == kiMaxPickups + 9);
+	CHECK(SweepArmor(*game.pBillboards).size() == static_cast<size_t>(kiMaxPickups));
+}
+
+// Frames compare lists by the entries in use, a compaction leaves old entries behind
+void ComparesUsedEntries()
+{
+	Pickups first;
+	Pickups second;
+	for (billboard_t i = 1; i <= 4; ++i)
+	{
+		first.Add(i);
+		second.Add(i);
+	}
+	first.Compact([](billboard_t uiBillboard){ return uiBillboard != 4; });
+	second.Compact([](billboard_t uiBillboard){ return uiBillboard != 4; });
+	second.puiIndices[3] = 0;
+	CHECK(first == second);
+
+	second.Compact([](billboard_t uiBillboard){ return uiBillboard != 1; });
+	CHECK(!(first == second));
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(MatchesPoolSweep);
+	RUN_TEST(FullListDropsOldest);
+	RUN_TEST(ComparesUsedEntries);
+	return test::Result();
+}
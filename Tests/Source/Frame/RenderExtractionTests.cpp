@@ -0,0 +1,532 @@
+namespace common
+{
+
+// ObjectPool::operator== reports through this, the real one is in Utils.h which needs Windows
+inline void BreakOnNotEqual(bool) {}
+
+} // namespace common
+
+#include "MathUtils.h"
+#include "Frame/Pools/ObjectPool.h"
+#include "Frame/Pools/RenderExtraction.h"
+
+using namespace DirectX;
+
+namespace
+{
+
+// Same members as the engine's infos
+struct AreaLightInfo
+{
+	bool bAlwaysVisible = false;
+	uint32_t crc = 0;
+	uint32_t puiColors[4] {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+	XMFLOAT2 pf2Texcoords[4] {};
+	XMVECTOR pVecVisiblePositions[4] {};
+	float fVisibleIntensity = 0.0f;
+	XMVECTOR pVecLightingPositions[4] {};
+	float fLightingIntensity = 0.0f;
+	XMVECTOR vecDirectionMultipliers {1.0f, 1.0f, 1.0f, 1.0f};
+};
+struct PointLightInfo
+{
+	XMVECTOR vecPosition {};
+	uint32_t uiColor = 0xFFFFFFFF;
+	float fVisibleArea = 0.0f;
+	float fVisibleIntensity = 0.0f;
+	float fLightingArea = 0.0f;
+	float fLightingIntensity = 0.0f;
+	uint32_t crc = 0;
+	float fRotation = 0.0f;
+};
+struct PuffInfo
+{
+	XMVECTOR vecPosition {};
+	float fIntensity = 0.0f;
+	float fArea = 0.0f;
+	float fCookie = 0.0f;
+};
+struct TrailInfo
+{
+	XMVECTOR vecPosition {};
+	float fIntensity = 0.0f;
+	float fWidth = 1.0f;
+};
+struct Empty
+{
+};
+
+// Same layouts as shaders::VisibleLightQuadLayout, shaders::QuadLayout and shaders::AxisAlignedQuadLayout
+struct VisibleLightQuadLayout
+{
+	XMFLOAT4 pf4Vertices[4] {};
+	XMFLOAT4 pf4Texcoords[4] {};
+	uint32_t puiColors[4] {};
+	float fIntensity = 0.0f;
+	float fRotation = 0.0f;
+	float fPad2 = 0.0f;
+	float fPad3 = 0.0f;
+	uint32_t uiTextureIndex = 0;
+	uint32_t uiPad1 = 0;
+	uint32_t uiPad2 = 0;
+	uint32_t uiPad3 = 0;
+};
+struct QuadLayout
+{
+	XMFLOAT4 pf4VerticesTexcoords[4] {};
+	XMFLOAT4 pf4Misc[4] {};
+	XMFLOAT4 f4Misc {};
+	uint32_t uiColor = 0;
+	uint32_t uiPad1 = 0;
+	uint32_t uiPad2 = 0;
+	uint32_t uiPad3 = 0;
+};
+struct AxisAlignedQuadLayout
+{
+	XMFLOAT4 f4VertexRect {};
+	XMFLOAT4 f4TextureRect {};
+	XMFLOAT4 f4Misc {};
+	uint32_t uiColor = 0;
+	uint32_t uiPad1 = 0;
+	uint32_t uiPad2 = 0;
+	uint32_t uiPad3 = 0;
+};
+
+using pool_t = uint32_t;
+inline constexpr pool_t kuiMaxObjects = 4094;
+
+using AreaLights = engine::ObjectPool<AreaLightInfo, Empty, pool_t, kuiMaxObjects>;
+using PointLights = engine::ObjectPool<PointLightInfo, Empty, pool_t, kuiMaxObjects>;
+using Puffs = engine::ObjectPool<PuffInfo, Empty, pool_t, kuiMaxObjects>;
+using Trails = engine::ObjectPool<TrailInfo, Empty, pool_t, kuiMaxObjects>;
+
+inline constexpr XMFLOAT4 kf4VisibleArea {-100.0f, 60.0f, 100.0f, -60.0f};
+inline constexpr float kfBaseHeight = 0.5f;
+const XMVECTOR kVecEyePosition = XMVectorSet(3.0f, -20.0f, 80.0f, 1.0f);
+
+// Stands in for Islands::GlobalElevation() and CrcToIndex()
+float Elevation(FXMVECTOR vecPosition)
+{
+	XMFLOAT4A f4Position {};
+	XMStoreFloat4A(&f4Position, vecPosition);
+	return 3.0f * std::sin(0.1f * f4Position.x) * std::cos(0.13f * f4Position.y);
+}
+
+XMVECTOR XM_CALLCONV BaseHeight(FXMVECTOR vecPosition)
+{
+	return common::ToBaseHeight(vecPosition, kVecEyePosition, std::max(Elevation(vecPosition), kfBaseHeight));
+}
+
+float TextureIndex(uint32_t crc)
+{
+	return static_cast<float>(crc % 97);
+}
+
+void BaseHeights(XMVECTOR* pVecPositions, int64_t iCount)
+{
+	for (int64_t i = 0; i < iCount; ++i)
+	{
+		pVecPositions[i] = BaseHeight(pVecPositions[i]);
+	}
+}
+
+struct Scene
+{
+	std::unique_ptr<AreaLights> pAreaLights = std::make_unique<AreaLights>();
+	std::unique_ptr<PointLights> pPointLights = std::make_unique<PointLights>();
+	std::unique_ptr<Puffs> pPuffs = std::make_unique<Puffs>();
+	std::unique_ptr<Trails> pTrails = std::make_unique<Trails>();
+	std::vector<XMFLOAT4A> previousTrailPositions = std::vector<XMFLOAT4A>(kuiMaxObjects + 2);
+};
+
+// Positions well outside the visible area, along its edges and inside it, with removed objects in between
+Scene MakeScene(uint32_t uiSeed, int64_t iCount)
+{
+	std::mt19937 random(uiSeed);
+	auto position = [&random]()
+	{
+		std::uniform_real_distribution<float> distributionX(-160.0f, 160.0f);
+		std::uniform_real_distribution<float> distributionY(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> distributionZ(0.0f, 10.0f);
+		return XMVectorSet(distributionX(random), distributionY(random), distributionZ(random), 1.0f);
+	};
+	auto value = [&random](float fMax)
+	{
+		return std::uniform_real_distribution<float>(0.0f, fMax)(random);
+	};
+
+	Scene scene;
+	for (int64_t i = 0; i < iCount; ++i)
+	{
+		AreaLightInfo areaLight {.bAlwaysVisible = value(1.0f) < 0.05f, .crc = static_cast<uint32_t>(random()), .fVisibleIntensity = value(2.0f), .fLightingIntensity = value(2.0f)};
+		XMVECTOR vecCenter = position();
+		for (int64_t j = 0; j < 4; ++j)
+		{
+			XMVECTOR vecCorner = XMVectorSet(j % 2 == 0 ? -8.0f : 8.0f, j < 2 ? 8.0f : -8.0f, 0.0f, 0.0f);
+			areaLight.puiColors[j] = static_cast<uint32_t>(random());
+			areaLight.pf2Texcoords[j] = {j % 2 == 0 ? 0.0f : 1.0f, j < 2 ? 0.0f : 1.0f};
+			areaLight.pVecVisiblePositions[j] = XMVectorAdd(vecCenter, vecCorner);
+			areaLight.pVecLightingPositions[j] = XMVectorAdd(vecCenter, XMVectorScale(vecCorner, 1.5f));
+		}
+		areaLight.vecDirectionMultipliers = XMVectorSet(value(1.0f), value(1.0f), value(1.0f), value(1.0f));
+		// Add() only looks for a free slot when the index is 0, every pool gets the same slot
+		pool_t uiIndex = 0;
+		scene.pAreaLights->Add(uiIndex, areaLight);
+		uiIndex = 0;
+		scene.pPointLights->Add(uiIndex, {.vecPosition = position(), .uiColor = static_cast<uint32_t>(random()), .fVisibleArea = value(5.0f), .fVisibleIntensity = value(2.0f), .fLightingArea = value(20.0f), .fLightingIntensity = value(2.0f), .crc = static_cast<uint32_t>(random()), .fRotation = value(6.0f)});
+		uiIndex = 0;
+		scene.pPuffs->Add(uiIndex, {.vecPosition = position(), .fIntensity = value(1.0f), .fArea = value(10.0f), .fCookie = value(4.0f)});
+		uiIndex = 0;
+		scene.pTrails->Add(uiIndex, {.vecPosition = position(), .fIntensity = value(1.0f), .fWidth = value(2.0f)});
+		XMStoreFloat4A(&scene.previousTrailPositions[uiIndex], position());
+	}
+
+	// Holes in the pools
+	for (pool_t i = 1; i <= static_cast<pool_t>(iCount); ++i)
+	{
+		if (value(1.0f) < 0.3f)
+		{
+			pool_t uiIndex = i;
+			scene.pAreaLights->Remove(uiIndex);
+			uiIndex = i;
+			scene.pPointLights->Remove(uiIndex);
+			uiIndex = i;
+			scene.pPuffs->Remove(uiIndex);
+			uiIndex = i;
+			scene.pTrails->Remove(uiIndex);
+		}
+	}
+	return scene;
+}
+
+struct Lights
+{
+	std::vector<VisibleLightQuadLayout> visibleLayouts;
+	std::vector<QuadLayout> areaLayouts;
+	std::vector<AxisAlignedQuadLayout> pointLayouts;
+	int64_t iLightCount = 0;
+	int64_t iAreaLightsRendered = 0;
+};
+
+// What RenderLightingMain() did before the extraction was bucketed
+Lights OldLights(const AreaLights& rAreaLights, const PointLights& rPointLights)
+{
+	Lights lights;
+	lights.visibleLayouts.resize(2 * kuiMaxObjects);
+	lights.areaLayouts.resize(kuiMaxObjects);
+	lights.pointLayouts.resize(kuiMaxObjects);
+	int64_t iVisibleLightsRendered = 0;
+
+	for (pool_t i = 0; i <= rAreaLights.uiMaxIndex; ++i)
+	{
+		if (!rAreaLights.pbUsed[i])
+		{
+			continue;
+		}
+
+		const AreaLightInfo& rAreaLightInfo = rAreaLights.pObjectInfos[i];
+
+		++lights.iLightCount;
+
+		VisibleLightQuadLayout& rVisibleLightQuadLayout = lights.visibleLayouts[iVisibleLightsRendered];
+		QuadLayout& rAreaLightQuadLayout = lights.areaLayouts[lights.iAreaLightsRendered];
+
+		bool bInVisibleArea = rAreaLightInfo.bAlwaysVisible;
+		for (int64_t j = 0; j < 4; ++j)
+		{
+			XMFLOAT4A f4Position {};
+			XMStoreFloat4A(&f4Position, rAreaLightInfo.pVecVisiblePositions[j]);
+			if (!(f4Position.x < kf4VisibleArea.x || f4Position.x > kf4VisibleArea.z || f4Position.y > kf4VisibleArea.y || f4Position.y < kf4VisibleArea.w))
+			{
+				bInVisibleArea = true;
+			}
+
+			rVisibleLightQuadLayout.pf4Vertices[j] = f4Position;
+			rVisibleLightQuadLayout.pf4Texcoords[j] = {rAreaLightInfo.pf2Texcoords[j].x, rAreaLightInfo.pf2Texcoords[j].y, 0.0f, 0.0f};
+
+			XMStoreFloat4A(&f4Position, BaseHeight(rAreaLightInfo.pVecLightingPositions[j]));
+			rAreaLightQuadLayout.pf4VerticesTexcoords[j] = {f4Position.x, f4Position.y, rAreaLightInfo.pf2Texcoords[j].x, rAreaLightInfo.pf2Texcoords[j].y};
+
+			rVisibleLightQuadLayout.puiColors[j] = rAreaLightInfo.puiColors[j];
+		}
+
+		if (!bInVisibleArea)
+		{
+			continue;
+		}
+
+		rVisibleLightQuadLayout.fIntensity = rAreaLightInfo.fVisibleIntensity;
+		rVisibleLightQuadLayout.fRotation = 0.0f;
+		rVisibleLightQuadLayout.uiTextureIndex = static_cast<uint32_t>(TextureIndex(rAreaLightInfo.crc));
+
+		XMFLOAT4A f4Misc {};
+		f4Misc.x = TextureIndex(rAreaLightInfo.crc);
+		f4Misc.y = rAreaLightInfo.fLightingIntensity;
+		rAreaLightQuadLayout.pf4Misc[0] = rAreaLightQuadLayout.pf4Misc[1] = rAreaLightQuadLayout.pf4Misc[2] = rAreaLightQuadLayout.pf4Misc[3] = f4Misc;
+		XMStoreFloat4(&rAreaLightQuadLayout.f4Misc, rAreaLightInfo.vecDirectionMultipliers);
+		rAreaLightQuadLayout.uiColor = rAreaLightInfo.puiColors[0];
+
+		++iVisibleLightsRendered;
+		++lights.iAreaLightsRendered;
+	}
+
+	int64_t iPointLightsRendered = 0;
+	for (pool_t i = 0; i <= rPointLights.uiMaxIndex; ++i)
+	{
+		if (!rPointLights.pbUsed[i])
+		{
+			continue;
+		}
+
+		const PointLightInfo& rPointLightInfo = rPointLights.pObjectInfos[i];
+
+		++lights.iLightCount;
+
+		XMFLOAT4A f4Position {};
+		XMStoreFloat4A(&f4Position, rPointLightInfo.vecPosition);
+		if (f4Position.x < kf4VisibleArea.x || f4Position.x > kf4VisibleArea.z || f4Position.y > kf4VisibleArea.y || f4Position.y < kf4VisibleArea.w)
+		{
+			continue;
+		}
+
+		XMFLOAT4 f4VertexRect = {f4Position.x - rPointLightInfo.fVisibleArea, f4Position.y + rPointLightInfo.fVisibleArea, 2.0f * rPointLightInfo.fVisibleArea, -2.0f * rPointLightInfo.fVisibleArea};
+
+		VisibleLightQuadLayout& rVisibleLightQuadLayout = lights.visibleLayouts[iVisibleLightsRendered];
+		rVisibleLightQuadLayout.pf4Vertices[0] = {f4VertexRect.x, f4VertexRect.y, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Vertices[1] = {f4VertexRect.x + f4VertexRect.z, f4VertexRect.y, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Vertices[2] = {f4VertexRect.x, f4VertexRect.y + f4VertexRect.w, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Vertices[3] = {f4VertexRect.x + f4VertexRect.z, f4VertexRect.y + f4VertexRect.w, f4Position.z, 1.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[0] = {0.0f, 0.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[1] = {1.0f, 0.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[2] = {0.0f, 1.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.pf4Texcoords[3] = {1.0f, 1.0f, 0.0f, 0.0f};
+		rVisibleLightQuadLayout.fIntensity = rPointLightInfo.fVisibleIntensity;
+		rVisibleLightQuadLayout.fRotation = rPointLightInfo.fRotation;
+		// The old loop left the fourth color to whatever the buffer held, the extraction writes all four
+		rVisibleLightQuadLayout.puiColors[0] = rVisibleLightQuadLayout.puiColors[1] = rVisibleLightQuadLayout.puiColors[2] = rVisibleLightQuadLayout.puiColors[3] = rPointLightInfo.uiColor;
+		rVisibleLightQuadLayout.uiTextureIndex = static_cast<uint32_t>(TextureIndex(rPointLightInfo.crc));
+
+		XMStoreFloat4A(&f4Position, BaseHeight(rPointLightInfo.vecPosition));
+
+		XMFLOAT4A f4Misc {};
+		f4Misc.x = TextureIndex(rPointLightInfo.crc);
+		f4Misc.y = rPointLightInfo.fLightingIntensity;
+		f4Misc.z = rPointLightInfo.fRotation;
+
+		AxisAlignedQuadLayout& rLightingQuadLayout = lights.pointLayouts[iPointLightsRendered];
+		rLightingQuadLayout.f4VertexRect = {f4Position.x - rPointLightInfo.fLightingArea, f4Position.y + rPointLightInfo.fLightingArea, 2.0f * rPointLightInfo.fLightingArea, -2.0f * rPointLightInfo.fLightingArea};
+		rLightingQuadLayout.f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
+		rLightingQuadLayout.f4Misc = f4Misc;
+		rLightingQuadLayout.uiColor = rPointLightInfo.uiColor;
+
+		++iVisibleLightsRendered;
+		++iPointLightsRendered;
+	}
+
+	lights.visibleLayouts.resize(iVisibleLightsRendered);
+	lights.areaLayouts.resize(lights.iAreaLightsRendered);
+	lights.pointLayouts.resize(iPointLightsRendered);
+	return lights;
+}
+
+// The engine keeps positions in workbuffers, a vector of XMVECTOR would drop its alignment attribute with GCC
+XMVECTOR* Vectors(std::vector<XMFLOAT4A>& rVectors)
+{
+	return reinterpret_cast<XMVECTOR*>(rVectors.data());
+}
+
+// Same split as RenderBuckets()
+std::vector<int64_t> BucketStarts(int64_t iCount, int64_t iBuckets)
+{
+	std::vector<int64_t> starts(iBuckets + 1);
+	for (int64_t i = 0; i <= iBuckets; ++i)
+	{
+		starts[i] = (iCount * i) / iBuckets;
+	}
+	return starts;
+}
+
+// What RenderLightingMain() does now, the buckets are run one after the other and packed like it packs them
+Lights BucketedLights(const AreaLights& rAreaLights, const PointLights& rPointLights, int64_t iBuckets)
+{
+	Lights lights;
+
+	int64_t iAreaLightCount = rAreaLights.uiMaxIndex + 1;
+	std::vector<XMFLOAT4A> areaPositions(4 * iAreaLightCount);
+	std::vector<VisibleLightQuadLayout> visibleAreaLayouts(iAreaLightCount);
+	std::vector<QuadLayout> areaLayouts(iAreaLightCount);
+	std::vector<int64_t> areaVisible(iAreaLightCount);
+	std::vector<int64_t> starts = BucketStarts(iAreaLightCount, iBuckets);
+	for (int64_t i = 0; i < iBuckets; ++i)
+	{
+		int64_t iStart = starts[i];
+		auto [iUsed, iRendered] = engine::ExtractAreaLights(visibleAreaLayouts.data() + iStart, areaLayouts.data() + iStart, areaVisible.data() + iStart, Vectors(areaPositions) + 4 * iStart, iStart, starts[i + 1], rAreaLights, kf4VisibleArea, BaseHeights, TextureIndex);
+		lights.visibleLayouts.insert(lights.visibleLayouts.end(), &visibleAreaLayouts[iStart], &visibleAreaLayouts[iStart] + iRendered);
+		lights.areaLayouts.insert(lights.areaLayouts.end(), &areaLayouts[iStart], &areaLayouts[iStart] + iRendered);
+		lights.iLightCount += iUsed;
+		lights.iAreaLightsRendered += iRendered;
+	}
+
+	int64_t iPointLightCount = rPointLights.uiMaxIndex + 1;
+	std::vector<XMFLOAT4A> pointPositions(iPointLightCount);
+	std::vector<VisibleLightQuadLayout> visiblePointLayouts(iPointLightCount);
+	std::vector<AxisAlignedQuadLayout> pointLayouts(iPointLightCount);
+	std::vector<int64_t> pointVisible(iPointLightCount);
+	starts = BucketStarts(iPointLightCount, iBuckets);
+	for (int64_t i = 0; i < iBuckets; ++i)
+	{
+		int64_t iStart = starts[i];
+		auto [iUsed, iRendered] = engine::ExtractPointLights(visiblePointLayouts.data() + iStart, pointLayouts.data() + iStart, pointVisible.data() + iStart, Vectors(pointPositions) + iStart, iStart, starts[i + 1], rPointLights, kf4VisibleArea, BaseHeights, TextureIndex);
+		lights.visibleLayouts.insert(lights.visibleLayouts.end(), &visiblePointLayouts[iStart], &visiblePointLayouts[iStart] + iRendered);
+		lights.pointLayouts.insert(lights.pointLayouts.end(), &pointLayouts[iStart], &pointLayouts[iStart] + iRendered);
+		lights.iLightCount += iUsed;
+	}
+
+	return lights;
+}
+
+template<typename T>
+bool SameBytes(const std::vector<T>& rOne, const std::vector<T>& rTwo)
+{
+	return rOne.size() == rTwo.size() && (rOne.empty() || memcmp(rOne.data(), rTwo.data(), rOne.size() * sizeof(T)) == 0);
+}
+
+void LightsMatchOldLoop()
+{
+	for (int64_t iCount : {0, 1, 5, 300, 4000})
+	{
+		Scene scene = MakeScene(static_cast<uint32_t>(iCount), iCount);
+		Lights old = OldLights(*scene.pAreaLights, *scene.pPointLights);
+		for (int64_t iBuckets : {1, 3, 7, 16})
+		{
+			if (iBuckets > scene.pAreaLights->uiMaxIndex + 1)
+			{
+				continue;
+			}
+
+			Lights bucketed = BucketedLights(*scene.pAreaLights, *scene.pPointLights, iBuckets);
+			CHECK(bucketed.iLightCount == old.iLightCount);
+			CHECK(bucketed.iAreaLightsRendered == old.iAreaLightsRendered);
+			CHECK(SameBytes(bucketed.visibleLayouts, old.visibleLayouts));
+			CHECK(SameBytes(bucketed.areaLayouts, old.areaLayouts));
+			CHECK(SameBytes(bucketed.pointLayouts, old.pointLayouts));
+		}
+
+		// Some of each kind are culled and some drawn
+		if (iCount >= 300)
+		{
+			CHECK(old.iAreaLightsRendered > 0 && old.iAreaLightsRendered < old.iLightCount / 2);
+			CHECK(old.pointLayouts.size() > 0);
+		}
+	}
+}
+
+// What RenderSmokeMain() did with the puffs and the trail positions, the random rotations are left out since they're drawn serially in both
+void SmokeMatchesOldLoop()
+{
+	static constexpr XMFLOAT4 kf4SmokeArea {-120.0f, 70.0f, 120.0f, -70.0f};
+
+	for (int64_t iCount : {0, 1, 5, 300, 4000})
+	{
+		Scene scene = MakeScene(static_cast<uint32_t>(iCount) + 100, iCount);
+		const Puffs& rPuffs = *scene.pPuffs;
+		const Trails& rTrails = *scene.pTrails;
+
+		std::vector<AxisAlignedQuadLayout> oldPuffs;
+		int64_t iOldPuffCount = 0;
+		for (pool_t i = 0; i <= rPuffs.uiMaxIndex; ++i)
+		{
+			if (!rPuffs.pbUsed[i])
+			{
+				continue;
+			}
+
+			const PuffInfo& rPuffInfo = rPuffs.pObjectInfos[i];
+
+			++iOldPuffCount;
+
+			XMFLOAT4A f4Position {};
+			XMStoreFloat4A(&f4Position, rPuffInfo.vecPosition);
+			if (f4Position.x < kf4SmokeArea.x || f4Position.x > kf4SmokeArea.z || f4Position.y > kf4SmokeArea.y || f4Position.y < kf4SmokeArea.w)
+			{
+				continue;
+			}
+
+			XMStoreFloat4A(&f4Position, BaseHeight(rPuffInfo.vecPosition));
+
+			AxisAlignedQuadLayout& rLayout = oldPuffs.emplace_back();
+			rLayout.f4VertexRect = {f4Position.x - rPuffInfo.fArea, f4Position.y + rPuffInfo.fArea, 2.0f * rPuffInfo.fArea, -2.0f * rPuffInfo.fArea};
+			rLayout.f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f};
+			rLayout.f4Misc = {rPuffInfo.fIntensity, 1.0f, rPuffInfo.fCookie, 0.0f};
+		}
+
+		int64_t iPuffSlots = rPuffs.uiMaxIndex + 1;
+		for (int64_t iBuckets : {1, 3, 7, 16})
+		{
+			if (iBuckets > iPuffSlots)
+			{
+				continue;
+			}
+
+			std::vector<XMFLOAT4A> positions(iPuffSlots);
+			std::vector<AxisAlignedQuadLayout> scratchLayouts(iPuffSlots);
+			std::vector<int64_t> visible(iPuffSlots);
+			std::vector<AxisAlignedQuadLayout> puffs;
+			int64_t iPuffCount = 0;
+			std::vector<int64_t> starts = BucketStarts(iPuffSlots, iBuckets);
+			for (int64_t i = 0; i < iBuckets; ++i)
+			{
+				int64_t iStart = starts[i];
+				auto [iUsed, iRendered] = engine::ExtractPuffs(scratchLayouts.data() + iStart, visible.data() + iStart, Vectors(positions) + iStart, iStart, starts[i + 1], rPuffs, kf4SmokeArea, BaseHeights);
+				puffs.insert(puffs.end(), &scratchLayouts[iStart], &scratchLayouts[iStart] + iRendered);
+				iPuffCount += iUsed;
+			}
+			CHECK(iPuffCount == iOldPuffCount);
+			CHECK(SameBytes(puffs, oldPuffs));
+		}
+
+		// Trails, the quads are built from these positions in the same order
+		std::vector<int64_t> oldTrails;
+		std::vector<XMFLOAT4A> oldTrailPositions;
+		int64_t iOldTrailCount = 0;
+		for (pool_t i = 0; i <= rTrails.uiMaxIndex; ++i)
+		{
+			if (!rTrails.pbUsed[i])
+			{
+				continue;
+			}
+
+			++iOldTrailCount;
+
+			XMFLOAT4A f4Position {};
+			XMStoreFloat4A(&f4Position, rTrails.pObjectInfos[i].vecPosition);
+			if (f4Position.x < kf4SmokeArea.x || f4Position.x > kf4SmokeArea.z || f4Position.y > kf4SmokeArea.y || f4Position.y < kf4SmokeArea.w)
+			{
+				continue;
+			}
+
+			oldTrails.push_back(i);
+			XMStoreFloat4A(&oldTrailPositions.emplace_back(), BaseHeight(rTrails.pObjectInfos[i].vecPosition));
+			XMStoreFloat4A(&oldTrailPositions.emplace_back(), BaseHeight(XMLoadFloat4A(&scene.previousTrailPositions[i])));
+		}
+
+		int64_t iTrailSlots = rTrails.uiMaxIndex + 1;
+		std::vector<int64_t> trails(iTrailSlots);
+		std::vector<XMFLOAT4A> trailPositions(2 * iTrailSlots);
+		auto [iTrailCount, iTrailsVisible] = engine::ExtractTrails(trails.data(), Vectors(trailPositions), rTrails, Vectors(scene.previousTrailPositions), kf4SmokeArea, BaseHeights);
+		trails.resize(iTrailsVisible);
+		trailPositions.resize(2 * iTrailsVisible);
+		CHECK(iTrailCount == iOldTrailCount);
+		CHECK(trails == oldTrails);
+		CHECK(SameBytes(trailPositions, oldTrailPositions));
+	}
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(LightsMatchOldLoop);
+	RUN_TEST(SmokeMatchesOldLoop);
+	return test::Result();
+}
@@ -0,0 +1,206 @@
+#include "Frame/TickScheduler.h"
+
+using engine::TickScheduler;
+
+namespace
+{
+
+// Same step and limit as GameBase, a 60 Hz monitor and half of it as the budget
+inline constexpr std::chrono::nanoseconds kStepNs = 1'000'000'000ns / 250;
+inline constexpr int64_t kiMaxOwedTicks = 25;
+inline constexpr std::chrono::nanoseconds kRefreshNs = 1'000'000'000ns / 60;
+inline constexpr std::chrono::nanoseconds kBudgetNs = kRefreshNs / 2;
+
+struct Frames
+{
+	test::FakeClock clock;
+	std::chrono::high_resolution_clock::time_point last = clock.now;
+
+	std::chrono::nanoseconds Next(std::chrono::nanoseconds frameNs)
+	{
+		clock.Advance(frameNs);
+		std::chrono::nanoseconds deltaNs = clock.now - last;
+		last = clock.now;
+		return deltaNs;
+	}
+};
+
+void AdvanceCarriesRemainder()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+	Frames frames;
+
+	// No time is lost between frames, a 60 Hz frame isn't a whole number of steps
+	int64_t iTicks = 0;
+	for (int64_t i = 0; i < 60; ++i)
+	{
+		iTicks += tickScheduler.Advance(frames.Next(kRefreshNs), 1, 1);
+		CHECK(tickScheduler.mRemainderNs >= 0ns && tickScheduler.mRemainderNs < kStepNs);
+	}
+	CHECK(iTicks * kStepNs + tickScheduler.mRemainderNs == 60 * kRefreshNs);
+	CHECK(iTicks == 249);
+
+	// Half speed
+	tickScheduler.mRemainderNs = 0ns;
+	CHECK(tickScheduler.Advance(frames.Next(8 * kStepNs), 1, 2) == 4);
+	CHECK(tickScheduler.mRemainderNs == 0ns);
+
+	CHECK(tickScheduler.SingleStep() == 1);
+	CHECK(tickScheduler.mRemainderNs == 0ns);
+}
+
+void UnmeasuredRunsEverythingOwed()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+
+	CHECK(tickScheduler.Budget(0, kBudgetNs) == 0);
+	CHECK(tickScheduler.Budget(5, kBudgetNs) == 5);
+	CHECK(tickScheduler.miOwedTicks == 0);
+
+	// Past the limit the rest is dropped
+	CHECK(tickScheduler.Budget(40, kBudgetNs) == kiMaxOwedTicks);
+	CHECK(tickScheduler.miOwedTicks == 0);
+	CHECK(tickScheduler.miDroppedTicks == 40 - kiMaxOwedTicks);
+}
+
+void HitchIsSpreadOverFrames()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+	Frames frames;
+
+	// Ticks cost 1 ms so eight fit in half of a 60 Hz refresh
+	tickScheduler.MeasureTick(1ms);
+	CHECK(tickScheduler.mTickCostNs == 1ms);
+
+	// A 20 tick hitch, then normal frames with about 4 due ticks each
+	int64_t iRun = tickScheduler.Budget(tickScheduler.Advance(frames.Next(20 * kStepNs), 1, 1), kBudgetNs);
+	CHECK(iRun == 8);
+	CHECK(tickScheduler.miOwedTicks == 12);
+
+	int64_t iFrames = 1;
+	int64_t iTotal = iRun;
+	int64_t iDue = 20;
+	while (tickScheduler.miOwedTicks > 0 && iFrames < 100)
+	{
+		int64_t iDueNow = tickScheduler.Advance(frames.Next(kRefreshNs), 1, 1);
+		iDue += iDueNow;
+		iRun = tickScheduler.Budget(iDueNow, kBudgetNs);
+		CHECK(iRun <= 8);
+		iTotal += iRun;
+		++iFrames;
+	}
+
+	// Nothing was dropped, every due tick ran and the game is back to real time
+	CHECK(tickScheduler.miOwedTicks == 0);
+	CHECK(tickScheduler.miDroppedTicks == 0);
+	CHECK(iTotal == iDue);
+	CHECK(iFrames < 10);
+}
+
+void SlowTicksStillMove()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+
+	// A tick that costs more than the whole budget still runs one per frame
+	tickScheduler.MeasureTick(50ms);
+	CHECK(tickScheduler.Budget(4, kBudgetNs) == 1);
+	CHECK(tickScheduler.miOwedTicks == 3);
+}
+
+void InFlightTicksUseBudget()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+	tickScheduler.MeasureTick(1ms);
+
+	// Three of the eight ticks that fit are already on the simulation thread
+	CHECK(tickScheduler.Budget(10, kBudgetNs, 3) == 5);
+	CHECK(tickScheduler.miOwedTicks == 5);
+
+	// With the thread busy for the whole budget nothing more is handed over, there's no minimum of one
+	CHECK(tickScheduler.Budget(0, kBudgetNs, 8) == 0);
+	CHECK(tickScheduler.miOwedTicks == 5);
+
+	// In flight and owed together never pass the limit, 20 in flight leaves room for 5 owed
+	CHECK(tickScheduler.Budget(10, kBudgetNs, 20) == 0);
+	CHECK(tickScheduler.miOwedTicks == 5);
+
+	// A full thread drops everything due
+	CHECK(tickScheduler.Budget(10, kBudgetNs, kiMaxOwedTicks) == 0);
+	CHECK(tickScheduler.miOwedTicks == 0);
+
+	// The 10 past the limit with 20 in flight, then the 5 owed and the 10 due with a full thread
+	CHECK(tickScheduler.miDroppedTicks == 25);
+}
+
+// While ticks are owed the render stays less than a step past the newest tick instead of running ahead of the simulation
+void InterpolationStaysBelowOneStep()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+	Frames frames;
+	tickScheduler.MeasureTick(1ms);
+
+	tickScheduler.Budget(tickScheduler.Advance(frames.Next(20 * kStepNs + kStepNs / 2), 1, 1), kBudgetNs);
+	CHECK(tickScheduler.miOwedTicks == 12);
+	CHECK(tickScheduler.Interpolation() == kStepNs / 2);
+
+	for (int64_t i = 0; i < 20; ++i)
+	{
+		tickScheduler.Budget(tickScheduler.Advance(frames.Next(kRefreshNs), 1, 1), kBudgetNs);
+		CHECK(tickScheduler.Interpolation() >= 0ns && tickScheduler.Interpolation() < kStepNs);
+	}
+
+	// A remainder set by hand is clamped too
+	tickScheduler.mRemainderNs = 3 * kStepNs;
+	CHECK(tickScheduler.Interpolation() == kStepNs - 1ns);
+}
+
+// The estimate before input matches where the update after it leaves the render, and doesn't change the scheduler
+void EstimateMatchesUpdate()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+	Frames frames;
+	tickScheduler.MeasureTick(1ms);
+
+	for (std::chrono::nanoseconds frameNs : {kRefreshNs, 20 * kStepNs, kRefreshNs, 40 * kStepNs, kRefreshNs, kStepNs / 3})
+	{
+		std::chrono::nanoseconds deltaNs = frames.Next(frameNs);
+		TickScheduler before = tickScheduler;
+		std::chrono::nanoseconds estimateNs = tickScheduler.Estimate(deltaNs, 1, 1, kBudgetNs);
+		CHECK(tickScheduler.mRemainderNs == before.mRemainderNs && tickScheduler.miOwedTicks == before.miOwedTicks && tickScheduler.miDroppedTicks == before.miDroppedTicks);
+
+		int64_t iTicks = tickScheduler.Budget(tickScheduler.Advance(deltaNs, 1, 1), kBudgetNs);
+		CHECK(estimateNs == iTicks * kStepNs + tickScheduler.Interpolation());
+		CHECK(estimateNs < (iTicks + 1) * kStepNs);
+	}
+}
+
+void TickCostIsSmoothed()
+{
+	TickScheduler tickScheduler(kStepNs, kiMaxOwedTicks);
+
+	tickScheduler.MeasureTick(1ms);
+	tickScheduler.MeasureTick(9ms);
+	CHECK(tickScheduler.mTickCostNs == 2ms);
+
+	// Settles on a steady cost
+	for (int64_t i = 0; i < 200; ++i)
+	{
+		tickScheduler.MeasureTick(3ms);
+	}
+	CHECK(tickScheduler.mTickCostNs > 2990us && tickScheduler.mTickCostNs <= 3ms);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(AdvanceCarriesRemainder);
+	RUN_TEST(UnmeasuredRunsEverythingOwed);
+	RUN_TEST(HitchIsSpreadOverFrames);
+	RUN_TEST(SlowTicksStillMove);
+	RUN_TEST(InFlightTicksUseBudget);
+	RUN_TEST(TickCostIsSmoothed);
+	RUN_TEST(InterpolationStaysBelowOneStep);
+	RUN_TEST(EstimateMatchesUpdate);
+	return test::Result();
+}
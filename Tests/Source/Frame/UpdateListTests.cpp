@@ -0,0 +1,225 @@
+#include "Random.h"
+#include "Frame/UpdateList.h"
+
+using engine::PhaseAccess;
+
+namespace
+{
+
+// A frame with the same shape as game::Frame, a few members with an access bit each and phases that declare what they touch
+inline constexpr uint64_t kAccessShips = engine::kAccessGameFirst << 0;
+inline constexpr uint64_t kAccessShots = engine::kAccessGameFirst << 1;
+inline constexpr uint64_t kAccessRocks = engine::kAccessGameFirst << 2;
+inline constexpr uint64_t kAccessScore = engine::kAccessGameFirst << 3;
+
+inline constexpr uint32_t kRandomShips = 0;
+inline constexpr uint32_t kRandomShots = 1;
+inline constexpr uint32_t kRandomRocks = 2;
+
+inline constexpr int64_t kiCount = 4096;
+
+struct Input
+{
+	float fScale = 1.0f;
+};
+
+struct TestFrame
+{
+	int64_t iFrame = 0;
+	std::array<float, kiCount> pfShips {};
+	std::array<float, kiCount> pfShots {};
+	std::array<float, kiCount> pfRocks {};
+	std::array<int64_t, 4> piScore {};
+
+	static void HashAccess(const TestFrame& rFrame, uint64_t uiAccess, engine::access_hashes_t& rHashes)
+	{
+		engine::HashMember(rHashes, uiAccess, engine::kAccessGlobal, rFrame.iFrame);
+		engine::HashMember(rHashes, uiAccess, kAccessShips, rFrame.pfShips);
+		engine::HashMember(rHashes, uiAccess, kAccessShots, rFrame.pfShots);
+		engine::HashMember(rHashes, uiAccess, kAccessRocks, rFrame.pfRocks);
+		engine::HashMember(rHashes, uiAccess, kAccessScore, rFrame.piScore);
+	}
+};
+
+using phase_function_t = engine::phase_function_t<TestFrame, Input>;
+
+common::RandomStream Stream(const TestFrame& rFrame, uint32_t uiSubsystem, uint64_t uiEntity)
+{
+	return common::RandomStream(static_cast<uint64_t>(rFrame.iFrame), uiSubsystem, uiEntity);
+}
+
+// Enough work per phase that concurrent phases really overlap
+void MoveShips(TestFrame& __restrict rFrame, const TestFrame& __restrict rPreviousFrame, const Input& __restrict rInput, float fDeltaTime)
+{
+	common::RandomStream randomStream = Stream(rFrame, kRandomShips, 0);
+	for (int64_t i = 0; i < kiCount; ++i)
+	{
+		rFrame.pfShips[i] = rPreviousFrame.pfShips[i] + rInput.fScale * fDeltaTime * (common::Random<2.0f>(randomStream) - 1.0f);
+	}
+}
+
+void MoveShots(TestFrame& __restrict rFrame, const TestFrame& __restrict rPreviousFrame, const Input& __restrict rInput, float fDeltaTime)
+{
+	common::RandomStream randomStream = Stream(rFrame, kRandomShots, 0);
+	for (int64_t i = 0; i < kiCount; ++i)
+	{
+		rFrame.pfShots[i] = rPreviousFrame.pfShots[i] + rInput.fScale * fDeltaTime * common::Random<4.0f>(randomStream);
+	}
+}
+
+void MoveRocks(TestFrame& __restrict rFrame, const TestFrame& __restrict rPreviousFrame, [[maybe_unused]] const Input& __restrict rInput, float fDeltaTime)
+{
+	for (int64_t i = 0; i < kiCount; ++i)
+	{
+		common::RandomStream randomStream = Stream(rFrame, kRandomRocks, static_cast<uint64_t>(i));
+		rFrame.pfRocks[i] = std::fmod(rPreviousFrame.pfRocks[i] + fDeltaTime * common::Random(randomStream), 100.0f);
+	}
+}
+
+// Reads what the three moves wrote, so it has to wait for all of them
+void Score(TestFrame& __restrict rFrame, [[maybe_unused]] const TestFrame& __restrict rPreviousFrame, [[maybe_unused]] const Input& __restrict rInput, [[maybe_unused]] float fDeltaTime)
+{
+	for (int64_t i = 0; i < kiCount; ++i)
+	{
+		rFrame.piScore[i % 4] += std::abs(rFrame.pfShips[i] - rFrame.pfShots[i]) < rFrame.pfRocks[i] ? 1 : 0;
+	}
+}
+
+// Ships depend on the score from this tick, the shots don't
+void AvoidShots(TestFrame& __restrict rFrame, [[maybe_unused]] const TestFrame& __restrict rPreviousFrame, [[maybe_unused]] const Input& __restrict rInput, [[maybe_unused]] float fDeltaTime)
+{
+	for (int64_t i = 0; i < kiCount; ++i)
+	{
+		rFrame.pfShips[i] += rFrame.piScore[i % 4] % 2 == 0 ? 0.5f : -0.5f;
+	}
+}
+
+void CountFrame(TestFrame& __restrict rFrame, const TestFrame& __restrict rPreviousFrame, [[maybe_unused]] const Input& __restrict rInput, [[maybe_unused]] float fDeltaTime)
+{
+	rFrame.iFrame = rPreviousFrame.iFrame + 1;
+}
+
+constexpr std::array<phase_function_t, 6> kpFunctions {&CountFrame, &MoveShips, &MoveShots, &MoveRocks, &Score, &AvoidShots};
+constexpr std::array<PhaseAccess, 6> kAccesses
+{{
+	{.uiWrites = engine::kAccessGlobal},
+	{.uiReads = engine::kAccessGlobal, .uiWrites = kAccessShips, .bConcurrent = true},
+	{.uiReads = engine::kAccessGlobal, .uiWrites = kAccessShots, .bConcurrent = true},
+	{.uiReads = engine::kAccessGlobal, .uiWrites = kAccessRocks, .bConcurrent = true},
+	{.uiReads = kAccessShips | kAccessShots | kAccessRocks, .uiWrites = kAccessScore},
+	{.uiReads = kAccessScore, .uiWrites = kAccessShips},
+}};
+constexpr std::array<int64_t, 6> kLevels = engine::UpdateListLevels(kAccesses);
+
+uint64_t Hash(const TestFrame& rFrame)
+{
+	// FNV-1a offset basis
+	return engine::HashBytes(rFrame, 0xcbf29ce484222325);
+}
+
+// Touches a single byte at the end of the rocks, the hashes still have to see it
+void NudgeLastRock(TestFrame& __restrict rFrame, [[maybe_unused]] const TestFrame& __restrict rPreviousFrame, [[maybe_unused]] const Input& __restrict rInput, [[maybe_unused]] float fDeltaTime)
+{
+	uint8_t* pBytes = reinterpret_cast<uint8_t*>(&rFrame.pfRocks.back());
+	pBytes[3] ^= 0x80;
+}
+
+std::vector<uint64_t> RunTicks(int64_t iTicks, common::WorkerPool* pWorkerPool, bool bChecked)
+{
+	std::unique_ptr<TestFrame> pPreviousFrame = std::make_unique<TestFrame>();
+	std::unique_ptr<TestFrame> pFrame = std::make_unique<TestFrame>();
+	Input input {.fScale = 3.0f};
+
+	std::vector<uint64_t> hashes;
+	for (int64_t iTick = 0; iTick < iTicks; ++iTick)
+	{
+		memcpy(static_cast<void*>(pFrame.get()), pPreviousFrame.get(), sizeof(TestFrame));
+		if (bChecked)
+		{
+			engine::RunUpdateListLevelsChecked(*pFrame, *pPreviousFrame, input, 1.0f / 60.0f, kpFunctions, kAccesses, kLevels);
+		}
+		else
+		{
+			engine::RunUpdateListLevels(*pFrame, *pPreviousFrame, input, 1.0f / 60.0f, kpFunctions, kAccesses, kLevels, pWorkerPool);
+		}
+		hashes.push_back(Hash(*pFrame));
+		std::swap(pFrame, pPreviousFrame);
+	}
+	return hashes;
+}
+
+void LevelsFollowConflicts()
+{
+	// The three moves only read what CountFrame writes, Score reads all of them and AvoidShots writes what the moves wrote
+	CHECK(kLevels[0] == 0);
+	CHECK(kLevels[1] == 1);
+	CHECK(kLevels[2] == 1);
+	CHECK(kLevels[3] == 1);
+	CHECK(kLevels[4] == 2);
+	CHECK(kLevels[5] == 3);
+
+	// Entries that only read shared state don't conflict, a write against a read or a write does
+	constexpr PhaseAccess kReadOne {.uiReads = kAccessShips};
+	constexpr PhaseAccess kReadTwo {.uiReads = kAccessShips};
+	constexpr PhaseAccess kWrite {.uiWrites = kAccessShips};
+	CHECK(!kReadOne.ConflictsWith(kReadTwo));
+	CHECK(kReadOne.ConflictsWith(kWrite));
+	CHECK(kWrite.ConflictsWith(kReadOne));
+	CHECK(kWrite.ConflictsWith(kWrite));
+}
+
+void LeveledMatchesSerial()
+{
+	static constexpr int64_t kiTicks = 200;
+	std::vector<uint64_t> serial = RunTicks(kiTicks, nullptr, false);
+	common::WorkerPool pool(3);
+	for (int64_t iRun = 0; iRun < 5; ++iRun)
+	{
+		CHECK(RunTicks(kiTicks, &pool, false) == serial);
+	}
+	CHECK(RunTicks(kiTicks, nullptr, true) == serial);
+
+	// The frame has to change from tick to tick, otherwise the comparison above proves nothing
+	CHECK(serial.front() != serial.back());
+}
+
+void UndeclaredWriteAsserts()
+{
+	std::unique_ptr<TestFrame> pPreviousFrame = std::make_unique<TestFrame>();
+	std::unique_ptr<TestFrame> pFrame = std::make_unique<TestFrame>();
+	Input input {};
+
+	// MoveShips claiming it writes the shots instead
+	constexpr std::array<PhaseAccess, 2> kWrongAccesses
+	{{
+		{.uiWrites = engine::kAccessGlobal},
+		{.uiReads = engine::kAccessGlobal, .uiWrites = kAccessShots},
+	}};
+	constexpr std::array<phase_function_t, 2> kpWrongFunctions {&CountFrame, &MoveShips};
+	constexpr std::array<int64_t, 2> kWrongLevels = engine::UpdateListLevels(kWrongAccesses);
+	CHECK_THROWS(engine::RunUpdateListLevelsChecked(*pFrame, *pPreviousFrame, input, 1.0f, kpWrongFunctions, kWrongAccesses, kWrongLevels));
+
+	constexpr std::array<PhaseAccess, 1> kNudgeAccess {{{.uiWrites = kAccessShips}}};
+	constexpr std::array<phase_function_t, 1> kpNudgeFunction {&NudgeLastRock};
+	constexpr std::array<int64_t, 1> kNudgeLevels {};
+	CHECK_THROWS(engine::RunUpdateListLevelsChecked(*pFrame, *pPreviousFrame, input, 1.0f, kpNudgeFunction, kNudgeAccess, kNudgeLevels));
+
+	// A NaN left in place isn't a write
+	pPreviousFrame->pfRocks[0] = std::numeric_limits<float>::quiet_NaN();
+	memcpy(static_cast<void*>(pFrame.get()), pPreviousFrame.get(), sizeof(TestFrame));
+	constexpr std::array<PhaseAccess, 1> kCountAccess {{{.uiWrites = engine::kAccessGlobal}}};
+	constexpr std::array<phase_function_t, 1> kpCountFunction {&CountFrame};
+	constexpr std::array<int64_t, 1> kCountLevels {};
+	engine::RunUpdateListLevelsChecked(*pFrame, *pPreviousFrame, input, 1.0f, kpCountFunction, kCountAccess, kCountLevels);
+	CHECK(pFrame->iFrame == 1);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(LevelsFollowConflicts);
+	RUN_TEST(LeveledMatchesSerial);
+	RUN_TEST(UndeclaredWriteAsserts);
+	return test::Result();
+}
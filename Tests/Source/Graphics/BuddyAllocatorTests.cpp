@@ -0,0 +1,130 @@
+#include "Graphics/BuddyAllocator.h"
+
+using engine::BuddyAllocator;
+
+namespace
+{
+
+constexpr int64_t kiSize = 1024 * 1024;
+constexpr int64_t kiMinSize = 256;
+
+void SplitsAndMerges()
+{
+	BuddyAllocator buddyAllocator(kiSize, kiMinSize);
+	CHECK(buddyAllocator.miLevelCount == 13);
+	CHECK(buddyAllocator.LargestFree() == kiSize);
+
+	int64_t iFirst = buddyAllocator.Allocate(100, 1);
+	int64_t iSecond = buddyAllocator.Allocate(300, 1);
+	CHECK(iFirst != BuddyAllocator::kiInvalidOffset && iSecond != BuddyAllocator::kiInvalidOffset);
+	CHECK(buddyAllocator.miUsedBytes == kiMinSize + 2 * kiMinSize);
+	CHECK(buddyAllocator.miAllocationCount == 2);
+	CHECK(buddyAllocator.LargestFree() == kiSize / 2);
+	CHECK(buddyAllocator.Validate());
+
+	buddyAllocator.Free(iFirst);
+	buddyAllocator.Free(iSecond);
+	CHECK(buddyAllocator.miUsedBytes == 0 && buddyAllocator.miAllocationCount == 0);
+	CHECK(buddyAllocator.LargestFree() == kiSize);
+	CHECK(buddyAllocator.Fragmentation() == 0.0f);
+	CHECK(buddyAllocator.Validate());
+}
+
+void AlignsToBlockSize()
+{
+	BuddyAllocator buddyAllocator(kiSize, kiMinSize);
+
+	int64_t iSmall = buddyAllocator.Allocate(1, 1);
+	int64_t iAligned = buddyAllocator.Allocate(1, 64 * 1024);
+	int64_t iLarge = buddyAllocator.Allocate(5000, 256);
+	CHECK(iSmall % kiMinSize == 0);
+	CHECK(iAligned % (64 * 1024) == 0);
+	CHECK(iLarge % 8192 == 0);
+	CHECK(buddyAllocator.Validate());
+
+	CHECK_THROWS(buddyAllocator.Allocate(1, 3));
+	CHECK_THROWS(buddyAllocator.Allocate(0, 1));
+}
+
+void RunsOutOfSpace()
+{
+	BuddyAllocator buddyAllocator(kiSize, kiMinSize);
+
+	CHECK(buddyAllocator.Allocate(kiSize + 1, 1) == BuddyAllocator::kiInvalidOffset);
+	int64_t iWhole = buddyAllocator.Allocate(kiSize, 1);
+	CHECK(iWhole == 0);
+	CHECK(buddyAllocator.Allocate(1, 1) == BuddyAllocator::kiInvalidOffset);
+	CHECK(buddyAllocator.Fragmentation() == 0.0f);
+
+	buddyAllocator.Free(iWhole);
+	CHECK_THROWS(buddyAllocator.Free(iWhole));
+}
+
+// Random allocations and frees against a byte map, allocations must never overlap and everything merges back once freed
+void RandomAgainstReference()
+{
+	BuddyAllocator buddyAllocator(kiSize, kiMinSize);
+	std::vector<int64_t> piOwner(kiSize / kiMinSize, -1);
+	std::vector<std::pair<int64_t, int64_t>> live;
+	std::mt19937 randomEngine(2);
+
+	for (int64_t i = 0; i < 20'000; ++i)
+	{
+		bool bAllocate = live.empty() || std::uniform_int_distribution<int64_t>(0, 2)(randomEngine) != 0;
+		if (bAllocate)
+		{
+			int64_t iSize = std::uniform_int_distribution<int64_t>(1, 32 * 1024)(randomEngine);
+			int64_t iAlignment = int64_t(1) << std::uniform_int_distribution<int64_t>(0, 12)(randomEngine);
+			int64_t iOffset = buddyAllocator.Allocate(iSize, iAlignment);
+			if (iOffset == BuddyAllocator::kiInvalidOffset)
+			{
+				continue;
+			}
+
+			CHECK(iOffset % iAlignment == 0 && iOffset + iSize <= kiSize);
+			for (int64_t iSlot = iOffset / kiMinSize; iSlot < (iOffset + iSize + kiMinSize - 1) / kiMinSize; ++iSlot)
+			{
+				CHECK(piOwner[iSlot] == -1);
+				piOwner[iSlot] = iOffset;
+			}
+			live.push_back({iOffset, iSize});
+		}
+		else
+		{
+			int64_t iIndex = std::uniform_int_distribution<int64_t>(0, static_cast<int64_t>(live.size()) - 1)(randomEngine);
+			auto [iOffset, iSize] = live[iIndex];
+			live[iIndex] = live.back();
+			live.pop_back();
+
+			buddyAllocator.Free(iOffset);
+			for (int64_t iSlot = iOffset / kiMinSize; iSlot < (iOffset + iSize + kiMinSize - 1) / kiMinSize; ++iSlot)
+			{
+				piOwner[iSlot] = -1;
+			}
+		}
+
+		if (i % 1000 == 0)
+		{
+			CHECK(buddyAllocator.Validate());
+			CHECK(buddyAllocator.miAllocationCount == static_cast<int64_t>(live.size()));
+		}
+	}
+
+	for (auto [iOffset, iSize] : live)
+	{
+		buddyAllocator.Free(iOffset);
+	}
+	CHECK(buddyAllocator.Validate());
+	CHECK(buddyAllocator.miUsedBytes == 0 && buddyAllocator.LargestFree() == kiSize);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(SplitsAndMerges);
+	RUN_TEST(AlignsToBlockSize);
+	RUN_TEST(RunsOutOfSpace);
+	RUN_TEST(RandomAgainstReference);
+	return test::Result();
+}
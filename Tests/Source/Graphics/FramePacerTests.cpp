@@ -0,0 +1,213 @@
+#include "Graphics/FramePacer.h"
+
+using engine::FramePacer;
+
+namespace
+{
+
+inline constexpr std::chrono::nanoseconds kRefreshNs = 1'000'000'000ns / 60;
+inline constexpr int64_t kiFrames = 5000;
+
+struct TraceResult
+{
+	std::chrono::nanoseconds averageLatencyNs {};
+	int64_t iMissed = 0;
+	int64_t iAlreadyFree = 0;
+	int64_t iPacerMisses = 0;
+	std::chrono::nanoseconds marginNs {};
+};
+
+// A FIFO swapchain at 60 Hz, frames go on screen at the first free refresh after they finish and an image comes back once the frame iImages - 1 later is shown
+// The loop is SwapchainManager::ReduceInputLag(), the work is around workNs with 2% spikes of 6 ms
+TraceResult RunTrace(std::chrono::nanoseconds workNs, int64_t iImages, bool bPace)
+{
+	FramePacer framePacer;
+	framePacer.SetRefreshRate(60);
+
+	std::mt19937 random {1234};
+	std::uniform_real_distribution<double> jitter(0.9, 1.1);
+	std::uniform_real_distribution<double> spike(0.0, 1.0);
+
+	test::FakeClock clock;
+	std::vector<std::chrono::high_resolution_clock::time_point> shown;
+	TraceResult result;
+	std::chrono::nanoseconds latencyNs {};
+	int64_t iLatencies = 0;
+
+	clock.Advance(kRefreshNs);
+	framePacer.ImageAvailable(clock.now, true);
+	framePacer.StartFrame(clock.now);
+	std::chrono::high_resolution_clock::time_point start = clock.now;
+
+	for (int64_t i = 0; i < kiFrames; ++i)
+	{
+		auto frameWorkNs = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(workNs.count()) * jitter(random)));
+		if (spike(random) < 0.02)
+		{
+			frameWorkNs += 6ms;
+		}
+		clock.now = start + frameWorkNs;
+		framePacer.EndFrame(clock.now, 0ns);
+
+		// First refresh after it finished, one per refresh in order
+		int64_t iRefresh = (clock.now.time_since_epoch() + kRefreshNs - 1ns) / kRefreshNs;
+		std::chrono::high_resolution_clock::time_point onScreen(iRefresh * kRefreshNs);
+		if (!shown.empty())
+		{
+			onScreen = std::max(onScreen, shown.back() + kRefreshNs);
+			result.iMissed += onScreen - shown.back() > kRefreshNs;
+		}
+		shown.push_back(onScreen);
+		if (i >= kiFrames / 10)
+		{
+			latencyNs += onScreen - start;
+			++iLatencies;
+		}
+
+		// The next image is free once the frame iImages - 1 after it is on screen, the newest one for two images
+		std::chrono::high_resolution_clock::time_point imageFree = shown[std::max<int64_t>(static_cast<int64_t>(shown.size()) - (iImages - 1), 0)];
+		bool bWaited = imageFree > clock.now;
+		result.iAlreadyFree += !bWaited;
+		clock.now = std::max(clock.now, imageFree);
+		framePacer.ImageAvailable(clock.now, bWaited);
+
+		start = bPace ? std::max(clock.now, framePacer.StartTime()) : clock.now;
+		framePacer.StartFrame(start);
+	}
+
+	result.averageLatencyNs = latencyNs / iLatencies;
+	result.iPacerMisses = framePacer.Misses();
+	result.marginNs = framePacer.Margin();
+	return result;
+}
+
+void Print(const char* pcName, const TraceResult& rResult)
+{
+	std::printf("%s: latency %.2f ms, %lld missed refreshes, %lld counted by the pacer, %lld images already free, margin %.2f ms\n", pcName,
+		static_cast<double>(rResult.averageLatencyNs.count()) / 1e6, static_cast<long long>(rResult.iMissed), static_cast<long long>(rResult.iPacerMisses),
+		static_cast<long long>(rResult.iAlreadyFree), static_cast<double>(rResult.marginNs.count()) / 1e6);
+}
+
+void CheapFramesStartLater()
+{
+	for (int64_t iImages : {2, 3})
+	{
+		TraceResult unpaced = RunTrace(4ms, iImages, false);
+		TraceResult paced = RunTrace(4ms, iImages, true);
+		Print(iImages == 2 ? "4 ms, 2 images, unpaced" : "4 ms, 3 images, unpaced", unpaced);
+		Print(iImages == 2 ? "4 ms, 2 images, paced" : "4 ms, 3 images, paced", paced);
+
+		// Most of a refresh less between sampling input and the frame being shown, at the cost of some spikes missing
+		CHECK(paced.averageLatencyNs < unpaced.averageLatencyNs - 5ms);
+		CHECK(paced.iMissed < kiFrames / 20);
+	}
+}
+
+void ExpensiveFramesAreLeftAlone()
+{
+	// No slack to give away, pacing changes nothing
+	TraceResult unpaced = RunTrace(15ms, 2, false);
+	TraceResult paced = RunTrace(15ms, 2, true);
+	Print("15 ms, 2 images, unpaced", unpaced);
+	Print("15 ms, 2 images, paced", paced);
+	CHECK(paced.averageLatencyNs <= unpaced.averageLatencyNs + 100us);
+	CHECK(paced.iMissed <= unpaced.iMissed + kiFrames / 100);
+}
+
+void FreeImagesArentMisses()
+{
+	// With three images a frame that ran long finds the next image already free, the old check counted every one of those as a miss and pinned the margin at half a refresh
+	for (std::chrono::nanoseconds workNs : {std::chrono::nanoseconds(4ms), std::chrono::nanoseconds(12ms)})
+	{
+		TraceResult result = RunTrace(workNs, 3, true);
+		Print(workNs == 4ms ? "4 ms, 3 images, paced" : "12 ms, 3 images, paced", result);
+		CHECK(result.iAlreadyFree > 0);
+		// The queued image can hide a late one, so a gap of two refreshes is counted now and then without the screen repeating a frame
+		CHECK(result.iPacerMisses <= result.iMissed + kiFrames / 1000);
+		CHECK(result.iPacerMisses < result.iAlreadyFree / 10);
+		CHECK(result.marginNs < kRefreshNs / 2);
+	}
+}
+
+void MissesGrowTheMargin()
+{
+	FramePacer framePacer;
+	framePacer.SetRefreshRate(60);
+	test::FakeClock clock;
+
+	framePacer.ImageAvailable(clock.now, true);
+	clock.Advance(kRefreshNs);
+	framePacer.ImageAvailable(clock.now, true);
+	CHECK(framePacer.Misses() == 0);
+	CHECK(framePacer.Margin() == FramePacer::kMinimumMargin);
+
+	// Two refreshes apart, then an already free image four refreshes on
+	clock.Advance(2 * kRefreshNs);
+	framePacer.ImageAvailable(clock.now, true);
+	CHECK(framePacer.Misses() == 1);
+	CHECK(framePacer.Margin() == 2 * FramePacer::kMinimumMargin);
+
+	clock.Advance(4 * kRefreshNs + 3ms);
+	framePacer.ImageAvailable(clock.now, false);
+	CHECK(framePacer.Misses() == 2);
+	CHECK(framePacer.Margin() == 4 * FramePacer::kMinimumMargin);
+
+	// Capped at half a refresh
+	for (int64_t i = 0; i < 10; ++i)
+	{
+		clock.Advance(3 * kRefreshNs);
+		framePacer.ImageAvailable(clock.now, true);
+	}
+	CHECK(framePacer.Margin() == kRefreshNs / 2);
+
+	// Made refreshes give it back
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		clock.Advance(kRefreshNs);
+		framePacer.ImageAvailable(clock.now, true);
+	}
+	CHECK(framePacer.Margin() == FramePacer::kMinimumMargin);
+}
+
+void StartTimeUsesPredictedWork()
+{
+	FramePacer framePacer;
+	framePacer.SetRefreshRate(60);
+	test::FakeClock clock;
+
+	// Not enough history yet, start right away
+	framePacer.ImageAvailable(clock.now, true);
+	CHECK(framePacer.StartTime() == clock.now);
+
+	for (int64_t i = 0; i < FramePacer::kiMinimumHistory; ++i)
+	{
+		framePacer.StartFrame(clock.now);
+		clock.Advance(5ms);
+		framePacer.EndFrame(clock.now, 1ms);
+		clock.Advance(kRefreshNs - 5ms);
+		framePacer.ImageAvailable(clock.now, true);
+	}
+	CHECK(framePacer.PredictedWork() == 6ms);
+	CHECK(framePacer.StartTime() == clock.now + kRefreshNs - 6ms - framePacer.Margin());
+
+	// An already free image is scheduled from the refresh it became free at, not from when the loop got there
+	framePacer.StartFrame(clock.now);
+	clock.Advance(5ms);
+	framePacer.EndFrame(clock.now, 1ms);
+	std::chrono::high_resolution_clock::time_point refresh = clock.now + kRefreshNs - 5ms;
+	clock.now = refresh + 2ms;
+	framePacer.ImageAvailable(clock.now, false);
+	CHECK(framePacer.StartTime() == refresh + kRefreshNs - 6ms - framePacer.Margin());
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(CheapFramesStartLater);
+	RUN_TEST(ExpensiveFramesAreLeftAlone);
+	RUN_TEST(FreeImagesArentMisses);
+	RUN_TEST(MissesGrowTheMargin);
+	RUN_TEST(StartTimeUsesPredictedWork);
+	return test::Result();
+}
@@ -0,0 +1,248 @@
+#include "Graphics/Glyphs.h"
+
+using engine::Glyph;
+using engine::GlyphTable;
+
+namespace
+{
+
+struct Font
+{
+	std::vector<uint32_t> ids;
+	std::vector<common::Character> characters;
+	int64_t iLineHeight = 0;
+};
+
+// Every id gets different metrics so a glyph from the wrong font or the wrong slot shows up
+Font MakeFont(std::vector<uint32_t> ids, int64_t iLineHeight, int16_t iSeed)
+{
+	Font font {.ids = std::move(ids), .characters = {}, .iLineHeight = iLineHeight};
+	for (uint32_t uiId : font.ids)
+	{
+		int16_t iValue = static_cast<int16_t>(iSeed + static_cast<int16_t>(uiId % 97));
+		font.characters.push_back(common::Character
+		{
+			.uiX = static_cast<uint16_t>(3 * iValue),
+			.uiY = static_cast<uint16_t>(5 * iValue),
+			.uiWidth = static_cast<uint16_t>(iValue % 40 + 1),
+			.uiHeight = static_cast<uint16_t>(iValue % 50 + 2),
+			.iXOffset = static_cast<int16_t>(iValue % 7 - 3),
+			.iYOffset = static_cast<int16_t>(iValue % 11),
+			.iXAdvance = static_cast<int16_t>(iValue % 45 + 4),
+		});
+	}
+	return font;
+}
+
+GlyphTable Build(const Font& rEfigs, const Font& rChinese)
+{
+	GlyphTable glyphTable;
+	engine::AddFont(glyphTable, rEfigs.ids.data(), rEfigs.characters.data(), static_cast<int64_t>(rEfigs.ids.size()), rEfigs.iLineHeight, true);
+	engine::AddFont(glyphTable, rChinese.ids.data(), rChinese.characters.data(), static_cast<int64_t>(rChinese.ids.size()), rChinese.iLineHeight, false);
+	engine::SortGlyphTable(glyphTable);
+	return glyphTable;
+}
+
+// What TextManager::GetCharacter() and WriteQuads() did per character before the table, Efigs first, then Chinese with its adjustments applied at draw time
+struct OldQuad
+{
+	bool bFound = false;
+	bool bEfigs = true;
+	DirectX::XMFLOAT4 f4VertexRect {};
+	DirectX::XMFLOAT4 f4TextureRect {};
+	float fAdvance = 0.0f;
+};
+
+OldQuad OldWriteQuad(const Font& rEfigs, const Font& rChinese, uint32_t uiChar, float fX, float fY, float fSize, float fAspectRatio)
+{
+	OldQuad quad;
+	const common::Character* pCharacter = nullptr;
+	for (const Font* pFont : {&rEfigs, &rChinese})
+	{
+		auto it = std::find(pFont->ids.begin(), pFont->ids.end(), uiChar);
+		if (it != pFont->ids.end())
+		{
+			pCharacter = &pFont->characters[it - pFont->ids.begin()];
+			quad.bEfigs = pFont == &rEfigs;
+			break;
+		}
+	}
+	if (pCharacter == nullptr)
+	{
+		return quad;
+	}
+	quad.bFound = true;
+
+	float fLineHeight = static_cast<float>(quad.bEfigs ? rEfigs.iLineHeight : rChinese.iLineHeight);
+	if (!quad.bEfigs)
+	{
+		fLineHeight *= 1.4f;
+	}
+
+	float fInverseAspectRatio = 1.0f / fAspectRatio;
+	float fInverseLineHeight = 1.0f / fLineHeight;
+	float fWidth = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->uiWidth);
+	float fHeight = fSize * fInverseLineHeight * static_cast<float>(pCharacter->uiHeight);
+	float fXOffset = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->iXOffset);
+	float fYOffset = fSize * fInverseLineHeight * static_cast<float>(pCharacter->iYOffset);
+	quad.fAdvance = fInverseAspectRatio * fSize * fInverseLineHeight * static_cast<float>(pCharacter->iXAdvance);
+	if (!quad.bEfigs)
+	{
+		fWidth *= 1.4f;
+		fHeight *= 1.4f;
+		quad.fAdvance *= 1.6f;
+	}
+
+	quad.f4VertexRect = {-1.0f + 2.0f * (fX + fXOffset), 1.0f - 2.0f * (fY + fYOffset), 2.0f * fWidth, -2.0f * fHeight};
+	float fTextureSize = quad.bEfigs ? engine::kfEfigsSize : engine::kfChineseSize;
+	quad.f4TextureRect =
+	{
+		static_cast<float>(pCharacter->uiX) / fTextureSize,
+		static_cast<float>(pCharacter->uiY) / fTextureSize,
+		static_cast<float>(pCharacter->uiX + pCharacter->uiWidth) / fTextureSize,
+		static_cast<float>(pCharacter->uiY + pCharacter->uiHeight) / fTextureSize,
+	};
+	return quad;
+}
+
+// Printable ASCII and some Latin-1 for Efigs, CJK plus a few ASCII duplicates for Chinese, both have '?'
+const Font& Efigs()
+{
+	static const Font sFont = []()
+	{
+		std::vector<uint32_t> ids;
+		for (uint32_t uiId = 0x20; uiId < 0x7F; ++uiId)
+		{
+			ids.push_back(uiId);
+		}
+		for (uint32_t uiId : {0xC4u, 0xD6u, 0xDCu, 0xE9u, 0x2014u, 0x20ACu})
+		{
+			ids.push_back(uiId);
+		}
+		// Font files aren't sorted
+		std::reverse(ids.begin(), ids.end());
+		return MakeFont(std::move(ids), 68, 10);
+	}();
+	return sFont;
+}
+
+const Font& Chinese()
+{
+	static const Font sFont = []()
+	{
+		std::vector<uint32_t> ids {'?', 'A', '0', 0x3002u};
+		for (uint32_t uiId = 0x4E00; uiId < 0x4E00 + 500; uiId += 3)
+		{
+			ids.push_back(uiId);
+		}
+		return MakeFont(std::move(ids), 91, 20);
+	}();
+	return sFont;
+}
+
+void MatchesOldLookup()
+{
+	GlyphTable glyphTable = Build(Efigs(), Chinese());
+	CHECK(glyphTable.fLineHeightEfigs == 68.0f && glyphTable.fLineHeightChinese == 91.0f);
+
+	// Every character either font has, plus ones in between that neither has
+	std::vector<uint32_t> chars;
+	for (const Font* pFont : {&Efigs(), &Chinese()})
+	{
+		chars.insert(chars.end(), pFont->ids.begin(), pFont->ids.end());
+	}
+	for (uint32_t uiChar : {0x01u, 0x7Fu, 0x7FFu, 0x800u, 0x4E01u, 0x4E00u + 499u, 0x10FFFFu})
+	{
+		chars.push_back(uiChar);
+	}
+
+	const float fSize = 0.0625f;
+	const float fAspectRatio = 16.0f / 9.0f;
+	const Glyph& rFallback = glyphTable.Find('?');
+	CHECK(rFallback.bEfigs);
+
+	int64_t iMissing = 0;
+	float fWorstError = 0.0f;
+	for (uint32_t uiChar : chars)
+	{
+		OldQuad oldQuad = OldWriteQuad(Efigs(), Chinese(), uiChar, 0.25f, 0.5f, fSize, fAspectRatio);
+		const Glyph& rGlyph = glyphTable.Find(uiChar);
+		if (!oldQuad.bFound)
+		{
+			// Used to be whatever the Efigs map happened to iterate first
+			CHECK(&rGlyph == &rFallback);
+			++iMissing;
+			continue;
+		}
+
+		CHECK(rGlyph.uiChar == uiChar);
+		CHECK(rGlyph.bEfigs == oldQuad.bEfigs);
+
+		// WriteQuads() with the table, the adjustments are applied in a different order so allow for rounding
+		float fScaleX = fSize / fAspectRatio;
+		float fScaleY = fSize;
+		const float pfNew[] =
+		{
+			-1.0f + 2.0f * (0.25f + fScaleX * rGlyph.fXOffset), 1.0f - 2.0f * (0.5f + fScaleY * rGlyph.fYOffset), 2.0f * fScaleX * rGlyph.fWidth, -2.0f * fScaleY * rGlyph.fHeight,
+			fScaleX * rGlyph.fAdvance,
+		};
+		const float pfOld[] = {oldQuad.f4VertexRect.x, oldQuad.f4VertexRect.y, oldQuad.f4VertexRect.z, oldQuad.f4VertexRect.w, oldQuad.fAdvance};
+		for (int64_t i = 0; i < static_cast<int64_t>(std::size(pfNew)); ++i)
+		{
+			fWorstError = std::max(fWorstError, std::abs(pfNew[i] - pfOld[i]));
+		}
+
+		// The texture rect is computed the same way as before
+		CHECK(std::memcmp(&rGlyph.f4TextureRect, &oldQuad.f4TextureRect, sizeof(rGlyph.f4TextureRect)) == 0);
+	}
+	std::printf("%lld characters, %lld missing, worst vertex difference %g\n", static_cast<long long>(chars.size()), static_cast<long long>(iMissing), fWorstError);
+	CHECK(iMissing == 7);
+	CHECK(fWorstError < 1e-6f);
+}
+
+void TableIsSortedAndUnique()
+{
+	GlyphTable glyphTable = Build(Efigs(), Chinese());
+	CHECK(std::is_sorted(glyphTable.glyphs.begin(), glyphTable.glyphs.end(), [](const Glyph& rA, const Glyph& rB){ return rA.uiChar < rB.uiChar; }));
+	CHECK(std::adjacent_find(glyphTable.glyphs.begin(), glyphTable.glyphs.end(), [](const Glyph& rA, const Glyph& rB){ return rA.uiChar == rB.uiChar; }) == glyphTable.glyphs.end());
+
+	// '?', 'A' and '0' are in both, the Chinese copies are dropped
+	CHECK(static_cast<int64_t>(glyphTable.glyphs.size()) == static_cast<int64_t>(Efigs().ids.size() + Chinese().ids.size()) - 3);
+
+	// Every direct slot points at its own character or nothing
+	for (int64_t i = 0; i < engine::kiDirectGlyphs; ++i)
+	{
+		int32_t iGlyph = glyphTable.piDirectGlyphs[i];
+		CHECK(iGlyph == -1 || glyphTable.glyphs[iGlyph].uiChar == static_cast<uint32_t>(i));
+	}
+}
+
+void NoFallbackThrows()
+{
+	GlyphTable glyphTable;
+	Font font = MakeFont({'A', 'B'}, 50, 0);
+	engine::AddFont(glyphTable, font.ids.data(), font.characters.data(), 2, font.iLineHeight, true);
+	CHECK_THROWS(engine::SortGlyphTable(glyphTable));
+}
+
+void TextLinesStopAtCapacity()
+{
+	engine::TextLines lines;
+	for (int64_t i = 0; i < engine::TextLines::kiMaxLines + 10; ++i)
+	{
+		lines.Push(static_cast<float>(i));
+	}
+	CHECK(lines.iCount == engine::TextLines::kiMaxLines);
+	CHECK(*(lines.end() - 1) == static_cast<float>(engine::TextLines::kiMaxLines - 1));
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(MatchesOldLookup);
+	RUN_TEST(TableIsSortedAndUnique);
+	RUN_TEST(NoFallbackThrows);
+	RUN_TEST(TextLinesStopAtCapacity);
+	return test::Result();
+}
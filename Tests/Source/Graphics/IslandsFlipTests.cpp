@@ -0,0 +1,208 @@
+#include "Graphics/IslandsFlip.h"
+
+using engine::kiGlobalHeightmapSize;
+using engine::kfGlobalHeightmapSize;
+
+namespace
+{
+
+static constexpr float kfSeaFloorElevation = -1.0f;
+
+struct Layout
+{
+	const char* pcName = nullptr;
+	std::vector<DirectX::XMFLOAT4> vertexRects;
+	DirectX::XMFLOAT4 f4GlobalArea {};
+};
+
+// Same as Islands::FillGlobalArea()
+Layout MakeLayout(const char* pcName, std::vector<DirectX::XMFLOAT4> vertexRects)
+{
+	Layout layout {.pcName = pcName, .vertexRects = std::move(vertexRects)};
+	layout.f4GlobalArea = {std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max()};
+	for (const DirectX::XMFLOAT4& rf4Rect : layout.vertexRects)
+	{
+		layout.f4GlobalArea.x = std::min(layout.f4GlobalArea.x, rf4Rect.x);
+		layout.f4GlobalArea.y = std::max(layout.f4GlobalArea.y, rf4Rect.y);
+		layout.f4GlobalArea.z = std::max(layout.f4GlobalArea.z, rf4Rect.x + rf4Rect.z);
+		layout.f4GlobalArea.w = std::min(layout.f4GlobalArea.w, rf4Rect.y + rf4Rect.w);
+	}
+	return layout;
+}
+
+// Grid lines fall on texel edges so a mirrored texel samples exactly the texture coordinate the flipped render does
+const std::vector<Layout>& Layouts()
+{
+	static const std::vector<Layout> sLayouts
+	{
+		// Game::Frame::kpfIslandPositions of the sandbox
+		MakeLayout("Sandbox", {{-100.0f, 100.0f, 200.0f, -200.0f}}),
+		MakeLayout("2x2", {{-100.0f, 100.0f, 100.0f, -100.0f}, {0.0f, 100.0f, 100.0f, -100.0f}, {-100.0f, 0.0f, 100.0f, -100.0f}, {0.0f, 0.0f, 100.0f, -100.0f}}),
+		// Columns 64, 128 and 64 wide, rows 128, 64 and 64 high, with a hole
+		MakeLayout("Uneven 3x3", []()
+		{
+			std::vector<DirectX::XMFLOAT4> rects;
+			const float pfColumns[][2] {{0.0f, 64.0f}, {64.0f, 128.0f}, {192.0f, 64.0f}};
+			const float pfRows[][2] {{256.0f, 128.0f}, {128.0f, 64.0f}, {64.0f, 64.0f}};
+			for (const auto& rRow : pfRows)
+			{
+				for (const auto& rColumn : pfColumns)
+				{
+					if (rRow[0] != 128.0f || rColumn[0] != 64.0f)
+					{
+						rects.push_back({rColumn[0], rRow[0], rColumn[1], -rRow[1]});
+					}
+				}
+			}
+			return rects;
+		}()),
+	};
+	return sLayouts;
+}
+
+// Stands in for an island's elevation texture, different for every island so reading the wrong one shows up
+float Elevation(int64_t iIsland, float fU, float fV)
+{
+	float fIsland = static_cast<float>(iIsland);
+	return std::sin(13.0f * fU + fIsland) * std::cos(7.0f * fV * fV + 2.0f * fIsland) + 0.1f * fU;
+}
+
+// What Islands::BuildGlobalHeightmap() renders, every texel center takes the island under it at the texture coordinate its flipped texture rect gives
+std::vector<float> RenderHeightmap(const Layout& rLayout, bool bFlipX, bool bFlipY)
+{
+	const DirectX::XMFLOAT4& rf4Area = rLayout.f4GlobalArea;
+	std::vector<float> heightmap(kiGlobalHeightmapSize * kiGlobalHeightmapSize, kfSeaFloorElevation);
+	for (int64_t iRow = 0; iRow < kiGlobalHeightmapSize; ++iRow)
+	{
+		float fY = rf4Area.y - (static_cast<float>(iRow) + 0.5f) / kfGlobalHeightmapSize * (rf4Area.y - rf4Area.w);
+		for (int64_t iColumn = 0; iColumn < kiGlobalHeightmapSize; ++iColumn)
+		{
+			float fX = rf4Area.x + (static_cast<float>(iColumn) + 0.5f) / kfGlobalHeightmapSize * (rf4Area.z - rf4Area.x);
+			for (int64_t i = 0; i < static_cast<int64_t>(rLayout.vertexRects.size()); ++i)
+			{
+				const DirectX::XMFLOAT4& rf4Rect = rLayout.vertexRects[i];
+				if (fX >= rf4Rect.x && fX < rf4Rect.x + rf4Rect.z && fY <= rf4Rect.y && fY > rf4Rect.y + rf4Rect.w)
+				{
+					float fU = (fX - rf4Rect.x) / rf4Rect.z;
+					float fV = (rf4Rect.y - fY) / -rf4Rect.w;
+					heightmap[iRow * kiGlobalHeightmapSize + iColumn] = Elevation(i, bFlipX ? 1.0f - fU : fU, bFlipY ? 1.0f - fV : fV);
+				}
+			}
+		}
+	}
+	return heightmap;
+}
+
+struct FlipTables
+{
+	int32_t piRows[kiGlobalHeightmapSize] {};
+	int32_t piColumns[kiGlobalHeightmapSize] {};
+};
+
+// Same arithmetic as Islands::GlobalElevation()
+float GlobalElevation(const std::vector<float>& rHeightmap, const FlipTables& rFlipTables, const DirectX::XMFLOAT4& rf4Area, float fX, float fY)
+{
+	int64_t iX = static_cast<int64_t>(kfGlobalHeightmapSize * (fX - rf4Area.x) / (rf4Area.z - rf4Area.x));
+	int64_t iY = static_cast<int64_t>(kfGlobalHeightmapSize - kfGlobalHeightmapSize * (fY - rf4Area.w) / (rf4Area.y - rf4Area.w));
+	if (iX < 0 || iX >= kiGlobalHeightmapSize || iY < 0 || iY >= kiGlobalHeightmapSize)
+	{
+		return kfSeaFloorElevation;
+	}
+	return rHeightmap[rFlipTables.piRows[iY] * kiGlobalHeightmapSize + rFlipTables.piColumns[iX]];
+}
+
+void MatchesRebuiltHeightmap()
+{
+	static constexpr int64_t kiPositions = 200'000;
+
+	auto pIdentity = std::make_unique<FlipTables>();
+	engine::BuildFlipTables(pIdentity->piRows, pIdentity->piColumns, false, false, {0.0f, 1.0f, 1.0f, 0.0f}, {});
+
+	for (const Layout& rLayout : Layouts())
+	{
+		std::vector<float> unflipped = RenderHeightmap(rLayout, false, false);
+		for (int64_t iFlip = engine::kFlipNone; iFlip < engine::kFlipCount; ++iFlip)
+		{
+			bool bFlipX = iFlip == engine::kFlipX || iFlip == engine::kFlipXY;
+			bool bFlipY = iFlip == engine::kFlipY || iFlip == engine::kFlipXY;
+			auto pFlipTables = std::make_unique<FlipTables>();
+			engine::BuildFlipTables(pFlipTables->piRows, pFlipTables->piColumns, bFlipX, bFlipY, rLayout.f4GlobalArea, rLayout.vertexRects);
+
+			// What the heightmap used to be rebuilt as on every flip
+			std::vector<float> rebuilt = RenderHeightmap(rLayout, bFlipX, bFlipY);
+
+			int64_t iTexelMismatches = 0;
+			for (int64_t iRow = 0; iRow < kiGlobalHeightmapSize; ++iRow)
+			{
+				for (int64_t iColumn = 0; iColumn < kiGlobalHeightmapSize; ++iColumn)
+				{
+					iTexelMismatches += unflipped[pFlipTables->piRows[iRow] * kiGlobalHeightmapSize + pFlipTables->piColumns[iColumn]] != rebuilt[iRow * kiGlobalHeightmapSize + iColumn];
+				}
+			}
+
+			// Positions around and outside the global area, through the lookup the game uses
+			const DirectX::XMFLOAT4& rf4Area = rLayout.f4GlobalArea;
+			float fMarginX = 0.05f * (rf4Area.z - rf4Area.x);
+			float fMarginY = 0.05f * (rf4Area.y - rf4Area.w);
+			std::mt19937 generator(static_cast<uint32_t>(iFlip));
+			std::uniform_real_distribution<float> distributionX(rf4Area.x - fMarginX, rf4Area.z + fMarginX);
+			std::uniform_real_distribution<float> distributionY(rf4Area.w - fMarginY, rf4Area.y + fMarginY);
+			int64_t iPositionMismatches = 0;
+			for (int64_t i = 0; i < kiPositions; ++i)
+			{
+				float fX = distributionX(generator);
+				float fY = distributionY(generator);
+				iPositionMismatches += GlobalElevation(unflipped, *pFlipTables, rf4Area, fX, fY) != GlobalElevation(rebuilt, *pIdentity, rf4Area, fX, fY);
+			}
+
+			std::printf("%s flip %lld: %lld texel and %lld of %lld position mismatches\n", rLayout.pcName, static_cast<long long>(iFlip), static_cast<long long>(iTexelMismatches), static_cast<long long>(iPositionMismatches), static_cast<long long>(kiPositions));
+			CHECK(iTexelMismatches == 0);
+			CHECK(iPositionMismatches == 0);
+		}
+	}
+}
+
+void TablesArePermutations()
+{
+	for (const Layout& rLayout : Layouts())
+	{
+		auto pFlipTables = std::make_unique<FlipTables>();
+		engine::BuildFlipTables(pFlipTables->piRows, pFlipTables->piColumns, true, true, rLayout.f4GlobalArea, rLayout.vertexRects);
+		for (const int32_t* piTable : {pFlipTables->piRows, pFlipTables->piColumns})
+		{
+			std::vector<int32_t> sorted(piTable, piTable + kiGlobalHeightmapSize);
+			std::sort(sorted.begin(), sorted.end());
+			std::vector<int32_t> identity(kiGlobalHeightmapSize);
+			std::iota(identity.begin(), identity.end(), 0);
+			CHECK(sorted == identity);
+
+			// Flipping twice is no flip
+			for (int32_t i = 0; i < kiGlobalHeightmapSize; ++i)
+			{
+				CHECK(piTable[piTable[i]] == i);
+			}
+		}
+	}
+}
+
+// Islands sharing some columns but not all of them can't be mirrored through one column table
+void OffGridLayoutThrows()
+{
+	Layout layout = MakeLayout("Off grid", {{0.0f, 100.0f, 100.0f, -50.0f}, {50.0f, 50.0f, 100.0f, -50.0f}});
+	auto pFlipTables = std::make_unique<FlipTables>();
+	CHECK_THROWS(engine::BuildFlipTables(pFlipTables->piRows, pFlipTables->piColumns, true, false, layout.f4GlobalArea, layout.vertexRects));
+
+	// Rows are still a grid so flipping only Y is fine
+	engine::BuildFlipTables(pFlipTables->piRows, pFlipTables->piColumns, false, true, layout.f4GlobalArea, layout.vertexRects);
+	CHECK(pFlipTables->piRows[0] == kiGlobalHeightmapSize / 2 - 1);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(MatchesRebuiltHeightmap);
+	RUN_TEST(TablesArePermutations);
+	RUN_TEST(OffGridLayoutThrows);
+	return test::Result();
+}
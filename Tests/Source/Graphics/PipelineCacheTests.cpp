@@ -0,0 +1,256 @@
+#include <sstream>
+
+#include "Graphics/PipelineCache.h"
+
+using engine::PipelineCacheHeader;
+
+namespace
+{
+
+VkPhysicalDeviceProperties FakeProperties()
+{
+	VkPhysicalDeviceProperties vkPhysicalDeviceProperties {};
+	vkPhysicalDeviceProperties.vendorID = 0x10de;
+	vkPhysicalDeviceProperties.deviceID = 0x2684;
+	vkPhysicalDeviceProperties.driverVersion = 0x89a8c000;
+	for (uint8_t i = 0; i < VK_UUID_SIZE; ++i)
+	{
+		vkPhysicalDeviceProperties.pipelineCacheUUID[i] = static_cast<uint8_t>(i * 7 + 1);
+	}
+	return vkPhysicalDeviceProperties;
+}
+
+std::vector<uint8_t> FakeData(int64_t iSize)
+{
+	std::mt19937 random {1234};
+	std::vector<uint8_t> data(iSize);
+	for (uint8_t& rByte : data)
+	{
+		rByte = static_cast<uint8_t>(random());
+	}
+	return data;
+}
+
+std::string Write(const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties, std::span<const uint8_t> data)
+{
+	std::stringstream stream;
+	CHECK(engine::WritePipelineCache(stream, rVkPhysicalDeviceProperties, data));
+	return stream.str();
+}
+
+std::vector<uint8_t> Read(const std::string& rFile, const VkPhysicalDeviceProperties& rVkPhysicalDeviceProperties)
+{
+	std::stringstream stream(rFile);
+	return engine::ReadPipelineCache(stream, rVkPhysicalDeviceProperties);
+}
+
+void RoundTrips()
+{
+	VkPhysicalDeviceProperties vkPhysicalDeviceProperties = FakeProperties();
+	for (int64_t iSize : {1, 32, 1000, 65536})
+	{
+		std::vector<uint8_t> data = FakeData(iSize);
+		std::string file = Write(vkPhysicalDeviceProperties, data);
+		CHECK(file.size() == sizeof(PipelineCacheHeader) + data.size());
+		CHECK(Read(file, vkPhysicalDeviceProperties) == data);
+	}
+}
+
+// Each of these would hand the driver data it didn't write
+void OtherDeviceOrDriverIsDiscarded()
+{
+	VkPhysicalDeviceProperties vkPhysicalDeviceProperties = FakeProperties();
+	std::string file = Write(vkPhysicalDeviceProperties, FakeData(1000));
+
+	VkPhysicalDeviceProperties other = vkPhysicalDeviceProperties;
+	other.vendorID += 1;
+	CHECK(Read(file, other).empty());
+
+	other = vkPhysicalDeviceProperties;
+	other.deviceID += 1;
+	CHECK(Read(file, other).empty());
+
+	other = vkPhysicalDeviceProperties;
+	other.driverVersion += 1;
+	CHECK(Read(file, other).empty());
+
+	other = vkPhysicalDeviceProperties;
+	other.pipelineCacheUUID[VK_UUID_SIZE - 1] ^= 1;
+	CHECK(Read(file, other).empty());
+
+	CHECK(Read(file, vkPhysicalDeviceProperties).size() == 1000);
+}
+
+void DamagedFileIsDiscarded()
+{
+	VkPhysicalDeviceProperties vkPhysicalDeviceProperties = FakeProperties();
+	std::vector<uint8_t> data = FakeData(1000);
+	std::string file = Write(vkPhysicalDeviceProperties, data);
+
+	// A partial write, cut in the header and in the data
+	CHECK(Read(file.substr(0, sizeof(PipelineCacheHeader) - 1), vkPhysicalDeviceProperties).empty());
+	CHECK(Read(file.substr(0, file.size() - 1), vkPhysicalDeviceProperties).empty());
+	CHECK(Read("", vkPhysicalDeviceProperties).empty());
+
+	// One flipped bit in the data fails the crc
+	std::string damaged = file;
+	damaged[sizeof(PipelineCacheHeader) + 500] ^= 0x10;
+	CHECK(Read(damaged, vkPhysicalDeviceProperties).empty());
+
+	// Another version of the header
+	damaged = file;
+	damaged[offsetof(PipelineCacheHeader, iVersion)] ^= 1;
+	CHECK(Read(damaged, vkPhysicalDeviceProperties).empty());
+
+	// Nothing to give the driver
+	CHECK(Read(Write(vkPhysicalDeviceProperties, {}), vkPhysicalDeviceProperties).empty());
+}
+
+void HeaderSizeIsBounded()
+{
+	PipelineCacheHeader expected = engine::MakePipelineCacheHeader(FakeProperties());
+	PipelineCacheHeader header = expected;
+
+	header.iDataSize = 1;
+	CHECK(engine::ValidPipelineCacheHeader(header, expected));
+	header.iDataSize = PipelineCacheHeader::kiMaxDataSize;
+	CHECK(engine::ValidPipelineCacheHeader(header, expected));
+
+	header.iDataSize = 0;
+	CHECK(!engine::ValidPipelineCacheHeader(header, expected));
+	header.iDataSize = -1;
+	CHECK(!engine::ValidPipelineCacheHeader(header, expected));
+	header.iDataSize = PipelineCacheHeader::kiMaxDataSize + 1;
+	CHECK(!engine::ValidPipelineCacheHeader(header, expected));
+
+	header.iDataSize = 1;
+	header.iMagic = 0;
+	CHECK(!engine::ValidPipelineCacheHeader(header, expected));
+}
+
+// Saves the cache of a real device, reloads it like DeviceManager::CreatePipelineCache() and saves that one again
+// Machines without a Vulkan driver, like most CI runners, only run the tests above
+void DriverReloadsCache()
+{
+	VkApplicationInfo vkApplicationInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+		.pNext = nullptr,
+		.pApplicationName = "PipelineCacheTests",
+		.applicationVersion = 0,
+		.pEngineName = nullptr,
+		.engineVersion = 0,
+		.apiVersion = VK_API_VERSION_1_0,
+	};
+	VkInstanceCreateInfo vkInstanceCreateInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.pApplicationInfo = &vkApplicationInfo,
+		.enabledLayerCount = 0,
+		.ppEnabledLayerNames = nullptr,
+		.enabledExtensionCount = 0,
+		.ppEnabledExtensionNames = nullptr,
+	};
+	VkInstance vkInstance = VK_NULL_HANDLE;
+	if (vkCreateInstance(&vkInstanceCreateInfo, nullptr, &vkInstance) != VK_SUCCESS)
+	{
+		std::printf("No Vulkan driver, skipping\n");
+		return;
+	}
+	common::ScopedLambda destroyInstance([&vkInstance]()
+	{
+		vkDestroyInstance(vkInstance, nullptr);
+	});
+
+	uint32_t uiPhysicalDeviceCount = 1;
+	VkPhysicalDevice vkPhysicalDevice = VK_NULL_HANDLE;
+	VkResult vkResult = vkEnumeratePhysicalDevices(vkInstance, &uiPhysicalDeviceCount, &vkPhysicalDevice);
+	if ((vkResult != VK_SUCCESS && vkResult != VK_INCOMPLETE) || uiPhysicalDeviceCount == 0)
+	{
+		std::printf("No Vulkan device, skipping\n");
+		return;
+	}
+	VkPhysicalDeviceProperties vkPhysicalDeviceProperties {};
+	vkGetPhysicalDeviceProperties(vkPhysicalDevice, &vkPhysicalDeviceProperties);
+
+	float fQueuePriority = 1.0f;
+	VkDeviceQueueCreateInfo vkDeviceQueueCreateInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.queueFamilyIndex = 0,
+		.queueCount = 1,
+		.pQueuePriorities = &fQueuePriority,
+	};
+	VkDeviceCreateInfo vkDeviceCreateInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.queueCreateInfoCount = 1,
+		.pQueueCreateInfos = &vkDeviceQueueCreateInfo,
+		.enabledLayerCount = 0,
+		.ppEnabledLayerNames = nullptr,
+		.enabledExtensionCount = 0,
+		.ppEnabledExtensionNames = nullptr,
+		.pEnabledFeatures = nullptr,
+	};
+	VkDevice vkDevice = VK_NULL_HANDLE;
+	CHECK(vkCreateDevice(vkPhysicalDevice, &vkDeviceCreateInfo, nullptr, &vkDevice) == VK_SUCCESS);
+	if (vkDevice == VK_NULL_HANDLE)
+	{
+		return;
+	}
+	common::ScopedLambda destroyDevice([&vkDevice]()
+	{
+		vkDestroyDevice(vkDevice, nullptr);
+	});
+
+	auto save = [vkDevice](const std::vector<uint8_t>& rInitialData)
+	{
+		VkPipelineCacheCreateInfo vkPipelineCacheCreateInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.initialDataSize = rInitialData.size(),
+			.pInitialData = rInitialData.empty() ? nullptr : rInitialData.data(),
+		};
+		VkPipelineCache vkPipelineCache = VK_NULL_HANDLE;
+		CHECK(vkCreatePipelineCache(vkDevice, &vkPipelineCacheCreateInfo, nullptr, &vkPipelineCache) == VK_SUCCESS);
+
+		size_t dataSize = 0;
+		CHECK(vkGetPipelineCacheData(vkDevice, vkPipelineCache, &dataSize, nullptr) == VK_SUCCESS);
+		std::vector<uint8_t> data(dataSize);
+		CHECK(vkGetPipelineCacheData(vkDevice, vkPipelineCache, &dataSize, data.data()) == VK_SUCCESS);
+		vkDestroyPipelineCache(vkDevice, vkPipelineCache, nullptr);
+		return data;
+	};
+
+	// Even an empty cache has the driver's own header, which is enough for the driver to check what it's given
+	std::vector<uint8_t> data = save({});
+	CHECK(data.size() >= 16 + VK_UUID_SIZE);
+
+	std::string file = Write(vkPhysicalDeviceProperties, data);
+	std::vector<uint8_t> loaded = Read(file, vkPhysicalDeviceProperties);
+	CHECK(loaded == data);
+
+	// The driver accepts its own data back and writes a cache for the same device
+	std::vector<uint8_t> reloaded = save(loaded);
+	CHECK(reloaded.size() >= 16 + VK_UUID_SIZE && std::equal(reloaded.begin(), reloaded.begin() + 16 + VK_UUID_SIZE, data.begin()));
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(RoundTrips);
+	RUN_TEST(OtherDeviceOrDriverIsDiscarded);
+	RUN_TEST(DamagedFileIsDiscarded);
+	RUN_TEST(HeaderSizeIsBounded);
+	RUN_TEST(DriverReloadsCache);
+	return test::Result();
+}
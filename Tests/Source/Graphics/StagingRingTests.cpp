@@ -0,0 +1,124 @@
+#include "Graphics/StagingRing.h"
+
+using engine::StagingRing;
+
+namespace
+{
+
+constexpr int64_t kiBlockSize = 1024;
+constexpr int64_t kiBlockCount = 4;
+constexpr int64_t kiAlignment = 16;
+
+void PacksAndAligns()
+{
+	StagingRing stagingRing(kiBlockSize, kiBlockCount, kiAlignment);
+
+	StagingRing::Allocation first = stagingRing.Allocate(100);
+	CHECK(first.bNewBlock && first.iBlock == 0 && first.iOffset == 0);
+
+	StagingRing::Allocation second = stagingRing.Allocate(100);
+	CHECK(!second.bNewBlock && second.iBlock == 0 && second.iOffset == 112);
+
+	// 212 rounded up to 224, 224 + 800 fits exactly
+	StagingRing::Allocation third = stagingRing.Allocate(800);
+	CHECK(!third.bNewBlock && third.iBlock == 0 && third.iOffset == 224);
+
+	StagingRing::Allocation fourth = stagingRing.Allocate(1);
+	CHECK(fourth.bNewBlock && fourth.iBlock == 1 && fourth.iOffset == 0);
+}
+
+void CyclesThroughBlocks()
+{
+	StagingRing stagingRing(kiBlockSize, kiBlockCount, kiAlignment);
+
+	for (int64_t i = 0; i < 3 * kiBlockCount; ++i)
+	{
+		StagingRing::Allocation allocation = stagingRing.Allocate(kiBlockSize);
+		CHECK(allocation.bNewBlock && allocation.iBlock == i % kiBlockCount && allocation.iOffset == 0);
+	}
+	CHECK(stagingRing.miBlocksStarted == 3 * kiBlockCount);
+
+	stagingRing.Clear();
+	StagingRing::Allocation allocation = stagingRing.Allocate(1);
+	CHECK(allocation.bNewBlock && allocation.iBlock == 0);
+}
+
+void RejectsOversize()
+{
+	StagingRing stagingRing(kiBlockSize, kiBlockCount, kiAlignment);
+
+	CHECK_THROWS(stagingRing.Allocate(kiBlockSize + 1));
+	CHECK_THROWS(stagingRing.Allocate(0));
+}
+
+// TextureUploader aligns every upload for its own format, a BC7 texture after an R8 one moves up to a whole block
+void AlignsPerAllocation()
+{
+	StagingRing stagingRing(kiBlockSize, kiBlockCount, 1);
+
+	CHECK(stagingRing.Allocate(3).iOffset == 0);
+	CHECK(stagingRing.Allocate(5, 16).iOffset == 16);
+	CHECK(stagingRing.Allocate(1, 2).iOffset == 22);
+
+	// Combined with the alignment of the ring, 48 is the first multiple of both 3 and 16 past 23
+	StagingRing threes(kiBlockSize, kiBlockCount, 3);
+	CHECK(threes.Allocate(23).iOffset == 0);
+	CHECK(threes.Allocate(1, 16).iOffset == 48);
+
+	CHECK_THROWS(stagingRing.Allocate(1, 0));
+}
+
+// Replays TextureUploader's use of the ring, a block is only written again after the upload that last read it was retired
+void NeverOverwritesLiveBlocks()
+{
+	StagingRing stagingRing(kiBlockSize, kiBlockCount, kiAlignment);
+	std::mt19937 randomEngine(1);
+	std::uniform_int_distribution<int64_t> sizeDistribution(1, kiBlockSize);
+
+	// Per block whether its copies are still in flight and where its last allocation ends
+	std::array<bool, kiBlockCount> pbInFlight {};
+	std::array<int64_t, kiBlockCount> piBlockEnd {};
+	int64_t iPendingBlock = -1;
+	int64_t iTotal = 0;
+
+	for (int64_t i = 0; i < 10'000; ++i)
+	{
+		int64_t iSize = sizeDistribution(randomEngine);
+		iTotal += iSize;
+		StagingRing::Allocation allocation = stagingRing.Allocate(iSize);
+		CHECK(allocation.iBlock >= 0 && allocation.iBlock < kiBlockCount);
+		CHECK(allocation.iOffset % kiAlignment == 0 && allocation.iOffset + iSize <= kiBlockSize);
+
+		if (allocation.bNewBlock)
+		{
+			// SubmitPending() then RetireBlock()
+			if (iPendingBlock >= 0)
+			{
+				pbInFlight[iPendingBlock] = true;
+			}
+			pbInFlight[allocation.iBlock] = false;
+			piBlockEnd[allocation.iBlock] = 0;
+			iPendingBlock = allocation.iBlock;
+		}
+
+		CHECK(allocation.iBlock == iPendingBlock && !pbInFlight[allocation.iBlock]);
+		CHECK(allocation.iOffset >= piBlockEnd[allocation.iBlock]);
+		piBlockEnd[allocation.iBlock] = allocation.iOffset + iSize;
+	}
+
+	// Far more was staged than the ring holds
+	CHECK(iTotal > 100 * kiBlockSize * kiBlockCount);
+	CHECK(stagingRing.miBlocksStarted > kiBlockCount);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(PacksAndAligns);
+	RUN_TEST(CyclesThroughBlocks);
+	RUN_TEST(RejectsOversize);
+	RUN_TEST(AlignsPerAllocation);
+	RUN_TEST(NeverOverwritesLiveBlocks);
+	return test::Result();
+}
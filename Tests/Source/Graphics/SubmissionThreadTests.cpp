@@ -0,0 +1,122 @@
+#include "Graphics/SubmissionThread.h"
+
+using engine::SubmissionThread;
+using engine::SubmitDescriptor;
+using engine::SubmitType;
+
+namespace
+{
+
+// Stands in for vkQueueSubmit and vkQueuePresentKHR, records what it was given in the order it got it
+struct FakeSubmit
+{
+	std::chrono::microseconds delay {};
+	int64_t iThrowAt = -1;
+	std::vector<std::pair<SubmitType, uint32_t>> submits {};
+
+	SubmissionThread::ProcessFunction Function()
+	{
+		return [this](SubmitDescriptor& rSubmitDescriptor)
+		{
+			if (static_cast<int64_t>(submits.size()) == iThrowAt)
+			{
+				throw std::runtime_error("VK_ERROR_DEVICE_LOST");
+			}
+
+			std::this_thread::sleep_for(delay);
+			submits.emplace_back(rSubmitDescriptor.eSubmitType, rSubmitDescriptor.uiImageIndex);
+		};
+	}
+};
+
+void Push(SubmissionThread& rSubmissionThread, SubmitType eSubmitType, uint32_t uiImageIndex)
+{
+	SubmitDescriptor& rSubmitDescriptor = rSubmissionThread.Back();
+	rSubmitDescriptor.eSubmitType = eSubmitType;
+	rSubmitDescriptor.uiImageIndex = uiImageIndex;
+	rSubmissionThread.Push();
+}
+
+void SubmitsInOrder()
+{
+	FakeSubmit fakeSubmit {.delay = std::chrono::microseconds(50)};
+	std::vector<std::pair<SubmitType, uint32_t>> expected;
+	{
+		SubmissionThread submissionThread(fakeSubmit.Function());
+
+		// Far more frames than the queue holds, Back() has to wait for the thread to free slots
+		for (uint32_t i = 0; i < 100; ++i)
+		{
+			for (SubmitType eSubmitType : {SubmitType::kGlobal, SubmitType::kMain, SubmitType::kImage, SubmitType::kPresent})
+			{
+				Push(submissionThread, eSubmitType, i);
+				expected.emplace_back(eSubmitType, i);
+			}
+		}
+
+		submissionThread.WaitIdle();
+		CHECK(fakeSubmit.submits == expected);
+	}
+
+	// Nothing runs after the thread is gone
+	CHECK(fakeSubmit.submits == expected);
+}
+
+void WaitIdleWaitsForEverything()
+{
+	FakeSubmit fakeSubmit {.delay = std::chrono::milliseconds(5)};
+	SubmissionThread submissionThread(fakeSubmit.Function());
+
+	Push(submissionThread, SubmitType::kImage, 0);
+	Push(submissionThread, SubmitType::kPresent, 0);
+	submissionThread.WaitIdle();
+	CHECK(fakeSubmit.submits.size() == 2);
+
+	// Idle with nothing pushed returns straight away
+	submissionThread.WaitIdle();
+	CHECK(fakeSubmit.submits.size() == 2);
+}
+
+void RethrowsOnRenderThread()
+{
+	FakeSubmit fakeSubmit {.iThrowAt = 3};
+	SubmissionThread submissionThread(fakeSubmit.Function());
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		Push(submissionThread, SubmitType::kImage, i);
+	}
+	submissionThread.WaitIdle();
+	CHECK(fakeSubmit.submits.size() == 3);
+
+	// The fourth submit fails, WaitIdle() has to return and hand the error over instead of waiting forever
+	Push(submissionThread, SubmitType::kImage, 3);
+	CHECK_THROWS(submissionThread.WaitIdle());
+	CHECK(fakeSubmit.submits.size() == 3);
+}
+
+void DestroysWhileBusy()
+{
+	FakeSubmit fakeSubmit {.delay = std::chrono::milliseconds(1)};
+	{
+		SubmissionThread submissionThread(fakeSubmit.Function());
+		for (uint32_t i = 0; i < 6; ++i)
+		{
+			Push(submissionThread, SubmitType::kMain, i);
+		}
+	}
+
+	// The stop goes through the queue behind the pending submits, so they all still run
+	CHECK(fakeSubmit.submits.size() == 6);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(SubmitsInOrder);
+	RUN_TEST(WaitIdleWaitsForEverything);
+	RUN_TEST(RethrowsOnRenderThread);
+	RUN_TEST(DestroysWhileBusy);
+	return test::Result();
+}
@@ -0,0 +1,127 @@
+#include "Graphics/StagingRing.h"
+#include "Graphics/TextureCopies.h"
+
+namespace
+{
+
+// Every format Textures.bin and the engine's own textures use
+constexpr VkFormat kpFormats[]
+{
+	VK_FORMAT_BC4_UNORM_BLOCK,
+	VK_FORMAT_BC7_UNORM_BLOCK,
+	VK_FORMAT_R8_UNORM,
+	VK_FORMAT_R16_UNORM,
+	VK_FORMAT_R8G8B8A8_UNORM,
+	VK_FORMAT_R32_SFLOAT,
+	VK_FORMAT_R16G16B16A16_SFLOAT,
+};
+
+// Mips below 4 x 4 still take a whole block, the packer stops at 4 x 4 but engine textures don't have to
+void SmallBlockCompressedMips()
+{
+	CHECK(common::SizeInBytes(VK_FORMAT_BC7_UNORM_BLOCK, 1, 1) == 16);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC7_UNORM_BLOCK, 2, 2) == 16);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC7_UNORM_BLOCK, 4, 4) == 16);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC7_UNORM_BLOCK, 8, 2) == 32);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC7_UNORM_BLOCK, 5, 5) == 64);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC4_UNORM_BLOCK, 1, 1) == 8);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC4_UNORM_BLOCK, 16, 8) == 64);
+
+	// Same as before for everything the packer writes
+	CHECK(common::SizeInBytes(VK_FORMAT_BC7_UNORM_BLOCK, 256, 128) == 256 * 128);
+	CHECK(common::SizeInBytes(VK_FORMAT_BC4_UNORM_BLOCK, 256, 128) == 256 * 128 / 2);
+	CHECK(common::SizeInBytes(VK_FORMAT_R16_UNORM, 3, 5) == 30);
+
+	// A 16 x 16 BC7 texture down to 1 x 1, two layers
+	std::vector<VkBufferImageCopy> copies;
+	engine::BuildTextureCopies(copies, VK_FORMAT_BC7_UNORM_BLOCK, {16, 16, 1}, 5, 2, 0);
+	CHECK(copies.size() == 10);
+
+	constexpr VkDeviceSize kpuiOffsets[] {0, 256, 320, 336, 352, 368, 624, 688, 704, 720};
+	constexpr uint32_t kpuiExtents[] {16, 8, 4, 2, 1};
+	int64_t iWrong = 0;
+	for (int64_t i = 0; i < 10; ++i)
+	{
+		const VkBufferImageCopy& rCopy = copies[i];
+		iWrong += rCopy.bufferOffset != kpuiOffsets[i];
+		iWrong += rCopy.imageExtent.width != kpuiExtents[i % 5] || rCopy.imageExtent.height != kpuiExtents[i % 5] || rCopy.imageExtent.depth != 1;
+		iWrong += rCopy.imageSubresource.mipLevel != i % 5 || rCopy.imageSubresource.baseArrayLayer != i / 5 || rCopy.imageSubresource.layerCount != 1;
+	}
+	CHECK(iWrong == 0);
+	CHECK(engine::TextureUploadSize(VK_FORMAT_BC7_UNORM_BLOCK, {16, 16, 1}, 5, 2) == 736);
+}
+
+// Halving stops at 1, an 8 x 2 texture goes 8 x 2, 4 x 1, 2 x 1, 1 x 1
+void NonSquareMipsStopAtOne()
+{
+	std::vector<VkBufferImageCopy> copies;
+	engine::BuildTextureCopies(copies, VK_FORMAT_R8G8B8A8_UNORM, {8, 2, 1}, 4, 1, 0);
+	CHECK(copies.size() == 4);
+	CHECK(copies[2].imageExtent.width == 2 && copies[2].imageExtent.height == 1);
+	CHECK(copies[3].imageExtent.width == 1 && copies[3].imageExtent.height == 1);
+	CHECK(copies[3].bufferOffset == 64 + 16 + 8);
+	CHECK(engine::TextureUploadSize(VK_FORMAT_R8G8B8A8_UNORM, {8, 2, 1}, 4, 1) == 64 + 16 + 8 + 4);
+}
+
+void AlignmentCoversBlockAndDevice()
+{
+	CHECK(engine::TextureCopyAlignment(VK_FORMAT_BC7_UNORM_BLOCK, 1) == 16);
+	CHECK(engine::TextureCopyAlignment(VK_FORMAT_BC4_UNORM_BLOCK, 1) == 8);
+	CHECK(engine::TextureCopyAlignment(VK_FORMAT_BC4_UNORM_BLOCK, 64) == 64);
+	CHECK(engine::TextureCopyAlignment(VK_FORMAT_R8_UNORM, 1) == 1);
+	CHECK(engine::TextureCopyAlignment(VK_FORMAT_R16_UNORM, 4) == 4);
+	CHECK(engine::TextureCopyAlignment(VK_FORMAT_R16G16B16A16_SFLOAT, 0) == 8);
+}
+
+// Uploads of every format, size and mip count staged back to back like TextureUploader::Upload() does
+// Every copy has to start on a texel block and stay inside its own upload, and the first one on optimalBufferCopyOffsetAlignment too
+void StagedCopiesAreAligned()
+{
+	static constexpr int64_t kiBlockSize = 1024 * 1024;
+	std::mt19937 random {1234};
+
+	for (int64_t iOptimalAlignment : {1, 4, 16, 64, 256})
+	{
+		engine::StagingRing stagingRing(kiBlockSize, 4, 1);
+		int64_t iMisaligned = 0;
+		int64_t iOutside = 0;
+		int64_t iSmallMips = 0;
+		for (int64_t i = 0; i < 2000; ++i)
+		{
+			VkFormat vkFormat = kpFormats[random() % std::size(kpFormats)];
+			VkExtent3D vkExtent3D {1u + static_cast<uint32_t>(random() % 64), 1u + static_cast<uint32_t>(random() % 64), 1};
+			uint32_t uiMipLevels = 1 + static_cast<uint32_t>(std::bit_width(std::max(vkExtent3D.width, vkExtent3D.height)) - 1);
+			uint32_t uiArrayLayers = 1 + static_cast<uint32_t>(random() % 3);
+
+			int64_t iSize = engine::TextureUploadSize(vkFormat, vkExtent3D, uiMipLevels, uiArrayLayers);
+			engine::StagingRing::Allocation allocation = stagingRing.Allocate(iSize, engine::TextureCopyAlignment(vkFormat, iOptimalAlignment));
+
+			std::vector<VkBufferImageCopy> copies;
+			engine::BuildTextureCopies(copies, vkFormat, vkExtent3D, uiMipLevels, uiArrayLayers, allocation.iOffset);
+			iMisaligned += allocation.iOffset % iOptimalAlignment != 0;
+
+			int64_t iBlock = common::TexelBlockSize(vkFormat);
+			for (const VkBufferImageCopy& rCopy : copies)
+			{
+				int64_t iOffset = static_cast<int64_t>(rCopy.bufferOffset);
+				iMisaligned += iOffset % iBlock != 0;
+				iOutside += iOffset < allocation.iOffset || iOffset + common::SizeInBytes(vkFormat, rCopy.imageExtent.width, rCopy.imageExtent.height) > allocation.iOffset + iSize;
+				iSmallMips += rCopy.imageExtent.width < 4 || rCopy.imageExtent.height < 4;
+			}
+		}
+		CHECK(iMisaligned == 0);
+		CHECK(iOutside == 0);
+		CHECK(iSmallMips > 0);
+	}
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(SmallBlockCompressedMips);
+	RUN_TEST(NonSquareMipsStopAtOne);
+	RUN_TEST(AlignmentCoversBlockAndDevice);
+	RUN_TEST(StagedCopiesAreAligned);
+	return test::Result();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// Force included into every test, the engine Pch pulls in Windows, Vulkan and DirectXMath so tests only get the standard library and whatever the build found
+// BT_TEST_DIRECTXMATH, BT_TEST_VULKAN and BT_TEST_FORMAT are set by CMakeLists.txt
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+using namespace std::chrono_literals;
+#include <cmath>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <immintrin.h>
+
+#if defined(_WIN32)
+	// Same as ExternalHeaders.h
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#endif
+
+#if defined(BT_TEST_FORMAT)
+	#include <format>
+#endif
+
+#if defined(BT_TEST_DIRECTXMATH)
+	// Same configuration as ExternalHeaders.h
+	#define _XM_SSE4_INTRINSICS_
+	#include <DirectXMath.h>
+#endif
+
+#if defined(BT_TEST_VULKAN)
+	#include <vulkan/vulkan.h>
+	#undef VK_NULL_HANDLE
+	#define VK_NULL_HANDLE nullptr
+#endif
+
+#define CONCAT(a, b) CONCAT_INNER(a, b)
+#define CONCAT_INNER(a, b) a ## b
+
+// A failed ASSERT throws like in the engine, CHECK_THROWS() in Test.h relies on it
+#undef ASSERT
+#define ASSERT(a) do { if (!(a)) [[unlikely]] { throw std::runtime_error("ASSERT: " #a); } } while (0)
+#define DEBUG_BREAK() ((void)0)
+#define LOG(a, ...) ((void)0)
+#define LOG_INDENT(a) ((void)0)
+#define SCOPED_LOG_INDENT() ((void)0)
+
+#define BOOT_TIMER_START(a) ((void)0)
+#define BOOT_TIMER_STOP(a) ((void)0)
+#define SCOPED_BOOT_TIMER(a) ((void)0)
+#define PROFILE_SET_COUNT(a, b) ((void)0)
+#define CPU_PROFILE_START(a) ((void)0)
+#define SCOPED_CPU_PROFILE(a) ((void)0)
+#define CPU_PROFILE_STOP(a) ((void)0)
+
+// The parts of Utils.h that don't need Windows, Vulkan or DirectXMath
+#include "Crc.h"
+#include "Histogram.h"
+#include "MpscQueue.h"
+#include "Random.h"
+#include "ScopedLambda.h"
+#include "SpscQueue.h"
+#include "ThreadLocal.h"
+#include "WorkerPool.h"
+#if defined(BT_TEST_VULKAN)
+	#include "TexelBlocks.h"
+#endif
+
+#include "Test.h"
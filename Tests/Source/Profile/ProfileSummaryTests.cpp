@@ -0,0 +1,112 @@
+#include "Profile/ProfileSummary.h"
+
+using engine::ProfilePercentiles;
+using engine::ProfileSummaryEntry;
+
+namespace
+{
+
+bool operator==(const ProfilePercentiles& rA, const ProfilePercentiles& rB)
+{
+	return rA.iCount == rB.iCount && rA.iP50 == rB.iP50 && rA.iP90 == rB.iP90 && rA.iP99 == rB.iP99 && rA.iP999 == rB.iP999 && rA.iMax == rB.iMax;
+}
+
+ProfileSummaryEntry Entry(const char* pcName, int64_t iP99, int64_t iP999)
+{
+	return {.name = pcName, .percentiles = {.iCount = 1000, .iP50 = iP99 / 2, .iP90 = iP99 * 3 / 4, .iP99 = iP99, .iP999 = iP999, .iMax = iP999 * 2}};
+}
+
+void PercentilesFromHistogram()
+{
+	auto pHistogram = std::make_unique<common::Histogram>();
+	for (int64_t i = 1; i <= 1000; ++i)
+	{
+		pHistogram->Record(i);
+	}
+
+	ProfilePercentiles percentiles = engine::Percentiles(*pHistogram);
+	CHECK(percentiles.iCount == 1000);
+	CHECK(percentiles.iMax == 1000);
+
+	// Bucket upper bounds, at most 1 / 16 above the exact rank
+	CHECK(percentiles.iP50 >= 500 && percentiles.iP50 <= 500 + 500 / 16);
+	CHECK(percentiles.iP90 >= 900 && percentiles.iP90 <= 900 + 900 / 16);
+	CHECK(percentiles.iP99 >= 990 && percentiles.iP99 <= 1000);
+	CHECK(percentiles.iP999 >= 999 && percentiles.iP999 <= 1000);
+
+	// The window is reset at the end, the total keeps everything
+	engine::ProfileDistribution distribution;
+	distribution.Record(10);
+	distribution.Record(20);
+	distribution.EndWindow();
+	distribution.Record(30);
+	CHECK(distribution.windowPercentiles.iCount == 2 && distribution.windowPercentiles.iMax == 20);
+	CHECK(distribution.window.Count() == 1);
+	CHECK(distribution.total.Count() == 3 && distribution.total.Max() == 30);
+}
+
+void WriteReadRoundTrips()
+{
+	std::vector<ProfileSummaryEntry> entries {Entry("Render", 8000, 12000), Entry("Update UpdateList", 900, 1500), {.name = "Empty", .percentiles = {}}};
+	std::string text = engine::WriteProfileSummary(entries);
+	CHECK(text.starts_with("name,count,p50,p90,p99,p99.9,max\n"));
+	CHECK(text.find("Render,1000,4000,6000,8000,12000,24000\n") != std::string::npos);
+
+	std::vector<ProfileSummaryEntry> read = engine::ReadProfileSummary(text);
+	CHECK(read.size() == entries.size());
+	for (size_t i = 0; i < std::min(read.size(), entries.size()); ++i)
+	{
+		CHECK(read[i].name == entries[i].name);
+		CHECK(read[i].percentiles == entries[i].percentiles);
+	}
+}
+
+void ReadSkipsBadLines()
+{
+	// CRLF, a missing column, an extra column, a non number, an empty name and no trailing new line
+	std::string_view text =
+		"name,count,p50,p90,p99,p99.9,max\r\n"
+		"Good,1,2,3,4,5,6\r\n"
+		"Short,1,2,3,4,5\n"
+		"Long,1,2,3,4,5,6,7\n"
+		"Word,1,2,x,4,5,6\n"
+		",1,2,3,4,5,6\n"
+		"\n"
+		"Last,7,8,9,10,11,12";
+
+	std::vector<ProfileSummaryEntry> read = engine::ReadProfileSummary(text);
+	CHECK(read.size() == 2);
+	if (read.size() == 2)
+	{
+		CHECK(read[0].name == "Good" && read[0].percentiles.iMax == 6);
+		CHECK(read[1].name == "Last" && read[1].percentiles.iCount == 7 && read[1].percentiles.iMax == 12);
+	}
+}
+
+void CompareFindsRegressions()
+{
+	std::vector<ProfileSummaryEntry> baseline {Entry("Same", 1000, 2000), Entry("Slower", 1000, 2000), Entry("Tail", 1000, 2000), Entry("Noise", 100, 120), Entry("Gone", 1000, 2000), Entry("Idle", 0, 0)};
+	baseline.back().percentiles.iCount = 0;
+	std::vector<ProfileSummaryEntry> current {Entry("Same", 1050, 2100), Entry("Slower", 1200, 2000), Entry("Tail", 1000, 2500), Entry("Noise", 140, 160), Entry("New", 9000, 9000), Entry("Idle", 9000, 9000)};
+
+	std::vector<engine::ProfileRegression> regressions = engine::CompareProfileSummaries(baseline, current, engine::kfProfileRegressionThreshold, engine::kiProfileRegressionMinimumUs);
+
+	// Same is under 10%, Noise is 40% but under 50 us, New and Idle have nothing to compare against
+	CHECK(regressions.size() == 2);
+	if (regressions.size() == 2)
+	{
+		CHECK(regressions[0].name == "Slower" && regressions[0].baseline.iP99 == 1000 && regressions[0].current.iP99 == 1200);
+		CHECK(regressions[1].name == "Tail");
+	}
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(PercentilesFromHistogram);
+	RUN_TEST(WriteReadRoundTrips);
+	RUN_TEST(ReadSkipsBadLines);
+	RUN_TEST(CompareFindsRegressions);
+	return test::Result();
+}
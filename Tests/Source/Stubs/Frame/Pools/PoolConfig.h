@@ -0,0 +1,3 @@
+#pragma once
+
+// Stands in for the game's pool sizes, tests instantiate pools with their own index types and sizes
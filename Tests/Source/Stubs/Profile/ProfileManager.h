@@ -0,0 +1,3 @@
+#pragma once
+
+// Stands in for the engine profiler, the test Pch.h turns the profiling macros into no-ops so nothing from it is needed
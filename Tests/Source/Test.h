@@ -0,0 +1,71 @@
+#pragma once
+
+namespace test
+{
+
+inline int64_t giChecks = 0;
+inline int64_t giFailures = 0;
+
+// ctest treats this exit code as skipped, see SKIP_RETURN_CODE in CMakeLists.txt
+inline constexpr int kiSkipped = 77;
+
+inline void Check(bool bPassed, const char* pcExpression, const char* pcFile, int iLine)
+{
+	++giChecks;
+	if (!bPassed) [[unlikely]]
+	{
+		++giFailures;
+		std::fprintf(stderr, "%s(%d): CHECK failed: %s\n", pcFile, iLine, pcExpression);
+	}
+}
+
+inline void CheckNear(double dValue, double dExpected, double dTolerance, const char* pcExpression, const char* pcFile, int iLine)
+{
+	++giChecks;
+	if (!(std::abs(dValue - dExpected) <= dTolerance)) [[unlikely]]
+	{
+		++giFailures;
+		std::fprintf(stderr, "%s(%d): CHECK_NEAR failed: %s, %.9g vs %.9g, tolerance %.9g\n", pcFile, iLine, pcExpression, dValue, dExpected, dTolerance);
+	}
+}
+
+// Runs one test function, an exception escaping it counts as a failure and the remaining tests still run
+template<typename T>
+void Run(const char* pcName, const T& rFunction)
+{
+	int64_t iFailures = giFailures;
+	try
+	{
+		rFunction();
+	}
+	catch (const std::exception& rException)
+	{
+		++giFailures;
+		std::fprintf(stderr, "%s: exception: %s\n", pcName, rException.what());
+	}
+	std::printf("%s: %s\n", pcName, giFailures == iFailures ? "ok" : "FAILED");
+}
+
+inline int Result()
+{
+	std::printf("%lld checks, %lld failed\n", static_cast<long long>(giChecks), static_cast<long long>(giFailures));
+	return giFailures == 0 ? 0 : 1;
+}
+
+// Deterministic clock for code that takes time points as parameters
+struct FakeClock
+{
+	std::chrono::high_resolution_clock::time_point now {};
+
+	void Advance(std::chrono::nanoseconds ns)
+	{
+		now += ns;
+	}
+};
+
+} // namespace test
+
+#define CHECK(a) test::Check(static_cast<bool>(a), #a, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, c) test::CheckNear(static_cast<double>(a), static_cast<double>(b), static_cast<double>(c), #a, __FILE__, __LINE__)
+#define CHECK_THROWS(a) do { bool bThrew = false; try { a; } catch (const std::exception&) { bThrew = true; } test::Check(bThrew, "throws: " #a, __FILE__, __LINE__); } while (0)
+#define RUN_TEST(a) test::Run(#a, a)
@@ -0,0 +1,243 @@
+#include "Ui/Retained.h"
+
+using engine::RetainedLayout;
+using engine::RetainedQuads;
+
+namespace
+{
+
+// Same layout as shaders::WidgetLayout
+struct Quad
+{
+	DirectX::XMFLOAT4 f4VertexRect {};
+	DirectX::XMFLOAT4 f4TextureRect {};
+	uint32_t pui4Misc[4] {};
+};
+
+// What Widget::WriteUniformBuffer() reads from the callbacks of a slider or toggle
+struct Key
+{
+	float pfRect[4] {};
+	float fAspectRatio = 0.0f;
+	bool bFocused = false;
+	uint32_t uiBackground = 0;
+	float fPercent = 0.0f;
+
+	bool operator==(const Key& rOther) const = default;
+};
+
+// Stands in for Widget::WriteQuads(), a background, a slider knob and a quad per character laid out with the arithmetic of TextManager::WriteQuads()
+void BuildQuads(const Key& rKey, std::u32string_view pcText, Quad* pQuads, int64_t& riQuads, int64_t iMaxQuads)
+{
+	auto push = [&](DirectX::XMFLOAT4 f4VertexRect, uint32_t uiColor)
+	{
+		if (riQuads < iMaxQuads)
+		{
+			pQuads[riQuads++] = {.f4VertexRect = f4VertexRect, .f4TextureRect = {0.0f, 0.0f, 1.0f, 1.0f}, .pui4Misc = {uiColor, 0, 1, 0}};
+		}
+	};
+
+	push({-1.0f + 2.0f * rKey.pfRect[0], 1.0f - 2.0f * rKey.pfRect[1], 2.0f * rKey.pfRect[2], -2.0f * rKey.pfRect[3]}, rKey.uiBackground);
+	push({-1.0f + 2.0f * (rKey.pfRect[0] + rKey.fPercent * rKey.pfRect[2]), 1.0f - 2.0f * rKey.pfRect[1], 0.04f * rKey.pfRect[2], -2.0f * rKey.pfRect[3]}, rKey.bFocused ? 0xFFFFFFFF : ~rKey.uiBackground);
+
+	float fSize = 0.5f * rKey.pfRect[3];
+	float fScaleX = fSize / rKey.fAspectRatio;
+	float fCurrentX = rKey.pfRect[0];
+	for (char32_t c : pcText)
+	{
+		float fAdvance = 0.4f + 0.01f * static_cast<float>(c % 32);
+		float fXOffset = 0.02f * static_cast<float>(c % 5);
+		push({-1.0f + 2.0f * (fCurrentX + fScaleX * fXOffset), 1.0f - 2.0f * (rKey.pfRect[1] + fSize * 0.1f), 2.0f * fScaleX * 0.5f, -2.0f * fSize * 0.7f}, 0xFFFFFFFF);
+		fCurrentX += fScaleX * fAdvance;
+	}
+}
+
+void RebuildsOnlyWhenSomethingChanged()
+{
+	RetainedQuads<Key, char32_t, Quad> retainedQuads;
+	std::vector<Quad> scratch(64);
+	int64_t iBuilds = 0;
+	auto update = [&](const Key& rKey, std::u32string_view pcText)
+	{
+		return retainedQuads.Update(rKey, pcText, std::span(scratch), [&](Quad* pQuads, int64_t& riQuads, int64_t iMaxQuads)
+		{
+			++iBuilds;
+			BuildQuads(rKey, pcText, pQuads, riQuads, iMaxQuads);
+		});
+	};
+
+	Key key {.pfRect = {0.1f, 0.2f, 0.3f, 0.05f}, .fAspectRatio = 16.0f / 9.0f, .uiBackground = 0x202020FF, .fPercent = 0.5f};
+	std::u32string text = U"VOLUME";
+
+	CHECK(update(key, text));
+	CHECK(!update(key, text));
+	CHECK(!update(key, std::u32string(U"VOLUME")));
+	CHECK(iBuilds == 1);
+	CHECK(retainedQuads.Quads().size() == 2 + text.size());
+
+	// Every field of the key, and the text
+	Key changed = key;
+	changed.pfRect[3] = 0.06f;
+	CHECK(update(changed, text));
+	changed.fAspectRatio = 4.0f / 3.0f;
+	CHECK(update(changed, text));
+	changed.bFocused = true;
+	CHECK(update(changed, text));
+	changed.uiBackground = 0x303030FF;
+	CHECK(update(changed, text));
+	changed.fPercent = 0.51f;
+	CHECK(update(changed, text));
+	CHECK(update(changed, U"VOLUMF"));
+	CHECK(update(changed, U"VOLUM"));
+	CHECK(update(changed, U""));
+	CHECK(retainedQuads.Quads().size() == 2);
+	CHECK(!update(changed, U""));
+	CHECK(iBuilds == 9);
+
+	retainedQuads.Invalidate();
+	CHECK(update(changed, U""));
+	CHECK(iBuilds == 10);
+}
+
+void RetainedMatchesRebuilt()
+{
+	RetainedQuads<Key, char32_t, Quad> retainedQuads;
+	std::vector<Quad> scratch(64);
+	Key key {.pfRect = {0.4f, 0.6f, 0.2f, 0.04f}, .fAspectRatio = 16.0f / 10.0f, .uiBackground = 0x102030FF, .fPercent = 0.25f};
+	std::u32string_view pcText = U"MUSIC 75%";
+
+	auto build = [&](Quad* pQuads, int64_t& riQuads, int64_t iMaxQuads){ BuildQuads(key, pcText, pQuads, riQuads, iMaxQuads); };
+	retainedQuads.Update(key, pcText, std::span(scratch), build);
+
+	// Scratch memory is shared between widgets, whatever the next one writes doesn't reach the retained copy
+	std::fill(scratch.begin(), scratch.end(), Quad {.f4VertexRect = {9.0f, 9.0f, 9.0f, 9.0f}});
+	CHECK(!retainedQuads.Update(key, pcText, std::span(scratch), build));
+
+	std::vector<Quad> rebuilt(64);
+	int64_t iRebuilt = 0;
+	BuildQuads(key, pcText, rebuilt.data(), iRebuilt, static_cast<int64_t>(rebuilt.size()));
+	CHECK(static_cast<int64_t>(retainedQuads.Quads().size()) == iRebuilt);
+	CHECK(std::memcmp(retainedQuads.Quads().data(), rebuilt.data(), retainedQuads.Quads().size_bytes()) == 0);
+
+	// A build stops at the scratch size like TextManager::WriteQuads() stops at iMaxPos
+	std::vector<Quad> smallScratch(4);
+	retainedQuads.Invalidate();
+	retainedQuads.Update(key, pcText, std::span(smallScratch), build);
+	CHECK(retainedQuads.Quads().size() == 4);
+}
+
+void LayoutReusedOnlyWhenCleanWithSameRects()
+{
+	RetainedLayout retainedLayout;
+	DirectX::XMFLOAT4 f4Parent {0.0f, 0.0f, 1.0f, 1.0f};
+	DirectX::XMFLOAT4 f4Assigned {0.1f, 0.1f, 0.5f, 0.2f};
+	DirectX::XMFLOAT4 f4Padded {0.11f, 0.12f, 0.48f, 0.16f};
+
+	// Never laid out, even when not dirty
+	DirectX::XMFLOAT4 f4Rect = f4Assigned;
+	CHECK(!retainedLayout.Reuse(false, f4Rect, f4Parent));
+	f4Rect = f4Padded;
+	retainedLayout.Store(f4Rect);
+
+	// The parent assigns the same rect again, the padded one comes back without running the layout
+	f4Rect = f4Assigned;
+	CHECK(retainedLayout.Reuse(false, f4Rect, f4Parent));
+	CHECK(RetainedLayout::SameRect(f4Rect, f4Padded));
+
+	// Dirty, a different assigned rect or a different parent all lay out again
+	f4Rect = f4Assigned;
+	CHECK(!retainedLayout.Reuse(true, f4Rect, f4Parent));
+	CHECK(RetainedLayout::SameRect(f4Rect, f4Assigned));
+	retainedLayout.Store(f4Padded);
+
+	f4Rect = {0.1f, 0.1f, 0.5f, 0.21f};
+	CHECK(!retainedLayout.Reuse(false, f4Rect, f4Parent));
+	retainedLayout.Store({0.11f, 0.12f, 0.48f, 0.17f});
+
+	f4Rect = {0.1f, 0.1f, 0.5f, 0.21f};
+	DirectX::XMFLOAT4 f4OtherParent {0.0f, 0.0f, 1.0f, 0.9f};
+	CHECK(!retainedLayout.Reuse(false, f4Rect, f4OtherParent));
+	retainedLayout.Store({0.11f, 0.12f, 0.48f, 0.17f});
+	f4Rect = {0.1f, 0.1f, 0.5f, 0.21f};
+	CHECK(retainedLayout.Reuse(false, f4Rect, f4OtherParent));
+}
+
+// Not a pass or fail check, prints the CPU time of writing a menu of sliders and toggles
+// Rebuilt is every widget every frame as before, retained is nothing changed, dragged is one slider moving every frame
+void BenchmarkMenu()
+{
+	static constexpr int64_t kiWidgets = 96;
+	static constexpr int64_t kiFrames = 2000;
+	static constexpr int64_t kiMaxQuads = 8192;
+
+	struct MenuWidget
+	{
+		Key key;
+		std::u32string text;
+		RetainedQuads<Key, char32_t, Quad> retainedQuads;
+	};
+	std::vector<MenuWidget> widgets(kiWidgets);
+	for (int64_t i = 0; i < kiWidgets; ++i)
+	{
+		widgets[i].key = {.pfRect = {0.3f, 0.05f + 0.009f * static_cast<float>(i), 0.4f, 0.008f}, .fAspectRatio = 16.0f / 9.0f, .uiBackground = 0x202020FF, .fPercent = 0.5f};
+		widgets[i].text = i % 2 == 0 ? U"RENDER SCALE 100%" : U"REDUCE INPUT LAG";
+	}
+
+	std::vector<Quad> scratch(kiMaxQuads);
+	std::vector<Quad> mapped(kiMaxQuads);
+
+	auto run = [&](const char* pcName, bool bRetained, bool bDrag)
+	{
+		int64_t iQuads = 0;
+		int64_t iBuilds = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int64_t iFrame = 0; iFrame < kiFrames; ++iFrame)
+		{
+			if (bDrag)
+			{
+				widgets[0].key.fPercent = static_cast<float>(iFrame % 100) / 100.0f;
+			}
+
+			iQuads = 0;
+			for (MenuWidget& rWidget : widgets)
+			{
+				if (bRetained)
+				{
+					iBuilds += rWidget.retainedQuads.Update(rWidget.key, std::u32string_view(rWidget.text), std::span(scratch), [&](Quad* pQuads, int64_t& riQuads, int64_t iMaxQuads)
+					{
+						BuildQuads(rWidget.key, rWidget.text, pQuads, riQuads, iMaxQuads);
+					});
+					std::span<const Quad> quads = rWidget.retainedQuads.Quads();
+					std::memcpy(&mapped[iQuads], quads.data(), quads.size_bytes());
+					iQuads += quads.size();
+				}
+				else
+				{
+					BuildQuads(rWidget.key, rWidget.text, mapped.data(), iQuads, kiMaxQuads);
+					++iBuilds;
+				}
+			}
+		}
+		double dUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / kiFrames;
+		std::printf("%s: %.2f us per frame, %lld quads, %.1f widgets built per frame\n", pcName, dUs, static_cast<long long>(iQuads), static_cast<double>(iBuilds) / kiFrames);
+		return iQuads;
+	};
+
+	int64_t iRebuiltQuads = run("Rebuilt", false, false);
+	std::vector<Quad> rebuilt(mapped.begin(), mapped.begin() + iRebuiltQuads);
+	int64_t iRetainedQuads = run("Retained", true, false);
+	CHECK(iRetainedQuads == iRebuiltQuads);
+	CHECK(std::memcmp(mapped.data(), rebuilt.data(), rebuilt.size() * sizeof(Quad)) == 0);
+	run("Retained, one slider dragged", true, true);
+}
+
+} // namespace
+
+int main()
+{
+	RUN_TEST(RebuildsOnlyWhenSomethingChanged);
+	RUN_TEST(RetainedMatchesRebuilt);
+	RUN_TEST(LayoutReusedOnlyWhenCleanWithSameRects);
+	RUN_TEST(BenchmarkMenu);
+	return test::Result();
+}